@@ -0,0 +1,18 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+// Build-time probe : the core package (shared pointer factories, casts, comparisons).
+
+#include <solo/anys/handles/any_handle_core_package.hpp>
+
+bool probe( solo::any_handle const &a_handle )
+{
+    auto const p = solo::any_handle_cast<int>(a_handle);
+    return p.has_value() && a_handle == a_handle;
+}
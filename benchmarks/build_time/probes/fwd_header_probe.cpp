@@ -0,0 +1,18 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+// Build-time probe : a header declaring an API in terms of any_handle (forward declarations only).
+
+#include <solo/anys/handles/any_handle_fwd.hpp>
+
+struct service_registry
+{
+    void add( solo::any_handle const &a_service );
+    solo::any_handle const *find( char const *a_name ) const;
+};
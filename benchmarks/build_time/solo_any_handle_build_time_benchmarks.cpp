@@ -0,0 +1,167 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+// Per translation unit build cost of the library headers.
+//
+// Each probe is a translation unit including one entry point of the library
+// (forward header, core package, complete package, complete package with the testing outputters).
+// For each probe, the driver measures :
+// - the size of the preprocessed unit (bytes and lines),
+// - the median wall time of the preprocessing (-E),
+// - the median wall time of the compilation (-c).
+//
+// Usage (GCC and Clang command lines only) :
+//
+//     solo_any_handle_build_time_benchmarks [--repetitions=N] [--benchmark_out=file.json]
+//         --compiler=<c++ compiler> --probe=<probe.cpp>... -- <compiler flags>...
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct build_time_result
+{
+    std::string probe;
+    std::size_t preprocessed_bytes{0};
+    std::size_t preprocessed_lines{0};
+    double preprocess_ms{0};
+    double compile_ms{0};
+};
+
+std::string quoted( std::string const &a_arg )
+{
+    return "\"" + a_arg + "\"";
+}
+
+/// @brief Run the command @c a_repetitions times, return the median wall time (ms), or a negative value on failure.
+double median_run_ms( std::string const &a_command, int a_repetitions )
+{
+    auto times = std::vector<double>{};
+    for ( auto i = 0; i < a_repetitions; ++i )
+    {
+        auto const start = std::chrono::steady_clock::now();
+        if ( std::system(a_command.c_str()) != 0 )
+        {
+            std::cerr << "failed: " << a_command << std::endl;
+            return -1;
+        }
+        auto const stop = std::chrono::steady_clock::now();
+        times.push_back( std::chrono::duration<double, std::milli>(stop - start).count() );
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+build_time_result measure( std::string const &a_compiler, std::string const &a_flags, std::string const &a_probe, int a_repetitions )
+{
+    auto result = build_time_result{};
+    result.probe = a_probe.substr( a_probe.find_last_of("/\\") + 1 );
+
+    auto const preprocessed_file = std::string{"solo_any_handle_build_time.ii"};
+    auto const object_file = std::string{"solo_any_handle_build_time.o"};
+
+    auto const preprocess = quoted(a_compiler) + a_flags + " -E " + quoted(a_probe) + " -o " + quoted(preprocessed_file);
+    auto const compile = quoted(a_compiler) + a_flags + " -c " + quoted(a_probe) + " -o " + quoted(object_file);
+
+    result.preprocess_ms = median_run_ms(preprocess, a_repetitions);
+    result.compile_ms = median_run_ms(compile, a_repetitions);
+
+    auto preprocessed = std::ifstream{ preprocessed_file, std::ios::binary };
+    auto const content = std::string{ std::istreambuf_iterator<char>{preprocessed}, std::istreambuf_iterator<char>{} };
+    result.preprocessed_bytes = content.size();
+    result.preprocessed_lines = static_cast<std::size_t>( std::count(content.begin(), content.end(), '\n') );
+
+    std::remove(preprocessed_file.c_str());
+    std::remove(object_file.c_str());
+    return result;
+}
+
+void write_json( std::ostream &a_os, std::vector<build_time_result> const &a_results, int a_repetitions )
+{
+    a_os << "{\n  \"repetitions\": " << a_repetitions << ",\n  \"probes\": [\n";
+    for ( auto i = std::size_t{0}; i < a_results.size(); ++i )
+    {
+        auto const &r = a_results[i];
+        a_os << "    { \"probe\": \"" << r.probe << "\""
+             << ", \"preprocessed_bytes\": " << r.preprocessed_bytes
+             << ", \"preprocessed_lines\": " << r.preprocessed_lines
+             << ", \"preprocess_ms\": " << r.preprocess_ms
+             << ", \"compile_ms\": " << r.compile_ms << " }"
+             << ( i + 1 < a_results.size() ? ",\n" : "\n" );
+    }
+    a_os << "  ]\n}\n";
+}
+
+bool starts_with( std::string const &a_arg, std::string const &a_prefix )
+{
+    return a_arg.compare(0, a_prefix.size(), a_prefix) == 0;
+}
+
+}// EONS ANONYMOUS
+
+int main(int argc, char **argv)
+{
+    auto compiler = std::string{};
+    auto flags = std::string{};
+    auto output_file = std::string{"solo_any_handle_build_time_benchmarks.json"};
+    auto repetitions = 5;
+    auto probes = std::vector<std::string>{};
+
+    auto i = 1;
+    for ( ; i < argc; ++i )
+    {
+        auto const arg = std::string{ argv[i] };
+        if ( arg == "--" ) { ++i; break; }
+        else if ( starts_with(arg, "--compiler=") ) { compiler = arg.substr(11); }
+        else if ( starts_with(arg, "--probe=") ) { probes.push_back(arg.substr(8)); }
+        else if ( starts_with(arg, "--repetitions=") ) { repetitions = std::max(1, std::atoi(arg.c_str() + 14)); }
+        else if ( starts_with(arg, "--benchmark_out=") ) { output_file = arg.substr(16); }
+        else
+        {
+            std::cerr << "unrecognized argument: " << arg << std::endl;
+            return 1;
+        }
+    }
+    for ( ; i < argc; ++i )
+    {
+        flags += " " + quoted(argv[i]);
+    }
+
+    if ( compiler.empty() || probes.empty() )
+    {
+        std::cerr << "usage: " << argv[0] << " [--repetitions=N] [--benchmark_out=file.json]"
+                  << " --compiler=<c++ compiler> --probe=<probe.cpp>... -- <compiler flags>..." << std::endl;
+        return 1;
+    }
+
+    auto results = std::vector<build_time_result>{};
+    for ( auto const &probe : probes )
+    {
+        results.push_back( measure(compiler, flags, probe, repetitions) );
+        auto const &r = results.back();
+        if ( r.preprocess_ms < 0 || r.compile_ms < 0 )
+        {
+            return 1;
+        }
+        std::printf("%-40s %10zu bytes %8zu lines %10.1f ms (-E) %10.1f ms (-c)\n",
+                    r.probe.c_str(), r.preprocessed_bytes, r.preprocessed_lines, r.preprocess_ms, r.compile_ms);
+    }
+
+    auto out = std::ofstream{ output_file };
+    write_json(out, results, repetitions);
+    return 0;
+}
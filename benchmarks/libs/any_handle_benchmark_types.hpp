@@ -0,0 +1,65 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/any_handle_package.hpp>
+
+#include <boost/any.hpp>
+#include <any>
+#include <memory>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace benchmarks {
+////////////////////////////////////////////////////////////////////////////////
+
+/// @brief The payload handled by all the contenders.
+struct BenchObject
+{
+    explicit BenchObject(int a_ = 0) noexcept : data{a_} {}
+    int data;
+    int padding[7]{};
+};
+
+/// @brief Another payload type, used to make casting operations fail.
+struct OtherBenchObject
+{
+    double data{0};
+};
+
+// Each operation is measured on four contenders holding the same shared object :
+// - solo::any_handle,
+// - std::shared_ptr<void> (no type information, casts are unchecked static_pointer_cast),
+// - std::any holding a std::shared_ptr<T>,
+// - boost::any holding a std::shared_ptr<T>.
+
+using raw_handle_type = std::shared_ptr<void>;
+
+inline solo::any_handle make_bench_any_handle(int a_ = 0)
+{
+    return solo::make_any_handle_mutable<BenchObject>(stdex::in_place, a_);
+}
+
+inline raw_handle_type make_bench_raw_handle(int a_ = 0)
+{
+    return std::make_shared<BenchObject>(a_);
+}
+
+inline std::any make_bench_std_any(int a_ = 0)
+{
+    return std::make_shared<BenchObject>(a_);
+}
+
+inline boost::any make_bench_boost_any(int a_ = 0)
+{
+    return std::make_shared<BenchObject>(a_);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::BENCHMARKS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,113 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "any_handle_benchmark_types.hpp"
+
+#include <solo/anys/handles/biased/biased_package.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace benchmarks {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// -- copies of a handle by the thread owning the object (plain counter for the biased handle),
+// and by other threads (atomic counter for both : the cost of the owner check is added to the biased handle).
+// The cross-thread correctness is checked by the tests suite (BiasedHandleTests, run under ThreadSanitizer).
+
+/// @brief The number of copies held at once by a fan-out iteration.
+constexpr auto const fan_out_size = 64;
+
+inline solo::anys::biased::biased_handle make_bench_biased_handle(int a_ = 0)
+{
+    return solo::anys::biased::make_biased_handle_mutable<BenchObject>(stdex::in_place, a_);
+}
+
+/// @brief Return a handle to an object whose owner thread has exited (every benchmark thread is foreign to it).
+template < typename Handle, Handle (*MakeHandle)(int) >
+Handle const &foreign_handle()
+{
+    static auto const h = []
+    {
+        auto result = Handle{};
+        std::thread{ [&] { result = MakeHandle(1); } }.join();
+        return result;
+    }();
+    return h;
+}
+
+//..............................................................................
+
+// -- copy : copy the handle on the owner thread (one increment, then one decrement).
+
+template < typename Handle, Handle (*MakeHandle)(int) >
+void Copy_Owner(benchmark::State &state)
+{
+    auto const h = MakeHandle(1);
+    for ( auto _ : state )
+    {
+        auto h_copy = h;
+        benchmark::DoNotOptimize(h_copy);
+    }
+}
+
+// -- fan-out : hold 64 copies at once on the owner thread, then release them.
+
+template < typename Handle, Handle (*MakeHandle)(int) >
+void FanOut_Owner(benchmark::State &state)
+{
+    auto const h = MakeHandle(1);
+    auto copies = std::vector<Handle>{};
+    copies.reserve(fan_out_size);
+    for ( auto _ : state )
+    {
+        for ( auto i = 0; i < fan_out_size; ++i )
+        {
+            copies.push_back(h);
+        }
+        benchmark::DoNotOptimize(copies.data());
+        copies.clear();
+    }
+    state.SetItemsProcessed(fan_out_size * state.iterations());
+}
+
+// -- copy on foreign threads : the same handle copied by all the benchmark threads.
+
+template < typename Handle, Handle (*MakeHandle)(int) >
+void Copy_Foreign(benchmark::State &state)
+{
+    auto const &h = foreign_handle<Handle, MakeHandle>();
+    for ( auto _ : state )
+    {
+        auto h_copy = h;
+        benchmark::DoNotOptimize(h_copy);
+    }
+}
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BENCHMARK_TEMPLATE(Copy_Owner, solo::any_handle, make_bench_any_handle)->Name("AnyHandle_Copy_Owner");
+BENCHMARK_TEMPLATE(Copy_Owner, solo::anys::biased::biased_handle, make_bench_biased_handle)->Name("BiasedHandle_Copy_Owner");
+
+BENCHMARK_TEMPLATE(FanOut_Owner, solo::any_handle, make_bench_any_handle)->Name("AnyHandle_FanOut_Owner");
+BENCHMARK_TEMPLATE(FanOut_Owner, solo::anys::biased::biased_handle, make_bench_biased_handle)->Name("BiasedHandle_FanOut_Owner");
+
+BENCHMARK_TEMPLATE(Copy_Foreign, solo::any_handle, make_bench_any_handle)->Name("AnyHandle_Copy_Foreign")->Threads(1)->Threads(4)->UseRealTime();
+BENCHMARK_TEMPLATE(Copy_Foreign, solo::anys::biased::biased_handle, make_bench_biased_handle)->Name("BiasedHandle_Copy_Foreign")->Threads(1)->Threads(4)->UseRealTime();
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::BENCHMARKS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "any_handle_benchmark_types.hpp"
+
+#include <solo/anys/handles/buses/any_handle_bus.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace benchmarks {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// -- fan-out of BenchObject messages to 1 to 64 subscribers :
+// a hand-written bus casting the handle for every subscriber (the baseline),
+// versus any_handle_bus publishing one message, and a batch of messages.
+// Items are deliveries.
+
+constexpr long bench_batch_size = 64;
+
+using cast_per_subscriber_bus = std::vector<std::function<void( solo::any_handle const & )>>;
+
+cast_per_subscriber_bus make_cast_per_subscriber_bus( long a_subscribers, std::int64_t &a_sum )
+{
+    auto bus = cast_per_subscriber_bus{};
+    for ( auto i = 0l; i < a_subscribers; ++i )
+    {
+        bus.emplace_back( [&a_sum]( solo::any_handle const &a_message )
+        {
+            auto const result = solo::any_handle_cast<BenchObject>(a_message);
+            if ( result.has_value() )
+            {
+                a_sum += result.assume_value()->data;
+            }
+        } );
+    }
+    return bus;
+}
+
+solo::any_handle_bus make_bench_bus( long a_subscribers, std::int64_t &a_sum )
+{
+    auto bus = solo::any_handle_bus{};
+    for ( auto i = 0l; i < a_subscribers; ++i )
+    {
+        bus.subscribe<BenchObject>( [&a_sum]( BenchObject const &a_message ) { a_sum += a_message.data; } );
+    }
+    bus.subscribe<OtherBenchObject>( []( OtherBenchObject const & ) {} );// another topic
+    return bus;
+}
+
+void Bus_CastPerSubscriber(benchmark::State &state)
+{
+    auto sum = std::int64_t{0};
+    auto const bus = make_cast_per_subscriber_bus(state.range(0), sum);
+    auto const message = make_bench_any_handle(1);
+    for ( auto _ : state )
+    {
+        for ( auto const &subscriber : bus )
+        {
+            subscriber(message);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void Bus_Publish(benchmark::State &state)
+{
+    auto sum = std::int64_t{0};
+    auto const bus = make_bench_bus(state.range(0), sum);
+    auto const message = make_bench_any_handle(1);
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(bus.publish(message));
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void Bus_PublishBatch(benchmark::State &state)
+{
+    auto sum = std::int64_t{0};
+    auto const bus = make_bench_bus(state.range(0), sum);
+    auto const messages = std::vector<solo::any_handle>(bench_batch_size, make_bench_any_handle(1));
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(bus.publish(messages.begin(), messages.end()));
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * bench_batch_size);
+}
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BENCHMARK(Bus_CastPerSubscriber)->RangeMultiplier(2)->Range(1, 64);
+BENCHMARK(Bus_Publish)->RangeMultiplier(2)->Range(1, 64);
+BENCHMARK(Bus_PublishBatch)->RangeMultiplier(2)->Range(1, 64);
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::BENCHMARKS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "any_handle_benchmark_types.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace benchmarks {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// -- many call sites : a dispatch loop visiting handles of many distinct types,
+// one cast call site per type (as a message dispatcher or a service locator does).
+// The casts succeed : the measured code is the success path, and the failure paths
+// inlined in each call site only cost instruction cache space.
+
+/// @brief The number of distinct types (i.e. of cast call sites per dispatch loop).
+constexpr std::size_t call_site_count = 64;
+
+template < std::size_t I >
+struct CallSiteObject
+{
+    explicit CallSiteObject(int a_ = 0) noexcept : data{a_} {}
+    int data;
+};
+
+using visit_function = int (*)( solo::any_handle const & );
+
+template < std::size_t I >
+struct cast_visitor
+{
+    static int call( solo::any_handle const &a_handle )
+    {
+        auto const r = solo::any_handle_cast<CallSiteObject<I>>(a_handle);
+        return r.has_value() ? r.assume_value()->data : 0;
+    }
+};
+
+template < std::size_t I >
+struct mutable_cast_visitor
+{
+    static int call( solo::any_handle const &a_handle )
+    {
+        auto const r = solo::any_handle_mutable_cast<CallSiteObject<I>>(a_handle);
+        return r.has_value() ? ++r.assume_value()->data : 0;
+    }
+};
+
+template < std::size_t I >
+struct cast_or_throw_visitor
+{
+    static int call( solo::any_handle const &a_handle )
+    {
+        return solo::any_handle_cast_or_throw<CallSiteObject<I>>(a_handle)->data;
+    }
+};
+
+template < std::size_t... Is >
+std::vector<solo::any_handle> make_call_site_handles( std::index_sequence<Is...> )
+{
+    return { solo::make_any_handle_mutable<CallSiteObject<Is>>(stdex::in_place, static_cast<int>(Is))... };
+}
+
+template < template < std::size_t > class Visit, std::size_t... Is >
+std::vector<visit_function> make_call_site_visitors( std::index_sequence<Is...> )
+{
+    return { &Visit<Is>::call... };
+}
+
+template < template < std::size_t > class Visit >
+void AnyHandle_CallSites(benchmark::State &state)
+{
+    auto const indexes = std::make_index_sequence<call_site_count>{};
+    auto const handles = make_call_site_handles(indexes);
+    auto const visitors = make_call_site_visitors<Visit>(indexes);
+
+    for ( auto _ : state )
+    {
+        auto sum = 0;
+        for ( auto i = std::size_t{0}; i < call_site_count; ++i )
+        {
+            sum += visitors[i](handles[i]);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(call_site_count));
+}
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BENCHMARK_TEMPLATE(AnyHandle_CallSites, cast_visitor)->Name("AnyHandle_CallSites_Cast");
+BENCHMARK_TEMPLATE(AnyHandle_CallSites, mutable_cast_visitor)->Name("AnyHandle_CallSites_MutableCast");
+BENCHMARK_TEMPLATE(AnyHandle_CallSites, cast_or_throw_visitor)->Name("AnyHandle_CallSites_CastOrThrow");
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::BENCHMARKS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,221 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "any_handle_benchmark_types.hpp"
+
+#include <benchmark/benchmark.h>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace benchmarks {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// -- cast hit : retrieve a typed shared pointer to the non-mutable object.
+
+void AnyHandle_CastHit(benchmark::State &state)
+{
+    auto const h = make_bench_any_handle(1);
+    for ( auto _ : state )
+    {
+        auto r = solo::any_handle_cast<BenchObject>(h);
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+void RawSharedPtr_CastHit(benchmark::State &state)
+{
+    auto const h = make_bench_raw_handle(1);
+    for ( auto _ : state )
+    {
+        auto r = std::static_pointer_cast<BenchObject const>(h);// unchecked
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+void StdAny_CastHit(benchmark::State &state)
+{
+    auto const h = make_bench_std_any(1);
+    for ( auto _ : state )
+    {
+        auto const *p = std::any_cast<std::shared_ptr<BenchObject>>(&h);
+        auto r = std::shared_ptr<BenchObject const>{ *p };
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+void BoostAny_CastHit(benchmark::State &state)
+{
+    auto const h = make_bench_boost_any(1);
+    for ( auto _ : state )
+    {
+        auto const *p = boost::any_cast<std::shared_ptr<BenchObject>>(&h);
+        auto r = std::shared_ptr<BenchObject const>{ *p };
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+//..............................................................................
+
+// -- cast miss : fail to cast to another type (no equivalent for std::shared_ptr<void>).
+
+void AnyHandle_CastMiss(benchmark::State &state)
+{
+    auto const h = make_bench_any_handle(1);
+    for ( auto _ : state )
+    {
+        auto r = solo::any_handle_cast<OtherBenchObject>(h);
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+void StdAny_CastMiss(benchmark::State &state)
+{
+    auto const h = make_bench_std_any(1);
+    for ( auto _ : state )
+    {
+        auto const *p = std::any_cast<std::shared_ptr<OtherBenchObject>>(&h);
+        benchmark::DoNotOptimize(p);
+    }
+}
+
+void BoostAny_CastMiss(benchmark::State &state)
+{
+    auto const h = make_bench_boost_any(1);
+    for ( auto _ : state )
+    {
+        auto const *p = boost::any_cast<std::shared_ptr<OtherBenchObject>>(&h);
+        benchmark::DoNotOptimize(p);
+    }
+}
+
+//..............................................................................
+
+// -- mutable cast : retrieve a typed shared pointer to the mutable object.
+
+void AnyHandle_MutableCast(benchmark::State &state)
+{
+    auto const h = make_bench_any_handle(1);
+    for ( auto _ : state )
+    {
+        auto r = solo::any_handle_mutable_cast<BenchObject>(h);
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+void RawSharedPtr_MutableCast(benchmark::State &state)
+{
+    auto const h = make_bench_raw_handle(1);
+    for ( auto _ : state )
+    {
+        auto r = std::static_pointer_cast<BenchObject>(h);// unchecked
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+void StdAny_MutableCast(benchmark::State &state)
+{
+    auto h = make_bench_std_any(1);
+    for ( auto _ : state )
+    {
+        auto r = *std::any_cast<std::shared_ptr<BenchObject>>(&h);
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+void BoostAny_MutableCast(benchmark::State &state)
+{
+    auto h = make_bench_boost_any(1);
+    for ( auto _ : state )
+    {
+        auto r = *boost::any_cast<std::shared_ptr<BenchObject>>(&h);
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+//..............................................................................
+
+// -- throwing cast failure : throw and catch the bad cast exception (no equivalent for std::shared_ptr<void>).
+
+void AnyHandle_CastOrThrowFailure(benchmark::State &state)
+{
+    auto const h = make_bench_any_handle(1);
+    for ( auto _ : state )
+    {
+        try
+        {
+            auto r = solo::any_handle_cast_or_throw<OtherBenchObject>(h);
+            benchmark::DoNotOptimize(r);
+        }
+        catch ( solo::anys::exceptions::bad_any_handle_cast const &ex )
+        {
+            benchmark::DoNotOptimize(&ex);
+        }
+    }
+}
+
+void StdAny_CastOrThrowFailure(benchmark::State &state)
+{
+    auto const h = make_bench_std_any(1);
+    for ( auto _ : state )
+    {
+        try
+        {
+            auto r = std::any_cast<std::shared_ptr<OtherBenchObject>>(h);
+            benchmark::DoNotOptimize(r);
+        }
+        catch ( std::bad_any_cast const &ex )
+        {
+            benchmark::DoNotOptimize(&ex);
+        }
+    }
+}
+
+void BoostAny_CastOrThrowFailure(benchmark::State &state)
+{
+    auto const h = make_bench_boost_any(1);
+    for ( auto _ : state )
+    {
+        try
+        {
+            auto r = boost::any_cast<std::shared_ptr<OtherBenchObject>>(h);
+            benchmark::DoNotOptimize(r);
+        }
+        catch ( boost::bad_any_cast const &ex )
+        {
+            benchmark::DoNotOptimize(&ex);
+        }
+    }
+}
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BENCHMARK(AnyHandle_CastHit);
+BENCHMARK(RawSharedPtr_CastHit);
+BENCHMARK(StdAny_CastHit);
+BENCHMARK(BoostAny_CastHit);
+
+BENCHMARK(AnyHandle_CastMiss);
+BENCHMARK(StdAny_CastMiss);
+BENCHMARK(BoostAny_CastMiss);
+
+BENCHMARK(AnyHandle_MutableCast);
+BENCHMARK(RawSharedPtr_MutableCast);
+BENCHMARK(StdAny_MutableCast);
+BENCHMARK(BoostAny_MutableCast);
+
+BENCHMARK(AnyHandle_CastOrThrowFailure);
+BENCHMARK(StdAny_CastOrThrowFailure);
+BENCHMARK(BoostAny_CastOrThrowFailure);
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::BENCHMARKS
+////////////////////////////////////////////////////////////////////////////////
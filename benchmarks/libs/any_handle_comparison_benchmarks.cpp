@@ -0,0 +1,149 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "any_handle_benchmark_types.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace benchmarks {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// -- comparisons : pointer equality and ordering between two handles.
+// std::any and boost::any have no comparison operators :
+// they are compared through the pointers they hold (which requires a cast).
+
+void AnyHandle_Compare(benchmark::State &state)
+{
+    auto const h1 = make_bench_any_handle(1);
+    auto const h2 = make_bench_any_handle(2);
+    for ( auto _ : state )
+    {
+        auto eq = ( h1 == h2 );
+        auto lt = ( h1 < h2 );
+        benchmark::DoNotOptimize(eq);
+        benchmark::DoNotOptimize(lt);
+    }
+}
+
+void AnyHandle_Equals(benchmark::State &state)
+{
+    auto const h1 = make_bench_any_handle(1);
+    auto const h2 = h1;
+    for ( auto _ : state )
+    {
+        auto eq = h1.equals(h2);
+        benchmark::DoNotOptimize(eq);
+    }
+}
+
+void RawSharedPtr_Compare(benchmark::State &state)
+{
+    auto const h1 = make_bench_raw_handle(1);
+    auto const h2 = make_bench_raw_handle(2);
+    for ( auto _ : state )
+    {
+        auto eq = ( h1 == h2 );
+        auto lt = ( h1 < h2 );
+        benchmark::DoNotOptimize(eq);
+        benchmark::DoNotOptimize(lt);
+    }
+}
+
+void StdAny_Compare(benchmark::State &state)
+{
+    auto const h1 = make_bench_std_any(1);
+    auto const h2 = make_bench_std_any(2);
+    for ( auto _ : state )
+    {
+        auto const &p1 = *std::any_cast<std::shared_ptr<BenchObject>>(&h1);
+        auto const &p2 = *std::any_cast<std::shared_ptr<BenchObject>>(&h2);
+        auto eq = ( p1 == p2 );
+        auto lt = ( p1 < p2 );
+        benchmark::DoNotOptimize(eq);
+        benchmark::DoNotOptimize(lt);
+    }
+}
+
+void BoostAny_Compare(benchmark::State &state)
+{
+    auto const h1 = make_bench_boost_any(1);
+    auto const h2 = make_bench_boost_any(2);
+    for ( auto _ : state )
+    {
+        auto const &p1 = *boost::any_cast<std::shared_ptr<BenchObject>>(&h1);
+        auto const &p2 = *boost::any_cast<std::shared_ptr<BenchObject>>(&h2);
+        auto eq = ( p1 == p2 );
+        auto lt = ( p1 < p2 );
+        benchmark::DoNotOptimize(eq);
+        benchmark::DoNotOptimize(lt);
+    }
+}
+
+// -- sorting type informations : std::type_index order (std::type_info::before)
+// versus the precomputed ordering keys (any_type_index_less).
+
+template < std::size_t I >
+struct SortedTypeObject {};
+
+template < std::size_t... Is >
+std::vector<solo::any_type_index> make_sort_type_indexes( std::index_sequence<Is...> )
+{
+    auto tis = std::vector<solo::any_type_index>{
+        solo::make_any_type_index<SortedTypeObject<Is>>(solo::mutability::false_)...,
+        solo::make_any_type_index<SortedTypeObject<Is>>(solo::mutability::true_)...
+    };
+    std::reverse(tis.begin(), tis.end());
+    return tis;
+}
+
+template < typename Less >
+void AnyTypeIndex_Sort(benchmark::State &state)
+{
+    auto const tis = make_sort_type_indexes( std::make_index_sequence<128>{} );
+    for ( auto _ : state )
+    {
+        auto sorted = tis;
+        std::sort(sorted.begin(), sorted.end(), Less{});
+        benchmark::DoNotOptimize(sorted.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(tis.size()));
+}
+
+/// @brief The builtin c++ type information order (ignoring the mutability flag).
+struct type_index_less
+{
+    bool operator()( solo::any_type_index const &a_x, solo::any_type_index const &a_y ) const noexcept
+    {
+        return a_x.external_type_index() < a_y.external_type_index();
+    }
+};
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BENCHMARK(AnyHandle_Compare);
+BENCHMARK(AnyHandle_Equals);
+BENCHMARK(RawSharedPtr_Compare);
+BENCHMARK(StdAny_Compare);
+BENCHMARK(BoostAny_Compare);
+BENCHMARK_TEMPLATE(AnyTypeIndex_Sort, type_index_less)->Name("AnyTypeIndex_Sort_TypeIndex");
+BENCHMARK_TEMPLATE(AnyTypeIndex_Sort, solo::any_type_index_less)->Name("AnyTypeIndex_Sort_OrderingKey");
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::BENCHMARKS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,190 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "any_handle_benchmark_types.hpp"
+#include "contention_benchmark_harness.hpp"
+
+#include <solo/anys/handles/allocators/cache_line_allocator.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace benchmarks {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Scaling of the reference-counting operations with the number of threads :
+// - Shared : all the threads work on the same handle (its control block line ping-pongs between cores),
+// - Disjoint : each thread works on its own handle (cache line aligned, so no false sharing either).
+// Each operation is run on 1..N threads, N being the number of hardware threads.
+
+enum class contention_op { copy, cast, destroy, lookup, mixed };
+
+enum class handle_sharing { shared, disjoint };
+
+/// @brief A read-only registry of handles indexed by type, as found in service locators.
+using handle_registry = std::unordered_map<std::type_index, solo::any_handle>;
+
+/// @brief The number of copies kept alive by the destroy operation :
+/// each copy is released @c destroy_window iterations after it has been taken.
+constexpr auto const destroy_window = 64;
+
+/// @brief The handles and registries used by the running benchmark (built by the first thread).
+struct contention_fixture
+{
+    std::vector<solo::any_handle> handles;
+    std::vector<handle_registry> registries;
+
+    void setup( handle_sharing a_sharing, int a_thread_count )
+    {
+        using solo::anys::allocators::cache_line_allocator;
+
+        auto const count = ( a_sharing == handle_sharing::shared ) ? 1 : a_thread_count;
+        for ( auto i = 0; i < count; ++i )
+        {
+            auto h = solo::make_any_handle_mutable<BenchObject>(std::allocator_arg, cache_line_allocator<BenchObject>{}, i);
+            auto registry = handle_registry{};
+            registry.emplace(typeid(BenchObject), h);
+            registry.emplace(typeid(OtherBenchObject), solo::make_any_handle_mutable<OtherBenchObject>(stdex::in_place));
+            registry.emplace(typeid(int), solo::make_any_handle_mutable<int>(stdex::in_place, i));
+            registry.emplace(typeid(double), solo::make_any_handle_mutable<double>(stdex::in_place, i));
+            registry.emplace(typeid(std::string), solo::make_any_handle_mutable<std::string>(stdex::in_place, "registry"));
+            handles.push_back(std::move(h));
+            registries.push_back(std::move(registry));
+        }
+    }
+
+    void teardown()
+    {
+        handles.clear();
+        registries.clear();
+    }
+
+    solo::any_handle const &handle( int a_thread_index ) const
+    {
+        return handles[ static_cast<std::size_t>(a_thread_index) % handles.size() ];
+    }
+
+    handle_registry const &registry( int a_thread_index ) const
+    {
+        return registries[ static_cast<std::size_t>(a_thread_index) % registries.size() ];
+    }
+};
+
+contention_fixture fixture;
+
+//..............................................................................
+
+/// @brief The operation run at the iteration @c a_iteration of the mixed workload :
+/// 50% copies, 30% casts, 10% destructions, 10% registry lookups.
+constexpr contention_op mixed_op( std::size_t a_iteration ) noexcept
+{
+    switch ( a_iteration % 10 )
+    {
+    case 0: case 1: case 2: case 3: case 4: return contention_op::copy;
+    case 5: case 6: case 7: return contention_op::cast;
+    case 8: return contention_op::destroy;
+    default: return contention_op::lookup;
+    }
+}
+
+template < handle_sharing Sharing >
+void Contention(benchmark::State &state, contention_op a_op)
+{
+    if ( state.thread_index() == 0 )
+    {
+        fixture.setup(Sharing, state.threads());
+    }
+
+    auto sampler = latency_sampler<>{};
+    auto perf = perf_event_counters{};
+    auto kept_copies = std::vector<solo::any_handle>(destroy_window);
+    auto iteration = std::size_t{0};
+
+    auto const run_op = [&](contention_op op) {
+        auto const &h = fixture.handle(state.thread_index());
+        switch ( op )
+        {
+        case contention_op::copy:
+        {
+            auto h_copy = h;
+            benchmark::DoNotOptimize(h_copy);
+            break;
+        }
+        case contention_op::cast:
+        {
+            auto r = solo::any_handle_cast<BenchObject>(h);
+            benchmark::DoNotOptimize(r);
+            break;
+        }
+        case contention_op::destroy:
+        {
+            // release the copy taken destroy_window iterations ago, keep a new one :
+            kept_copies[iteration % destroy_window] = h;
+            break;
+        }
+        case contention_op::lookup:
+        {
+            auto const &registry = fixture.registry(state.thread_index());
+            auto r = solo::any_handle_cast<BenchObject>(registry.find(typeid(BenchObject))->second);
+            benchmark::DoNotOptimize(r);
+            break;
+        }
+        case contention_op::mixed:
+            break;
+        }
+    };
+
+    perf.start();
+    for ( auto _ : state )
+    {
+        auto const op = ( a_op == contention_op::mixed ) ? mixed_op(iteration) : a_op;
+        sampler.run(iteration, [&]() { run_op(op); });
+        ++iteration;
+    }
+    auto const values = perf.stop();
+
+    report_contention_counters(state, sampler, perf, values);
+
+    if ( state.thread_index() == 0 )
+    {
+        fixture.teardown();
+    }
+}
+
+/// @brief Register every operation in both sharing modes, on 1..N threads.
+bool register_contention_benchmarks()
+{
+    struct named_op { char const *name; contention_op op; };
+    auto const ops = { named_op{ "Copy", contention_op::copy }, named_op{ "Cast", contention_op::cast },
+                       named_op{ "Destroy", contention_op::destroy }, named_op{ "Lookup", contention_op::lookup },
+                       named_op{ "Mixed", contention_op::mixed } };
+    for ( auto const &op : ops )
+    {
+        benchmark::RegisterBenchmark( ( std::string{"AnyHandle_Contention_Shared_"} + op.name ).c_str(), Contention<handle_sharing::shared>, op.op )
+            ->ThreadRange(1, max_benchmark_thread_count())->UseRealTime();
+        benchmark::RegisterBenchmark( ( std::string{"AnyHandle_Contention_Disjoint_"} + op.name ).c_str(), Contention<handle_sharing::disjoint>, op.op )
+            ->ThreadRange(1, max_benchmark_thread_count())->UseRealTime();
+    }
+    return true;
+}
+
+bool const contention_benchmarks_registered = register_contention_benchmarks();
+
+}// EONS ANONYMOUS
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::BENCHMARKS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "any_handle_benchmark_types.hpp"
+
+#include <solo/anys/handles/cow/cow_package.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace benchmarks {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// -- a consumer receiving a shared configuration (a vector of 4096 integers) and modifying it rarely :
+// the copy-on-write handle copies it on the first modification only, the plain handle "just in case", up front.
+
+using BenchConfig = std::vector<int>;
+
+constexpr auto const config_size = 4096;
+
+//..............................................................................
+
+// -- mutable cast of a handle owning its object : in place for both.
+
+void MutableCast_Owned(benchmark::State &state)
+{
+    auto const h = solo::make_any_handle_mutable<BenchConfig>(stdex::in_place, config_size, 1);
+    for ( auto _ : state )
+    {
+        auto r = solo::any_handle_mutable_cast<BenchConfig>(h);
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+void CowMutableCast_Owned(benchmark::State &state)
+{
+    auto h = solo::anys::cow::make_any_handle_cow<BenchConfig>(stdex::in_place, config_size, 1);
+    for ( auto _ : state )
+    {
+        auto r = solo::anys::cow::any_handle_cow_mutable_cast<BenchConfig>(h);
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+// -- receive : take a copy of the shared configuration, never modified.
+
+void DeepCopy_Receive(benchmark::State &state)
+{
+    auto const shared = solo::make_any_handle<BenchConfig>(stdex::in_place, config_size, 1);
+    for ( auto _ : state )
+    {
+        auto const &config = *solo::any_handle_cast<BenchConfig>(shared).assume_value();
+        auto mine = solo::make_any_handle_mutable<BenchConfig>(stdex::in_place, config);// just in case
+        benchmark::DoNotOptimize(mine);
+    }
+}
+
+void Cow_Receive(benchmark::State &state)
+{
+    auto const shared = solo::anys::cow::make_any_handle_cow<BenchConfig>(stdex::in_place, config_size, 1);
+    for ( auto _ : state )
+    {
+        auto mine = shared;
+        benchmark::DoNotOptimize(mine);
+    }
+}
+
+// -- receive and modify : the copy-on-write handle copies on the first modification.
+
+void Cow_ReceiveAndModify(benchmark::State &state)
+{
+    auto const shared = solo::anys::cow::make_any_handle_cow<BenchConfig>(stdex::in_place, config_size, 1);
+    for ( auto _ : state )
+    {
+        auto mine = shared;
+        solo::anys::cow::any_handle_cow_mutable_cast<BenchConfig>(mine).assume_value()->front() = 2;
+        benchmark::DoNotOptimize(mine);
+    }
+}
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BENCHMARK(MutableCast_Owned);
+BENCHMARK(CowMutableCast_Owned);
+
+BENCHMARK(DeepCopy_Receive);
+BENCHMARK(Cow_Receive);
+BENCHMARK(Cow_ReceiveAndModify);
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::BENCHMARKS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,80 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "any_handle_benchmark_types.hpp"
+
+#include <solo/anys/handles/allocators/cache_line_allocator.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace benchmarks {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// @brief The maximal number of threads (i.e. of hot handles).
+constexpr auto const max_thread_count = 64;
+
+inline solo::any_handle make_bench_cache_line_any_handle(int a_ = 0)
+{
+    using solo::anys::allocators::cache_line_allocator;
+    return solo::make_any_handle_mutable<BenchObject>(std::allocator_arg, cache_line_allocator<BenchObject>{}, a_);
+}
+
+/// @brief One hot handle per thread, all created back to back by the first thread.
+std::vector<solo::any_handle> hot_handles;
+
+//..............................................................................
+
+// -- false sharing : each thread copies then destroys its own handle.
+// No handle is shared between threads : any slowdown when adding threads comes from
+// control blocks (reference counts) sharing a cache line with the control block of another thread.
+
+template < solo::any_handle (*MakeHandle)(int) >
+void FalseSharing(benchmark::State &state)
+{
+    if ( state.thread_index() == 0 )
+    {
+        hot_handles.clear();
+        for ( auto i = 0; i < state.threads(); ++i )
+        {
+            hot_handles.push_back(MakeHandle(i));
+        }
+    }
+
+    // the first iteration starts once every thread is ready (and once the handles are built) :
+    for ( auto _ : state )
+    {
+        auto const &h = hot_handles[state.thread_index()];
+        auto h_copy = h;
+        benchmark::DoNotOptimize(h_copy);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if ( state.thread_index() == 0 )
+    {
+        hot_handles.clear();
+    }
+}
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BENCHMARK_TEMPLATE(FalseSharing, make_bench_any_handle)->Name("AnyHandle_FalseSharing_Default")
+    ->ThreadRange(1, max_thread_count)->UseRealTime();
+BENCHMARK_TEMPLATE(FalseSharing, make_bench_cache_line_any_handle)->Name("AnyHandle_FalseSharing_CacheLine")
+    ->ThreadRange(1, max_thread_count)->UseRealTime();
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::BENCHMARKS
+////////////////////////////////////////////////////////////////////////////////
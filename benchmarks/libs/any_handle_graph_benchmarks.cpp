@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "any_handle_benchmark_types.hpp"
+
+#include <solo/anys/handles/graphs/graph_package.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace benchmarks {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// -- the start-up of layered resource graphs : 8 layers of 16 resources, each depending on two resources of the
+// previous layer and costing about 20 microseconds of computation. The critical path is 8 resources long :
+// the build time should fall with the number of threads, down to the critical path (and the number of cores).
+
+constexpr auto const layer_count = 8;
+constexpr auto const layer_width = 16;
+
+/// @brief Spin for about the given duration (a resource construction).
+inline std::uint64_t busy_work( std::chrono::microseconds a_duration )
+{
+    auto const end = std::chrono::steady_clock::now() + a_duration;
+    auto x = std::uint64_t{ 1 };
+    while ( std::chrono::steady_clock::now() < end )
+    {
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+    }
+    return x;
+}
+
+inline std::string resource_key( int a_layer, int a_index )
+{
+    return "r" + std::to_string(a_layer) + "_" + std::to_string(a_index);
+}
+
+solo::anys::graphs::resource_graph make_layered_graph()
+{
+    using solo::anys::graphs::depends_on;
+    auto graph = solo::anys::graphs::resource_graph{};
+    auto const work = std::chrono::microseconds{ 20 };
+    for ( auto i = 0; i < layer_width; ++i )
+    {
+        graph.add<std::uint64_t>(resource_key(0, i), [work] { return std::make_shared<std::uint64_t const>(busy_work(work)); });
+    }
+    for ( auto l = 1; l < layer_count; ++l )
+    {
+        for ( auto i = 0; i < layer_width; ++i )
+        {
+            graph.add<std::uint64_t>(resource_key(l, i),
+                                     depends_on<std::uint64_t, std::uint64_t>(resource_key(l - 1, i), resource_key(l - 1, ( i + 1 ) % layer_width)),
+                                     [work]( std::shared_ptr<std::uint64_t const> a, std::shared_ptr<std::uint64_t const> b )
+                                     {
+                                         return std::make_shared<std::uint64_t const>(*a ^ *b ^ busy_work(work));
+                                     });
+        }
+    }
+    return graph;
+}
+
+//..............................................................................
+
+// -- build : build the graph into a new registry, on state.range(0) threads.
+
+void ResourceGraph_Build(benchmark::State &state)
+{
+    auto const graph = make_layered_graph();
+    auto const threads = static_cast<std::size_t>(state.range(0));
+    auto critical_path_us = 0.0;
+    for ( auto _ : state )
+    {
+        solo::anys::registries::any_handle_registry registry{};
+        auto const report = graph.build(registry, threads);
+        critical_path_us = std::chrono::duration<double, std::micro>(report.critical_path_duration).count();
+        benchmark::DoNotOptimize(registry.size());
+    }
+    state.counters["critical_path_us"] = critical_path_us;
+    state.SetItemsProcessed(layer_count * layer_width * state.iterations());
+}
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BENCHMARK(ResourceGraph_Build)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::BENCHMARKS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "any_handle_benchmark_types.hpp"
+
+#include <solo/anys/handles/interning/interning_package.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace benchmarks {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// -- a workload holding many handles on few distinct values (64 tags among 4096 handles) : the interned handles
+// share one object per value, and compare by pointer where the plain handles compare their contents.
+
+constexpr auto const value_count = 64;
+constexpr auto const handle_count = 4096;
+
+inline std::string tag_of( int a_index )
+{
+    return "a rather long tag, not fitting a small string #" + std::to_string(a_index % value_count);
+}
+
+//..............................................................................
+
+// -- make : a handle on a value already held elsewhere.
+
+void Plain_Make(benchmark::State &state)
+{
+    auto const tag = tag_of(7);
+    for ( auto _ : state )
+    {
+        auto h = solo::make_any_handle<std::string>(stdex::in_place, tag);
+        benchmark::DoNotOptimize(h);
+    }
+}
+
+void Interned_Make(benchmark::State &state)
+{
+    solo::anys::interning::intern_table table{};
+    auto const tag = tag_of(7);
+    auto const held = solo::anys::interning::make_interned_any_handle<std::string>(table, stdex::in_place, tag);
+    for ( auto _ : state )
+    {
+        auto h = solo::anys::interning::make_interned_any_handle<std::string>(table, stdex::in_place, tag);
+        benchmark::DoNotOptimize(h);
+    }
+}
+
+// -- equality : count the handles equal in contents to the first one.
+
+void Plain_Equality(benchmark::State &state)
+{
+    auto handles = std::vector<solo::any_handle>{};
+    for ( auto n = 0; n < handle_count; ++n )
+    {
+        handles.push_back(solo::make_any_handle<std::string>(stdex::in_place, tag_of(n)));
+    }
+    for ( auto _ : state )
+    {
+        auto const &first = *solo::any_handle_cast<std::string>(handles.front()).assume_value();
+        auto count = 0;
+        for ( auto const &h : handles )
+        {
+            count += *solo::any_handle_cast<std::string>(h).assume_value() == first;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(handle_count * state.iterations());
+}
+
+void Interned_Equality(benchmark::State &state)
+{
+    solo::anys::interning::intern_table table{};
+    auto handles = std::vector<solo::any_handle>{};
+    for ( auto n = 0; n < handle_count; ++n )
+    {
+        handles.push_back(solo::anys::interning::make_interned_any_handle<std::string>(table, stdex::in_place, tag_of(n)));
+    }
+    for ( auto _ : state )
+    {
+        auto count = 0;
+        for ( auto const &h : handles )
+        {
+            count += h == handles.front();
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(handle_count * state.iterations());
+}
+
+// -- footprint : the number of distinct objects held for the 4096 handles.
+
+void Interned_Footprint(benchmark::State &state)
+{
+    for ( auto _ : state )
+    {
+        solo::anys::interning::intern_table table{};
+        auto handles = std::vector<solo::any_handle>{};
+        for ( auto n = 0; n < handle_count; ++n )
+        {
+            handles.push_back(solo::anys::interning::make_interned_any_handle<std::string>(table, stdex::in_place, tag_of(n)));
+        }
+        state.counters["objects"] = static_cast<double>(table.size());
+        benchmark::DoNotOptimize(handles.data());
+    }
+}
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BENCHMARK(Plain_Make);
+BENCHMARK(Interned_Make);
+
+BENCHMARK(Plain_Equality);
+BENCHMARK(Interned_Equality);
+
+BENCHMARK(Interned_Footprint)->Unit(benchmark::kMicrosecond);
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::BENCHMARKS
+////////////////////////////////////////////////////////////////////////////////
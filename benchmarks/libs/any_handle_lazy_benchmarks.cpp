@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "any_handle_benchmark_types.hpp"
+
+#include <solo/anys/handles/lazy/lazy_package.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace benchmarks {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// -- the handles built but never cast pay the allocation only (the object, here a vector of state.range(0) integers, is never built) ;
+// the built lazy handles pay one acquire load more than the eager ones on each access.
+
+inline solo::any_handle make_bench_lazy_handle(int a_ = 0)
+{
+    return solo::anys::lazy::make_any_handle_mutable_lazy<BenchObject>(stdex::in_place, a_);
+}
+
+//..............................................................................
+
+// -- make : build a handle, never cast.
+
+void Eager_Make(benchmark::State &state)
+{
+    auto const n = static_cast<std::size_t>(state.range(0));
+    for ( auto _ : state )
+    {
+        auto h = solo::make_any_handle<std::vector<int>>(stdex::in_place, n, 1);
+        benchmark::DoNotOptimize(h);
+    }
+}
+
+void Lazy_Make(benchmark::State &state)
+{
+    auto const n = static_cast<std::size_t>(state.range(0));
+    for ( auto _ : state )
+    {
+        auto h = solo::anys::lazy::make_any_handle_lazy<std::vector<int>>(stdex::in_place, n, 1);
+        benchmark::DoNotOptimize(h);
+    }
+}
+
+// -- make and cast : build a handle, then cast it once (the lazy handle builds its object).
+
+void Eager_MakeAndCast(benchmark::State &state)
+{
+    auto const n = static_cast<std::size_t>(state.range(0));
+    for ( auto _ : state )
+    {
+        auto h = solo::make_any_handle<std::vector<int>>(stdex::in_place, n, 1);
+        auto r = solo::any_handle_cast<std::vector<int>>(h);
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+void Lazy_MakeAndCast(benchmark::State &state)
+{
+    auto const n = static_cast<std::size_t>(state.range(0));
+    for ( auto _ : state )
+    {
+        auto h = solo::anys::lazy::make_any_handle_lazy<std::vector<int>>(stdex::in_place, n, 1);
+        auto r = solo::any_handle_cast<std::vector<int>>(h);
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+//..............................................................................
+
+// -- cast hit : cast a built handle.
+
+template < solo::any_handle (*MakeHandle)(int) >
+void CastHit(benchmark::State &state)
+{
+    auto const h = MakeHandle(1);
+    benchmark::DoNotOptimize(h.get());// built
+    for ( auto _ : state )
+    {
+        auto r = solo::any_handle_cast<BenchObject>(h);
+        benchmark::DoNotOptimize(r);
+    }
+}
+
+// -- get : read the raw pointer of a built handle.
+
+template < solo::any_handle (*MakeHandle)(int) >
+void Get(benchmark::State &state)
+{
+    auto const h = MakeHandle(1);
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(h.get());
+    }
+}
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BENCHMARK(Eager_Make)->Arg(16)->Arg(4096);
+BENCHMARK(Lazy_Make)->Arg(16)->Arg(4096);
+
+BENCHMARK(Eager_MakeAndCast)->Arg(16)->Arg(4096);
+BENCHMARK(Lazy_MakeAndCast)->Arg(16)->Arg(4096);
+
+BENCHMARK_TEMPLATE(CastHit, make_bench_any_handle)->Name("Eager_CastHit");
+BENCHMARK_TEMPLATE(CastHit, make_bench_lazy_handle)->Name("Lazy_CastHit");
+
+BENCHMARK_TEMPLATE(Get, make_bench_any_handle)->Name("Eager_Get");
+BENCHMARK_TEMPLATE(Get, make_bench_lazy_handle)->Name("Lazy_Get");
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::BENCHMARKS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,123 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "any_handle_benchmark_types.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace benchmarks {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// @brief The number of handles destroyed per timed batch.
+constexpr auto const destroy_batch_size = 1024;
+
+//..............................................................................
+
+// -- make : build a new object and its handle.
+
+template < typename Handle, Handle (*MakeHandle)(int) >
+void Make(benchmark::State &state)
+{
+    for ( auto _ : state )
+    {
+        auto h = MakeHandle(1);
+        benchmark::DoNotOptimize(h);
+    }
+}
+
+//..............................................................................
+
+// -- copy : copy an existing handle (one reference count increment, then one decrement).
+
+template < typename Handle, Handle (*MakeHandle)(int) >
+void Copy(benchmark::State &state)
+{
+    auto const h = MakeHandle(1);
+    for ( auto _ : state )
+    {
+        auto h_copy = h;
+        benchmark::DoNotOptimize(h_copy);
+    }
+}
+
+//..............................................................................
+
+// -- move : move a handle back and forth (no reference count traffic expected).
+
+template < typename Handle, Handle (*MakeHandle)(int) >
+void Move(benchmark::State &state)
+{
+    auto h1 = MakeHandle(1);
+    auto h2 = Handle{};
+    for ( auto _ : state )
+    {
+        h2 = std::move(h1);
+        benchmark::DoNotOptimize(h2);
+        h1 = std::move(h2);
+        benchmark::DoNotOptimize(h1);
+    }
+    state.SetItemsProcessed(2 * state.iterations());
+}
+
+//..............................................................................
+
+// -- destroy : release the last handle to an object (destroy the object and free its memory).
+
+template < typename Handle, Handle (*MakeHandle)(int) >
+void Destroy(benchmark::State &state)
+{
+    auto handles = std::vector<Handle>{};
+    handles.reserve(destroy_batch_size);
+    for ( auto _ : state )
+    {
+        state.PauseTiming();
+        for ( auto i = 0; i < destroy_batch_size; ++i )
+        {
+            handles.push_back(MakeHandle(i));
+        }
+        state.ResumeTiming();
+        handles.clear();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(destroy_batch_size * state.iterations());
+}
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BENCHMARK_TEMPLATE(Make, solo::any_handle, make_bench_any_handle)->Name("AnyHandle_Make");
+BENCHMARK_TEMPLATE(Make, raw_handle_type, make_bench_raw_handle)->Name("RawSharedPtr_Make");
+BENCHMARK_TEMPLATE(Make, std::any, make_bench_std_any)->Name("StdAny_Make");
+BENCHMARK_TEMPLATE(Make, boost::any, make_bench_boost_any)->Name("BoostAny_Make");
+
+BENCHMARK_TEMPLATE(Copy, solo::any_handle, make_bench_any_handle)->Name("AnyHandle_Copy");
+BENCHMARK_TEMPLATE(Copy, raw_handle_type, make_bench_raw_handle)->Name("RawSharedPtr_Copy");
+BENCHMARK_TEMPLATE(Copy, std::any, make_bench_std_any)->Name("StdAny_Copy");
+BENCHMARK_TEMPLATE(Copy, boost::any, make_bench_boost_any)->Name("BoostAny_Copy");
+
+BENCHMARK_TEMPLATE(Move, solo::any_handle, make_bench_any_handle)->Name("AnyHandle_Move");
+BENCHMARK_TEMPLATE(Move, raw_handle_type, make_bench_raw_handle)->Name("RawSharedPtr_Move");
+BENCHMARK_TEMPLATE(Move, std::any, make_bench_std_any)->Name("StdAny_Move");
+BENCHMARK_TEMPLATE(Move, boost::any, make_bench_boost_any)->Name("BoostAny_Move");
+
+BENCHMARK_TEMPLATE(Destroy, solo::any_handle, make_bench_any_handle)->Name("AnyHandle_Destroy");
+BENCHMARK_TEMPLATE(Destroy, raw_handle_type, make_bench_raw_handle)->Name("RawSharedPtr_Destroy");
+BENCHMARK_TEMPLATE(Destroy, std::any, make_bench_std_any)->Name("StdAny_Destroy");
+BENCHMARK_TEMPLATE(Destroy, boost::any, make_bench_boost_any)->Name("BoostAny_Destroy");
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::BENCHMARKS
+////////////////////////////////////////////////////////////////////////////////
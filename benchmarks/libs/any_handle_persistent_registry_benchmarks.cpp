@@ -0,0 +1,168 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "any_handle_benchmark_types.hpp"
+
+#include <solo/anys/handles/registries/registry_package.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace benchmarks {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// -- a consistent snapshot of a registry of N handles : one reference count for the persistent registry,
+// a copy of the whole table under the lock for a locked hash table. The registries are built once per size.
+
+using solo::anys::registries::persistent_handle_map;
+using solo::anys::registries::persistent_registry;
+
+struct LockedTable
+{
+    std::mutex mutex;
+    std::unordered_map<std::string, solo::any_handle> table;
+};
+
+inline std::string key_of( std::size_t a_index )
+{
+    return "resource" + std::to_string(a_index);
+}
+
+persistent_registry &persistent_of_size( std::size_t a_size )
+{
+    static auto registries = std::map<std::size_t, persistent_registry>{};
+    auto const found = registries.find(a_size);
+    if ( found != registries.end() )
+    {
+        return found->second;
+    }
+    auto &registry = registries[a_size];
+    registry.update([a_size]( persistent_handle_map a_map ) {
+        for ( auto n = std::size_t{0}; n < a_size; ++n )
+        {
+            a_map = a_map.with(key_of(n), solo::make_any_handle<int>(stdex::in_place, static_cast<int>(n)));
+        }
+        return a_map;
+    });
+    return registry;
+}
+
+LockedTable &locked_of_size( std::size_t a_size )
+{
+    static auto tables = std::map<std::size_t, LockedTable>{};
+    auto const found = tables.find(a_size);
+    if ( found != tables.end() )
+    {
+        return found->second;
+    }
+    auto &locked = tables[a_size];
+    for ( auto n = std::size_t{0}; n < a_size; ++n )
+    {
+        locked.table.emplace(key_of(n), solo::make_any_handle<int>(stdex::in_place, static_cast<int>(n)));
+    }
+    return locked;
+}
+
+//..............................................................................
+
+void Persistent_Snapshot(benchmark::State &state)
+{
+    auto &registry = persistent_of_size(static_cast<std::size_t>(state.range(0)));
+    for ( auto _ : state )
+    {
+        auto snapshot = registry.snapshot();
+        benchmark::DoNotOptimize(snapshot);
+    }
+}
+
+void Locked_Snapshot(benchmark::State &state)
+{
+    auto &locked = locked_of_size(static_cast<std::size_t>(state.range(0)));
+    for ( auto _ : state )
+    {
+        std::unique_lock<std::mutex> lock{ locked.mutex };
+        auto snapshot = locked.table;
+        lock.unlock();
+        benchmark::DoNotOptimize(snapshot);
+    }
+}
+
+// -- the price of the persistence : the updates copy a path of nodes, the lookups follow it.
+
+void Persistent_Publish(benchmark::State &state)
+{
+    auto &registry = persistent_of_size(static_cast<std::size_t>(state.range(0)));
+    auto const handle = solo::make_any_handle<int>(stdex::in_place, 0);
+    auto n = std::size_t{0};
+    for ( auto _ : state )
+    {
+        registry.publish(key_of(n++ % 1000), handle);
+    }
+}
+
+void Locked_Publish(benchmark::State &state)
+{
+    auto &locked = locked_of_size(static_cast<std::size_t>(state.range(0)));
+    auto const handle = solo::make_any_handle<int>(stdex::in_place, 0);
+    auto n = std::size_t{0};
+    for ( auto _ : state )
+    {
+        auto key = key_of(n++ % 1000);
+        std::lock_guard<std::mutex> lock{ locked.mutex };
+        locked.table[std::move(key)] = handle;
+    }
+}
+
+void Persistent_Find(benchmark::State &state)
+{
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto &registry = persistent_of_size(size);
+    auto const key = key_of(size / 2);
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize(registry.find(key));
+    }
+}
+
+void Locked_Find(benchmark::State &state)
+{
+    auto const size = static_cast<std::size_t>(state.range(0));
+    auto &locked = locked_of_size(size);
+    auto const key = key_of(size / 2);
+    for ( auto _ : state )
+    {
+        std::lock_guard<std::mutex> lock{ locked.mutex };
+        benchmark::DoNotOptimize(locked.table.find(key)->second);
+    }
+}
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BENCHMARK(Persistent_Snapshot)->Arg(1000)->Arg(1000000);
+BENCHMARK(Locked_Snapshot)->Arg(1000)->Arg(1000000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(Persistent_Publish)->Arg(1000)->Arg(1000000);
+BENCHMARK(Locked_Publish)->Arg(1000)->Arg(1000000);
+
+BENCHMARK(Persistent_Find)->Arg(1000)->Arg(1000000);
+BENCHMARK(Locked_Find)->Arg(1000)->Arg(1000000);
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::BENCHMARKS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,81 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "any_handle_benchmark_types.hpp"
+
+#include <solo/anys/handles/pools/pool_package.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace benchmarks {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// -- churn : batches of state.range(0) short-lived 64-byte messages created then released (in creation order),
+// by one or more threads, through glibc malloc (make_any_handle_mutable) or the slabs (make_pooled_any_handle_mutable).
+
+struct ChurnMessage
+{
+    explicit ChurnMessage( int a_id ) : id{ a_id } {}
+
+    int id;
+    char payload[60]{};
+};
+
+template < typename Make >
+void churn( benchmark::State &state, Make &&a_make )
+{
+    auto const batch = static_cast<std::size_t>(state.range(0));
+    auto handles = std::vector<solo::any_handle>{};
+    handles.reserve(batch);
+    for ( auto _ : state )
+    {
+        for ( auto n = std::size_t{0}; n < batch; ++n )
+        {
+            handles.push_back(a_make(static_cast<int>(n)));
+        }
+        benchmark::DoNotOptimize(handles.data());
+        handles.clear();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(batch) * state.iterations());
+}
+
+//..............................................................................
+
+void Malloc_Churn(benchmark::State &state)
+{
+    churn(state, []( int a_id ) { return solo::make_any_handle_mutable<ChurnMessage>(stdex::in_place, a_id); });
+}
+
+void Pooled_Churn(benchmark::State &state)
+{
+    churn(state, []( int a_id ) { return solo::anys::pools::make_pooled_any_handle_mutable<ChurnMessage>(stdex::in_place, a_id); });
+    if ( state.thread_index() == 0 )
+    {
+        auto const stats = solo::anys::pools::pooled_statistics<ChurnMessage>();
+        state.counters["slabs"] = static_cast<double>(stats.slab_count);
+        state.counters["reserved_kib"] = static_cast<double>(stats.reserved_bytes()) / 1024.0;
+    }
+}
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BENCHMARK(Malloc_Churn)->Arg(1)->Arg(256)->Arg(16384)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK(Pooled_Churn)->Arg(1)->Arg(256)->Arg(16384)->ThreadRange(1, 4)->UseRealTime();
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::BENCHMARKS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,153 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "any_handle_benchmark_types.hpp"
+
+#include <solo/anys/handles/queues/queue_package.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace benchmarks {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// -- handles moved between N producers and N consumers (N = 1, 4, 16, 64) :
+// a mutex-protected std::deque (the baseline), versus any_handle_mpmc_queue one handle
+// or a batch of handles at a time, and any_handle_spsc_queue for N = 1.
+// The even benchmark threads produce, the odd ones consume; items are handles transferred per thread.
+
+constexpr std::size_t bench_queue_capacity = 1024;
+constexpr std::size_t bench_queue_batch_size = 16;
+
+/// @brief The baseline : a mutex and a std::deque.
+class mutex_queue
+{
+public:
+
+    bool try_push( solo::any_handle &&a_handle )
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        m_handles.push_back(std::move(a_handle));
+        return true;
+    }
+
+    bool try_pop( solo::any_handle &a_handle )
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        if ( m_handles.empty() )
+        {
+            return false;
+        }
+        a_handle = std::move(m_handles.front());
+        m_handles.pop_front();
+        return true;
+    }
+
+private:
+
+    std::mutex m_mutex;
+    std::deque<solo::any_handle> m_handles;
+};
+
+template < typename Queue >
+Queue &bench_queue()
+{
+    static Queue queue{ bench_queue_capacity };
+    return queue;
+}
+
+template <>
+mutex_queue &bench_queue<mutex_queue>()
+{
+    static mutex_queue queue{};
+    return queue;
+}
+
+template < typename Queue >
+void Queue_Transfer(benchmark::State &state)
+{
+    auto &queue = bench_queue<Queue>();
+    auto const producer = state.thread_index() % 2 == 0;
+    auto const message = make_bench_any_handle(1);
+    auto h = solo::any_handle{};
+    for ( auto _ : state )
+    {
+        if ( producer )
+        {
+            h = message;// the copy is the producer's work, not the transfer
+            while ( !queue.try_push(std::move(h)) ) { std::this_thread::yield(); }
+        }
+        else
+        {
+            while ( !queue.try_pop(h) ) { std::this_thread::yield(); }
+            benchmark::DoNotOptimize(h.get());
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["producers"] = benchmark::Counter(state.threads() / 2, benchmark::Counter::kAvgThreads);
+}
+
+template < typename Queue >
+void Queue_TransferBatch(benchmark::State &state)
+{
+    auto &queue = bench_queue<Queue>();
+    auto const producer = state.thread_index() % 2 == 0;
+    auto const message = make_bench_any_handle(1);
+    auto batch = std::vector<solo::any_handle>(bench_queue_batch_size);
+    for ( auto _ : state )
+    {
+        auto done = std::size_t{0};
+        if ( producer )
+        {
+            std::fill(batch.begin(), batch.end(), message);
+            while ( done != batch.size() )
+            {
+                auto const n = queue.try_push_n(batch.data() + done, batch.size() - done);
+                done += n;
+                if ( n == 0 ) { std::this_thread::yield(); }
+            }
+        }
+        else
+        {
+            while ( done != batch.size() )
+            {
+                auto const n = queue.try_pop_n(batch.data() + done, batch.size() - done);
+                done += n;
+                if ( n == 0 ) { std::this_thread::yield(); }
+            }
+            benchmark::DoNotOptimize(batch.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(bench_queue_batch_size));
+    state.counters["producers"] = benchmark::Counter(state.threads() / 2, benchmark::Counter::kAvgThreads);
+}
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BENCHMARK_TEMPLATE(Queue_Transfer, mutex_queue)->Threads(2)->Threads(8)->Threads(32)->Threads(128)->UseRealTime();
+BENCHMARK_TEMPLATE(Queue_Transfer, solo::anys::queues::any_handle_mpmc_queue)->Threads(2)->Threads(8)->Threads(32)->Threads(128)->UseRealTime();
+BENCHMARK_TEMPLATE(Queue_TransferBatch, solo::anys::queues::any_handle_mpmc_queue)->Threads(2)->Threads(8)->Threads(32)->Threads(128)->UseRealTime();
+BENCHMARK_TEMPLATE(Queue_Transfer, solo::anys::queues::any_handle_spsc_queue)->Threads(2)->UseRealTime();
+BENCHMARK_TEMPLATE(Queue_TransferBatch, solo::anys::queues::any_handle_spsc_queue)->Threads(2)->UseRealTime();
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::BENCHMARKS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "any_handle_benchmark_types.hpp"
+
+#include <solo/anys/handles/reclaimers/reclaimer_package.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace benchmarks {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// -- latency of the requests of a thread releasing the last handle to its resources :
+// one request in 32 releases a resource whose destructor takes ~50 us, the others a small object.
+// The release runs inline (make_any_handle) or on the reclaimer thread (make_any_handle_deferred).
+// Reported : the latency percentiles, and the histogram of the latencies (ratio of the requests per bucket).
+
+constexpr int bench_large_period = 32;
+
+/// @brief A resource whose teardown takes about 50 us.
+struct BenchLargeResource
+{
+    ~BenchLargeResource()
+    {
+        auto const stop = std::chrono::steady_clock::now() + std::chrono::microseconds{ 50 };
+        while ( std::chrono::steady_clock::now() < stop )
+        {
+        }
+    }
+    int data{1};
+};
+
+/// @brief The latencies of the requests.
+class latency_histogram
+{
+public:
+
+    void add( std::int64_t a_latency_ns ) { m_samples.push_back(a_latency_ns); }
+
+    /// @brief Report the percentiles, and the ratio of the requests in each log10 bucket from 1 us.
+    void report( benchmark::State &state )
+    {
+        if ( m_samples.empty() )
+        {
+            return;
+        }
+        std::sort(m_samples.begin(), m_samples.end());
+        auto const percentile = [&]( double a_rank ) { return static_cast<double>( m_samples[ static_cast<std::size_t>(a_rank * static_cast<double>(m_samples.size() - 1)) ] ); };
+        state.counters["p50_ns"] = percentile(0.50);
+        state.counters["p99_ns"] = percentile(0.99);
+        state.counters["p999_ns"] = percentile(0.999);
+
+        auto const ratio_below = [&]( std::int64_t a_bound ) { return static_cast<double>( std::lower_bound(m_samples.begin(), m_samples.end(), a_bound) - m_samples.begin() ) / static_cast<double>(m_samples.size()); };
+        state.counters["<1us"] = ratio_below(1000);
+        state.counters["1-10us"] = ratio_below(10000) - ratio_below(1000);
+        state.counters["10-100us"] = ratio_below(100000) - ratio_below(10000);
+        state.counters[">=100us"] = 1. - ratio_below(100000);
+    }
+
+private:
+
+    std::vector<std::int64_t> m_samples;
+};
+
+template < typename MakeLarge, typename MakeSmall >
+void run_release_requests( benchmark::State &state, MakeLarge &&a_make_large, MakeSmall &&a_make_small )
+{
+    auto histogram = latency_histogram{};
+    auto i = 0;
+    for ( auto _ : state )
+    {
+        auto h = i++ % bench_large_period == 0 ? a_make_large() : a_make_small();
+        auto const start = std::chrono::steady_clock::now();
+        h = solo::any_handle{};// the release only
+        histogram.add( std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() );
+    }
+    state.SetItemsProcessed(state.iterations());
+    histogram.report(state);
+}
+
+void Release_Inline(benchmark::State &state)
+{
+    run_release_requests( state,
+        [] { return solo::make_any_handle<BenchLargeResource>(stdex::in_place); },
+        [] { return solo::make_any_handle<BenchObject>(stdex::in_place, 1); } );
+}
+
+void Release_Deferred(benchmark::State &state)
+{
+    solo::anys::reclaimers::reclaimer reclaimer{};
+    run_release_requests( state,
+        [&] { return solo::anys::reclaimers::make_any_handle_deferred<BenchLargeResource>(reclaimer, stdex::in_place); },
+        [&] { return solo::anys::reclaimers::make_any_handle_deferred<BenchObject>(reclaimer, stdex::in_place, 1); } );
+    reclaimer.drain();
+}
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BENCHMARK(Release_Inline)->Iterations(1 << 15);
+BENCHMARK(Release_Deferred)->Iterations(1 << 15);
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::BENCHMARKS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,112 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "any_handle_benchmark_types.hpp"
+
+#include <solo/anys/handles/pools/pool_package.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace benchmarks {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// -- short-lived payloads expensive to build : a parser with a 64 KiB buffer and a table of 256 keywords,
+// built for each request (make_any_handle_mutable) or recycled between requests (cleared, keeping its capacity).
+
+struct BenchParser
+{
+    BenchParser()
+        : buffer( 64 * 1024 )
+    {
+        for ( auto n = 0; n < 256; ++n )
+        {
+            keywords.emplace("keyword" + std::to_string(n), n);
+        }
+    }
+
+    void clear() noexcept
+    {
+        length = 0;
+    }
+
+    std::vector<char> buffer;
+    std::unordered_map<std::string, int> keywords;
+    std::size_t length = 0;
+};
+
+/// @brief A request : parse a few bytes.
+inline std::size_t parse( BenchParser &a_parser )
+{
+    a_parser.buffer[a_parser.length++] = 'x';
+    return a_parser.keywords.count("keyword42") + a_parser.length;
+}
+
+//..............................................................................
+
+void Plain_Request(benchmark::State &state)
+{
+    for ( auto _ : state )
+    {
+        auto h = solo::make_any_handle_mutable<BenchParser>(stdex::in_place);
+        benchmark::DoNotOptimize(parse(*solo::any_handle_mutable_cast<BenchParser>(h).assume_value()));
+    }
+}
+
+void Recycled_Request(benchmark::State &state)
+{
+    solo::anys::pools::recycling_pool<BenchParser> pool{ 16, []( BenchParser &a_parser ) { a_parser.clear(); } };
+    for ( auto _ : state )
+    {
+        auto h = solo::anys::pools::make_recycled_any_handle_mutable(pool, stdex::in_place);
+        benchmark::DoNotOptimize(parse(*solo::any_handle_mutable_cast<BenchParser>(h).assume_value()));
+    }
+    state.counters["hit_rate"] = pool.statistics().hit_rate();
+}
+
+// -- the overhead of the pool on a payload cheap to build.
+
+void Plain_Int(benchmark::State &state)
+{
+    for ( auto _ : state )
+    {
+        auto h = solo::make_any_handle_mutable<int>(stdex::in_place, 1);
+        benchmark::DoNotOptimize(h);
+    }
+}
+
+void Recycled_Int(benchmark::State &state)
+{
+    solo::anys::pools::recycling_pool<int> pool{ 16 };
+    for ( auto _ : state )
+    {
+        auto h = solo::anys::pools::make_recycled_any_handle_mutable(pool, stdex::in_place, 1);
+        benchmark::DoNotOptimize(h);
+    }
+}
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BENCHMARK(Plain_Request);
+BENCHMARK(Recycled_Request);
+
+BENCHMARK(Plain_Int);
+BENCHMARK(Recycled_Int);
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::BENCHMARKS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "any_handle_benchmark_types.hpp"
+
+#include <solo/anys/handles/snapshots/snapshot_package.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace benchmarks {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// -- restart of a registry of immutable resources :
+// rebuilding it from scratch, versus restoring it from a snapshot file
+// (opening only, then looking up and restoring every key).
+
+using bench_registry = std::map<std::string, solo::any_handle>;
+
+std::string make_bench_key( long a_i )
+{
+    return "resources/" + std::to_string(a_i);
+}
+
+bench_registry make_bench_registry( long a_size )
+{
+    auto registry = bench_registry{};
+    for ( auto i = 0l; i < a_size; ++i )
+    {
+        registry.emplace( make_bench_key(i), solo::make_any_handle<BenchObject>(stdex::in_place, static_cast<int>(i)) );
+    }
+    return registry;
+}
+
+solo::anys::snapshots::snapshot_codec_registry make_bench_codecs()
+{
+    auto codecs = solo::anys::snapshots::snapshot_codec_registry{};
+    codecs.add( solo::anys::snapshots::make_snapshot_codec<BenchObject>() );
+    return codecs;
+}
+
+/// @brief The snapshot file of a registry of the given size, written once per benchmark.
+struct bench_snapshot_file
+{
+    explicit bench_snapshot_file( long a_size )
+        : path{ "solo_any_handle_snapshot_benchmarks_" + std::to_string(a_size) + ".snap" }
+    {
+        auto const registry = make_bench_registry(a_size);
+        solo::anys::snapshots::write_snapshot(path, registry.begin(), registry.end(), make_bench_codecs());
+    }
+    ~bench_snapshot_file() { std::remove(path.c_str()); }
+
+    std::string path;
+};
+
+void Registry_Rebuild(benchmark::State &state)
+{
+    for ( auto _ : state )
+    {
+        auto registry = make_bench_registry(state.range(0));
+        benchmark::DoNotOptimize(registry.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void Snapshot_Write(benchmark::State &state)
+{
+    auto const registry = make_bench_registry(state.range(0));
+    auto const codecs = make_bench_codecs();
+    auto const path = std::string{"solo_any_handle_snapshot_benchmarks_write.snap"};
+    for ( auto _ : state )
+    {
+        solo::anys::snapshots::write_snapshot(path, registry.begin(), registry.end(), codecs);
+    }
+    std::remove(path.c_str());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void Snapshot_Open(benchmark::State &state)
+{
+    auto const file = bench_snapshot_file{ state.range(0) };
+    auto const codecs = make_bench_codecs();
+    for ( auto _ : state )
+    {
+        solo::anys::snapshots::mapped_snapshot const snapshot{ file.path, codecs };
+        benchmark::DoNotOptimize(snapshot.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void Snapshot_OpenAndRestoreAll(benchmark::State &state)
+{
+    auto const file = bench_snapshot_file{ state.range(0) };
+    auto const codecs = make_bench_codecs();
+    auto keys = std::vector<std::string>{};
+    for ( auto i = 0l; i < state.range(0); ++i )
+    {
+        keys.push_back( make_bench_key(i) );
+    }
+    for ( auto _ : state )
+    {
+        solo::anys::snapshots::mapped_snapshot const snapshot{ file.path, codecs };
+        for ( auto const &key : keys )
+        {
+            benchmark::DoNotOptimize( snapshot.find(key) );
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BENCHMARK(Registry_Rebuild)->Arg(1 << 12)->Arg(1 << 16)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Snapshot_Write)->Arg(1 << 12)->Arg(1 << 16)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Snapshot_Open)->Arg(1 << 12)->Arg(1 << 16)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Snapshot_OpenAndRestoreAll)->Arg(1 << 12)->Arg(1 << 16)->Unit(benchmark::kMicrosecond);
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::BENCHMARKS
+////////////////////////////////////////////////////////////////////////////////
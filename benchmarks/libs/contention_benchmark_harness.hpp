@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include "perf_event_counters.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace benchmarks {
+////////////////////////////////////////////////////////////////////////////////
+
+// Helpers shared by the multi-threaded (scaling) benchmarks :
+// - the thread counts to run (1..N, N being the number of hardware threads),
+// - a per-thread latency sampler (p50 / p99),
+// - the report of throughput, latency and hardware counters as user counters.
+
+/// @brief The maximal number of benchmark threads : the number of hardware threads.
+inline int max_benchmark_thread_count() noexcept
+{
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+/// @brief Records the latency of one operation every @c SamplePeriod operations.
+///
+/// Each sample is timed with two @c steady_clock reads : the clock overhead is included
+/// in the latencies (it is the same for all the contenders).
+/// The last @c capacity samples are kept.
+template < std::size_t SamplePeriod = 16 >
+class latency_sampler
+{
+public:
+
+    using clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t capacity = 1u << 16;
+
+    latency_sampler()
+    {
+        m_samples.reserve(capacity);
+    }
+
+    /// @brief Run @c a_operation, timing it if the iteration @c a_iteration is sampled.
+    template < typename F >
+    void run( std::size_t a_iteration, F &&a_operation )
+    {
+        if ( a_iteration % SamplePeriod != 0 )
+        {
+            a_operation();
+            return;
+        }
+        auto const start = clock::now();
+        a_operation();
+        auto const stop = clock::now();
+        record( std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count() );
+    }
+
+    /// @brief The latency (ns) below which a ratio @c a_rank of the samples fall.
+    double percentile( double a_rank )
+    {
+        if ( m_samples.empty() )
+        {
+            return 0;
+        }
+        auto const nth = static_cast<std::size_t>( a_rank * static_cast<double>(m_samples.size() - 1) );
+        std::nth_element(m_samples.begin(), m_samples.begin() + nth, m_samples.end());
+        return static_cast<double>( m_samples[nth] );
+    }
+
+private:
+
+    void record( std::int64_t a_latency )
+    {
+        if ( m_samples.size() < capacity )
+        {
+            m_samples.push_back(a_latency);
+        }
+        else
+        {
+            m_samples[m_next++ % capacity] = a_latency;
+        }
+    }
+
+    std::vector<std::int64_t> m_samples;
+    std::size_t m_next{0};
+};
+
+/// @brief Report the throughput, the latency percentiles and the hardware counters (per operation) of one thread.
+///
+/// Latencies and counters are averaged over threads, the throughput is summed.
+template < std::size_t SamplePeriod >
+void report_contention_counters( benchmark::State &state, latency_sampler<SamplePeriod> &a_sampler, perf_event_counters const &a_perf, perf_event_values const &a_values )
+{
+    state.SetItemsProcessed(state.iterations());
+    state.counters["p50_ns"] = benchmark::Counter(a_sampler.percentile(0.50), benchmark::Counter::kAvgThreads);
+    state.counters["p99_ns"] = benchmark::Counter(a_sampler.percentile(0.99), benchmark::Counter::kAvgThreads);
+    if ( a_perf.available() && state.iterations() > 0 )
+    {
+        auto const iterations = static_cast<double>(state.iterations());
+        state.counters["cycles/op"] = benchmark::Counter(static_cast<double>(a_values.cycles) / iterations, benchmark::Counter::kAvgThreads);
+        state.counters["cache_misses/op"] = benchmark::Counter(static_cast<double>(a_values.cache_misses) / iterations, benchmark::Counter::kAvgThreads);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::BENCHMARKS
+////////////////////////////////////////////////////////////////////////////////
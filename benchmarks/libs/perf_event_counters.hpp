@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace benchmarks {
+////////////////////////////////////////////////////////////////////////////////
+
+/// @brief The hardware counters read by @c perf_event_counters.
+struct perf_event_values
+{
+    std::uint64_t cycles{0};
+    std::uint64_t cache_misses{0};
+};
+
+/// @brief CPU cycles and cache misses of the calling thread (user space only),
+/// read through Linux @c perf_event_open.
+///
+/// The counters are unavailable (@c available() is false) on other platforms,
+/// or when the kernel refuses to open them (e.g. @c perf_event_paranoid, containers, virtual machines) :
+/// the benchmarks then only report throughput and latency.
+class perf_event_counters
+{
+public:
+
+    perf_event_counters() noexcept;
+    ~perf_event_counters();
+
+    perf_event_counters( perf_event_counters const & ) = delete;
+    perf_event_counters &operator=( perf_event_counters const & ) = delete;
+
+    /// @brief True if both counters have been opened.
+    bool available() const noexcept { return m_cycles_fd >= 0 && m_cache_misses_fd >= 0; }
+
+    /// @brief Reset and start counting.
+    void start() noexcept;
+
+    /// @brief Stop counting and return the counts since @c start().
+    perf_event_values stop() noexcept;
+
+private:
+
+    int m_cycles_fd{-1};
+    int m_cache_misses_fd{-1};
+};
+
+//..............................................................................
+
+#if defined(__linux__)
+
+namespace detail {
+
+inline int open_perf_event( std::uint64_t a_config, int a_group_fd ) noexcept
+{
+    auto attr = perf_event_attr{};
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = a_config;
+    attr.disabled = ( a_group_fd == -1 ) ? 1 : 0;// the group leader drives the whole group
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // calling thread, any cpu :
+    return static_cast<int>( ::syscall(SYS_perf_event_open, &attr, 0, -1, a_group_fd, 0) );
+}
+
+inline std::uint64_t read_perf_event( int a_fd ) noexcept
+{
+    auto value = std::uint64_t{0};
+    return ::read(a_fd, &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value)) ? value : 0;
+}
+
+}// EONS DETAIL
+
+inline perf_event_counters::perf_event_counters() noexcept
+{
+    m_cycles_fd = detail::open_perf_event(PERF_COUNT_HW_CPU_CYCLES, -1);
+    if ( m_cycles_fd >= 0 )
+    {
+        m_cache_misses_fd = detail::open_perf_event(PERF_COUNT_HW_CACHE_MISSES, m_cycles_fd);
+    }
+}
+
+inline perf_event_counters::~perf_event_counters()
+{
+    if ( m_cache_misses_fd >= 0 ) { ::close(m_cache_misses_fd); }
+    if ( m_cycles_fd >= 0 ) { ::close(m_cycles_fd); }
+}
+
+inline void perf_event_counters::start() noexcept
+{
+    if ( available() )
+    {
+        ::ioctl(m_cycles_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ::ioctl(m_cycles_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+}
+
+inline perf_event_values perf_event_counters::stop() noexcept
+{
+    auto values = perf_event_values{};
+    if ( available() )
+    {
+        ::ioctl(m_cycles_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        values.cycles = detail::read_perf_event(m_cycles_fd);
+        values.cache_misses = detail::read_perf_event(m_cache_misses_fd);
+    }
+    return values;
+}
+
+#else// no perf_event_open
+
+inline perf_event_counters::perf_event_counters() noexcept = default;
+inline perf_event_counters::~perf_event_counters() = default;
+inline void perf_event_counters::start() noexcept {}
+inline perf_event_values perf_event_counters::stop() noexcept { return {}; }
+
+#endif// __linux__
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::BENCHMARKS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,45 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Same as BENCHMARK_MAIN(), except that the results are also written as JSON
+// into "solo_any_handle_benchmarks.json" unless --benchmark_out is given.
+int main(int argc, char **argv)
+{
+    auto args = std::vector<char*>{ argv, argv + argc };
+
+    auto has_output_file = false;
+    for ( auto i = 1; i < argc; ++i )
+    {
+        has_output_file = has_output_file || std::strncmp(argv[i], "--benchmark_out=", 16) == 0;
+    }
+
+    static char default_output_file[] = "--benchmark_out=solo_any_handle_benchmarks.json";
+    static char default_output_format[] = "--benchmark_out_format=json";
+    if ( not has_output_file )
+    {
+        args.push_back(default_output_file);
+        args.push_back(default_output_format);
+    }
+
+    auto args_count = static_cast<int>(args.size());
+    benchmark::Initialize(&args_count, args.data());
+    if ( benchmark::ReportUnrecognizedArguments(args_count, args.data()) )
+    {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,152 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+/// @def SOLO_ANY_HANDLE_CACHE_LINE_SIZE
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The granularity (in bytes) used to keep objects off each other's cache lines.
+/// @note Defaults to two 64-byte lines, since adjacent-line prefetchers make neighbouring lines
+/// behave as a single 128-byte line for false sharing purposes.
+#if !defined(SOLO_ANY_HANDLE_CACHE_LINE_SIZE)
+#define SOLO_ANY_HANDLE_CACHE_LINE_SIZE 128
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace allocators {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+constexpr std::size_t cache_line_size = SOLO_ANY_HANDLE_CACHE_LINE_SIZE;
+
+template < typename T, std::size_t LineSize = cache_line_size >
+class cache_line_allocator;
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief An allocator whose allocations start on a cache line boundary and are padded
+/// up to a whole number of cache lines.
+///
+/// No other allocation can share a cache line with an allocation made by this allocator.
+/// Used with @c std::allocate_shared (or with the allocator-aware @c make_any_handle factories),
+/// the control block and the object are kept off the cache lines of their neighbours,
+/// so that reference count updates on one handle never invalidate the lines of another.
+///
+/// Example:
+///
+/// @code
+///     // two hot counters, created back to back, updated from different cores :
+///     auto c1 = make_any_handle_mutable<Counter>( std::allocator_arg, cache_line_allocator<Counter>{} );
+///     auto c2 = make_any_handle_mutable<Counter>( std::allocator_arg, cache_line_allocator<Counter>{} );
+/// @endcode
+///
+/// @note The allocator is stateless : all instances compare equal.
+template < typename T, std::size_t LineSize >
+class cache_line_allocator
+{
+    static_assert( LineSize != 0 && ( LineSize & ( LineSize - 1 ) ) == 0, "LineSize should be a power of 2" );
+
+public:
+
+    using value_type = T;
+
+    template < typename U >
+    struct rebind
+    {
+        using other = cache_line_allocator<U, LineSize>;
+    };
+
+    constexpr cache_line_allocator() noexcept = default;
+
+    template < typename U >
+    constexpr cache_line_allocator( cache_line_allocator<U, LineSize> const & ) noexcept
+    {}
+
+    /// @brief Allocate @c n objects of type @c T on whole cache lines.
+    T *allocate( std::size_t n );
+
+    /// @brief Deallocate a storage returned by @c allocate.
+    void deallocate( T *p, std::size_t n ) noexcept;
+
+    /// @brief The number of bytes actually reserved for @c n objects of type @c T.
+    static constexpr std::size_t padded_size( std::size_t n ) noexcept
+    {
+        return ( n * sizeof(T) + LineSize - 1 ) / LineSize * LineSize;
+    }
+};
+
+template < typename T, typename U, std::size_t LineSize >
+constexpr bool operator==( cache_line_allocator<T, LineSize> const &, cache_line_allocator<U, LineSize> const & ) noexcept
+{
+    return true;
+}
+
+template < typename T, typename U, std::size_t LineSize >
+constexpr bool operator!=( cache_line_allocator<T, LineSize> const &, cache_line_allocator<U, LineSize> const & ) noexcept
+{
+    return false;
+}
+
+//..............................................................................
+//..............................................................................
+
+// INLINES :
+
+#if defined(__cpp_aligned_new)
+
+template < typename T, std::size_t LineSize >
+inline T *
+cache_line_allocator<T, LineSize>::allocate( std::size_t n )
+{
+    return static_cast<T*>( ::operator new( padded_size(n), std::align_val_t{ LineSize } ) );
+}
+
+template < typename T, std::size_t LineSize >
+inline void
+cache_line_allocator<T, LineSize>::deallocate( T *p, std::size_t ) noexcept
+{
+    ::operator delete( static_cast<void*>(p), std::align_val_t{ LineSize } );
+}
+
+#else// C++14 : over-allocate and store the original address just before the aligned storage
+
+template < typename T, std::size_t LineSize >
+inline T *
+cache_line_allocator<T, LineSize>::allocate( std::size_t n )
+{
+    static_assert( LineSize >= 2 * sizeof(void*), "LineSize is too small" );
+
+    // ::operator new returns storage aligned on at least 2 * sizeof(void*) :
+    // there is always room for the original address between it and the next line boundary.
+    void *raw = ::operator new( padded_size(n) + LineSize );
+    auto const aligned = ( reinterpret_cast<std::uintptr_t>(raw) + LineSize ) & ~std::uintptr_t{ LineSize - 1 };
+    reinterpret_cast<void**>(aligned)[-1] = raw;
+    return reinterpret_cast<T*>(aligned);
+}
+
+template < typename T, std::size_t LineSize >
+inline void
+cache_line_allocator<T, LineSize>::deallocate( T *p, std::size_t ) noexcept
+{
+    ::operator delete( reinterpret_cast<void**>(p)[-1] );
+}
+
+#endif// __cpp_aligned_new
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::ALLOCATORS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,509 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/pragmas/code_layout_hints.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace allocators {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+struct slab_statistics;
+
+template < typename T, typename Key = T >
+class slab_allocator;
+
+namespace detail {
+    struct slab_magazine;
+    class slab_pool;
+    class slab_magazine_guard;
+}// EONS DETAIL
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief A snapshot of the blocks of the slab pool of a type (see @c slab_allocator::statistics).
+/// @note The counters of the other threads are read without stopping them : a snapshot taken while they
+/// allocate or deallocate is approximate.
+struct slab_statistics
+{
+    std::size_t block_size = 0;// the size of a block in bytes (0 before the first allocation)
+    std::size_t slab_count = 0;
+    std::size_t reserved_blocks = 0;// the blocks of all the slabs
+    std::size_t blocks_in_use = 0;// the blocks allocated and not deallocated yet
+    std::size_t fallback_allocations = 0;// the allocations served by ::operator new (arrays, other sizes)
+
+    /// @brief The number of bytes reserved by the slabs.
+    std::size_t reserved_bytes() const noexcept
+    {
+        return reserved_blocks * block_size;
+    }
+
+    /// @brief The fraction of the reserved blocks which are not in use, between 0 and 1 (0 if nothing is reserved).
+    double fragmentation() const noexcept
+    {
+        return reserved_blocks == 0 ? 0.0 : 1.0 - static_cast<double>(std::min(blocks_in_use, reserved_blocks)) / static_cast<double>(reserved_blocks);
+    }
+};
+
+namespace detail {
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The free blocks of a slab pool cached by a thread, allocated and deallocated without any lock.
+///
+/// A thread's magazine is exchanged whole with the shared depot of its pool when it runs empty or full.
+/// The magazine is trivially destructible, so that it remains usable by the thread-local destructors
+/// running after its guard (the blocks go straight to the depot then).
+struct slab_magazine
+{
+    static constexpr std::size_t capacity = 32;
+
+    enum state_type : int { unregistered = 0, live, retired };
+
+    void *blocks[capacity];
+    std::size_t count;
+    state_type state;
+    std::atomic<std::size_t> allocated;// written by the owner thread only, read by the statistics
+    std::atomic<std::size_t> released;
+
+    static void bump( std::atomic<std::size_t> &a_counter ) noexcept
+    {
+        a_counter.store(a_counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);// no read-modify-write
+    }
+};
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The slabs of a type, carved into blocks of one size, and the depot of the free blocks shared by the threads.
+///
+/// The free blocks are linked through their storage : the depot holds the full magazines flushed by the threads as
+/// chains (linked through the second word of their first block), and the loose blocks in a list. The slabs are never
+/// released, neither is the pool (see @c slab_allocator).
+class slab_pool
+{
+public:
+
+    slab_pool() = default;
+    slab_pool( slab_pool const & ) = delete;
+    slab_pool &operator=( slab_pool const & ) = delete;
+
+    /// @brief Return whether the blocks fit objects of the given size (the first object allocated sets the block size).
+    bool fits( std::size_t a_size ) noexcept;
+
+    /// @brief Allocate a block from the magazine of the calling thread.
+    /// @param a_enlist The function enlisting the magazine of the calling thread, called once.
+    void *allocate( slab_magazine &a_magazine, void (*a_enlist)() );
+
+    /// @brief Deallocate a block into the magazine of the calling thread (whatever the thread which allocated it).
+    void deallocate( slab_magazine &a_magazine, void *a_block, void (*a_enlist)() ) noexcept;
+
+    /// @brief Count an allocation served by @c ::operator new.
+    void count_fallback() noexcept
+    {
+        m_fallback_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// @brief Return a snapshot of the blocks.
+    slab_statistics statistics() const;
+
+private:
+
+    friend class slab_magazine_guard;
+
+    static constexpr std::size_t slab_bytes = 64 * 1024;
+
+    static void *&next_of( void *a_block ) noexcept { return static_cast<void**>(a_block)[0]; }
+    static void *&next_chain_of( void *a_block ) noexcept { return static_cast<void**>(a_block)[1]; }
+
+    void enlist( slab_magazine &a_magazine );
+    void retire( slab_magazine &a_magazine ) noexcept;
+
+    void *refill_and_allocate( slab_magazine &a_magazine, void (*a_enlist)() );
+    void flush_and_deallocate( slab_magazine &a_magazine, void *a_block, void (*a_enlist)() ) noexcept;
+
+    /// @brief Move up to @c capacity free blocks into the given (empty) magazine, carving a new slab if needed.
+    void refill_locked( slab_magazine &a_magazine );
+
+    mutable std::mutex m_mutex;
+    std::atomic<std::size_t> m_block_size{ 0 };
+    std::atomic<std::size_t> m_fallback_allocations{ 0 };
+    void *m_full_chains = nullptr;// flushed magazines, of capacity blocks each
+    void *m_loose_blocks = nullptr;
+    char *m_carve_cursor = nullptr;// the blocks of the last slab never allocated yet
+    char *m_carve_end = nullptr;
+    std::size_t m_slab_count = 0;
+    std::size_t m_reserved_blocks = 0;
+    std::size_t m_retired_allocated = 0;// the counters of the retired magazines
+    std::size_t m_retired_released = 0;
+    std::vector<slab_magazine*> m_magazines;
+};
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The thread-local guard enlisting the magazine of a thread into its pool, and retiring it on thread exit.
+class slab_magazine_guard
+{
+public:
+
+    slab_magazine_guard( slab_pool &a_pool, slab_magazine &a_magazine )
+        : m_pool{ a_pool }
+        , m_magazine{ a_magazine }
+    {
+        m_pool.enlist(m_magazine);
+    }
+
+    ~slab_magazine_guard()
+    {
+        m_pool.retire(m_magazine);
+    }
+
+    slab_magazine_guard( slab_magazine_guard const & ) = delete;
+    slab_magazine_guard &operator=( slab_magazine_guard const & ) = delete;
+
+private:
+
+    slab_pool &m_pool;
+    slab_magazine &m_magazine;
+};
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Return the slab pool of the given key type, built on first use and never destroyed.
+template < typename Key >
+inline slab_pool &slab_pool_of()
+{
+    static auto *const pool = new slab_pool{};// immortal : handles may be released by other static destructors
+    return *pool;
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Return the magazine of the calling thread for the given key type.
+template < typename Key >
+inline slab_magazine &local_slab_magazine() noexcept
+{
+    thread_local slab_magazine magazine;// zero-initialized, trivially destructible
+    return magazine;
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Enlist the magazine of the calling thread for the given key type into its pool.
+template < typename Key >
+inline void enlist_local_slab_magazine()
+{
+    thread_local slab_magazine_guard const guard{ slab_pool_of<Key>(), local_slab_magazine<Key>() };
+    (void)guard;
+}
+
+}// EONS DETAIL
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief An allocator serving single objects from slabs dedicated to a type, through lock-free per-thread magazines.
+///
+/// Each key type has its own pool : slabs of 64 KiB carved into blocks of one size, the size of the first
+/// object allocated (with @c std::allocate_shared, or the allocator-aware @c make_any_handle factories, the
+/// control block and the object together). A thread allocates from and deallocates into its own magazine
+/// of 32 blocks, and exchanges whole magazines with the pool under its lock only when its magazine runs
+/// empty or full : a block can be deallocated by any thread. The magazine of a thread is returned to
+/// the pool when the thread exits.
+///
+/// Example:
+///
+/// @code
+///     // millions of short-lived messages per second, without malloc :
+///     auto m = make_any_handle_mutable<Message>( std::allocator_arg, slab_allocator<Message>{}, args );
+///     auto const stats = slab_allocator<Message>::statistics();
+/// @endcode
+///
+/// @note The allocator is stateless : all instances compare equal.
+/// @note The arrays, and the objects of another size than the blocks, are allocated by @c ::operator new.
+/// @note The slabs are never released : the blocks of a type are reused by the type only.
+template < typename T, typename Key >
+class slab_allocator
+{
+    static_assert( alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported, see cache_line_allocator" );
+
+public:
+
+    using value_type = T;
+
+    template < typename U >
+    struct rebind
+    {
+        using other = slab_allocator<U, Key>;
+    };
+
+    constexpr slab_allocator() noexcept = default;
+
+    template < typename U >
+    constexpr slab_allocator( slab_allocator<U, Key> const & ) noexcept
+    {}
+
+    /// @brief Allocate @c n objects of type @c T, from the pool of @c Key if @c n is 1.
+    T *allocate( std::size_t n );
+
+    /// @brief Deallocate a storage returned by @c allocate.
+    void deallocate( T *p, std::size_t n ) noexcept;
+
+    /// @brief Return a snapshot of the blocks of the pool of @c Key.
+    static slab_statistics statistics()
+    {
+        return detail::slab_pool_of<Key>().statistics();
+    }
+};
+
+template < typename T, typename U, typename Key >
+constexpr bool operator==( slab_allocator<T, Key> const &, slab_allocator<U, Key> const & ) noexcept
+{
+    return true;
+}
+
+template < typename T, typename U, typename Key >
+constexpr bool operator!=( slab_allocator<T, Key> const &, slab_allocator<U, Key> const & ) noexcept
+{
+    return false;
+}
+
+//..............................................................................
+//..............................................................................
+
+// INLINES :
+
+namespace detail {
+
+inline bool
+slab_pool::fits( std::size_t a_size ) noexcept
+{
+    // at least two words (the links of the free blocks), and a whole number of words : since the slabs
+    // are aligned on max_align_t, so is every block whose size is a multiple of its object alignment
+    auto const block = std::max( ( a_size + sizeof(void*) - 1 ) / sizeof(void*) * sizeof(void*), 2 * sizeof(void*) );
+    auto current = m_block_size.load(std::memory_order_relaxed);
+    if ( SOLO_LIKELY(current == block) )
+    {
+        return true;
+    }
+    return current == 0 && ( m_block_size.compare_exchange_strong(current, block, std::memory_order_relaxed) || current == block );
+}
+
+inline void *
+slab_pool::allocate( slab_magazine &a_magazine, void (*a_enlist)() )
+{
+    if ( SOLO_LIKELY(a_magazine.count != 0) )
+    {
+        slab_magazine::bump(a_magazine.allocated);
+        return a_magazine.blocks[--a_magazine.count];
+    }
+    return refill_and_allocate(a_magazine, a_enlist);
+}
+
+inline void
+slab_pool::deallocate( slab_magazine &a_magazine, void *a_block, void (*a_enlist)() ) noexcept
+{
+    if ( SOLO_LIKELY(a_magazine.state == slab_magazine::live && a_magazine.count != slab_magazine::capacity) )
+    {
+        slab_magazine::bump(a_magazine.released);
+        a_magazine.blocks[a_magazine.count++] = a_block;
+        return;
+    }
+    flush_and_deallocate(a_magazine, a_block, a_enlist);
+}
+
+inline void
+slab_pool::enlist( slab_magazine &a_magazine )
+{
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    m_magazines.push_back(&a_magazine);
+    a_magazine.state = slab_magazine::live;
+}
+
+inline void
+slab_pool::retire( slab_magazine &a_magazine ) noexcept
+{
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    while ( a_magazine.count != 0 )
+    {
+        auto *const block = a_magazine.blocks[--a_magazine.count];
+        next_of(block) = m_loose_blocks;
+        m_loose_blocks = block;
+    }
+    m_retired_allocated += a_magazine.allocated.load(std::memory_order_relaxed);
+    m_retired_released += a_magazine.released.load(std::memory_order_relaxed);
+    m_magazines.erase(std::find(m_magazines.begin(), m_magazines.end(), &a_magazine));
+    a_magazine.state = slab_magazine::retired;
+}
+
+inline void *
+slab_pool::refill_and_allocate( slab_magazine &a_magazine, void (*a_enlist)() )
+{
+    if ( a_magazine.state == slab_magazine::unregistered )
+    {
+        a_enlist();
+    }
+    if ( a_magazine.state == slab_magazine::retired )// a thread-local destructor, on thread exit
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        refill_locked(a_magazine);
+        auto *const block = a_magazine.blocks[--a_magazine.count];
+        while ( a_magazine.count != 0 )// give the other blocks back
+        {
+            auto *const other = a_magazine.blocks[--a_magazine.count];
+            next_of(other) = m_loose_blocks;
+            m_loose_blocks = other;
+        }
+        ++m_retired_allocated;
+        return block;
+    }
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        refill_locked(a_magazine);
+    }
+    slab_magazine::bump(a_magazine.allocated);
+    return a_magazine.blocks[--a_magazine.count];
+}
+
+inline void
+slab_pool::flush_and_deallocate( slab_magazine &a_magazine, void *a_block, void (*a_enlist)() ) noexcept
+{
+    if ( a_magazine.state == slab_magazine::unregistered )
+    {
+        try
+        {
+            a_enlist();
+        }
+        catch ( ... )
+        {
+            // deallocated into the depot below
+        }
+    }
+    if ( a_magazine.state != slab_magazine::live )
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        next_of(a_block) = m_loose_blocks;
+        m_loose_blocks = a_block;
+        ++m_retired_released;
+        return;
+    }
+    if ( a_magazine.count == slab_magazine::capacity )
+    {
+        // chain the full magazine out of the lock, then push it in constant time
+        for ( auto i = std::size_t{1}; i < slab_magazine::capacity; ++i )
+        {
+            next_of(a_magazine.blocks[i - 1]) = a_magazine.blocks[i];
+        }
+        next_of(a_magazine.blocks[slab_magazine::capacity - 1]) = nullptr;
+        auto *const head = a_magazine.blocks[0];
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            next_chain_of(head) = m_full_chains;
+            m_full_chains = head;
+        }
+        a_magazine.count = 0;
+    }
+    slab_magazine::bump(a_magazine.released);
+    a_magazine.blocks[a_magazine.count++] = a_block;
+}
+
+inline void
+slab_pool::refill_locked( slab_magazine &a_magazine )
+{
+    if ( m_full_chains != nullptr )
+    {
+        auto *block = m_full_chains;
+        m_full_chains = next_chain_of(block);
+        for ( ; block != nullptr; block = next_of(block) )
+        {
+            a_magazine.blocks[a_magazine.count++] = block;
+        }
+        return;
+    }
+    for ( ; m_loose_blocks != nullptr && a_magazine.count != slab_magazine::capacity; m_loose_blocks = next_of(m_loose_blocks) )
+    {
+        a_magazine.blocks[a_magazine.count++] = m_loose_blocks;
+    }
+    if ( a_magazine.count != 0 )
+    {
+        return;
+    }
+    auto const block_size = m_block_size.load(std::memory_order_relaxed);
+    if ( m_carve_cursor == m_carve_end )
+    {
+        auto const block_count = std::max( slab_bytes / block_size, std::size_t{ slab_magazine::capacity } );
+        m_carve_cursor = static_cast<char*>( ::operator new( block_count * block_size ) );// aligned on max_align_t
+        m_carve_end = m_carve_cursor + block_count * block_size;
+        ++m_slab_count;
+        m_reserved_blocks += block_count;
+    }
+    for ( ; m_carve_cursor != m_carve_end && a_magazine.count != slab_magazine::capacity; m_carve_cursor += block_size )
+    {
+        a_magazine.blocks[a_magazine.count++] = m_carve_cursor;
+    }
+}
+
+inline slab_statistics
+slab_pool::statistics() const
+{
+    auto result = slab_statistics{};
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    result.block_size = m_block_size.load(std::memory_order_relaxed);
+    result.slab_count = m_slab_count;
+    result.reserved_blocks = m_reserved_blocks;
+    result.fallback_allocations = m_fallback_allocations.load(std::memory_order_relaxed);
+    auto allocated = m_retired_allocated;
+    auto released = m_retired_released;
+    for ( auto const *m : m_magazines )
+    {
+        allocated += m->allocated.load(std::memory_order_relaxed);
+        released += m->released.load(std::memory_order_relaxed);
+    }
+    // signed : blocks released by another thread than their allocator's balance out, but a snapshot racing with them
+    // may count a release before its allocation
+    auto const in_use = static_cast<std::ptrdiff_t>(allocated) - static_cast<std::ptrdiff_t>(released);
+    result.blocks_in_use = std::min(static_cast<std::size_t>(std::max(in_use, std::ptrdiff_t{0})), result.reserved_blocks);
+    return result;
+}
+
+}// EONS DETAIL
+
+template < typename T, typename Key >
+inline T *
+slab_allocator<T, Key>::allocate( std::size_t n )
+{
+    auto &pool = detail::slab_pool_of<Key>();
+    if ( SOLO_LIKELY(n == 1 && pool.fits(sizeof(T))) )
+    {
+        return static_cast<T*>( pool.allocate(detail::local_slab_magazine<Key>(), &detail::enlist_local_slab_magazine<Key>) );
+    }
+    pool.count_fallback();
+    return static_cast<T*>( ::operator new( n * sizeof(T) ) );
+}
+
+template < typename T, typename Key >
+inline void
+slab_allocator<T, Key>::deallocate( T *p, std::size_t n ) noexcept
+{
+    auto &pool = detail::slab_pool_of<Key>();
+    if ( SOLO_LIKELY(n == 1 && pool.fits(sizeof(T))) )
+    {
+        pool.deallocate(detail::local_slab_magazine<Key>(), p, &detail::enlist_local_slab_magazine<Key>);
+        return;
+    }
+    ::operator delete( static_cast<void*>(p) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::ALLOCATORS
+////////////////////////////////////////////////////////////////////////////////
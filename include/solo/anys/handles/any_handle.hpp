@@ -9,6 +9,7 @@
 #pragma once
 
 #include <solo/anys/handles/any_type_index.hpp>
+#include <atomic>
 #include <memory>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -94,12 +95,25 @@ public:
     /// @note Return @c false if this handle is empty.
     constexpr bool is_mutable() const noexcept;
 
+    /// @brief Return true if the handled object is built by its first cast (see @c make_any_handle_lazy).
+    /// @note The pointer of a lazy handle is the address of its object, built or not : cast it before dereferencing it.
+    constexpr bool is_lazy() const noexcept;
+
     /// @brief Return true if all handle's properties are equal.
     ///
     ///	The comparison operators compare pointers only (acting like if @c any_handle were a raw pointer).
     ///
     bool equals( any_handle const &another ) const noexcept;
 
+    // copy-on-write:
+
+    /// @brief Give this handle its own copy of the handled object if it shares it, when it is a copy-on-write handle
+    /// (see @c make_any_handle_cow).
+    /// @return true for a non-null copy-on-write handle, then the only owner of its object ; false otherwise (unchanged).
+    /// @throw Whatever the copy of the handled object throws (this handle is then unchanged).
+    /// @note An unshared handle keeps its object : one use count load.
+    bool unshare();
+
     // properties:
 
     /// @brief The type information type.
@@ -109,6 +123,9 @@ public:
     /// @note Could return @c typeid(void) even if this handle is not empty.
     constexpr type_index_type const &type() const noexcept;
 
+    /// @brief Get the fingerprint of the handled object's type (see @c any_type_index::fingerprint).
+    constexpr any_type_index::fingerprint_type type_fingerprint() const noexcept;
+
     /// @brief The type-erased shared non-mutable pointer type.
     using pointer_type = std::shared_ptr<const void>;
 
@@ -119,6 +136,12 @@ public:
     /// @note The pointer may be null even if its type information is not.
     pointer_type pointer() const noexcept;
 
+    /// @brief Get a raw pointer to the non-mutable object, without sharing its ownership.
+    /// @return The pointer stored by @c pointer(), valid as long as this handle (or a copy) holds the object.
+    ///
+    /// @note Return a null pointer if this handle is empty.
+    void const *get() const noexcept;
+
     /// @brief The type-erased shared mutable pointer type.
     using mutable_pointer_type = std::shared_ptr<void>;
 
@@ -233,24 +256,59 @@ any_handle::is_mutable() const noexcept
     return m_ti.is_type_mutable();
 }
 
+inline constexpr bool
+any_handle::is_lazy() const noexcept
+{
+    return m_ti.is_type_lazy();
+}
+
 inline bool
 any_handle::equals( any_handle const &another ) const noexcept
 {
     return m_ti.equals(another.m_ti) && m_pointer == another.m_pointer;
 }
 
+inline bool
+any_handle::unshare()
+{
+    auto const clone = m_ti.copy_on_write_clone();
+    if ( clone == nullptr || m_pointer == nullptr )
+    {
+        return false;
+    }
+    if ( m_pointer.use_count() > 1 )
+    {
+        m_pointer = clone(m_pointer.get());
+        return true;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);// after the release of the last other owner : its reads are done
+    return true;
+}
+
 inline constexpr any_handle::type_index_type const &
 any_handle::type() const noexcept
 {
     return m_ti.external_type_index();
 }
 
+inline constexpr any_type_index::fingerprint_type
+any_handle::type_fingerprint() const noexcept
+{
+    return m_ti.fingerprint();
+}
+
 inline any_handle::pointer_type
 any_handle::pointer() const noexcept
 {
     return m_pointer;
 }
 
+inline void const *
+any_handle::get() const noexcept
+{
+    return m_pointer.get();
+}
+
 inline any_handle::mutable_pointer_type
 any_handle::mutable_pointer() const noexcept
 {
@@ -23,6 +23,7 @@ namespace solo {
 /// @pre   @c T is the type stored in @c a_handle.
 /// @post  <c>result == a_handle.pointer()</c>
 /// @throw Throw a @c solo::anys::exceptions::bad_any_handle_cast exception if @c T is not the type stored in the given @c a_handle.
+/// @throw Whatever the construction of the object of a lazy handle throws (see @c make_any_handle_lazy).
 /// @note  Ignore the mutability flag of the given @c a_handle.
 /// @note  Casting to <c>T const</c> or <c>T</c> returns the same @c shared_ptr<T const> object:
 ///
@@ -51,13 +52,11 @@ template< typename T >
 inline std::shared_ptr<T const>
 any_handle_cast_or_throw( any_handle const &a_handle )
 {
-    auto cr = any_handle_cast<T>(a_handle);
-    if (cr.has_error())
+    if ( SOLO_UNLIKELY(!anys::detail::is_any_handle_castable(a_handle, anys::detail::any_cast_target<T>(), mutability::false_)) )
     {
-        anys::detail::throw_any_handle_cast_exception<T const,mutability::false_>(a_handle);
-        return nullptr;// unreachable
+        anys::detail::build_or_throw_any_handle_cast_exception(a_handle, anys::detail::any_cast_target<T>(), mutability::false_);// cold
     }
-    return std::move(cr).assume_move_value();
+    return std::static_pointer_cast<T const>(a_handle.pointer());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
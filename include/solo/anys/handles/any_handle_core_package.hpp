@@ -27,6 +27,8 @@
 /// - @c class solo::anys::exceptions::bad_any_handle_cast
 /// - @c solo::any_type_index
 /// - @c template < typename... Args> solo::make_any_type_index(args...)
+/// - @c solo::any_type_index_less
+/// - @c solo::any_type_tag (and @c SOLO_ANY_TYPE_TAG)
 ///
 /// @note @c solo::make_any_handle and @c solo::make_any_handle_mutable usually
 /// cannot @em move the given @c std::shared_ptr<T> pointer because they have to
@@ -46,6 +48,8 @@
 // already included : #include <solo/anys/handles/any_type_index.hpp>
 // already included : #include <solo/anys/handles/make_any_type_index.hpp>
 #include <solo/anys/handles/any_type_index_comparison_operators.hpp>
+#include <solo/anys/handles/any_type_index_less.hpp>
+#include <solo/anys/handles/any_type_tag.hpp>
 
 // any handle :
 // already included : #include <solo/anys/handles/any_handle.hpp>
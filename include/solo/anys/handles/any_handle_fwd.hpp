@@ -0,0 +1,63 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+/// @file
+/// @ingroup SoloAnyHandle
+/// @brief Forward declarations of the library types, without any include.
+///
+/// Include this header (instead of @c any_handle_core_package.hpp or @c any_handle_package.hpp)
+/// in headers which only name the types : members of type @c any_handle, function declarations
+/// taking or returning @c any_handle objects, pointers and references.
+/// The translation units which build, cast or compare handles include one of the packages.
+///
+/// Example:
+///
+/// @code
+///     // service_registry.hpp
+///     #include <solo/anys/handles/any_handle_fwd.hpp>
+///     class service_registry
+///     {
+///     public:
+///         void add( solo::any_handle const &a_service );
+///         solo::any_handle find( std::type_info const &a_type ) const;
+///     };
+/// @endcode
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo {
+////////////////////////////////////////////////////////////////////////////////
+
+enum class mutability : bool;
+
+class any_type_index;
+
+template < typename T >
+struct any_type_tag;
+
+struct any_type_index_less;
+
+class any_handle;
+
+namespace anys { namespace errors {
+    class any_handle_cast_error;
+}}// EONS ANYS::ERRORS
+
+namespace anys { namespace exceptions {
+    class bad_any_handle_cast;
+}}// EONS ANYS::EXCEPTIONS
+
+namespace anys { namespace outcomes {
+    template < typename T, solo::mutability IsMutable >
+    class any_handle_cast_result;
+}}// EONS ANYS::OUTCOMES
+
+////////////////////////////////////////////////////////////////////////////////
+}// EONS SOLO
+////////////////////////////////////////////////////////////////////////////////
@@ -13,6 +13,28 @@
 //  - 2021/11/21 : rename casting method any_handle_xxx_cast to any_handle_xxx_cast_or_throw.
 //  - 2021/11/21 : new non-throwing casting methods any_handle_xxx_cast with @c any_handle_cast_result.
 //  - 2021/11/22 : handle @c any_type_info singletons by observer pointers.
+//  - 2026/10/18 : live handle tracking mode (SOLO_ANY_HANDLE_ENABLE_TRACKING).
+//  - 2026/10/18 : allocator-aware factories and @c cache_line_allocator.
+//  - 2026/10/18 : forward header, solo.any_handle module, testing outputters out of the package.
+//  - 2026/10/18 : non-template builders and cast checks (symbols per type), constrained factories in C++20.
+//  - 2026/10/18 : cold, out-of-line failure paths of the casts, branch hints on their success path.
+//  - 2026/10/18 : precomputed ordering key of @c any_type_index, @c any_type_index_less.
+//  - 2026/10/18 : binary snapshots of handle registries, restored lazily from memory-mapped files (snapshots/).
+//  - 2026/10/18 : zero-copy handles to plain-data objects of mapped regions (regions/), shared by the snapshots.
+//  - 2026/10/18 : stable type fingerprints and type tags, fingerprint-based type equality for plugins (SOLO_ANY_HANDLE_ENABLE_TYPE_FINGERPRINTS).
+//  - 2026/10/18 : handles to objects shared between processes through POSIX shared memory segments (interprocess/).
+//  - 2026/10/18 : any_handle::get (raw borrowed pointer), publish/subscribe bus dispatching handles by type (buses/).
+//  - 2026/10/18 : bounded lock-free MPMC and SPSC queues moving handles between threads (queues/).
+//  - 2026/10/18 : deferred destruction of the handled objects on a background reclaimer thread (reclaimers/).
+//  - 2026/10/18 : handles with biased reference counting for thread-affine objects (biased/).
+//  - 2026/10/18 : registry of handles, with C++20 coroutine waits for their publication (registries/).
+//  - 2026/10/18 : lazy handles building their object on its first cast (lazy/).
+//  - 2026/10/18 : parallel construction of graphs of dependent resources on a work-stealing pool (graphs/).
+//  - 2026/10/18 : any_handle::unshare, copy-on-write handles copying their shared object before a mutation (cow/).
+//  - 2026/10/18 : interning of immutable values in a weak sharded table (interning/).
+//  - 2026/10/18 : slab_allocator with per-thread magazines, pooled handles allocated from the slabs of their type (pools/).
+//  - 2026/10/18 : recycling_pool, handles returning their object to a pool on their final release (pools/).
+//  - 2026/10/18 : persistent_handle_map and persistent_registry, hash array mapped tries with O(1) snapshots and wait-free reads (registries/).
 
 /// @cond 
 
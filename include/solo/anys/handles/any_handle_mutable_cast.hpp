@@ -10,6 +10,8 @@
 
 #include <solo/anys/handles/outcomes/any_handle_cast_result.hpp>
 #include <solo/anys/handles/any_handle.hpp>
+#include <solo/anys/handles/details/check_any_handle_cast.hpp>
+#include <solo/anys/handles/pragmas/code_layout_hints.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////
 namespace solo {
@@ -58,20 +60,16 @@ any_handle_mutable_cast( solo::any_handle const &a_handle ) noexcept
 {
     using solo::anys::errors::any_handle_cast_error;
 
-    if ( a_handle.empty() )// nothrow
+    if ( SOLO_LIKELY(anys::detail::is_any_handle_castable(a_handle, anys::detail::any_cast_target<T>(), mutability::true_)) )// nothrow
     {
-        return any_handle_cast_error{any_handle_cast_error::code_type::empty_source};// nothrow
+        return std::static_pointer_cast<T>(a_handle.mutable_pointer());// nothrow
     }
-    if ( a_handle.type() != typeid(T) )// nothrow
+    auto const errc = anys::detail::check_any_handle_cast(a_handle, anys::detail::any_cast_target<T>(), mutability::true_);// nothrow, cold
+    if ( errc == anys::errors::any_handle_cast_errc::undefined )// a lazy object, built by the check
     {
-        return any_handle_cast_error{any_handle_cast_error::code_type::bad_source_type};// nothrow
+        return std::static_pointer_cast<T>(a_handle.mutable_pointer());// nothrow
     }
-    if ( not a_handle.is_mutable() )// nothrow
-    {
-        return any_handle_cast_error{any_handle_cast_error::code_type::bad_source_mutability};// nothrow
-    }
-
-    return std::static_pointer_cast<T>(a_handle.mutable_pointer());// nothrow
+    return any_handle_cast_error{ errc };
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -25,6 +25,7 @@ namespace solo {
 /// @post  <c>result == a_handle.pointer() == a_handle.mutable_pointer()</c>
 /// @throw Throw a @c bad_any_handle_cast exception if @c T is not the type stored in @c a_handle.
 /// @throw Throw a @c bad_any_handle_cast exception if @c a_handle is not @em mutable (see @c any_handle).
+/// @throw Whatever the construction of the object of a lazy handle throws (see @c make_any_handle_lazy).
 /// @note  Casting to <c>T const</c> returns a @c std::shared_ptr<T const> object although the mutability flag is set :
 ///
 /// @code
@@ -54,13 +55,11 @@ template< typename T >
 inline std::shared_ptr<T>
 any_handle_mutable_cast_or_throw( any_handle const &a_handle )
 {
-    auto cr = any_handle_mutable_cast<T>(a_handle);
-    if (cr.has_error())
+    if ( SOLO_UNLIKELY(!anys::detail::is_any_handle_castable(a_handle, anys::detail::any_cast_target<T>(), mutability::true_)) )
     {
-        anys::detail::throw_any_handle_cast_exception<T const,mutability::true_>(a_handle);
-        return nullptr;// unreachable
+        anys::detail::build_or_throw_any_handle_cast_exception(a_handle, anys::detail::any_cast_target<T>(), mutability::true_);// cold
     }
-    return std::move(cr).assume_move_value();
+    return std::static_pointer_cast<T>(a_handle.mutable_pointer());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
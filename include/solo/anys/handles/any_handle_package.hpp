@@ -26,7 +26,7 @@
 #include <solo/anys/handles/make_any_handle_ex.hpp>
 #include <solo/anys/handles/make_any_handle_mutable_ex.hpp>
 
-// testing helpers:
-#include <solo/anys/handles/testing/printing/any_handle_boost_test_outputters.hpp>
+// testing helpers are not part of the package (they depend on Boost.Core and on <ostream>) :
+// test units include <solo/anys/handles/testing/printing/any_handle_boost_test_outputters.hpp> explicitly.
 
 ////////////////////////////////////////////////////////////////////////////////
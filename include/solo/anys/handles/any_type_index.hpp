@@ -12,7 +12,9 @@
 // already included : #include <solo/anys/handles/details/any_type_info.hpp>
 #include <solo/anys/handles/details/empty_any_type_info_instance.hpp>
 
+#include <solo/anys/handles/pragmas/code_layout_hints.hpp>
 // already included : #include <experimental/memory>
+#include <cstdint>
 #include <utility>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -89,11 +91,64 @@ public:
     /// @brief Return true if the type information is empty.
     constexpr bool is_type_empty() const noexcept;
 
+    /// @brief Return true if the handled objects are built on their first cast (see @c make_any_handle_lazy).
+    /// @note Ignored by the comparisons : a lazy handle has the type of the object it builds.
+    constexpr bool is_type_lazy() const noexcept;
+
+    /// @brief Return the function cloning the handled objects of the copy-on-write handles (see @c make_any_handle_cow),
+    /// @c nullptr for the other handles.
+    /// @note Ignored by the comparisons : a copy-on-write handle has the type of its object.
+    constexpr anys::detail::any_type_info::clone_function copy_on_write_clone() const noexcept;
+
     /// @brief Return true if all type's properties are equal (including mutability and emptiness).
     ///
+    /// Compare the fingerprints instead of the builtin c++ type information when
+    /// @c SOLO_ANY_HANDLE_ENABLE_TYPE_FINGERPRINTS is set.
+    ///
     ///	The comparison operators compare builtin c++ type information only (acting like if @c any_type_index were @c std::type_index).
     bool equals(any_type_index const &another) const noexcept;
 
+    // fingerprint:
+
+    /// @brief The type of the type fingerprint.
+    using fingerprint_type = std::uint64_t;
+
+    /// @brief Return the precomputed fingerprint of the type (ignoring emptiness and mutability).
+    ///
+    /// A 64-bit hash of the type name, or of its user tag (see @c any_type_tag) :
+    /// the same in every binary (executable or shared library) of the same build, whereas @c std::type_info
+    /// objects may be duplicated across shared libraries.
+    /// @note Distinct types may share the same fingerprint (hash collision, about one chance in 2^64 per pair of types) :
+    /// the library compares the fingerprints only if @c SOLO_ANY_HANDLE_ENABLE_TYPE_FINGERPRINTS is set.
+    /// @note Distinct types with internal linkage share the same fingerprint when they have the same name
+    /// (the types of the anonymous namespaces, the local classes of the functions with internal linkage) :
+    /// with @c SOLO_ANY_HANDLE_ENABLE_TYPE_FINGERPRINTS, these types are compared by their builtin
+    /// type information too (see @c anys::detail::is_any_type_name_local).
+    constexpr fingerprint_type fingerprint() const noexcept;
+
+    // ordering:
+
+    /// @brief The type of the ordering key.
+    using ordering_key_type = std::uint64_t;
+
+    /// @brief Return the precomputed ordering key of the type information.
+    ///
+    /// The key covers the type, the emptiness and the mutability : it is the fingerprint of the type
+    /// with the two flags in its lowest bits. It is stable across runs of the same build.
+    /// @note Distinct types may share the same key (hash collision) : use @c before to order @c any_type_index objects.
+    constexpr ordering_key_type ordering_key() const noexcept;
+
+    /// @brief Return true if @c this is ordered before @c another.
+    ///
+    /// A strict total order consistent with @c equals :
+    /// <c>!a.before(b) && !b.before(a)</c> if and only if <c>a.equals(b)</c>.
+    /// Compare the ordering keys (a single integer comparison),
+    /// then the builtin c++ type information when the keys collide.
+    ///
+    ///	The comparison operators compare builtin c++ type information only (acting like if @c any_type_index were @c std::type_index).
+    /// @see @c any_type_index_less
+    bool before(any_type_index const &another) const noexcept;
+
 protected:
 
     // explicit type info-based constructor:
@@ -153,12 +208,63 @@ any_type_index::is_type_empty() const noexcept
     return not m_ti_ptr->m_nonempty_flag;
 }
 
+inline constexpr bool
+any_type_index::is_type_lazy() const noexcept
+{
+    return m_ti_ptr->m_lazy_flag;
+}
+
+inline constexpr anys::detail::any_type_info::clone_function
+any_type_index::copy_on_write_clone() const noexcept
+{
+    return m_ti_ptr->m_clone;
+}
+
 inline bool
 any_type_index::equals(any_type_index const &another) const noexcept
 {
+#if SOLO_ANY_HANDLE_ENABLE_TYPE_FINGERPRINTS
+    return m_ti_ptr->m_ordering_key == another.m_ti_ptr->m_ordering_key// flags included
+            && anys::detail::is_same_fingerprinted_type(*m_ti_ptr, another.m_ti_ptr->m_fingerprint, another.m_ti_ptr->m_external_type_index);
+#else
     return m_ti_ptr->m_external_type_index == another.m_ti_ptr->m_external_type_index
             && m_ti_ptr->m_nonempty_flag == another.m_ti_ptr->m_nonempty_flag
             && m_ti_ptr->m_mutable_flag == another.m_ti_ptr->m_mutable_flag;
+#endif
+}
+
+inline constexpr any_type_index::fingerprint_type
+any_type_index::fingerprint() const noexcept
+{
+    return m_ti_ptr->m_fingerprint;
+}
+
+inline constexpr any_type_index::ordering_key_type
+any_type_index::ordering_key() const noexcept
+{
+    return m_ti_ptr->m_ordering_key;
+}
+
+inline bool
+any_type_index::before(any_type_index const &another) const noexcept
+{
+    auto const key = m_ti_ptr->m_ordering_key;
+    auto const another_key = another.m_ti_ptr->m_ordering_key;
+    if ( SOLO_LIKELY(key != another_key) )
+    {
+        return key < another_key;
+    }
+    // same key : same flags, same type (equal) or colliding type names
+#if SOLO_ANY_HANDLE_ENABLE_TYPE_FINGERPRINTS
+    if ( m_ti_ptr->m_fingerprint != another.m_ti_ptr->m_fingerprint )
+    {
+        return m_ti_ptr->m_fingerprint < another.m_ti_ptr->m_fingerprint;
+    }
+    // same name : distinct types with internal linkage, ordered by their builtin type information
+    return m_ti_ptr->m_local_flag && m_ti_ptr->m_external_type_index < another.m_ti_ptr->m_external_type_index;
+#else
+    return m_ti_ptr->m_external_type_index < another.m_ti_ptr->m_external_type_index;
+#endif
 }
 
 inline constexpr
@@ -87,32 +87,32 @@ namespace
 {
     inline bool operator==( std::type_info const &a_x, std::type_index const &a_y ) noexcept
     {
-        return a_y == a_x;
+        return a_y == std::type_index{ a_x };
     }
 
     inline bool operator!=( std::type_info const &a_x, std::type_index const &a_y ) noexcept
     {
-        return a_y != a_x;
+        return a_y != std::type_index{ a_x };
     }
 
     inline bool operator<=( std::type_info const &a_x, std::type_index const &a_y ) noexcept
     {
-        return a_y <= a_x;
+        return a_y <= std::type_index{ a_x };
     }
 
     inline bool operator< ( std::type_info const &a_x, std::type_index const &a_y ) noexcept
     {
-        return a_y <  a_x;
+        return a_y <  std::type_index{ a_x };
     }
 
     inline bool operator>=( std::type_info const &a_x, std::type_index const &a_y ) noexcept
     {
-        return a_y >= a_x;
+        return a_y >= std::type_index{ a_x };
     }
 
     inline bool operator> ( std::type_info const &a_x, std::type_index const &a_y ) noexcept
     {
-        return a_y >  a_x;
+        return a_y >  std::type_index{ a_x };
     }
 }
 
@@ -0,0 +1,52 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/any_type_index.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+struct any_type_index_less;
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandle
+/// @brief Order @c any_type_index objects by their precomputed ordering keys.
+///
+/// A strict total order consistent with @c any_type_index::equals (mutability and emptiness included),
+/// stable across runs of the same build.
+/// Use it as the comparator of sorted containers keyed by type information,
+/// instead of @c std::less<any_type_index> (which compares the builtin c++ type information only,
+/// through @c std::type_info::before ).
+///
+/// Example:
+///
+/// @code
+///     std::map<solo::any_type_index, factory_type, solo::any_type_index_less> factories;
+///     factories[solo::make_any_type_index<A>(mutability::true_)] = make_a;
+/// @endcode
+///
+struct any_type_index_less
+{
+    bool operator()( any_type_index const &a_x, any_type_index const &a_y ) const noexcept
+    {
+        return a_x.before(a_y);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}// EONS SOLO
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,57 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+template < typename T >
+struct any_type_tag;
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandle
+/// @brief The user tag of the type @c T : the name its fingerprint is computed from (see @c any_type_index::fingerprint).
+///
+/// By default, a type has no tag (@c value is @c nullptr) and its fingerprint is computed from @c typeid(T).name().
+/// Tag the types exchanged between binaries built by different compilers (whose type names differ),
+/// or whose names must not change when they are renamed, with @c SOLO_ANY_TYPE_TAG.
+///
+/// @note The tag must be visible wherever handles of the type are built or cast :
+/// declare it next to the type.
+template < typename T >
+struct any_type_tag
+{
+    static constexpr char const *value = nullptr;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}// EONS SOLO
+////////////////////////////////////////////////////////////////////////////////
+
+/// @def SOLO_ANY_TYPE_TAG
+/// @ingroup SoloAnyHandle
+/// @brief Tag the given type with the given string literal (at global namespace scope).
+///
+/// Example:
+///
+/// @code
+///     namespace plugins { struct mesh { ... }; }
+///     SOLO_ANY_TYPE_TAG(plugins::mesh, "plugins.mesh/1")
+/// @endcode
+#define SOLO_ANY_TYPE_TAG( a_type, a_tag ) \
+    namespace solo { \
+        template <> struct any_type_tag< a_type > { static constexpr char const *value = a_tag; }; \
+    }
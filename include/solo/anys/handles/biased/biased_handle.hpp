@@ -0,0 +1,398 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/biased/biased_refcount.hpp>
+
+#include <solo/anys/handles/details/check_any_handle_cast.hpp>
+#include <solo/anys/handles/errors/any_handle_cast_error.hpp>
+#include <solo/anys/handles/make_any_type_index.hpp>
+
+#include <stdex/in_place_t.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <typeindex>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace biased {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+class biased_handle;
+
+template < typename T >
+class biased_ptr;
+
+template < typename T >
+class biased_handle_cast_result;
+
+template < typename T, typename... Args >
+biased_handle make_biased_handle( stdex::in_place_t, Args &&...a_type_constructor_arguments_list );
+
+template < typename T, typename... Args >
+biased_handle make_biased_handle_mutable( stdex::in_place_t, Args &&...a_type_constructor_arguments_list );
+
+template < typename T >
+biased_handle_cast_result<T const> biased_handle_cast( biased_handle const &a_handle ) noexcept;
+
+template < typename T >
+biased_handle_cast_result<T> biased_handle_mutable_cast( biased_handle const &a_handle ) noexcept;
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+namespace detail {
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief One reference to a biased object (the common part of @c biased_handle and @c biased_ptr).
+class biased_reference
+{
+public:
+
+    constexpr biased_reference() noexcept = default;
+
+    /// @brief Adopt the given reference (already retained).
+    explicit biased_reference( biased_control_block *a_block ) noexcept
+        : m_block{ a_block }
+    {}
+
+    biased_reference( biased_reference const &a_other ) noexcept
+        : m_block{ a_other.m_block }
+    {
+        if ( m_block != nullptr ) { m_block->retain(); }
+    }
+
+    biased_reference( biased_reference &&a_other ) noexcept
+        : m_block{ std::exchange(a_other.m_block, nullptr) }
+    {}
+
+    biased_reference &operator=( biased_reference a_other ) noexcept
+    {
+        std::swap(m_block, a_other.m_block);
+        return *this;
+    }
+
+    ~biased_reference()
+    {
+        if ( m_block != nullptr ) { m_block->release(); }
+    }
+
+    biased_control_block *block() const noexcept { return m_block; }
+
+private:
+
+    biased_control_block *m_block{nullptr};
+};
+
+}// EONS DETAIL
+
+//..............................................................................
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief A handle whose references are counted without atomic operation by the thread which created the object.
+///
+/// The counterpart of @c any_handle for the objects mostly copied by the thread creating them :
+/// the copies and releases of the owner thread increment and decrement a plain counter,
+/// those of the other threads an atomic counter, and the two counts are merged when the owner thread
+/// releases its last reference (biased reference counting).
+/// The handles can be copied, moved and released by any thread ; the type checks and the casts are those of @c any_handle.
+///
+/// When another thread releases a reference counted by the owner, the object is queued to its owner thread,
+/// which merges it on its next biased factory call, or on @c collect_biased_releases, or on its exit.
+///
+/// Example:
+///
+/// @code
+///     auto h = solo::anys::biased::make_biased_handle<A>(stdex::in_place, 1);
+///     auto copies = std::vector<solo::anys::biased::biased_handle>(100, h);// non-atomic increments
+///     auto rh = solo::anys::biased::biased_handle_cast<A>(h);
+///     if ( rh.has_value() ) { rh.assume_value()->f(); }
+/// @endcode
+class biased_handle
+{
+public:
+
+    /// @brief The builtin c++ type information of the handled type.
+    using type_index_type = std::type_index;
+
+    /// @brief Build an empty handle.
+    constexpr biased_handle() noexcept = default;
+
+    /// @brief Return true if the handle is empty.
+    bool empty() const noexcept { return m_reference.block() == nullptr; }
+
+    /// @brief Return the type information of the handled object (of an empty object for an empty handle).
+    any_type_index type_index() const noexcept;
+
+    /// @brief Return the builtin c++ type information of the handled object.
+    type_index_type const &type() const noexcept { return type_index().external_type_index(); }
+
+    /// @brief Return the fingerprint of the handled type.
+    any_type_index::fingerprint_type type_fingerprint() const noexcept { return type_index().fingerprint(); }
+
+    /// @brief Return true if the object can be cast to a mutable object (see @c biased_handle_mutable_cast).
+    bool is_mutable() const noexcept { return type_index().is_type_mutable(); }
+
+    /// @brief Return the raw pointer to the handled object (null for an empty handle), valid while the handle is.
+    void const *get() const noexcept;
+
+    /// @brief Return the number of references : exact on the owner thread, the atomic count only on the other threads.
+    std::int64_t use_count() const noexcept;
+
+    /// @brief Return true if the calling thread copies the handle without atomic operation.
+    bool is_biased() const noexcept;
+
+protected:
+
+    /// @brief Adopt the given reference (already retained).
+    explicit biased_handle( detail::biased_reference a_reference ) noexcept
+        : m_reference{ std::move(a_reference) }
+    {}
+
+    friend struct biased_handle_builder;
+
+private:
+
+    detail::biased_reference m_reference{};
+};
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The builder of the handles (the constructor of a handle is protected).
+struct biased_handle_builder
+{
+    static biased_handle build( detail::biased_control_block *a_block ) noexcept
+    {
+        return biased_handle{ detail::biased_reference{ a_block } };
+    }
+
+    static detail::biased_reference const &reference( biased_handle const &a_handle ) noexcept
+    {
+        return a_handle.m_reference;
+    }
+};
+
+//..............................................................................
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief An owning typed pointer to a biased object : the value of a successful @c biased_handle_cast.
+///
+/// It owns a reference counted like those of @c biased_handle.
+template < typename T >
+class biased_ptr
+{
+public:
+
+    using element_type = T;
+
+    constexpr biased_ptr() noexcept = default;
+
+    explicit biased_ptr( detail::biased_reference a_reference ) noexcept
+        : m_reference{ std::move(a_reference) }
+        , m_ptr{ static_cast<T *>( m_reference.block()->object() ) }
+    {}
+
+    T *get() const noexcept { return m_ptr; }
+    T &operator*() const noexcept { return *m_ptr; }
+    T *operator->() const noexcept { return m_ptr; }
+    explicit operator bool() const noexcept { return m_ptr != nullptr; }
+
+    std::int64_t use_count() const noexcept
+    {
+        return m_ptr == nullptr ? 0 : m_reference.block()->use_count();
+    }
+
+private:
+
+    detail::biased_reference m_reference{};
+    T *m_ptr{nullptr};
+};
+
+//..............................................................................
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The result of @c biased_handle_cast and @c biased_handle_mutable_cast : a @c biased_ptr or an @c any_handle_cast_error.
+///
+/// Same interface as @c any_handle_cast_result.
+template < typename T >
+class biased_handle_cast_result
+{
+public:
+
+    using value_type = biased_ptr<T>;
+    using error_type = anys::errors::any_handle_cast_error;
+
+    biased_handle_cast_result( value_type &&a_value ) noexcept
+        : m_value{std::move(a_value)}
+        , m_valuable{true}
+    {}
+
+    biased_handle_cast_result( error_type &&a_error ) noexcept
+        : m_error{std::move(a_error)}
+        , m_valuable{false}
+    {}
+
+    biased_handle_cast_result() = delete;
+
+    bool has_value() const noexcept { return m_valuable; }
+
+    value_type const &assume_value() const & noexcept { return m_value; }
+
+    value_type assume_move_value() && noexcept { return std::move(m_value); }
+
+    bool has_error() const noexcept { return not m_valuable; }
+
+    error_type const &assume_error() const & noexcept { return m_error; }
+
+private:
+
+    value_type m_value{};
+    error_type m_error{};
+    bool m_valuable{false};
+};
+
+//..............................................................................
+//..............................................................................
+
+// INLINES :
+
+inline any_type_index
+biased_handle::type_index() const noexcept
+{
+    return empty() ? any_type_index{} : m_reference.block()->type();
+}
+
+inline void const *
+biased_handle::get() const noexcept
+{
+    return empty() ? nullptr : m_reference.block()->object();
+}
+
+inline std::int64_t
+biased_handle::use_count() const noexcept
+{
+    return empty() ? 0 : m_reference.block()->use_count();
+}
+
+inline bool
+biased_handle::is_biased() const noexcept
+{
+    return !empty() && m_reference.block()->is_biased();
+}
+
+//..............................................................................
+
+namespace detail {
+
+template < typename T, typename... Args >
+biased_handle
+make_biased_handle_with_mutability( mutability a_ismutable, Args &&...a_args )
+{
+    static_assert(!std::is_reference<T>::value, "T should not be a reference type");
+
+    auto const &owner = biased_owner::current();
+    owner->collect();
+    auto *const block = new biased_object_block<std::remove_cv_t<T>>{ make_any_type_index<T>(a_ismutable), owner, std::forward<Args>(a_args)... };
+    return biased_handle_builder::build(block);
+}
+
+/// @brief Return true if the handled type is the given target type (see @c anys::detail::is_any_handle_type).
+inline bool
+is_biased_handle_type( biased_handle const &a_handle, anys::detail::any_cast_target_type const &a_target_type ) noexcept
+{
+#if SOLO_ANY_HANDLE_ENABLE_TYPE_FINGERPRINTS
+    return anys::detail::is_same_fingerprinted_type(a_target_type, a_handle.type_fingerprint(), a_handle.type());
+#else
+    return a_handle.type() == a_target_type;
+#endif
+}
+
+template < typename T >
+anys::errors::any_handle_cast_error
+check_biased_handle_cast( biased_handle const &a_handle, mutability a_ismutable ) noexcept
+{
+    using errc = anys::errors::any_handle_cast_errc;
+    if ( a_handle.empty() )
+    {
+        return anys::errors::any_handle_cast_error{ errc::empty_source };
+    }
+    if ( !is_biased_handle_type(a_handle, anys::detail::any_cast_target<T>()) )
+    {
+        return anys::errors::any_handle_cast_error{ errc::bad_source_type };
+    }
+    if ( mutability_as_boolean(a_ismutable) && !a_handle.is_mutable() )
+    {
+        return anys::errors::any_handle_cast_error{ errc::bad_source_mutability };
+    }
+    return anys::errors::any_handle_cast_error{};
+}
+
+}// EONS DETAIL
+
+//..............................................................................
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Build a non-mutable object of type @c T owned by the calling thread, and return its handle.
+/// @see @c make_any_handle.
+template < typename T, typename... Args >
+biased_handle
+make_biased_handle( stdex::in_place_t, Args &&...a_type_constructor_arguments_list )
+{
+    return detail::make_biased_handle_with_mutability<T>(mutability::false_, std::forward<Args>(a_type_constructor_arguments_list)...);
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Build a mutable object of type @c T owned by the calling thread, and return its handle.
+/// @see @c make_any_handle_mutable.
+template < typename T, typename... Args >
+biased_handle
+make_biased_handle_mutable( stdex::in_place_t, Args &&...a_type_constructor_arguments_list )
+{
+    static_assert(!std::is_const<T>::value && !std::is_volatile<T>::value, "T should not be cv-qualified");
+    return detail::make_biased_handle_with_mutability<T>(mutability::true_, std::forward<Args>(a_type_constructor_arguments_list)...);
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Cast the given handle to a constant object of type @c T.
+/// @return A @c biased_ptr<T const>, or an @c any_handle_cast_error (empty source, bad source type).
+template < typename T >
+biased_handle_cast_result<T const>
+biased_handle_cast( biased_handle const &a_handle ) noexcept
+{
+    auto error = detail::check_biased_handle_cast<T>(a_handle, mutability::false_);
+    if ( error.code() != anys::errors::any_handle_cast_errc::undefined )
+    {
+        return biased_handle_cast_result<T const>{ std::move(error) };
+    }
+    return biased_handle_cast_result<T const>{ biased_ptr<T const>{ biased_handle_builder::reference(a_handle) } };
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Cast the given handle to a mutable object of type @c T.
+/// @return A @c biased_ptr<T>, or an @c any_handle_cast_error (empty source, bad source type, bad source mutability).
+template < typename T >
+biased_handle_cast_result<T>
+biased_handle_mutable_cast( biased_handle const &a_handle ) noexcept
+{
+    auto error = detail::check_biased_handle_cast<T>(a_handle, mutability::true_);
+    if ( error.code() != anys::errors::any_handle_cast_errc::undefined )
+    {
+        return biased_handle_cast_result<T>{ std::move(error) };
+    }
+    return biased_handle_cast_result<T>{ biased_ptr<T>{ biased_handle_builder::reference(a_handle) } };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::BIASED
+////////////////////////////////////////////////////////////////////////////////
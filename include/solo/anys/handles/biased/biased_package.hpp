@@ -0,0 +1,21 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+/// @file
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Opt-in handles with biased reference counting, for thread-affine objects (not included by the library packages).
+///
+/// - @c solo::anys::biased::biased_handle : the handle, copied without atomic operation by the thread owning the object,
+/// - @c solo::anys::biased::make_biased_handle<T>, @c make_biased_handle_mutable<T> : the factories,
+/// - @c solo::anys::biased::biased_handle_cast<T>, @c biased_handle_mutable_cast<T> : the casts,
+/// - @c solo::anys::biased::collect_biased_releases : the merge of the references released by the other threads.
+
+#include <solo/anys/handles/biased/biased_refcount.hpp>
+#include <solo/anys/handles/biased/biased_handle.hpp>
@@ -0,0 +1,369 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/any_type_index.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace biased {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+class biased_owner;
+
+void collect_biased_releases() noexcept;
+
+namespace detail {
+    class biased_control_block;
+    biased_owner *&current_biased_owner() noexcept;
+}// EONS DETAIL
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The owner record of a thread : the objects it created, whose biased references were released by other threads.
+///
+/// One per thread creating biased handles, shared with the control blocks of its objects.
+/// When another thread releases the last reference counted by the shared counter of an object
+/// while the owner thread still counts biased references, it cannot touch the (non-atomic) biased count :
+/// it queues the object to its owner, which merges the two counts on its next @c collect.
+/// Once the owner thread has exited (the record is closed), the other threads merge by themselves, out of the lock of the record
+/// (the destruction of an object may release other objects of the same record).
+class biased_owner
+{
+public:
+
+    biased_owner() = default;
+    biased_owner( biased_owner const & ) = delete;
+    biased_owner &operator=( biased_owner const & ) = delete;
+
+    /// @brief Return the owner record of the calling thread (created on first use).
+    static std::shared_ptr<biased_owner> const &current();
+
+    /// @brief Return true if objects are queued for a merge (a hint, read without lock).
+    bool has_queued() const noexcept { return m_has_queued.load(std::memory_order_relaxed); }
+
+    /// @brief Merge the queued objects (owner thread only).
+    void collect() noexcept;
+
+    /// @brief Queue the given object for a merge by the owner thread, or merge it at once if the owner thread has exited.
+    void enqueue( detail::biased_control_block *a_block ) noexcept;
+
+    /// @brief Merge the queued objects and close the record (on the exit of the owner thread).
+    void close() noexcept;
+
+private:
+
+    std::mutex m_mutex;
+    detail::biased_control_block *m_queued{nullptr};// intrusive list : queuing never allocates
+    std::atomic<bool> m_has_queued{false};
+    bool m_closed{false};
+};
+
+//..............................................................................
+
+namespace detail {
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The reference counts, type and owner of a biased object.
+///
+/// The references are counted by two counters, whose sum is the number of references :
+/// - the biased count, non-atomic, incremented and decremented by the owner thread only,
+/// - the shared count, atomic, incremented and decremented by the other threads (it may drop below zero).
+///
+/// The shared word also holds two flags :
+/// - merged : the biased count was added to the shared count (once the owner thread released its biased references,
+///   or collected the object) ; from then on, every thread uses the shared count, and the object is destroyed at zero,
+/// - queued : a thread released a reference while the shared count was zero (the reference is then kept by the queue
+///   of the owner, which releases it after the merge : the object cannot be destroyed before).
+class biased_control_block
+{
+public:
+
+    biased_control_block( any_type_index a_type, std::shared_ptr<biased_owner> a_owner ) noexcept
+        : m_type{ a_type }
+        , m_owner_ptr{ a_owner.get() }
+        , m_owner{ std::move(a_owner) }
+    {}
+
+    biased_control_block( biased_control_block const & ) = delete;
+    biased_control_block &operator=( biased_control_block const & ) = delete;
+
+    virtual ~biased_control_block() = default;
+
+    any_type_index const &type() const noexcept { return m_type; }
+    void *object() const noexcept { return m_object; }
+    std::shared_ptr<biased_owner> const &owner() const noexcept { return m_owner; }
+
+    /// @brief Return true if the calling thread counts its references with the biased count.
+    bool is_biased() const noexcept
+    {
+        return m_owner_ptr == current_biased_owner() && !m_merged;
+    }
+
+    void retain() noexcept
+    {
+        if ( is_biased() )
+        {
+            ++m_biased;
+            return;
+        }
+        m_shared.fetch_add(shared_unit, std::memory_order_relaxed);
+    }
+
+    void release() noexcept
+    {
+        if ( is_biased() )
+        {
+            if ( --m_biased == 0 )
+            {
+                merge();
+            }
+            return;
+        }
+        release_shared();
+    }
+
+    /// @brief The number of references : exact on the owner thread, the shared count only on the other threads.
+    std::int64_t use_count() const noexcept
+    {
+        auto const shared = shared_count( m_shared.load(std::memory_order_relaxed) );
+        return is_biased() ? shared + m_biased : shared;
+    }
+
+    /// @brief Add the biased count to the shared count (owner thread, or lock of a closed owner record).
+    void merge() noexcept
+    {
+        m_merged = true;
+        auto const addend = static_cast<std::int64_t>(m_biased) * shared_unit + shared_merged_flag;
+        m_biased = 0;
+        auto const shared = m_shared.fetch_add(addend, std::memory_order_acq_rel) + addend;
+        if ( shared_count(shared) == 0 )
+        {
+            delete this;
+        }
+    }
+
+    /// @brief Merge the object if needed, and release the reference kept by the queue of the owner.
+    void collect() noexcept
+    {
+        if ( !m_merged )
+        {
+            merge();// cannot destroy : the queue keeps a reference
+        }
+        release_shared();
+    }
+
+protected:
+
+    void set_object( void *a_object ) noexcept { m_object = a_object; }
+
+private:
+
+    static constexpr std::int64_t shared_merged_flag = 1;
+    static constexpr std::int64_t shared_queued_flag = 2;
+    static constexpr std::int64_t shared_flags = 3;
+    static constexpr std::int64_t shared_unit = 4;
+
+    static std::int64_t shared_count( std::int64_t a_shared ) noexcept
+    {
+        return ( a_shared - ( a_shared & shared_flags ) ) / shared_unit;
+    }
+
+    void release_shared() noexcept
+    {
+        auto shared = m_shared.load(std::memory_order_relaxed);
+        for ( ;; )
+        {
+            if ( ( shared & shared_merged_flag ) != 0 )// never cleared
+            {
+                if ( shared_count( m_shared.fetch_sub(shared_unit, std::memory_order_acq_rel) ) == 1 )
+                {
+                    delete this;
+                }
+                return;
+            }
+            if ( shared_count(shared) > 0 || ( shared & shared_queued_flag ) != 0 )// the owner merges later
+            {
+                if ( m_shared.compare_exchange_weak(shared, shared - shared_unit, std::memory_order_acq_rel, std::memory_order_relaxed) )
+                {
+                    return;
+                }
+                continue;
+            }
+            // the reference is counted by the biased count : hand it to the owner
+            if ( m_shared.compare_exchange_weak(shared, shared | shared_queued_flag, std::memory_order_acq_rel, std::memory_order_relaxed) )
+            {
+                m_owner_ptr->enqueue(this);
+                return;
+            }
+        }
+    }
+
+    any_type_index const m_type;
+    void *m_object{nullptr};
+    biased_owner *const m_owner_ptr;
+    std::shared_ptr<biased_owner> const m_owner;
+    std::uint32_t m_biased{1};// owner thread only
+    bool m_merged{false};// owner thread only
+    std::atomic<std::int64_t> m_shared{0};
+
+    friend class biased::biased_owner;
+    biased_control_block *m_next_queued{nullptr};// lock of the owner record
+};
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The control block of a biased object, followed by the object (one allocation).
+template < typename T >
+class biased_object_block final : public biased_control_block
+{
+public:
+
+    template < typename... Args >
+    biased_object_block( any_type_index a_type, std::shared_ptr<biased_owner> a_owner, Args &&...a_args )
+        : biased_control_block{ a_type, std::move(a_owner) }
+        , m_value( std::forward<Args>(a_args)... )
+    {
+        set_object(&m_value);
+    }
+
+private:
+
+    T m_value;
+};
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The owner record of the calling thread (null before its first biased object, and after its exit).
+///
+/// A trivially initialized thread local : the hot paths read it without initialization guard.
+inline biased_owner *&
+current_biased_owner() noexcept
+{
+    static thread_local biased_owner *s_current = nullptr;
+    return s_current;
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The thread local slot keeping the owner record of a thread, closed on the exit of the thread.
+struct biased_owner_slot
+{
+    biased_owner_slot()
+        : owner{ std::make_shared<biased_owner>() }
+    {
+        current_biased_owner() = owner.get();
+    }
+
+    ~biased_owner_slot()
+    {
+        current_biased_owner() = nullptr;// from now on, the objects of the thread are foreign to it
+        owner->close();
+    }
+
+    std::shared_ptr<biased_owner> owner;
+};
+
+}// EONS DETAIL
+
+//..............................................................................
+//..............................................................................
+
+// INLINES :
+
+inline std::shared_ptr<biased_owner> const &
+biased_owner::current()
+{
+    static thread_local detail::biased_owner_slot s_slot;
+    return s_slot.owner;
+}
+
+inline void
+biased_owner::collect() noexcept
+{
+    if ( !has_queued() )
+    {
+        return;
+    }
+    detail::biased_control_block *queued = nullptr;
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        queued = std::exchange(m_queued, nullptr);
+        m_has_queued.store(false, std::memory_order_relaxed);
+    }
+    while ( queued != nullptr )
+    {
+        auto *const block = std::exchange(queued, queued->m_next_queued);
+        block->collect();
+    }
+}
+
+inline void
+biased_owner::enqueue( detail::biased_control_block *a_block ) noexcept
+{
+    auto const keep = a_block->owner();// the last object may reference the record
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        if ( !m_closed )
+        {
+            a_block->m_next_queued = m_queued;
+            m_queued = a_block;
+            m_has_queued.store(true, std::memory_order_relaxed);
+            return;
+        }
+    }
+    // the owner thread has exited (its counts are visible through the lock) : merge out of the lock,
+    // the destroyed object may release other objects of the record
+    a_block->collect();
+}
+
+inline void
+biased_owner::close() noexcept
+{
+    detail::biased_control_block *queued = nullptr;
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        m_closed = true;// the next releases merge by themselves
+        queued = std::exchange(m_queued, nullptr);
+        m_has_queued.store(false, std::memory_order_relaxed);
+    }
+    while ( queued != nullptr )// out of the lock, as collect
+    {
+        auto *const block = std::exchange(queued, queued->m_next_queued);
+        block->collect();
+    }
+}
+
+//..............................................................................
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Merge the objects of the calling thread whose biased references were released by other threads.
+///
+/// Called by the biased factories : call it from the threads creating objects but rarely building new ones,
+/// to bound the delay of the destruction of the objects released by the other threads.
+inline void
+collect_biased_releases() noexcept
+{
+    if ( auto *const owner = detail::current_biased_owner() )
+    {
+        owner->collect();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::BIASED
+////////////////////////////////////////////////////////////////////////////////
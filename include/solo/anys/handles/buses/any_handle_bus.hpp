@@ -0,0 +1,273 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+/// @file
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Opt-in publish/subscribe bus dispatching handles by type (not included by the library packages).
+
+#include <solo/anys/handles/any_handle_core_package.hpp>
+#include <solo/anys/handles/details/check_any_handle_cast.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+class any_handle_bus;
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief A publish/subscribe bus : each published handle is delivered to the subscribers of its type.
+///
+/// The subscribers of a type are found with one hash lookup of the type fingerprint, read through the type information
+/// pointer stored by the handle (see @c any_handle::type_fingerprint), then checked once per message
+/// like @c any_handle_cast does. Each subscriber receives a borrowed <c>T const &</c> :
+/// the handle is neither copied nor cast per subscriber.
+/// Mutable and non-mutable handles of a type are delivered to the same subscribers.
+///
+/// Publishing a range resolves the subscribers once per run of messages of the same type,
+/// and delivers the run to each subscriber in turn (each subscriber receives the messages in order).
+///
+/// Example:
+///
+/// @code
+///     auto bus = solo::any_handle_bus{};
+///     bus.subscribe<Quote>( [&](Quote const &a_quote) { book.update(a_quote); } );
+///
+///     bus.publish( solo::make_any_handle<Quote>(stdex::in_place, "EURUSD", 1.0842) );
+/// @endcode
+///
+/// @note Publishing is reentrant (a subscriber may publish on the same bus),
+/// but the subscriptions must not change while a message is delivered : like a standard container,
+/// the bus is not synchronized.
+class any_handle_bus
+{
+public:
+
+    /// @brief The identifier of a subscription (never 0).
+    using subscription_id = std::uint64_t;
+
+    any_handle_bus() = default;
+
+    any_handle_bus( any_handle_bus const & ) = delete;
+    any_handle_bus &operator=( any_handle_bus const & ) = delete;
+
+    any_handle_bus( any_handle_bus && ) = default;
+    any_handle_bus &operator=( any_handle_bus && ) = default;
+
+    /// @brief Subscribe the given handler to the messages of type @c T.
+    /// @param a_handler A copyable callable taking a <c>T const &</c>.
+    /// @return The identifier of the subscription (see @c unsubscribe).
+    /// @throw @c std::invalid_argument if another subscribed type has the same fingerprint (hash collision of the type names).
+    template < typename T, typename Handler >
+    subscription_id subscribe( Handler &&a_handler );
+
+    /// @brief Cancel the given subscription.
+    /// @return false if there is no such subscription.
+    bool unsubscribe( subscription_id a_id ) noexcept;
+
+    /// @brief Return the number of subscribers to the messages of the type of the given index.
+    std::size_t subscriber_count( any_type_index const &a_type ) const noexcept;
+
+    /// @brief Deliver the given message to the subscribers of its type.
+    /// @return The number of deliveries (0 for an empty handle, a null pointer, or a type without subscriber).
+    /// @note The exceptions thrown by a subscriber are propagated (the next subscribers don't receive the message).
+    /// @note A lazy message is built before its delivery, as by a cast (the exceptions of its construction are propagated).
+    std::size_t publish( any_handle const &a_message ) const;
+
+    /// @brief Deliver the given messages to the subscribers of their types.
+    /// @return The number of deliveries.
+    template < typename ForwardIterator >
+    std::size_t publish( ForwardIterator a_first, ForwardIterator a_last ) const;
+
+private:
+
+    using deliver_function = std::function<void( void const *a_object )>;
+
+    struct subscriber
+    {
+        subscription_id id;
+        deliver_function deliver;
+    };
+
+    /// @brief The subscribers of one type.
+    struct topic
+    {
+        anys::detail::any_cast_target_type const *target;
+        std::vector<subscriber> subscribers;
+    };
+
+    static bool is_topic_type( topic const &a_topic, any_type_index const &a_type ) noexcept;
+
+    topic const *find_topic( any_handle const &a_message ) const noexcept;
+
+    std::unordered_map<any_type_index::fingerprint_type, topic> m_topics;
+    subscription_id m_last_id{0};
+};
+
+//..............................................................................
+//..............................................................................
+
+// INLINES :
+
+template < typename T, typename Handler >
+inline any_handle_bus::subscription_id
+any_handle_bus::subscribe( Handler &&a_handler )
+{
+    static_assert(!std::is_reference<T>::value && !std::is_const<T>::value && !std::is_volatile<T>::value,
+                  "any_handle_bus::subscribe<T>() : T must be a non cv-qualified object type");
+
+    auto const fingerprint = make_any_type_index<T>().fingerprint();
+    auto const *const target = &anys::detail::any_cast_target<T>();
+    auto &t = m_topics.emplace(fingerprint, topic{ target, {} }).first->second;
+    if ( !is_topic_type(t, make_any_type_index<T>()) )
+    {
+        throw std::invalid_argument{ "solo::any_handle_bus: type fingerprint collision between two subscribed types" };
+    }
+    t.subscribers.push_back( subscriber{
+        ++m_last_id,
+        [handler = std::forward<Handler>(a_handler)]( void const *a_object ) { handler( *static_cast<T const *>(a_object) ); } } );
+    return m_last_id;
+}
+
+inline bool
+any_handle_bus::unsubscribe( subscription_id a_id ) noexcept
+{
+    for ( auto it = m_topics.begin(); it != m_topics.end(); ++it )
+    {
+        auto &subscribers = it->second.subscribers;
+        for ( auto s = subscribers.begin(); s != subscribers.end(); ++s )
+        {
+            if ( s->id == a_id )
+            {
+                subscribers.erase(s);// keep the subscription order
+                if ( subscribers.empty() )
+                {
+                    m_topics.erase(it);
+                }
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+inline std::size_t
+any_handle_bus::subscriber_count( any_type_index const &a_type ) const noexcept
+{
+    auto const found = m_topics.find(a_type.fingerprint());
+    return found != m_topics.end() && is_topic_type(found->second, a_type) ? found->second.subscribers.size() : 0;
+}
+
+inline bool
+any_handle_bus::is_topic_type( topic const &a_topic, any_type_index const &a_type ) noexcept
+{
+#if SOLO_ANY_HANDLE_ENABLE_TYPE_FINGERPRINTS
+    return anys::detail::is_same_fingerprinted_type(*a_topic.target, a_type.fingerprint(), a_type.external_type_index());
+#else
+    return a_type.external_type_index() == *a_topic.target;
+#endif
+}
+
+inline any_handle_bus::topic const *
+any_handle_bus::find_topic( any_handle const &a_message ) const noexcept
+{
+    if ( a_message.get() == nullptr )// empty handle or null pointer
+    {
+        return nullptr;
+    }
+    auto const found = m_topics.find(a_message.type_fingerprint());
+    return found != m_topics.end() && anys::detail::is_any_handle_type(a_message, *found->second.target)
+        ? &found->second : nullptr;
+}
+
+inline std::size_t
+any_handle_bus::publish( any_handle const &a_message ) const
+{
+    auto const *const t = find_topic(a_message);
+    if ( t == nullptr )
+    {
+        return 0;
+    }
+    anys::detail::build_any_handle_object(a_message);// lazy message not cast yet
+    auto const *const object = a_message.get();
+    for ( auto const &s : t->subscribers )
+    {
+        s.deliver(object);
+    }
+    return t->subscribers.size();
+}
+
+template < typename ForwardIterator >
+inline std::size_t
+any_handle_bus::publish( ForwardIterator a_first, ForwardIterator a_last ) const
+{
+    static_assert(std::is_convertible<typename std::iterator_traits<ForwardIterator>::iterator_category, std::forward_iterator_tag>::value,
+                  "any_handle_bus::publish(first, last) : the messages are traversed once per subscriber");
+
+    auto deliveries = std::size_t{0};
+    while ( a_first != a_last )
+    {
+        auto const fingerprint = a_first->type_fingerprint();
+        auto const found = m_topics.find(fingerprint);
+        if ( found == m_topics.end() )
+        {
+            // no subscriber : skip the run of the messages of the same fingerprint
+            do { ++a_first; } while ( a_first != a_last && a_first->type_fingerprint() == fingerprint );
+            continue;
+        }
+
+        // the run of the messages of the subscribed type, checked once per message :
+        auto const &t = found->second;
+        auto run_last = a_first;
+        while ( run_last != a_last && anys::detail::is_any_handle_type(*run_last, *t.target) )
+        {
+            anys::detail::build_any_handle_object(*run_last);// lazy message not cast yet
+            ++run_last;
+        }
+        if ( run_last == a_first )// another type of the same fingerprint (hash collision)
+        {
+            ++a_first;
+            continue;
+        }
+        for ( auto const &s : t.subscribers )
+        {
+            for ( auto it = a_first; it != run_last; ++it )
+            {
+                if ( auto const *const object = it->get() )
+                {
+                    s.deliver(object);
+                    ++deliveries;
+                }
+            }
+        }
+        a_first = run_last;
+    }
+    return deliveries;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}// EONS SOLO
+////////////////////////////////////////////////////////////////////////////////
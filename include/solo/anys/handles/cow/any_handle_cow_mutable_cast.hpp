@@ -0,0 +1,61 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/any_handle_mutable_cast.hpp>
+#include <solo/anys/handles/details/check_any_handle_cast.hpp>
+#include <solo/anys/handles/pragmas/code_layout_hints.hpp>
+
+#include <memory>
+#include <type_traits>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace cow {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+template < typename T >
+any_handle_mutable_cast_result_type<T> any_handle_cow_mutable_cast( any_handle &a_handle );
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Cast the given copy-on-write handle to a typed shared pointer to its @em mutable object,
+/// after giving it its own copy of the object if the object is shared.
+/// @param a_handle The handle to cast : a copy-on-write handle (see @c make_any_handle_cow), or a mutable handle.
+/// @return The mutable object ; an error if the handle is empty, of another type, or neither copy-on-write nor mutable.
+/// @throw Whatever the copy of the object throws (the handle is then unchanged).
+///
+/// The other copies of the handle keep the original object. The casts of a handle owning its object are
+/// a use count load more than @c any_handle_mutable_cast : no copy.
+/// @note A mutable handle is cast as by @c any_handle_mutable_cast (in place, shared or not).
+/// @note The returned pointer is an owner of the object : cast again after having released it.
+/// @note Not thread-safe on the same handle object (as any of its modifications) ; the copies of the handle are independent.
+template < typename T >
+inline any_handle_mutable_cast_result_type<T>
+any_handle_cow_mutable_cast( any_handle &a_handle )
+{
+    static_assert(!std::is_const<T>::value, "a mutable object is not const");
+
+    if ( SOLO_LIKELY(anys::detail::is_any_handle_castable(a_handle, anys::detail::any_cast_target<T>(), mutability::false_))
+         && a_handle.unshare() )
+    {
+        // created non-const by make_any_handle_cow, and no other owner now
+        return std::shared_ptr<T>{ a_handle.pointer(), const_cast<T *>( static_cast<T const *>(a_handle.get()) ) };// aliasing
+    }
+    return any_handle_mutable_cast<T>(a_handle);// mutable handle, or the reason of the failure
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::COW
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,20 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+/// @file
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Opt-in copy-on-write handles (not included by the library packages).
+///
+/// - @c solo::anys::cow::make_any_handle_cow<T> : the factories, capturing the clone function of @c T in the type information,
+/// - @c solo::anys::cow::any_handle_cow_mutable_cast<T> : the mutable cast, copying the object first if it is shared,
+/// - @c any_handle::unshare : the same, untyped.
+
+#include <solo/anys/handles/cow/make_any_handle_cow.hpp>
+#include <solo/anys/handles/cow/any_handle_cow_mutable_cast.hpp>
@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/any_handle_core_package.hpp>
+#include <solo/anys/handles/any_type_tag.hpp>
+#include <solo/anys/handles/details/any_type_index_builder_t.hpp>
+#include <solo/anys/handles/details/make_owned_shared_t.hpp>
+
+#include <stdex/in_place_t.hpp>
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace cow {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+template < typename T, typename... Args >
+any_handle make_any_handle_cow( stdex::in_place_t, Args&&... a_type_constructor_arguments_list );
+
+template < typename T >
+any_handle make_any_handle_cow( std::shared_ptr<T> a_shared_pointer );
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+namespace detail {
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Copy the given object of type @c T into a new one (the clone function of the copy-on-write handles).
+template < typename T >
+inline std::shared_ptr<void>
+clone_cow_object( void const *a_object )
+{
+    return anys::detail::make_owned_shared<T,T>(mutability::false_, *static_cast<T const *>(a_object));
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Return the static copy-on-write type information of the type @c T (non-mutable, with its clone function).
+/// @note Equal to the non-mutable one of @c anys::detail::any_type_info_instances<T>() : the clone function is not compared.
+template < typename T >
+inline anys::detail::any_type_info const *
+cow_any_type_info_instance() noexcept
+{
+    static anys::detail::any_type_info const sti{ typeid(T), mutability::false_, any_type_tag<T>::value, false, &clone_cow_object<T> };
+    return &sti;
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Return a copy-on-write handle to the given non-null object.
+template < typename T >
+inline any_handle
+make_cow_handle( std::shared_ptr<T> &&a_shared_pointer )
+{
+    return anys::detail::any_handle_builder<void>{
+        any_type_index{
+            anys::details::any_type_index_builder{ std::experimental::make_observer(cow_any_type_info_instance<T>()) }
+        },
+        std::shared_ptr<void>{ std::move(a_shared_pointer) }
+    };
+}
+
+}// EONS DETAIL
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Build a copy-on-write handle to a new object of type @c T.
+///
+/// The handle is non-mutable (@c any_handle_cast, @c is_mutable, comparisons : it has the type of @c T) and its copies
+/// share the object ; @c any_handle_cow_mutable_cast gives the handle it is called on a private copy of the object
+/// first if the object is shared, then a mutable pointer to it. The clone function is captured by the type information.
+///
+/// Example:
+///
+/// @code
+///     auto shared = solo::anys::cow::make_any_handle_cow<Config>(stdex::in_place, ...);
+///     auto mine = shared;
+///     solo::anys::cow::any_handle_cow_mutable_cast<Config>(mine).assume_value()->verbose = true;// mine has a copy
+///     assert(mine.get() != shared.get());
+/// @endcode
+///
+/// @pre @c T is copy-constructible.
+template < typename T, typename... Args >
+inline any_handle
+make_any_handle_cow( stdex::in_place_t, Args&&... a_type_constructor_arguments_list )
+{
+    static_assert(!std::is_reference<T>::value, "T should not be a reference type");
+    static_assert(!std::is_const<T>::value && !std::is_volatile<T>::value, "T should not be cv-qualified");
+    static_assert(std::is_copy_constructible<T>::value, "T should be copy-constructible");
+
+    return detail::make_cow_handle( anys::detail::make_owned_shared<T,T>(mutability::false_, std::forward<Args>(a_type_constructor_arguments_list)...) );
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Build a copy-on-write handle to the given object (an empty handle if the pointer is null).
+/// @note The given pointer (and its copies) share the object with the handle : the handle copies it before its first mutation.
+/// @see The @c in_place_t overload.
+template < typename T >
+inline any_handle
+make_any_handle_cow( std::shared_ptr<T> a_shared_pointer )
+{
+    static_assert(!std::is_const<T>::value && !std::is_volatile<T>::value, "T should not be cv-qualified");
+    static_assert(std::is_copy_constructible<T>::value, "T should be copy-constructible");
+
+    return a_shared_pointer ? detail::make_cow_handle(std::move(a_shared_pointer)) : any_handle{};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::COW
+////////////////////////////////////////////////////////////////////////////////
@@ -11,12 +11,30 @@
 #include <solo/anys/handles/any_handle.hpp>
 #include <solo/anys/handles/make_any_type_index.hpp>
 
+#include <memory>
+#include <type_traits>
+
+/// @def SOLO_ANY_HANDLE_HAS_CONCEPTS
+/// @ingroup SoloAnyHandleDetail
+/// @brief Constrain the builders with concepts (C++20) instead of SFINAE.
+#if !defined(SOLO_ANY_HANDLE_HAS_CONCEPTS)
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+#define SOLO_ANY_HANDLE_HAS_CONCEPTS 1
+#else
+#define SOLO_ANY_HANDLE_HAS_CONCEPTS 0
+#endif
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 namespace solo { namespace anys { namespace detail {
 ////////////////////////////////////////////////////////////////////////////////
 
 // -- package :
 
+/// @ingroup SoloAnyHandleDetail
+template < typename U, typename V >
+struct is_any_handle_constructive;
+
 /// @ingroup SoloAnyHandleDetail
 template< typename T >
 struct any_handle_builder;
@@ -30,6 +48,58 @@ struct any_handle_builder<void>;
 
 // -- definition :
 
+/// @ingroup SoloAnyHandleDetail
+/// @brief Check that @c U type can build a shared pointer object convertible to @c std::shared_ptr<V> .
+///
+/// A namespace-scope trait (instead of a member template of @c any_handle_builder<T>) :
+/// it is only instantiated once per pair of types actually used.
+template < typename U, typename V >
+struct is_any_handle_constructive
+    : std::integral_constant<bool,
+           !std::is_reference<U>::value
+        && !std::is_volatile<U>::value
+        && !std::is_const<U>::value
+        && std::is_convertible<U*,V*>::value
+    >
+{};
+
+#if SOLO_ANY_HANDLE_HAS_CONCEPTS
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Concept version of @c is_any_handle_constructive (cheaper to check than SFINAE).
+template < typename U, typename V >
+concept any_handle_constructive =
+       !std::is_reference_v<U>
+    && !std::is_volatile_v<U>
+    && !std::is_const_v<U>
+    && std::is_convertible_v<U*,V*>;
+
+#endif// SOLO_ANY_HANDLE_HAS_CONCEPTS
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Specialize @c any_handle_builder for type @c void .
+///
+/// Not a template : every @c any_handle object is built here, from a type index and a type-erased pointer.
+/// The typed builders only compute these two arguments.
+template <>
+struct any_handle_builder<void>
+        : public any_handle
+{
+    any_handle_builder( any_type_index const &a_ti, std::shared_ptr<void> &&a_sp ) noexcept
+        : any_handle{ a_ti, std::move(a_sp) }
+    {}
+
+    any_handle_builder( std::shared_ptr<void> const &sp, mutability ismutable )
+        : any_handle{ make_any_type_index<void>(ismutable), sp}
+    {}
+
+    any_handle_builder( std::shared_ptr<void> &&sp, mutability ismutable )
+        : any_handle{ make_any_type_index<void>(ismutable), std::move(sp)}
+    {}
+};
+
+//..............................................................................
+
 /// @ingroup SoloAnyHandleDetail
 /// @brief An helper class to safely build an @c any_handle object
 /// from an already-built typed shared pointer.
@@ -38,12 +108,15 @@ struct any_handle_builder<void>;
 ///
 /// @see @c make_any_handle, @c make_any_handle_mutable
 ///
-/// @note We dont need to overload @c any_handle_builder constructors to move the given shared pointer
+/// @note We dont need to overload @c build functions to move the given shared pointer
 /// because the given shared pointer is @em always copied (through the cast operations to @c std::shared_ptr<void> ).
 ///
+/// Design rationale:
+/// - a class with static functions only (no constructor, no destructor to instantiate per type),
+/// - the type-erased construction is done by the non-template @c any_handle_builder<void>,
+/// - the overloads are constrained by a concept under C++20, by SFINAE otherwise.
 template< typename T >
 struct any_handle_builder
-        : public any_handle
 {
     /// @brief The underlying @c any_handle target type.
     ///
@@ -55,29 +128,6 @@ struct any_handle_builder
     /// @brief Check that this builder type can build a mutable handle.
     using is_mutable_type = std::integral_constant<bool,!std::is_const<std::remove_reference_t<T>>::value>;
 
-    /// @brief Check that @c U type can build a shared pointer object convertible to @c std::shared_ptr<value_type> .
-    template < typename U >
-    using is_type_constructive = std::integral_constant<bool,
-           !std::is_reference<U>::value
-        && !std::is_volatile<U>::value
-        && !std::is_const<U>::value
-        && std::is_convertible<U*,value_type*>::value
-    >;
-
-    /// @brief SFINAE helper.
-    template < typename U >
-    using enable_if_type_is_constructive_t = std::enable_if_t<
-        is_type_constructive<U>::value,
-        struct type_is_constructive
-    >;
-
-    /// @brief SFINAE helper.
-    template < typename U >
-    using enable_mutable_if_type_is_constructive_t = std::enable_if_t<
-        is_mutable_type::value && is_type_constructive<U>::value,
-        struct type_is_constructive
-    >;
-
     /// @brief Safely build a non-mutable @c any_handle object on an object of type @c value_type,
     /// copying an already-built typed shared pointer to a @em non-mutable object of type @c U,
     /// where @c U* is convertible to @c value_type* .
@@ -94,7 +144,7 @@ struct any_handle_builder
     ///     class Base {};
     ///     class Derived : public Base {};
     ///     auto sp = std::make_shared<const Derived>(...);
-    ///     auto result = any_handle_builder<Base>(sp);// <-- or any_handle_builder<const Base>
+    ///     auto result = any_handle_builder<Base>::build(sp);// <-- or any_handle_builder<const Base>
     ///     assert(result.type() == typeid(Base));
     ///     assert(result.is_mutable() == false);
     ///     auto sp2 = any_handle_cast<const Base>(result);// <-- could be any_handle_cast<Base>
@@ -102,15 +152,21 @@ struct any_handle_builder
     ///
     /// @endcode
     ///
+#if SOLO_ANY_HANDLE_HAS_CONCEPTS
+    template < typename U >
+        requires any_handle_constructive<U, value_type>
+#else
     template < typename U,
-               typename Enable = enable_if_type_is_constructive_t<U> >
-    any_handle_builder( std::shared_ptr<const U> const &a_sp )
-        : any_handle
+               typename Enable = std::enable_if_t<is_any_handle_constructive<U, value_type>::value> >
+#endif
+    static any_handle build( std::shared_ptr<const U> const &a_sp )
+    {
+        return any_handle_builder<void>
         {
             make_any_type_index<value_type>(mutability::false_), // the type we want to store (with non-mutable flag)
-            std::move(std::const_pointer_cast<void>(std::static_pointer_cast<const void>(a_sp)))// move the temporary
-        }
-    {}
+            std::const_pointer_cast<void>(std::static_pointer_cast<const void>(a_sp))
+        };
+    }
 
     /// @brief Safely build an @c any_handle object on an object of type @c value_type,
     /// copying an already-built typed shared pointer to a @em mutable object of type @c U,
@@ -119,8 +175,8 @@ struct any_handle_builder
     /// @param a_ismutable The desired mutability of the handled object.
     /// @pre U* must be convertible to @c value_type*.
     /// @note The resulting @c any_handle object stores the type information based on @c value_type, not @c U.
-	/// 
-	/// Example:
+    ///
+    /// Example:
     ///
     /// @code
     ///
@@ -129,48 +185,33 @@ struct any_handle_builder
     ///     class Base {};
     ///     class Derived : public Base {};
     ///     auto sp = std::make_shared<Derived>(...);// <-- must be mutable, even if the mutability value is false
-    ///     auto result = any_handle_builder<Base>(sp, mutability::false_);// <-- cannot be any_handle_builder<const Base>
+    ///     auto result = any_handle_builder<Base>::build(sp, mutability::false_);// <-- cannot be any_handle_builder<const Base>
     ///     assert(result.type() == typeid(Base));
     ///     assert(result.is_mutable() == false);
-    ///     auto result_value = any_handle_cast<const Base>(result);// <-- could be any_handle_cast<Base>
-    ///     static_assert(std::is_same_v<decltype(result_value),std::shared_ptr<const Base>>);
     ///
     ///     // Build a mutable any_handle object castable to type std::shared_ptr<Base> :
     ///
-    ///     auto result_m = any_handle_builder<Base>(sp_m, mutability::true_);// <-- cannot be any_handle_builder<const Base>
+    ///     auto result_m = any_handle_builder<Base>::build(sp_m, mutability::true_);// <-- cannot be any_handle_builder<const Base>
     ///     assert(result_m.type() == typeid(Base));
     ///     assert(result_m.is_mutable() == true);
-    ///     auto result_m_value_m = any_handle_mutable_cast<Base>(result_m);// <-- cannot be any_handle_mutable_cast<const Base>
-    ///     static_assert(std::is_same_v<decltype(result_m_value_m),std::shared_ptr<Base>>);
     ///
     /// @endcode
     ///
+#if SOLO_ANY_HANDLE_HAS_CONCEPTS
+    template < typename U >
+        requires ( is_mutable_type::value && any_handle_constructive<U, value_type> )
+#else
     template < typename U,
-               typename Enable = enable_mutable_if_type_is_constructive_t<U> >
-    any_handle_builder( std::shared_ptr<U> const &a_sp, mutability a_ismutable )
-        : any_handle
+               typename Enable = std::enable_if_t<is_mutable_type::value && is_any_handle_constructive<U, value_type>::value> >
+#endif
+    static any_handle build( std::shared_ptr<U> const &a_sp, mutability a_ismutable )
+    {
+        return any_handle_builder<void>
         {
             make_any_type_index<value_type>(a_ismutable), // the type we want to store (with the given mutability flag)
-            std::move(std::static_pointer_cast<void>(a_sp))// move the temporary
-        }
-    {}
-};
-
-//..............................................................................
-
-/// @ingroup SoloAnyHandleDetail
-/// @brief Specialize @c any_handle_builder for type @c void .
-template <>
-struct any_handle_builder<void>
-        : public any_handle
-{
-    any_handle_builder( std::shared_ptr<void> const &sp, mutability ismutable )
-        : any_handle{ make_any_type_index<void>(ismutable), sp}
-    {}
-
-    any_handle_builder( std::shared_ptr<void> &&sp, mutability ismutable )
-        : any_handle{ make_any_type_index<void>(ismutable), std::move(sp)}
-    {}
+            std::static_pointer_cast<void>(a_sp)
+        };
+    }
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -18,7 +18,6 @@ namespace solo { namespace anys { namespace details {
 
 // -- package :
 
-template < typename T >
 struct any_type_index_builder;
 
 //..............................................................................
@@ -27,14 +26,15 @@ struct any_type_index_builder;
 // -- definition :
 
 /// @ingroup SoloAnyHandleDetail
-/// @brief Build a <c>any_type_index</c>-based object from the given target type.
-template < typename T >
+/// @brief Build a <c>any_type_index</c>-based object from one of the static type informations.
+/// @note Not a template : the per-type work is limited to @c anys::detail::any_type_info_instances<T>()
+/// (see @c make_any_type_index).
 struct any_type_index_builder : any_type_index
 {
-    any_type_index_builder( mutability a_ismutable )
+    explicit any_type_index_builder( std::experimental::observer_ptr<anys::detail::any_type_info const> a_type_info_instance_ptr ) noexcept
         : any_type_index
           {
-              anys::detail::select_any_type_info_instance_ptr<T>(a_ismutable)
+              a_type_info_instance_ptr
           }
     {}
 };
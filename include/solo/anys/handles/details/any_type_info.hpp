@@ -8,7 +8,28 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+/// @def SOLO_ANY_HANDLE_ENABLE_TYPE_FINGERPRINTS
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Set to 1 to compare the types by their fingerprints (see @c any_type_index::fingerprint)
+/// instead of their builtin c++ type information, in the casts and in @c any_type_index::equals.
+///
+/// Enable it when handles cross shared libraries loaded with @c RTLD_LOCAL :
+/// there, the @c std::type_info objects of a type are duplicated and compared by name (@c strcmp).
+/// The casts are left with a single integer comparison, whichever binary built the handle
+/// (two for the types with internal linkage, whose names are not unique : see @c is_any_type_name_local).
+/// @note Every binary exchanging handles must be built with the same value.
+#if !defined(SOLO_ANY_HANDLE_ENABLE_TYPE_FINGERPRINTS)
+#define SOLO_ANY_HANDLE_ENABLE_TYPE_FINGERPRINTS 0
+#endif
+
+#include <solo/anys/handles/any_type_tag.hpp>
 #include <solo/anys/handles/mutability.hpp>
+#include <solo/anys/handles/pragmas/code_layout_hints.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
 #include <typeindex>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -19,34 +40,200 @@ namespace solo { namespace anys { namespace detail {
 
 struct any_type_info;
 
+std::uint64_t make_any_type_fingerprint( char const *a_name ) noexcept;
+
+bool is_any_type_name_local( char const *a_name ) noexcept;
+
+std::uint64_t make_any_type_ordering_key( std::uint64_t a_fingerprint, bool a_isnonempty, bool a_ismutable ) noexcept;
+
+std::uint64_t make_any_type_ordering_key( std::type_index const &a_eti, bool a_isnonempty, bool a_ismutable ) noexcept;
+
+std::uint64_t make_any_type_persistent_key( std::uint64_t a_fingerprint ) noexcept;
+
+template < typename T >
+std::uint64_t make_any_type_persistent_key() noexcept;
+
+bool is_same_fingerprinted_type( any_type_info const &a_type_info, std::uint64_t a_fingerprint, std::type_index const &a_type ) noexcept;
+
 //..............................................................................
 //..............................................................................
 
 // -- definition :
 
+/// @ingroup SoloAnyHandleDetail
+/// @brief Compute the fingerprint of a type from its name (or its tag).
+/// @return A 64-bit FNV-1a hash of the given name.
+/// @note Stable across runs and across shared libraries of the same build : it depends on the name only,
+/// whereas the identity of @c std::type_info objects may depend on the binary which owns them.
+inline std::uint64_t
+make_any_type_fingerprint( char const *a_name ) noexcept
+{
+    auto hash = std::uint64_t{ 14695981039346656037ull };// FNV-1a offset basis
+    for ( auto const *p = a_name; *p != '\0'; ++p )
+    {
+        hash ^= static_cast<unsigned char>(*p);
+        hash *= std::uint64_t{ 1099511628211ull };// FNV-1a prime
+    }
+    return hash;
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Return true if the given builtin type name may be shared by distinct types of the program.
+///
+/// The types with internal linkage are named after their translation unit by no compiler : the types of the
+/// anonymous namespaces (@c _GLOBAL__N_1 with g++ and clang, <c>`anonymous namespace'</c> with MSVC), and the
+/// local classes of the functions (the @c Z local names of the Itanium ABI, the <c>`function'::</c> scopes of MSVC),
+/// whose names repeat in every translation unit defining a function of the same name. Their fingerprints
+/// do not identify them : they are compared by their builtin type information too.
+/// @note Conservative : the local classes of the functions with external linkage are reported too, although unique,
+/// which only costs them the second comparison.
+inline bool
+is_any_type_name_local( char const *a_name ) noexcept
+{
+    if ( std::strstr(a_name, "_GLOBAL__N") != nullptr || std::strchr(a_name, '`') != nullptr )
+    {
+        return true;
+    }
+    if ( std::strchr(a_name, ' ') != nullptr || std::strchr(a_name, ':') != nullptr )// a readable name (MSVC)
+    {
+        return false;
+    }
+    auto const is_digit = []( char c ) { return c >= '0' && c <= '9'; };
+    auto const is_upper = []( char c ) { return c >= 'A' && c <= 'Z'; };
+    for ( auto const *p = a_name; *p != '\0'; )
+    {
+        if ( is_digit(*p) )// <length><identifier> : skipped
+        {
+            auto length = std::size_t{0};
+            for ( ; is_digit(*p); ++p )
+            {
+                length = length * 10 + static_cast<std::size_t>(*p - '0');
+            }
+            for ( ; length != 0 && *p != '\0'; --length, ++p ) {}
+        }
+        else if ( *p == 'Z' )// <local-name>
+        {
+            return true;
+        }
+        else if ( ( *p == 'S' || *p == 'T' || *p == 'A' ) && ( is_digit(p[1]) || is_upper(p[1]) || p[1] == '_' ) )
+        {
+            for ( ++p; is_digit(*p) || is_upper(*p); ++p ) {}// <substitution>, <template-param>, <array-type> : S12_, T_, A4_
+        }
+        else if ( *p == 'L' && p[1] >= 'a' && p[1] <= 'z' )// <expr-primary> : Li42E
+        {
+            for ( p += 2; *p == 'n' || is_digit(*p); ++p ) {}
+        }
+        else
+        {
+            ++p;
+        }
+    }
+    return false;
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Compute the ordering key of a type information.
+/// @return The fingerprint in the high 62 bits, the emptiness flag in bit 1 and the mutability flag in bit 0.
+inline std::uint64_t
+make_any_type_ordering_key( std::uint64_t a_fingerprint, bool a_isnonempty, bool a_ismutable ) noexcept
+{
+    return ( a_fingerprint << 2 )
+        | ( a_isnonempty ? std::uint64_t{2} : std::uint64_t{0} )
+        | ( a_ismutable ? std::uint64_t{1} : std::uint64_t{0} );
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Compute the ordering key of a type information from the builtin c++ type name (untagged types).
+inline std::uint64_t
+make_any_type_ordering_key( std::type_index const &a_eti, bool a_isnonempty, bool a_ismutable ) noexcept
+{
+    return make_any_type_ordering_key( make_any_type_fingerprint(a_eti.name()), a_isnonempty, a_ismutable );
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Compute the key identifying a type in the files written by the library (snapshots, mapped regions)
+/// from its fingerprint (see @c any_type_index::fingerprint).
+///
+/// The ordering key of the non-mutable @c any_type_index of the type : a hash of its tag (see @c any_type_tag)
+/// or of its name, stable across runs of the same build (and across builds for the tagged types).
+inline std::uint64_t
+make_any_type_persistent_key( std::uint64_t a_fingerprint ) noexcept
+{
+    return make_any_type_ordering_key(a_fingerprint, true, false);
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Compute the key identifying the type @c T in the files written by the library.
+/// @see @c make_any_type_persistent_key(std::uint64_t).
+template < typename T >
+inline std::uint64_t
+make_any_type_persistent_key() noexcept
+{
+    using type = std::remove_cv_t<T>;
+    auto const *const tag = any_type_tag<type>::value;
+    return make_any_type_persistent_key( make_any_type_fingerprint(tag != nullptr ? tag : typeid(type).name()) );
+}
+
+//..............................................................................
+
 /// @ingroup SoloAnyHandleDetail
 /// @class any_type_info
 /// @brief Wrap @c std::type_info runtime type information with additional
 /// emptyness and mutability information.
+///
+/// The fingerprint and the ordering key are computed once, when the static instance is built :
+/// comparing or ordering type informations costs a single integer comparison.
 struct any_type_info
 {
-    constexpr explicit any_type_info( std::type_index const &a_eti, mutability a_ismutable ) noexcept
+    /// @brief The function copying a handled object into a new one (see @c make_any_handle_cow).
+    using clone_function = std::shared_ptr<void> (*)( void const *a_object );
+
+    /// @param a_tag The user tag of the type (see @c any_type_tag), or @c nullptr to use the type name.
+    /// @param a_islazy True for the type informations of the lazy handles (see @c make_any_handle_lazy).
+    /// @param a_clone The clone function of the copy-on-write handles (see @c make_any_handle_cow), @c nullptr otherwise.
+    explicit any_type_info( std::type_index const &a_eti, mutability a_ismutable, char const *a_tag = nullptr, bool a_islazy = false,
+                            clone_function a_clone = nullptr ) noexcept
         : m_external_type_index{ a_eti }// noexcept
         , m_mutable_flag{ mutability_as_boolean(a_ismutable) }
         , m_nonempty_flag{ true }
+        , m_lazy_flag{ a_islazy }
+        , m_clone{ a_clone }
+        , m_fingerprint{ make_any_type_fingerprint(a_tag != nullptr ? a_tag : a_eti.name()) }
+        , m_ordering_key{ make_any_type_ordering_key(m_fingerprint, true, mutability_as_boolean(a_ismutable)) }
+        , m_local_flag{ a_tag == nullptr && is_any_type_name_local(a_eti.name()) }
     {}
 
      any_type_info() noexcept
         : m_external_type_index{ typeid(void) }// noexcep
         , m_mutable_flag{ false }
         , m_nonempty_flag{ false }
+        , m_lazy_flag{ false }
+        , m_clone{ nullptr }
+        , m_fingerprint{ make_any_type_fingerprint(typeid(void).name()) }
+        , m_ordering_key{ make_any_type_ordering_key(m_fingerprint, false, false) }
+        , m_local_flag{ false }
     {}
 
     const std::type_index m_external_type_index;
     const bool m_mutable_flag;
     const bool m_nonempty_flag;
+    const bool m_lazy_flag;// not compared : a lazy handle has the type of its object
+    const clone_function m_clone;// not compared : a copy-on-write handle has the type of its object
+    const std::uint64_t m_fingerprint;
+    const std::uint64_t m_ordering_key;
+    const bool m_local_flag;// the fingerprint may be shared by distinct types (see is_any_type_name_local)
 };
 
+/// @ingroup SoloAnyHandleDetail
+/// @brief Return true if the given fingerprint and builtin type information are the ones of the given type information :
+/// a single integer comparison, but for the types whose names are not unique (see @c is_any_type_name_local).
+inline bool
+is_same_fingerprinted_type( any_type_info const &a_type_info, std::uint64_t a_fingerprint, std::type_index const &a_type ) noexcept
+{
+    return a_fingerprint == a_type_info.m_fingerprint
+        && ( SOLO_LIKELY(!a_type_info.m_local_flag) || a_type == a_type_info.m_external_type_index );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 }}}// EONS SOLO::ANYS::DETAIL
 ////////////////////////////////////////////////////////////////////////////////
@@ -8,8 +8,10 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+#include <solo/anys/handles/any_type_tag.hpp>
 #include <solo/anys/handles/details/any_type_info.hpp>
 #include <experimental/memory>
+#include <type_traits>
 
 ////////////////////////////////////////////////////////////////////////////////
 namespace solo { namespace anys { namespace detail {
@@ -17,6 +19,10 @@ namespace solo { namespace anys { namespace detail {
 
 // -- package :
 
+template < typename T >
+any_type_info const *
+any_type_info_instances() noexcept;
+
 template < typename T, mutability IsMutable >
 std::experimental::observer_ptr<any_type_info const>
 any_type_info_instance_ptr() noexcept;
@@ -26,6 +32,24 @@ any_type_info_instance_ptr() noexcept;
 
 // -- definition :
 
+/// @ingroup SoloAnyHandleDetail
+/// @brief Return the two static @c any_type_info objects associated with the type @c T :
+/// the non-mutable one (at index 0) and the mutable one (at index 1).
+/// @post Return non-empty type informations.
+/// @note Both flavours share a single function-local static (and a single guard variable) per type :
+/// this is the only per-type data of the library.
+/// Callers should instantiate it with a plain type (no cv-qualifier), since @c typeid ignores cv-qualifiers.
+template < typename T >
+inline any_type_info const *
+any_type_info_instances() noexcept
+{
+    static any_type_info const stis[2] = {
+        any_type_info{ typeid(T), mutability::false_, any_type_tag<T>::value },
+        any_type_info{ typeid(T), mutability::true_, any_type_tag<T>::value }
+    };
+    return stis;
+}
+
 /// @ingroup SoloAnyHandleDetail
 /// @brief Return a non-mutable reference to the static @c any_handle_info_wrapper
 /// object associated with the template parameters.
@@ -34,16 +58,7 @@ template < typename T, mutability IsMutable = mutability::false_ >
 inline std::experimental::observer_ptr<any_type_info const>
 any_type_info_instance_ptr() noexcept
 {
-    // @c std::decay<T> : applies lvalue-to-rvalue, array-to-pointer, and function-to-pointer
-    // implicit conversions to the type T, removes cv-qualifiers,
-    // and defines the resulting type as the member typedef type.
-    //
-    // Formally:
-    // - If T names the type "array of U" or "reference to array of U", the member typedef type is U*.
-    // - If T is a function type F or a reference thereto, the member typedef type is @c std::add_pointer<F>::type.
-    // - Otherwise, the member typedef type is @c std::remove_cv<std::remove_reference<T>::type>::type.
-    static auto const sti = any_type_info{ typeid(T), IsMutable };
-    return std::experimental::make_observer(&sti);
+    return std::experimental::make_observer( any_type_info_instances<std::remove_cv_t<T>>() + ( mutability_as_boolean(IsMutable) ? 1 : 0 ) );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
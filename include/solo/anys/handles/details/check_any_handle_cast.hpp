@@ -0,0 +1,189 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/any_handle.hpp>
+#include <solo/anys/handles/any_type_index_comparison_operators.hpp>
+#include <solo/anys/handles/details/any_type_info_instance_t.hpp>
+#include <solo/anys/handles/details/lazy_object_header.hpp>
+#include <solo/anys/handles/errors/any_handle_cast_errc.hpp>
+#include <solo/anys/handles/pragmas/code_layout_hints.hpp>
+
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace detail {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+#if SOLO_ANY_HANDLE_ENABLE_TYPE_FINGERPRINTS
+using any_cast_target_type = any_type_info;
+#else
+using any_cast_target_type = std::type_info;
+#endif
+
+template < typename T >
+any_cast_target_type const &any_cast_target() noexcept;
+
+std::type_index any_cast_target_type_index( any_cast_target_type const &a_target_type ) noexcept;
+
+inline bool
+is_any_handle_cast_valid( any_handle const &a_handle, any_cast_target_type const &a_target_type, mutability a_ismutable ) noexcept;
+
+bool is_any_handle_built( any_handle const &a_handle ) noexcept;
+
+void build_any_handle_object( any_handle const &a_handle );
+
+inline bool
+is_any_handle_castable( any_handle const &a_handle, any_cast_target_type const &a_target_type, mutability a_ismutable ) noexcept;
+
+// check_any_handle_cast : declared by its definition only (GCC rejects 'noinline' on a redeclared inline function).
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The type information the casts compare the handled type with :
+/// the static @c any_type_info of @c T when @c SOLO_ANY_HANDLE_ENABLE_TYPE_FINGERPRINTS is set
+/// (its precomputed fingerprint), @c typeid(T) otherwise.
+template < typename T >
+inline any_cast_target_type const &
+any_cast_target() noexcept
+{
+#if SOLO_ANY_HANDLE_ENABLE_TYPE_FINGERPRINTS
+    return *any_type_info_instances<std::remove_cv_t<T>>();
+#else
+    return typeid(T);
+#endif
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The builtin c++ type information of a cast target (reported by @c bad_any_handle_cast).
+inline std::type_index
+any_cast_target_type_index( any_cast_target_type const &a_target_type ) noexcept
+{
+#if SOLO_ANY_HANDLE_ENABLE_TYPE_FINGERPRINTS
+    return a_target_type.m_external_type_index;
+#else
+    return std::type_index{ a_target_type };
+#endif
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Return true if the handled type is the given target type (one integer comparison with fingerprints,
+/// but for the types with internal linkage : see @c is_same_fingerprinted_type).
+inline bool
+is_any_handle_type( any_handle const &a_handle, any_cast_target_type const &a_target_type ) noexcept
+{
+#if SOLO_ANY_HANDLE_ENABLE_TYPE_FINGERPRINTS
+    return is_same_fingerprinted_type(a_target_type, a_handle.type_fingerprint(), a_handle.type());
+#else
+    return a_handle.type() == a_target_type;
+#endif
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Check whether the type and the mutability of the given handle allow a cast to the given target type
+/// (whether its object is built or not).
+/// @param a_handle The type-erased handle to cast.
+/// @param a_target_type The target type of the cast.
+/// @param a_ismutable True for a mutable cast (the handle must be mutable).
+inline bool
+is_any_handle_cast_valid( any_handle const &a_handle, any_cast_target_type const &a_target_type, mutability a_ismutable ) noexcept
+{
+    return !a_handle.empty()
+        && is_any_handle_type(a_handle, a_target_type)
+        && ( !mutability_as_boolean(a_ismutable) || a_handle.is_mutable() );
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Return true if the object of the given handle is built : always but for a lazy handle not cast yet
+/// (see @c make_any_handle_lazy).
+/// @note One flag test for the eager handles, on the type information the cast has just read.
+inline bool
+is_any_handle_built( any_handle const &a_handle ) noexcept
+{
+    return SOLO_LIKELY(!a_handle.is_lazy())
+        || a_handle.get() == nullptr// moved from : nothing to build
+        || is_lazy_object_built(a_handle.get());
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Build the object of the given handle if it is a lazy handle not cast yet.
+/// @throw Whatever the construction throws : the object is left unbuilt, and the next cast retries.
+inline void
+build_any_handle_object( any_handle const &a_handle )
+{
+    if ( !is_any_handle_built(a_handle) )
+    {
+        build_lazy_object(a_handle.get());// cold
+    }
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The success path of the casts : check whether the given handle can be cast to the given target type,
+/// and whether its object is built.
+/// @param a_handle The type-erased handle to cast.
+/// @param a_target_type The target type of the cast.
+/// @param a_ismutable True for a mutable cast (the handle must be mutable).
+/// @note Inlined in every cast : the reason of a failure, and the construction of a lazy object, are left to
+/// @c check_any_handle_cast out of line.
+inline bool
+is_any_handle_castable( any_handle const &a_handle, any_cast_target_type const &a_target_type, mutability a_ismutable ) noexcept
+{
+    return is_any_handle_cast_valid(a_handle, a_target_type, a_ismutable)
+        && is_any_handle_built(a_handle);
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Check whether the given handle can be cast to the given target type.
+/// @param a_handle The type-erased handle to cast.
+/// @param a_target_type The target type of the cast.
+/// @param a_ismutable True for a mutable cast (the handle must be mutable).
+/// @return @c any_handle_cast_errc::undefined if the cast is valid, the reason of the failure otherwise.
+/// A valid lazy handle not cast yet builds its object here (@c any_handle_cast_errc::failed_source_construction if it throws).
+/// @note Not a template : the checks are shared by all the @c any_handle_cast<T> and @c any_handle_mutable_cast<T> instances,
+/// which are left with the pointer cast only.
+/// @note Cold and never inlined : the casts call it on their failure path only (see @c is_any_handle_castable).
+SOLO_COLD SOLO_NOINLINE inline errors::any_handle_cast_errc
+check_any_handle_cast( any_handle const &a_handle, any_cast_target_type const &a_target_type, mutability a_ismutable ) noexcept
+{
+    using errors::any_handle_cast_errc;
+
+    if ( a_handle.empty() )// nothrow
+    {
+        return any_handle_cast_errc::empty_source;
+    }
+    if ( !is_any_handle_type(a_handle, a_target_type) )// nothrow
+    {
+        return any_handle_cast_errc::bad_source_type;
+    }
+    if ( mutability_as_boolean(a_ismutable) && not a_handle.is_mutable() )// nothrow
+    {
+        return any_handle_cast_errc::bad_source_mutability;
+    }
+    try
+    {
+        build_any_handle_object(a_handle);
+    }
+    catch ( ... )
+    {
+        return any_handle_cast_errc::failed_source_construction;// left unbuilt : the next cast retries
+    }
+    return any_handle_cast_errc::undefined;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::DETAIL
+////////////////////////////////////////////////////////////////////////////////
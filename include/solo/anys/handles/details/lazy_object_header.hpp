@@ -0,0 +1,81 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/pragmas/code_layout_hints.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace detail {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+struct lazy_object_header;
+
+bool is_lazy_object_built( void const *a_object ) noexcept;
+
+void build_lazy_object( void const *a_object );
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The header of a lazy object, placed right before its storage (see @c make_any_handle_lazy).
+///
+/// A handle only stores the address of the storage : the header is found at a fixed offset,
+/// whatever the type of the object and of its factory.
+struct lazy_object_header
+{
+    /// @brief Set once the object is built (release), checked by every access (acquire).
+    std::atomic<bool> m_built{ false };
+
+    /// @brief Build the object exactly once (the factory synchronizes the concurrent first casts).
+    /// @throw Whatever the construction throws (the object is then left unbuilt).
+    void (*m_build)( void *a_block );
+
+    /// @brief The block holding the object and its factory, given to @c m_build.
+    void *m_block;
+
+    /// @brief Return the header of the lazy object stored at the given address.
+    static lazy_object_header &of( void const *a_object ) noexcept
+    {
+        // through an integer : the handled objects of the eager handles are not seen as indexed out of their bounds (-Wstringop-overflow)
+        return *reinterpret_cast<lazy_object_header *>( reinterpret_cast<std::uintptr_t>(a_object) - sizeof(lazy_object_header) );
+    }
+};
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Return true if the lazy object stored at the given address is built (a single acquire load).
+inline bool
+is_lazy_object_built( void const *a_object ) noexcept
+{
+    return lazy_object_header::of(a_object).m_built.load(std::memory_order_acquire);
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Build the lazy object stored at the given address, unless already built.
+/// @throw Whatever the construction throws : the object is left unbuilt, and the next call retries.
+inline void
+build_lazy_object( void const *a_object )
+{
+    auto &header = lazy_object_header::of(a_object);
+    if ( SOLO_UNLIKELY(!header.m_built.load(std::memory_order_acquire)) )
+    {
+        header.m_build(header.m_block);// cold
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::DETAIL
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,258 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+/// @def SOLO_ANY_HANDLE_ENABLE_TRACKING
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Set to 1 to register the objects owned by @c any_handle objects into the live handle table.
+/// @see @c solo::anys::tracking::live_handle_snapshot.
+#if !defined(SOLO_ANY_HANDLE_ENABLE_TRACKING)
+#define SOLO_ANY_HANDLE_ENABLE_TRACKING 0
+#endif
+
+#include <solo/anys/handles/mutability.hpp>
+
+#if SOLO_ANY_HANDLE_ENABLE_TRACKING
+#include <solo/anys/handles/tracking/live_handle_table.hpp>
+#endif
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace detail {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+template < typename T, typename U, typename... Args >
+std::shared_ptr<T> make_owned_shared( mutability a_ismutable, Args&&... a_type_constructor_arguments_list );
+
+template < typename T, typename U, typename Alloc, typename... Args >
+std::shared_ptr<T> make_owned_allocated_shared( Alloc const &a_allocator, mutability a_ismutable, Args&&... a_type_constructor_arguments_list );
+
+template < typename T, typename F >
+std::shared_ptr<T> make_owned_shared_with_finalizer( T *a_raw_pointer, F &&a_callable_finalizer, mutability a_ismutable );
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+#if SOLO_ANY_HANDLE_ENABLE_TRACKING
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief An allocator adaptor which allocates the tracking record of an object of type @c U
+/// together with the shared pointer's control block (and the object), in the same block.
+///
+/// Used with @c std::allocate_shared<U>, the shared pointer still owns a @c U (so that
+/// @c std::enable_shared_from_this<U> is honoured). The record is linked into the live handle table
+/// when the block is allocated and unlinked when it is deallocated : like the storage of any object built by
+/// @c std::make_shared, until the last weak reference is released.
+/// @tparam T The value type (the control block type once rebound by @c std::allocate_shared).
+/// @tparam U The type of the tracked object.
+/// @tparam Alloc The allocator of the blocks (rebound to a unit holding one @c T and its record).
+template < typename T, typename U, typename Alloc >
+class tracking_allocator
+{
+    template < typename, typename, typename > friend class tracking_allocator;
+
+    using record_type = tracking::live_handle_record;
+
+    /// @brief The offset of the record after @c a_count objects of type @c T.
+    static constexpr std::size_t record_offset( std::size_t a_count ) noexcept
+    {
+        return ( a_count * sizeof(T) + alignof(record_type) - 1 ) / alignof(record_type) * alignof(record_type);
+    }
+
+    /// @brief The allocation unit : one @c T followed by its record (a single unit for @c std::allocate_shared).
+    struct alignas(T) alignas(record_type) block_type
+    {
+        unsigned char bytes[record_offset(1) + sizeof(record_type)];
+    };
+
+    using block_allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<block_type>;
+    using block_traits = std::allocator_traits<block_allocator_type>;
+
+    static constexpr std::size_t block_count( std::size_t a_count ) noexcept
+    {
+        return ( record_offset(a_count) + sizeof(record_type) + sizeof(block_type) - 1 ) / sizeof(block_type);
+    }
+
+public:
+
+    using value_type = T;
+
+    tracking_allocator( Alloc const &a_allocator, mutability a_ismutable ) noexcept
+        : m_allocator{ a_allocator }
+        , m_ismutable{ a_ismutable }
+    {}
+
+    template < typename V >
+    tracking_allocator( tracking_allocator<V,U,Alloc> const &another ) noexcept
+        : m_allocator{ another.m_allocator }
+        , m_ismutable{ another.m_ismutable }
+    {}
+
+    T *allocate( std::size_t a_count )
+    {
+        auto allocator = block_allocator_type{ m_allocator };
+        auto *const block = block_traits::allocate(allocator, block_count(a_count));
+        auto *const bytes = reinterpret_cast<unsigned char *>(std::addressof(*block));
+        auto *const record = ::new ( bytes + record_offset(a_count) ) record_type{ typeid(U), sizeof(U), m_ismutable };
+        tracking::live_handle_table_instance().insert(*record);
+        return reinterpret_cast<T *>(bytes);
+    }
+
+    void deallocate( T *a_objects, std::size_t a_count ) noexcept
+    {
+        auto *const bytes = reinterpret_cast<unsigned char *>(a_objects);
+        auto *const record = reinterpret_cast<record_type *>(bytes + record_offset(a_count));
+        tracking::live_handle_table_instance().erase(*record);
+        record->~record_type();
+        auto allocator = block_allocator_type{ m_allocator };
+        block_traits::deallocate(allocator, reinterpret_cast<block_type *>(bytes), block_count(a_count));
+    }
+
+    template < typename V >
+    bool operator==( tracking_allocator<V,U,Alloc> const &another ) const noexcept
+    {
+        return m_allocator == another.m_allocator;
+    }
+
+    template < typename V >
+    bool operator!=( tracking_allocator<V,U,Alloc> const &another ) const noexcept
+    {
+        return !( *this == another );
+    }
+
+private:
+
+    Alloc m_allocator;
+    mutability m_ismutable;
+};
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief A finalizer wrapper which unregisters the finalized object from the live handle table.
+///
+/// The record is linked only once the wrapper has been stored into the shared pointer's control block
+/// (see @c arm), so that the copies made by @c std::shared_ptr constructors are never linked.
+template < typename T, typename F >
+struct tracked_finalizer
+{
+    tracked_finalizer( F &&a_callable_finalizer, mutability a_ismutable )
+        : m_finalizer{ std::forward<F>(a_callable_finalizer) }
+        , m_record{ typeid(T), sizeof(T), a_ismutable }
+    {}
+
+    tracked_finalizer( tracked_finalizer const &another )
+        : m_finalizer{ another.m_finalizer }
+        , m_record{ another.m_record.type(), another.m_record.size(), static_cast<mutability>(another.m_record.is_mutable()) }
+    {}
+
+    ~tracked_finalizer()
+    {
+        if ( m_armed )
+        {
+            tracking::live_handle_table_instance().erase(m_record);
+        }
+    }
+
+    void arm() noexcept
+    {
+        tracking::live_handle_table_instance().insert(m_record);
+        m_armed = true;
+    }
+
+    void operator()( T *a_raw_pointer )
+    {
+        if ( m_armed )
+        {
+            tracking::live_handle_table_instance().erase(m_record);
+            m_armed = false;
+        }
+        m_finalizer(a_raw_pointer);
+    }
+
+    std::decay_t<F> m_finalizer;
+    tracking::live_handle_record m_record;
+    bool m_armed{ false };
+};
+
+#endif// SOLO_ANY_HANDLE_ENABLE_TRACKING
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Build @em in-place an object of type @c U owned by a shared pointer of type @c T.
+/// @param a_ismutable The mutability of the handle which will own the object (tracking information only).
+/// @pre @c U* is convertible to @c T*.
+/// @note Equivalent to <c>std::make_shared<U>(args...)</c> unless @c SOLO_ANY_HANDLE_ENABLE_TRACKING is set to 1:
+/// then the object is allocated by @c std::allocate_shared together with a @c live_handle_record (see
+/// @c tracking_allocator), registered into the live handle table until its storage is released.
+template < typename T, typename U, typename... Args >
+inline std::shared_ptr<T>
+make_owned_shared( mutability a_ismutable, Args&&... a_type_constructor_arguments_list )
+{
+#if SOLO_ANY_HANDLE_ENABLE_TRACKING
+    using value_type = std::remove_cv_t<U>;
+    using allocator_type = tracking_allocator<value_type, value_type, std::allocator<value_type>>;
+    return std::allocate_shared<value_type>( allocator_type{ std::allocator<value_type>{}, a_ismutable }, std::forward<Args>(a_type_constructor_arguments_list)... );
+#else
+    (void)a_ismutable;
+    return std::make_shared<U>( std::forward<Args>(a_type_constructor_arguments_list)... );
+#endif
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Build @em in-place an object of type @c U owned by a shared pointer of type @c T,
+/// allocating the control block and the object with the given allocator.
+/// @param a_allocator The allocator to use (rebound by @c std::allocate_shared).
+/// @param a_ismutable The mutability of the handle which will own the object (tracking information only).
+/// @pre @c U* is convertible to @c T*.
+/// @note Equivalent to <c>std::allocate_shared<U>(alloc, args...)</c> unless @c SOLO_ANY_HANDLE_ENABLE_TRACKING is set to 1.
+/// @see @c make_owned_shared.
+template < typename T, typename U, typename Alloc, typename... Args >
+inline std::shared_ptr<T>
+make_owned_allocated_shared( Alloc const &a_allocator, mutability a_ismutable, Args&&... a_type_constructor_arguments_list )
+{
+#if SOLO_ANY_HANDLE_ENABLE_TRACKING
+    using value_type = std::remove_cv_t<U>;
+    using allocator_type = tracking_allocator<value_type, value_type, Alloc>;
+    return std::allocate_shared<value_type>( allocator_type{ a_allocator, a_ismutable }, std::forward<Args>(a_type_constructor_arguments_list)... );
+#else
+    (void)a_ismutable;
+    return std::allocate_shared<U>( a_allocator, std::forward<Args>(a_type_constructor_arguments_list)... );
+#endif
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Own an already-built object of type @c T through a shared pointer with a customized finalizer.
+/// @param a_ismutable The mutability of the handle which will own the object (tracking information only).
+/// @note Equivalent to <c>std::shared_ptr<T>{p, f}</c> unless @c SOLO_ANY_HANDLE_ENABLE_TRACKING is set to 1:
+/// then the object is registered into the live handle table until the finalizer is called.
+template < typename T, typename F >
+inline std::shared_ptr<T>
+make_owned_shared_with_finalizer( T *a_raw_pointer, F &&a_callable_finalizer, mutability a_ismutable )
+{
+#if SOLO_ANY_HANDLE_ENABLE_TRACKING
+    using finalizer_type = tracked_finalizer<T,F>;
+    auto output = std::shared_ptr<T>{ a_raw_pointer, finalizer_type{ std::forward<F>(a_callable_finalizer), a_ismutable } };
+    std::get_deleter<finalizer_type>(output)->arm();// the finalizer now lives in the control block
+    return output;
+#else
+    (void)a_ismutable;
+    return std::shared_ptr<T>{ a_raw_pointer, std::forward<F>(a_callable_finalizer) };
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::DETAIL
+////////////////////////////////////////////////////////////////////////////////
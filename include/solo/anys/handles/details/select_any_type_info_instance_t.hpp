@@ -20,6 +20,9 @@ namespace solo { namespace anys { namespace detail {
 
 // -- package:
 
+std::experimental::observer_ptr<any_type_info const>
+select_any_type_info_instance( any_type_info const *a_instances, bool a_ismutable ) noexcept;
+
 template < typename T >
 std::experimental::observer_ptr<any_type_info const>
 select_any_type_info_instance_ptr( mutability a_ismutable ) noexcept;
@@ -29,6 +32,18 @@ select_any_type_info_instance_ptr( mutability a_ismutable ) noexcept;
 
 // -- definition :
 
+/// @ingroup SoloAnyHandleDetail
+/// @brief Select, among the two instances returned by @c any_type_info_instances<T>(),
+/// the one matching the given mutability flag.
+/// @param a_instances The result of @c any_type_info_instances<T>().
+/// @param a_ismutable The mutability selector.
+/// @note Not a template : shared by all types.
+inline std::experimental::observer_ptr<any_type_info const>
+select_any_type_info_instance( any_type_info const *a_instances, bool a_ismutable ) noexcept
+{
+    return std::experimental::make_observer( a_instances + ( a_ismutable ? 1 : 0 ) );
+}
+
 /// @ingroup SoloAnyHandleDetail
 /// @brief Select the static @c any_handle_info_wrapper matching the given mutability flag.
 /// @param a_ismutable The mutability selector.
@@ -40,9 +55,9 @@ template < typename T >
 inline std::experimental::observer_ptr<any_type_info const>
 select_any_type_info_instance_ptr( mutability a_ismutable ) noexcept
 {
-    return ( ( a_ismutable == mutability::true_ ) && !( std::is_const<T>::value ) ) ?
-            any_type_info_instance_ptr<T,mutability::true_>() :
-            any_type_info_instance_ptr<T,mutability::false_>();
+    return select_any_type_info_instance(
+        any_type_info_instances<std::remove_cv_t<T>>(),
+        ( a_ismutable == mutability::true_ ) && !( std::is_const<T>::value ) );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -8,7 +8,11 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+#include <solo/anys/handles/details/check_any_handle_cast.hpp>
 #include <solo/anys/handles/exceptions/bad_any_handle_cast.hpp>
+#include <solo/anys/handles/pragmas/code_layout_hints.hpp>
+
+#include <typeinfo>
 
 ////////////////////////////////////////////////////////////////////////////////
 namespace solo { namespace anys { namespace detail {
@@ -16,6 +20,10 @@ namespace solo { namespace anys { namespace detail {
 
 // -- forward declaration :
 
+// throw_any_handle_cast_exception( any_handle const &, any_cast_target_type const &, mutability ),
+// build_or_throw_any_handle_cast_exception( any_handle const &, any_cast_target_type const &, mutability ) :
+// declared by their definition only (GCC rejects 'noinline' on a redeclared inline function).
+
 template< typename T, mutability IsCastMutable >
 void throw_any_handle_cast_exception( any_handle const &a_failing_handle );
 
@@ -24,6 +32,35 @@ void throw_any_handle_cast_exception( any_handle const &a_failing_handle );
 
 // -- definition :
 
+/// @ingroup SoloAnyHandleDetail
+/// @brief Throw a @c bad_any_handle_cast exception.
+/// @param a_failing_handle The @c any_handle object that failed to cast.
+/// @param a_target_type The target type of the failing cast.
+/// @param a_ismutable The mutability of the failing cast.
+/// @note Not a template : the throwing code is shared by all the @c any_handle_xxx_cast_or_throw<T> instances.
+/// @note Cold and never inlined : the construction of the exception stays out of the callers code.
+[[noreturn]] SOLO_COLD SOLO_NOINLINE inline void throw_any_handle_cast_exception( any_handle const &a_failing_handle, any_cast_target_type const &a_target_type, mutability a_ismutable )
+{
+    throw anys::exceptions::bad_any_handle_cast{ a_failing_handle, any_cast_target_type_index(a_target_type), a_ismutable };
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The failure path of the throwing casts : build the object of a valid lazy handle not cast yet,
+/// or throw a @c bad_any_handle_cast exception.
+/// @param a_handle The @c any_handle object to cast.
+/// @param a_target_type The target type of the cast.
+/// @param a_ismutable The mutability of the cast.
+/// @throw Whatever the construction of the lazy object throws (left unbuilt : the next cast retries).
+/// @note Cold and never inlined, as @c throw_any_handle_cast_exception.
+SOLO_COLD SOLO_NOINLINE inline void build_or_throw_any_handle_cast_exception( any_handle const &a_handle, any_cast_target_type const &a_target_type, mutability a_ismutable )
+{
+    if ( !is_any_handle_cast_valid(a_handle, a_target_type, a_ismutable) )
+    {
+        throw_any_handle_cast_exception(a_handle, a_target_type, a_ismutable);
+    }
+    build_any_handle_object(a_handle);
+}
+
 /// @ingroup SoloAnyHandleDetail
 /// @brief Throw a @c bad_any_handle_cast exception.
 /// @param a_failing_handle The @c any_handle object that failed to cast.
@@ -53,10 +90,10 @@ void throw_any_handle_cast_exception( any_handle const &a_failing_handle );
 /// @endcode
 ///
 template< typename T, mutability IsCastMutable >
-void throw_any_handle_cast_exception( any_handle const &a_failing_handle )
+inline void throw_any_handle_cast_exception( any_handle const &a_failing_handle )
 {
-    throw anys::exceptions::bad_any_handle_cast{ a_failing_handle, typeid(T), IsCastMutable };
-};
+    throw_any_handle_cast_exception( a_failing_handle, any_cast_target<T>(), IsCastMutable );
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 }}}// EONS SOLO::ANYS::DETAIL
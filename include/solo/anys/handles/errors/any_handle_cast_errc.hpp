@@ -22,7 +22,8 @@ enum class any_handle_cast_errc: std::int8_t
     undefined = 0,
     empty_source,
     bad_source_type,
-    bad_source_mutability
+    bad_source_mutability,
+    failed_source_construction
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -35,6 +35,13 @@ inline constexpr bool is_bad_source_mutability_error(any_handle_cast_error const
     return a_error.code() == any_handle_cast_errc::bad_source_mutability;
 }
 
+/// @ingroup SoloAnyHandle
+/// @brief Check if the given casting error is due to the failed construction of a lazy object (see @c make_any_handle_lazy).
+inline constexpr bool is_failed_source_construction_error(any_handle_cast_error const &a_error)
+{
+    return a_error.code() == any_handle_cast_errc::failed_source_construction;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 }}}// EONS SOLO::ANYS::ERRORS
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,41 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace graphs {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+class graph_error;
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Exception thrown when a resource graph cannot be built :
+/// duplicate key, missing dependency, dependency of another type, dependency cycle, null resource.
+class graph_error
+    : public std::runtime_error
+{
+public:
+    explicit graph_error( std::string const &a_what )
+        : std::runtime_error{ "solo::anys::graphs: " + a_what }
+    {}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::GRAPHS
+////////////////////////////////////////////////////////////////////////////////
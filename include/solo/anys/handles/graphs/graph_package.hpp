@@ -0,0 +1,21 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+/// @file
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Opt-in parallel construction of graphs of dependent resources (not included by the library packages).
+///
+/// - @c solo::anys::graphs::resource_graph : the declared resources, their typed dependencies and factories, @c build,
+/// - @c solo::anys::graphs::depends_on : the typed dependency keys of a resource,
+/// - @c solo::anys::graphs::resource_graph_report : the per-resource timings and the critical path of a build,
+/// - @c solo::anys::graphs::graph_error : the invalid graphs.
+
+#include <solo/anys/handles/graphs/graph_error.hpp>
+#include <solo/anys/handles/graphs/resource_graph.hpp>
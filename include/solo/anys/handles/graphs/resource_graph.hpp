@@ -0,0 +1,394 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/any_handle_core_package.hpp>
+#include <solo/anys/handles/graphs/graph_error.hpp>
+#include <solo/anys/handles/graphs/work_stealing_scheduler.hpp>
+#include <solo/anys/handles/registries/any_handle_registry.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace graphs {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+template < typename... Deps >
+struct dependencies;
+
+template < typename... Deps, typename... Keys >
+dependencies<Deps...> depends_on( Keys&&... a_keys );
+
+struct resource_timing;
+struct resource_graph_report;
+class resource_graph;
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The keys of the dependencies of a resource, and their types (see @c depends_on).
+template < typename... Deps >
+struct dependencies
+{
+    std::array<std::string, sizeof...(Deps)> keys;
+};
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Declare the dependencies of a resource : <c>depends_on<A, B>("a", "b")</c>.
+template < typename... Deps, typename... Keys >
+inline dependencies<Deps...>
+depends_on( Keys&&... a_keys )
+{
+    static_assert(sizeof...(Deps) == sizeof...(Keys), "one key per dependency type");
+    return dependencies<Deps...>{ { { std::string( std::forward<Keys>(a_keys) )... } } };
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The timing of the construction of a resource, relative to the start of @c resource_graph::build.
+struct resource_timing
+{
+    std::string key;
+    std::chrono::nanoseconds start{};
+    std::chrono::nanoseconds duration{};
+    std::size_t worker{};// 0 for the calling thread
+};
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The report of @c resource_graph::build.
+struct resource_graph_report
+{
+    /// @brief The timings of the resources, in declaration order.
+    std::vector<resource_timing> resources;
+
+    /// @brief The chain of dependent resources with the longest total construction time, from a root.
+    /// @note No number of threads builds the graph faster than @c critical_path_duration.
+    std::vector<std::string> critical_path;
+    std::chrono::nanoseconds critical_path_duration{};
+
+    /// @brief The wall-clock duration of the build.
+    std::chrono::nanoseconds total_duration{};
+    std::size_t thread_count{};// the workers which ran, the calling thread included
+};
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief A graph of resources depending on each other, built in parallel into a registry of handles.
+///
+/// Each resource is declared with its key, its type, the keys and types of its dependencies, and a factory
+/// called with the typed shared pointers to its dependencies (no cast in the factories). @c build validates the graph,
+/// then constructs the resources on a work-stealing pool, each as soon as its dependencies are built, and publishes them
+/// in the given registry as they are built (its waiters may start before the end of the build).
+///
+/// Example:
+///
+/// @code
+///     solo::anys::graphs::resource_graph graph;
+///     graph.add<Config>("config", [] { return std::make_shared<Config const>("config.json"); });
+///     graph.add<Pool>("pool", depends_on<Config>("config"),
+///                     []( std::shared_ptr<Config const> c ) { return std::make_shared<Pool const>(*c); });
+///
+///     solo::anys::registries::any_handle_registry registry;
+///     auto const report = graph.build(registry);// report.critical_path, report.resources
+/// @endcode
+///
+/// @note A throwing factory stops the resources depending on it (the others are still built and published),
+/// then its exception is rethrown by @c build.
+class resource_graph
+{
+public:
+
+    /// @brief Declare a resource of type @c T built by <c>a_factory(std::shared_ptr<Deps const>...)</c>.
+    /// @pre @c a_factory returns a shared pointer convertible to <c>std::shared_ptr<T const></c>.
+    /// @throw graph_error if a resource is already declared under @c a_key.
+    template < typename T, typename... Deps, typename Factory >
+    resource_graph &add( std::string a_key, dependencies<Deps...> a_dependencies, Factory a_factory );
+
+    /// @brief Declare a resource of type @c T without dependency, built by <c>a_factory()</c>.
+    template < typename T, typename Factory >
+    resource_graph &add( std::string a_key, Factory a_factory );
+
+    /// @brief Return the number of declared resources.
+    std::size_t size() const noexcept { return m_nodes.size(); }
+
+    /// @brief Build all the resources on @c a_thread_count threads (the calling one included), and publish them in @c a_registry.
+    /// @throw graph_error if a dependency is missing or of another type, or if the dependencies have a cycle (nothing is built).
+    /// @throw The first exception thrown by a factory (after the build of the resources not depending on it).
+    resource_graph_report build( registries::any_handle_registry &a_registry,
+                                 std::size_t a_thread_count = std::thread::hardware_concurrency() ) const;
+
+private:
+
+    using make_function = std::function<any_handle( std::vector<any_handle> const &a_dependencies )>;
+
+    struct node
+    {
+        std::string key;
+        std::type_index type;
+        std::vector<std::string> dependency_keys;
+        std::vector<std::type_index> dependency_types;
+        make_function make;
+    };
+
+    template < typename T, typename... Deps, typename Factory, std::size_t... Is >
+    static make_function make_node_function( Factory &&a_factory, std::index_sequence<Is...> );
+
+    std::vector<node> m_nodes;
+    std::unordered_map<std::string, std::size_t> m_indexes;
+};
+
+//..............................................................................
+//..............................................................................
+
+// INLINES :
+
+template < typename T, typename... Deps, typename Factory, std::size_t... Is >
+inline resource_graph::make_function
+resource_graph::make_node_function( Factory &&a_factory, std::index_sequence<Is...> )
+{
+    return [factory = std::forward<Factory>(a_factory)]( std::vector<any_handle> const &a_dependencies ) mutable
+    {
+        // the types are checked by build : the casts cannot fail
+        auto resource = std::shared_ptr<T const>{ factory( any_handle_cast<Deps>(a_dependencies[Is]).assume_value()... ) };
+        return resource ? make_any_handle(std::move(resource)) : any_handle{};
+    };
+}
+
+template < typename T, typename... Deps, typename Factory >
+inline resource_graph &
+resource_graph::add( std::string a_key, dependencies<Deps...> a_dependencies, Factory a_factory )
+{
+    static_assert(!std::is_reference<T>::value, "T should not be a reference type");
+
+    if ( m_indexes.count(a_key) != 0 )
+    {
+        throw graph_error{ "duplicate resource " + a_key };
+    }
+    auto n = node{ a_key, typeid(T), {}, {}, make_node_function<std::remove_cv_t<T>, Deps...>(std::move(a_factory), std::index_sequence_for<Deps...>{}) };
+    n.dependency_keys.assign(a_dependencies.keys.begin(), a_dependencies.keys.end());
+    n.dependency_types = { std::type_index{ typeid(Deps) }... };
+    m_nodes.push_back(std::move(n));
+    m_indexes.emplace(std::move(a_key), m_nodes.size() - 1);
+    return *this;
+}
+
+template < typename T, typename Factory >
+inline resource_graph &
+resource_graph::add( std::string a_key, Factory a_factory )
+{
+    return add<T>(std::move(a_key), dependencies<>{}, std::move(a_factory));
+}
+
+inline resource_graph_report
+resource_graph::build( registries::any_handle_registry &a_registry, std::size_t a_thread_count ) const
+{
+    using clock = std::chrono::steady_clock;
+    auto const count = m_nodes.size();
+
+    // validate, and link each resource to its dependents
+    auto dependencies = std::vector<std::vector<std::size_t>>(count);
+    auto dependents = std::vector<std::vector<std::size_t>>(count);
+    for ( auto i = std::size_t{0}; i < count; ++i )
+    {
+        auto const &n = m_nodes[i];
+        for ( auto d = std::size_t{0}; d < n.dependency_keys.size(); ++d )
+        {
+            auto const found = m_indexes.find(n.dependency_keys[d]);
+            if ( found == m_indexes.end() )
+            {
+                throw graph_error{ n.key + " depends on the undeclared resource " + n.dependency_keys[d] };
+            }
+            if ( m_nodes[found->second].type != n.dependency_types[d] )
+            {
+                throw graph_error{ n.key + " depends on " + n.dependency_keys[d] + " as a " + n.dependency_types[d].name()
+                                 + ", declared as a " + m_nodes[found->second].type.name() };
+            }
+            dependencies[i].push_back(found->second);
+            dependents[found->second].push_back(i);
+        }
+    }
+
+    // topological order (Kahn) : detects the cycles, then orders the critical path computation
+    auto order = std::vector<std::size_t>{};
+    order.reserve(count);
+    {
+        auto remaining = std::vector<std::size_t>(count);
+        for ( auto i = std::size_t{0}; i < count; ++i )
+        {
+            remaining[i] = dependencies[i].size();
+            if ( remaining[i] == 0 )
+            {
+                order.push_back(i);
+            }
+        }
+        for ( auto o = std::size_t{0}; o < order.size(); ++o )
+        {
+            for ( auto const d : dependents[order[o]] )
+            {
+                if ( --remaining[d] == 0 )
+                {
+                    order.push_back(d);
+                }
+            }
+        }
+        if ( order.size() != count )
+        {
+            auto cycle = std::string{};
+            for ( auto i = std::size_t{0}; i < count; ++i )
+            {
+                if ( remaining[i] != 0 )
+                {
+                    cycle += ( cycle.empty() ? "" : ", " ) + m_nodes[i].key;
+                }
+            }
+            throw graph_error{ "dependency cycle among " + cycle };
+        }
+    }
+
+    // build : each resource is pushed by the worker building its last dependency
+    auto handles = std::vector<any_handle>(count);
+    auto failed = std::vector<char>(count, 0);// a factory threw, or a dependency failed
+    auto pending = std::unique_ptr<std::atomic<std::size_t>[]>{ new std::atomic<std::size_t>[count] };
+    auto report = resource_graph_report{};
+    report.resources.resize(count);
+    for ( auto i = std::size_t{0}; i < count; ++i )
+    {
+        report.resources[i].key = m_nodes[i].key;// before the build : the workers do not allocate out of their try blocks
+    }
+    std::mutex error_mutex;
+    auto first_error = std::exception_ptr{};
+    auto record_error = [&]() noexcept
+    {
+        std::lock_guard<std::mutex> lock{ error_mutex };
+        if ( !first_error )
+        {
+            first_error = std::current_exception();
+        }
+    };
+
+    detail::work_stealing_scheduler scheduler{ a_thread_count };
+    auto const start = clock::now();
+
+    auto execute = [&]( std::size_t a_index, std::size_t a_worker ) noexcept
+    {
+        auto const &n = m_nodes[a_index];
+        auto &timing = report.resources[a_index];
+        auto const begin = clock::now();
+        try
+        {
+            auto inputs = std::vector<any_handle>{};
+            inputs.reserve(dependencies[a_index].size());
+            for ( auto const d : dependencies[a_index] )
+            {
+                failed[a_index] |= failed[d];
+                inputs.push_back(handles[d]);
+            }
+            if ( !failed[a_index] )
+            {
+                handles[a_index] = n.make(inputs);
+                if ( handles[a_index].empty() )
+                {
+                    throw graph_error{ "the factory of " + n.key + " returned a null resource" };
+                }
+                a_registry.publish(n.key, handles[a_index]);
+            }
+        }
+        catch ( ... )
+        {
+            failed[a_index] = 1;
+            record_error();
+        }
+        auto const end = clock::now();
+        timing.start = begin - start;
+        timing.duration = end - begin;
+        timing.worker = a_worker;
+        for ( auto const d : dependents[a_index] )
+        {
+            if ( pending[d].fetch_sub(1, std::memory_order_acq_rel) == 1 )// the last dependency : its inputs are visible
+            {
+                try
+                {
+                    scheduler.push(a_worker, d);// unchanged if it throws
+                }
+                catch ( ... )
+                {
+                    record_error();// the dependent and its own dependents are not built
+                }
+            }
+        }
+    };
+
+    for ( auto i = std::size_t{0}; i < count; ++i )
+    {
+        pending[i].store(dependencies[i].size(), std::memory_order_relaxed);
+    }
+    for ( auto i = std::size_t{0}; i < count; ++i )
+    {
+        if ( dependencies[i].empty() )
+        {
+            scheduler.push(i % scheduler.worker_count(), i);// spread the roots
+        }
+    }
+    report.thread_count = scheduler.run(execute);
+    report.total_duration = clock::now() - start;
+
+    if ( first_error )
+    {
+        std::rethrow_exception(first_error);
+    }
+
+    // critical path : the longest chain of construction times, over the topological order
+    auto finish = std::vector<std::chrono::nanoseconds>(count);
+    auto previous = std::vector<std::size_t>(count, count);
+    for ( auto const i : order )
+    {
+        auto longest = std::chrono::nanoseconds{};
+        for ( auto const d : dependencies[i] )
+        {
+            if ( finish[d] > longest || previous[i] == count )
+            {
+                longest = finish[d];
+                previous[i] = d;
+            }
+        }
+        finish[i] = longest + report.resources[i].duration;
+    }
+    if ( count != 0 )
+    {
+        auto last = static_cast<std::size_t>(std::max_element(finish.begin(), finish.end()) - finish.begin());
+        report.critical_path_duration = finish[last];
+        for ( ; last != count; last = previous[last] )
+        {
+            report.critical_path.push_back(m_nodes[last].key);
+        }
+        std::reverse(report.critical_path.begin(), report.critical_path.end());
+    }
+    return report;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::GRAPHS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,187 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace graphs { namespace detail {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+class work_stealing_scheduler;
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Run tasks (indexes) spawning other tasks on a set of workers, each with its own deque, until none is left.
+///
+/// A worker pushes the tasks it spawns on its own deque and pops them back first (last in, first out : the
+/// dependents of a resource run while its dependencies are hot) ; an idle worker steals the oldest task of another one.
+/// The workers are the calling thread and @c a_thread_count - 1 threads, started and joined by @c run.
+class work_stealing_scheduler
+{
+public:
+
+    explicit work_stealing_scheduler( std::size_t a_thread_count )
+        : m_workers( a_thread_count == 0 ? 1 : a_thread_count )
+    {
+        for ( auto &w : m_workers )
+        {
+            w = std::make_unique<worker>();
+        }
+    }
+
+    work_stealing_scheduler( work_stealing_scheduler const & ) = delete;
+    work_stealing_scheduler &operator=( work_stealing_scheduler const & ) = delete;
+
+    /// @brief Return the number of workers (the calling thread included).
+    std::size_t worker_count() const noexcept { return m_workers.size(); }
+
+    /// @brief Queue the given task on the given worker (the worker running the spawning task, or any before @c run).
+    /// @throw @c std::bad_alloc if the deque of the worker cannot grow : the task is then not queued, nor counted.
+    void push( std::size_t a_worker, std::size_t a_task )
+    {
+        m_unfinished.fetch_add(1, std::memory_order_relaxed);
+        try
+        {
+            std::lock_guard<std::mutex> lock{ m_workers[a_worker]->mutex };
+            m_workers[a_worker]->tasks.push_back(a_task);
+        }
+        catch ( ... )
+        {
+            m_unfinished.fetch_sub(1, std::memory_order_relaxed);// the spawning task, still running, keeps it above 0
+            throw;
+        }
+        m_queued.fetch_add(1);// sequentially consistent with the sleepers : either they see the task, or it sees them
+        if ( m_sleeping.load() > 0 )
+        {
+            std::lock_guard<std::mutex> lock{ m_idle_mutex };// no lost wake-up : the sleepers check m_queued under the lock
+            m_idle.notify_one();
+        }
+    }
+
+    /// @brief Run @c a_execute(task, worker) for the queued tasks and the ones they push, until none is left.
+    /// @pre @c a_execute is noexcept.
+    /// @return The number of workers which ran (the calling thread included).
+    /// @note If a thread cannot be started, the run goes on with the workers already running (at least the calling thread) :
+    /// the tasks queued on the workers without a thread are stolen.
+    template < typename Execute >
+    std::size_t run( Execute &a_execute )
+    {
+        auto threads = std::vector<std::thread>{};
+        threads.reserve(m_workers.size() - 1);// before any thread : nothing to join if it throws
+        for ( auto i = std::size_t{1}; i < m_workers.size(); ++i )
+        {
+            try
+            {
+                threads.emplace_back([this, i, &a_execute] { work(i, a_execute); });// unchanged if it throws (reserved)
+            }
+            catch ( ... )// std::system_error : no more threads
+            {
+                break;
+            }
+        }
+        work(0, a_execute);
+        for ( auto &t : threads )
+        {
+            t.join();
+        }
+        return threads.size() + 1;
+    }
+
+private:
+
+    struct worker
+    {
+        std::mutex mutex;
+        std::deque<std::size_t> tasks;
+    };
+
+    /// @brief Pop the newest task of the given worker, or steal the oldest one of another worker.
+    bool take( std::size_t a_worker, std::size_t &a_task )
+    {
+        {
+            auto &own = *m_workers[a_worker];
+            std::lock_guard<std::mutex> lock{ own.mutex };
+            if ( !own.tasks.empty() )
+            {
+                a_task = own.tasks.back();
+                own.tasks.pop_back();
+                m_queued.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        for ( auto i = std::size_t{1}; i < m_workers.size(); ++i )
+        {
+            auto &victim = *m_workers[( a_worker + i ) % m_workers.size()];
+            std::lock_guard<std::mutex> lock{ victim.mutex };
+            if ( !victim.tasks.empty() )
+            {
+                a_task = victim.tasks.front();
+                victim.tasks.pop_front();
+                m_queued.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template < typename Execute >
+    void work( std::size_t a_worker, Execute &a_execute )
+    {
+        for ( ;; )
+        {
+            auto task = std::size_t{};
+            if ( take(a_worker, task) )
+            {
+                a_execute(task, a_worker);// pushes the spawned tasks before ending
+                if ( m_unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1 )
+                {
+                    std::lock_guard<std::mutex> lock{ m_idle_mutex };
+                    m_idle.notify_all();// done
+                }
+                continue;
+            }
+            std::unique_lock<std::mutex> lock{ m_idle_mutex };
+            m_sleeping.fetch_add(1);
+            m_idle.wait(lock, [this]
+            {
+                return m_queued.load() > 0 || m_unfinished.load(std::memory_order_acquire) == 0;
+            });
+            m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+            if ( m_unfinished.load(std::memory_order_acquire) == 0 )
+            {
+                return;
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<worker>> m_workers;
+    std::atomic<std::size_t> m_unfinished{0};// queued or running
+    std::atomic<std::size_t> m_queued{0};
+    std::atomic<std::size_t> m_sleeping{0};
+    std::mutex m_idle_mutex;
+    std::condition_variable m_idle;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}}}}// EONS SOLO::ANYS::GRAPHS::DETAIL
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,213 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/any_handle_core_package.hpp>
+#include <solo/anys/handles/details/make_owned_shared_t.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace interning {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+class intern_table;
+
+intern_table &default_intern_table();
+
+namespace detail {
+    class intern_shards;
+}// EONS DETAIL
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+namespace detail {
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The interned objects, by hash of their type and content, in shards locked independently.
+///
+/// The entries hold their objects weakly (an object is destroyed with its last handle) : the entries of the
+/// destroyed objects are purged by the internings of their shard, whenever it has doubled since its last purge.
+class intern_shards
+{
+public:
+
+    /// @brief The number of shards (the concurrent internings of values with different hashes rarely contend).
+    static constexpr std::size_t shard_count = 64;
+
+    /// @brief Return the interned object of type @c T equal to the given candidate, or intern the candidate.
+    ///
+    /// The objects locked for a comparison are released after the shard lock : a destructor run by the last release
+    /// may intern again.
+    template < typename T >
+    std::shared_ptr<T const> intern( std::size_t a_hash, std::unique_ptr<T> a_candidate );
+
+    /// @brief Return the number of interned objects alive.
+    std::size_t size() const;
+
+private:
+
+    struct entry
+    {
+        any_type_index type;
+        std::weak_ptr<void const> object;
+    };
+
+    struct alignas(64) shard// no false sharing between the mutexes
+    {
+        mutable std::mutex mutex;
+        std::unordered_multimap<std::size_t, entry> entries;
+        std::size_t purge_threshold{ 8 };
+    };
+
+    shard &shard_of( std::size_t a_hash ) noexcept { return m_shards[( a_hash ^ ( a_hash >> 17 ) ) % shard_count]; }
+
+    /// @brief Erase the entries of the destroyed objects of the given (locked) shard, if it has doubled since its last purge.
+    static void purge_if_grown( shard &a_shard );
+
+    std::array<shard, shard_count> m_shards;
+};
+
+template < typename T >
+inline std::shared_ptr<T const>
+intern_shards::intern( std::size_t a_hash, std::unique_ptr<T> a_candidate )
+{
+    auto const type = make_any_type_index<T>();
+    auto &s = shard_of(a_hash);
+    auto compared = std::vector<std::shared_ptr<void const>>{};// destroyed after the lock (no allocation without collision)
+    std::lock_guard<std::mutex> lock{ s.mutex };
+    auto const range = s.entries.equal_range(a_hash);
+    for ( auto i = range.first; i != range.second; ++i )
+    {
+        if ( i->second.type.equals(type) )
+        {
+            auto existing = i->second.object.lock();// null once destroyed
+            if ( existing && *static_cast<T const *>(existing.get()) == *a_candidate )
+            {
+                return std::static_pointer_cast<T const>(std::move(existing));// the candidate is deleted
+            }
+            if ( existing )
+            {
+                compared.push_back(std::move(existing));
+            }
+        }
+    }
+    purge_if_grown(s);
+    auto const inserted = s.entries.emplace(a_hash, entry{ type, {} });
+    try
+    {
+        // on failure, the shared pointer constructor deletes the candidate
+        auto interned = anys::detail::make_owned_shared_with_finalizer<T const>(a_candidate.release(), std::default_delete<T const>{}, mutability::false_);
+        inserted->second.object = interned;
+        return interned;
+    }
+    catch ( ... )
+    {
+        s.entries.erase(inserted);
+        throw;
+    }
+}
+
+inline void
+intern_shards::purge_if_grown( shard &a_shard )
+{
+    if ( a_shard.entries.size() < a_shard.purge_threshold )
+    {
+        return;
+    }
+    for ( auto i = a_shard.entries.begin(); i != a_shard.entries.end(); )
+    {
+        i = i->second.object.expired() ? a_shard.entries.erase(i) : std::next(i);
+    }
+    a_shard.purge_threshold = 2 * a_shard.entries.size() + 8;// amortized : one visit per interning
+}
+
+inline std::size_t
+intern_shards::size() const
+{
+    auto count = std::size_t{0};
+    for ( auto const &s : m_shards )
+    {
+        std::lock_guard<std::mutex> lock{ s.mutex };
+        for ( auto const &e : s.entries )
+        {
+            count += e.second.object.expired() ? 0 : 1;
+        }
+    }
+    return count;
+}
+
+}// EONS DETAIL
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief A thread-safe table of interned immutable objects : one object per distinct type and value.
+///
+/// Holds its objects weakly : an object is destroyed with its last handle (its entry, with the control block of
+/// its shared pointers, is purged later).
+/// @see @c make_interned_any_handle.
+class intern_table
+{
+public:
+
+    intern_table() = default;
+
+    intern_table( intern_table const & ) = delete;
+    intern_table &operator=( intern_table const & ) = delete;
+
+    /// @brief Return the interned object equal to the given candidate, or intern the candidate.
+    /// @pre @c std::hash<T> and <c>operator==(T const &, T const &)</c> are defined, and consistent.
+    template < typename T >
+    std::shared_ptr<T const> intern( std::unique_ptr<T> a_candidate )
+    {
+        auto const hash = hash_of(*a_candidate);
+        return m_shards.intern<T>(hash, std::move(a_candidate));
+    }
+
+    /// @brief Return the number of interned objects.
+    std::size_t size() const { return m_shards.size(); }
+
+private:
+
+    /// @brief Mix the fingerprint of the type with the hash of the value (the equal values of different types do not collide).
+    template < typename T >
+    static std::size_t hash_of( T const &a_value )
+    {
+        auto const h = static_cast<std::uint64_t>( std::hash<T>{}(a_value) ) ^ make_any_type_index<T>().fingerprint();
+        return static_cast<std::size_t>( ( h ^ ( h >> 29 ) ) * 0xbf58476d1ce4e5b9ull );
+    }
+
+    detail::intern_shards m_shards;
+};
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Return the process-wide intern table of @c make_interned_any_handle.
+inline intern_table &
+default_intern_table()
+{
+    static intern_table table;// the interned objects do not reference it : they may outlive it
+    return table;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::INTERNING
+////////////////////////////////////////////////////////////////////////////////
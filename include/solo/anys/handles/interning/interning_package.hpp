@@ -0,0 +1,19 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+/// @file
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Opt-in interning of immutable values (not included by the library packages).
+///
+/// - @c solo::anys::interning::make_interned_any_handle<T> : the factories, returning the interned object equal to the built one,
+/// - @c solo::anys::interning::intern_table : the weak table of the interned objects, @c default_intern_table.
+
+#include <solo/anys/handles/interning/intern_table.hpp>
+#include <solo/anys/handles/interning/make_interned_any_handle.hpp>
@@ -0,0 +1,77 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/any_handle_core_package.hpp>
+#include <solo/anys/handles/interning/intern_table.hpp>
+
+#include <stdex/in_place_t.hpp>
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace interning {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+template < typename T, typename... Args >
+any_handle make_interned_any_handle( intern_table &a_table, stdex::in_place_t, Args&&... a_type_constructor_arguments_list );
+
+template < typename T, typename... Args >
+any_handle make_interned_any_handle( stdex::in_place_t, Args&&... a_type_constructor_arguments_list );
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Build a non-mutable object of type @c T, and return a handle to the interned object equal to it.
+///
+/// The object is built, hashed and compared with the objects of the table : if an equal object of the same type
+/// is alive, the new one is deleted and the handle shares the interned one. The handles of equal values are then
+/// equal as pointers (<c>a == b</c> compares addresses), and a value duplicated N times is stored once.
+///
+/// Example:
+///
+/// @code
+///     auto a = solo::anys::interning::make_interned_any_handle<std::string>(stdex::in_place, "key");
+///     auto b = solo::anys::interning::make_interned_any_handle<std::string>(stdex::in_place, "key");
+///     assert(a.get() == b.get());
+/// @endcode
+///
+/// @pre @c std::hash<T> and <c>operator==(T const &, T const &)</c> are defined, and consistent.
+/// @note An interning costs a construction, a hash and a lock of one of the 64 shards of the table ;
+/// a new value adds the allocation of its control block (the table holds the objects weakly).
+template < typename T, typename... Args >
+inline any_handle
+make_interned_any_handle( intern_table &a_table, stdex::in_place_t, Args&&... a_type_constructor_arguments_list )
+{
+    static_assert(!std::is_reference<T>::value, "T should not be a reference type");
+    using value_type = std::remove_cv_t<T>;
+
+    auto candidate = std::unique_ptr<value_type>{ new value_type( std::forward<Args>(a_type_constructor_arguments_list)... ) };
+    return make_any_handle( a_table.intern(std::move(candidate)) );
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The same, with the process-wide intern table (see @c default_intern_table).
+template < typename T, typename... Args >
+inline any_handle
+make_interned_any_handle( stdex::in_place_t, Args&&... a_type_constructor_arguments_list )
+{
+    return make_interned_any_handle<T>( default_intern_table(), stdex::in_place, std::forward<Args>(a_type_constructor_arguments_list)... );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::INTERNING
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,41 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace interprocess {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+class interprocess_error;
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Exception thrown when a shared segment cannot be created or opened,
+/// when it is full, or when its directory is full.
+class interprocess_error
+    : public std::runtime_error
+{
+public:
+    explicit interprocess_error( std::string const &a_what )
+        : std::runtime_error{ "solo::anys::interprocess: " + a_what }
+    {}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::INTERPROCESS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,22 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+/// @file
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Opt-in handles to objects shared between processes (POSIX only, not included by the library packages).
+///
+/// - @c solo::anys::interprocess::shared_segment, @c make_shared_segment, @c open_shared_segment : a named shared memory segment,
+/// - @c solo::anys::interprocess::make_shm_handle<T>, @c make_shm_handle_mutable<T> : build an object in a segment,
+/// - @c solo::anys::interprocess::shm_handle_cast<T>, @c shm_handle_mutable_cast<T> : the casts, by type fingerprint,
+/// - @c solo::anys::interprocess::publish_shm_handle, @c find_shm_handle : exchange the handles by name between processes.
+
+#include <solo/anys/handles/interprocess/interprocess_error.hpp>
+#include <solo/anys/handles/interprocess/shared_segment.hpp>
+#include <solo/anys/handles/interprocess/shm_handle.hpp>
@@ -0,0 +1,512 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/interprocess/interprocess_error.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace interprocess {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+struct shared_segment_header;
+struct shared_object_header;
+
+class shared_segment;
+
+std::shared_ptr<shared_segment> make_shared_segment( std::string const &a_name, std::size_t a_size );
+std::shared_ptr<shared_segment> open_shared_segment( std::string const &a_name );
+bool remove_shared_segment( std::string const &a_name ) noexcept;
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+// Shared segment layout (native endianness, all the links are offsets from the beginning of the segment) :
+//
+//     shared_segment_header     the allocator state and the directory of published objects
+//     blocks                    aligned on shared_segment_block_alignment, each one starting with a shared_object_header
+//
+// The segment is mapped at a different address in each process : it never stores a pointer.
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The magic number starting a shared segment.
+constexpr char const shared_segment_magic[8] = { 'S', 'O', 'L', 'O', 'S', 'H', 'M', '\0' };
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The version of the shared segment layout.
+constexpr std::uint32_t shared_segment_version = 1;
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The alignment of the blocks (and the maximal alignment of a shared object).
+constexpr std::size_t shared_segment_block_alignment = 64;
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The number of entries of the directory of published objects, and the maximal size of their names.
+constexpr std::size_t shared_segment_directory_size = 64;
+constexpr std::size_t shared_segment_name_size = 56;
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The flags of a @c shared_object_header.
+enum shared_object_flags : std::uint32_t
+{
+    shared_object_mutable = 1u
+};
+
+// The atomics shared between processes must be address-free, that is lock-free.
+static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2, "shared segments require lock-free atomics");
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief One published object : a name and the offset of its block.
+struct shared_segment_entry
+{
+    char name[shared_segment_name_size];// null-terminated
+    std::uint64_t object_offset;        // 0 for a free entry
+};
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The header of a shared segment.
+struct shared_segment_header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t reserved;
+    std::uint64_t size;
+    std::atomic<std::uint32_t> lock;// spin lock of the allocator and of the directory
+    std::uint32_t reserved2;
+    std::uint64_t top;              // first never allocated byte
+    std::uint64_t free_list;        // first free block, 0 if none
+    std::uint64_t used_size;        // bytes of the allocated blocks
+    shared_segment_entry directory[shared_segment_directory_size];
+};
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The header of a block : the cross-process reference count and the type of the object.
+struct shared_object_header
+{
+    std::atomic<std::uint64_t> use_count;
+    std::uint64_t fingerprint;// see any_type_index::fingerprint
+    std::uint64_t block_size;
+    std::uint64_t next_free;  // free blocks only
+    std::uint32_t data_offset;// from the header
+    std::uint32_t flags;      // shared_object_flags
+};
+
+//..............................................................................
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief A POSIX shared memory segment (@c shm_open) mapped by several processes, holding shared objects.
+///
+/// The objects are allocated in blocks carrying a cross-process atomic reference count
+/// and the fingerprint of their type (see @c make_shm_handle and @c shm_handle).
+/// A block is reused once its reference count drops to zero, whichever process released it.
+/// The processes find the objects by name, in the directory of the segment (see @c publish_shm_handle).
+///
+/// Example:
+///
+/// @code
+///     // builder process :
+///     auto const segment = make_shared_segment("/lookup_tables", 4ull << 30);
+///     publish_shm_handle( make_shm_handle<Table>(segment, ...), "table" );
+///
+///     // worker processes :
+///     auto const segment = open_shared_segment("/lookup_tables");
+///     auto const table = shm_handle_cast<Table>( find_shm_handle(segment, "table") );
+/// @endcode
+///
+/// @note Neither copyable nor movable : share it with @c std::shared_ptr (the handles keep it mapped).
+/// @note A process dying while holding the allocator lock leaves the segment locked.
+class shared_segment
+{
+public:
+
+    /// @brief Create and map a new segment of the given size.
+    /// @throw @c interprocess_error if a segment of the same name exists, or on system failure.
+    shared_segment( std::string a_name, std::size_t a_size );
+
+    /// @brief Map the existing segment of the given name.
+    /// @throw @c interprocess_error if there is no such segment, or if it is not a valid segment of this version.
+    explicit shared_segment( std::string a_name );
+
+    shared_segment( shared_segment const & ) = delete;
+    shared_segment &operator=( shared_segment const & ) = delete;
+
+    /// @brief Unmap the segment (it persists until removed, see @c remove_shared_segment).
+    ~shared_segment();
+
+    std::string const &name() const noexcept { return m_name; }
+
+    /// @brief The size of the segment in bytes.
+    std::size_t size() const noexcept { return m_size; }
+
+    /// @brief The bytes of the allocated blocks (in all the processes).
+    std::size_t used_size() const noexcept;
+
+    /// @brief Allocate a block for an object.
+    /// @return The offset of the block, whose use count is 1 (owned by the caller).
+    /// @throw @c interprocess_error if the segment is full.
+    std::uint64_t allocate( std::size_t a_size, std::size_t a_alignment, std::uint64_t a_fingerprint, std::uint32_t a_flags );
+
+    /// @brief Increment the use count of the given block.
+    void retain( std::uint64_t a_offset ) const noexcept;
+
+    /// @brief Decrement the use count of the given block, and free it when it drops to zero.
+    void release( std::uint64_t a_offset ) noexcept;
+
+    /// @brief The header of the given block.
+    shared_object_header &object( std::uint64_t a_offset ) const noexcept
+    {
+        return *reinterpret_cast<shared_object_header *>( m_data + a_offset );
+    }
+
+    /// @brief The object of the given block.
+    void *object_data( std::uint64_t a_offset ) const noexcept
+    {
+        return m_data + a_offset + object(a_offset).data_offset;
+    }
+
+    /// @brief Publish the given block under the given name (the directory owns one reference).
+    /// @throw @c interprocess_error if the name is too long, already published, or if the directory is full.
+    void publish( std::uint64_t a_offset, std::string const &a_name );
+
+    /// @brief Return the block published under the given name, retained for the caller, or 0 if not found.
+    std::uint64_t find( std::string const &a_name ) const noexcept;
+
+    /// @brief Withdraw the given name from the directory, and release its block.
+    /// @return false if the name was not published.
+    bool unpublish( std::string const &a_name ) noexcept;
+
+private:
+
+    /// @brief A scope holding the lock of the segment.
+    class lock_guard;
+
+    shared_segment_header &header() const noexcept { return *reinterpret_cast<shared_segment_header *>(m_data); }
+
+    void map( int a_fd, std::size_t a_size );
+
+    std::string m_name;
+    char *m_data{nullptr};
+    std::size_t m_size{0};
+};
+
+//..............................................................................
+//..............................................................................
+
+// INLINES :
+
+class shared_segment::lock_guard
+{
+public:
+    explicit lock_guard( shared_segment_header &a_header ) noexcept
+        : m_lock{ a_header.lock }
+    {
+        while ( m_lock.exchange(1u, std::memory_order_acquire) != 0u )
+        {
+            while ( m_lock.load(std::memory_order_relaxed) != 0u )
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+    lock_guard( lock_guard const & ) = delete;
+    lock_guard &operator=( lock_guard const & ) = delete;
+    ~lock_guard() { m_lock.store(0u, std::memory_order_release); }
+private:
+    std::atomic<std::uint32_t> &m_lock;
+};
+
+inline void
+shared_segment::map( int a_fd, std::size_t a_size )
+{
+    auto *const p = ::mmap(nullptr, a_size, PROT_READ | PROT_WRITE, MAP_SHARED, a_fd, 0);
+    ::close(a_fd);// the mapping keeps the segment
+    if ( p == MAP_FAILED )
+    {
+        throw interprocess_error{ "cannot map " + m_name };
+    }
+    m_data = static_cast<char *>(p);
+    m_size = a_size;
+}
+
+inline
+shared_segment::shared_segment( std::string a_name, std::size_t a_size )
+    : m_name{ std::move(a_name) }
+{
+    if ( a_size < sizeof(shared_segment_header) + shared_segment_block_alignment )
+    {
+        throw interprocess_error{ "segment " + m_name + " is too small" };
+    }
+    auto const fd = ::shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if ( fd < 0 )
+    {
+        throw interprocess_error{ "cannot create " + m_name };
+    }
+    if ( ::ftruncate(fd, static_cast<off_t>(a_size)) != 0 )
+    {
+        ::close(fd);
+        ::shm_unlink(m_name.c_str());
+        throw interprocess_error{ "cannot resize " + m_name };
+    }
+    try
+    {
+        map(fd, a_size);
+    }
+    catch ( ... )
+    {
+        ::shm_unlink(m_name.c_str());
+        throw;
+    }
+
+    auto *const h = new (m_data) shared_segment_header{};// zero-filled, unlocked
+    h->version = shared_segment_version;
+    h->size = a_size;
+    h->top = ( sizeof(shared_segment_header) + shared_segment_block_alignment - 1 ) / shared_segment_block_alignment * shared_segment_block_alignment;
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(h->magic, shared_segment_magic, sizeof(h->magic));// last : the segment is valid
+}
+
+inline
+shared_segment::shared_segment( std::string a_name )
+    : m_name{ std::move(a_name) }
+{
+    auto const fd = ::shm_open(m_name.c_str(), O_RDWR, 0600);
+    if ( fd < 0 )
+    {
+        throw interprocess_error{ "cannot open " + m_name };
+    }
+    struct stat st{};
+    if ( ::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(shared_segment_header) )
+    {
+        ::close(fd);
+        throw interprocess_error{ m_name + " is not a shared segment (too small)" };
+    }
+    map(fd, static_cast<std::size_t>(st.st_size));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if ( std::memcmp(header().magic, shared_segment_magic, sizeof(shared_segment_magic)) != 0
+      || header().version != shared_segment_version || header().size != m_size )
+    {
+        ::munmap(m_data, m_size);
+        throw interprocess_error{ m_name + " is not a shared segment of version " + std::to_string(shared_segment_version) };
+    }
+}
+
+inline
+shared_segment::~shared_segment()
+{
+    ::munmap(m_data, m_size);
+}
+
+inline std::size_t
+shared_segment::used_size() const noexcept
+{
+    lock_guard const guard{ header() };
+    return static_cast<std::size_t>(header().used_size);
+}
+
+inline std::uint64_t
+shared_segment::allocate( std::size_t a_size, std::size_t a_alignment, std::uint64_t a_fingerprint, std::uint32_t a_flags )
+{
+    auto const align = []( std::uint64_t a_offset, std::uint64_t a_alignment ) { return ( a_offset + a_alignment - 1 ) / a_alignment * a_alignment; };
+    auto const data_offset = align(sizeof(shared_object_header), a_alignment);
+    auto const block_size = align(data_offset + a_size, shared_segment_block_alignment);
+
+    auto &h = header();
+    auto offset = std::uint64_t{0};
+    {
+        lock_guard const guard{ h };
+
+        // first fit in the free blocks, splitting the larger ones :
+        for ( auto *link = &h.free_list; *link != 0; link = &object(*link).next_free )
+        {
+            auto &block = object(*link);
+            if ( block.block_size >= block_size )
+            {
+                offset = *link;
+                auto const rest = block.block_size - block_size;
+                if ( rest >= 2 * shared_segment_block_alignment )
+                {
+                    auto &tail = *new (m_data + offset + block_size) shared_object_header{};
+                    tail.block_size = rest;
+                    tail.next_free = block.next_free;
+                    *link = offset + block_size;
+                    block.block_size = block_size;
+                }
+                else
+                {
+                    *link = block.next_free;
+                }
+                break;
+            }
+        }
+        if ( offset == 0 )
+        {
+            if ( block_size > h.size - h.top )
+            {
+                throw interprocess_error{ "segment " + m_name + " is full" };
+            }
+            offset = h.top;
+            h.top += block_size;
+            new (m_data + offset) shared_object_header{};
+            object(offset).block_size = block_size;
+        }
+        h.used_size += object(offset).block_size;
+    }
+
+    auto &block = object(offset);
+    block.fingerprint = a_fingerprint;
+    block.next_free = 0;
+    block.data_offset = static_cast<std::uint32_t>(data_offset);
+    block.flags = a_flags;
+    block.use_count.store(1, std::memory_order_relaxed);// published by the caller's handle
+    return offset;
+}
+
+inline void
+shared_segment::retain( std::uint64_t a_offset ) const noexcept
+{
+    object(a_offset).use_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void
+shared_segment::release( std::uint64_t a_offset ) noexcept
+{
+    auto &block = object(a_offset);
+    if ( block.use_count.fetch_sub(1, std::memory_order_acq_rel) != 1 )
+    {
+        return;
+    }
+    // the objects are trivially destructible : no destructor to run, whichever process releases them
+    auto &h = header();
+    lock_guard const guard{ h };
+    h.used_size -= block.block_size;
+    block.next_free = h.free_list;
+    h.free_list = a_offset;
+}
+
+inline void
+shared_segment::publish( std::uint64_t a_offset, std::string const &a_name )
+{
+    if ( a_name.empty() || a_name.size() >= shared_segment_name_size )
+    {
+        throw interprocess_error{ "bad published name " + a_name };
+    }
+    auto &h = header();
+    lock_guard const guard{ h };
+    shared_segment_entry *free_entry = nullptr;
+    for ( auto &entry : h.directory )
+    {
+        if ( entry.object_offset == 0 )
+        {
+            free_entry = free_entry == nullptr ? &entry : free_entry;
+        }
+        else if ( a_name == entry.name )
+        {
+            throw interprocess_error{ a_name + " is already published" };
+        }
+    }
+    if ( free_entry == nullptr )
+    {
+        throw interprocess_error{ "the directory of " + m_name + " is full" };
+    }
+    std::memset(free_entry->name, 0, sizeof(free_entry->name));
+    std::memcpy(free_entry->name, a_name.data(), a_name.size());
+    retain(a_offset);
+    free_entry->object_offset = a_offset;
+}
+
+inline std::uint64_t
+shared_segment::find( std::string const &a_name ) const noexcept
+{
+    auto &h = header();
+    lock_guard const guard{ h };
+    for ( auto const &entry : h.directory )
+    {
+        if ( entry.object_offset != 0 && a_name == entry.name )
+        {
+            retain(entry.object_offset);
+            return entry.object_offset;
+        }
+    }
+    return 0;
+}
+
+inline bool
+shared_segment::unpublish( std::string const &a_name ) noexcept
+{
+    auto offset = std::uint64_t{0};
+    {
+        auto &h = header();
+        lock_guard const guard{ h };
+        for ( auto &entry : h.directory )
+        {
+            if ( entry.object_offset != 0 && a_name == entry.name )
+            {
+                offset = entry.object_offset;
+                entry.object_offset = 0;
+                break;
+            }
+        }
+    }
+    if ( offset == 0 )
+    {
+        return false;
+    }
+    release(offset);// outside the lock (it takes it when the block is freed)
+    return true;
+}
+
+//..............................................................................
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Create and map a new shared segment of the given size.
+/// @param a_name The POSIX shared memory name (e.g. "/my_tables").
+/// @throw @c interprocess_error if a segment of the same name exists, or on system failure.
+inline std::shared_ptr<shared_segment>
+make_shared_segment( std::string const &a_name, std::size_t a_size )
+{
+    return std::make_shared<shared_segment>(a_name, a_size);
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Map the existing shared segment of the given name.
+/// @throw @c interprocess_error if there is no such segment, or if it is not a valid segment of this version.
+inline std::shared_ptr<shared_segment>
+open_shared_segment( std::string const &a_name )
+{
+    return std::make_shared<shared_segment>(a_name);
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Remove the name of the given shared segment : it is destroyed once unmapped by all the processes.
+inline bool
+remove_shared_segment( std::string const &a_name ) noexcept
+{
+    return ::shm_unlink(a_name.c_str()) == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::INTERPROCESS
+////////////////////////////////////////////////////////////////////////////////
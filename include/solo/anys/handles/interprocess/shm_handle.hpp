@@ -0,0 +1,422 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/interprocess/shared_segment.hpp>
+#include <solo/anys/handles/interprocess/interprocess_error.hpp>
+
+#include <solo/anys/handles/errors/any_handle_cast_error.hpp>
+#include <solo/anys/handles/make_any_type_index.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace interprocess {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+class shm_handle;
+
+template < typename T >
+class shm_ptr;
+
+template < typename T >
+class shm_handle_cast_result;
+
+template < typename T, typename... Args >
+shm_handle make_shm_handle( std::shared_ptr<shared_segment> const &a_segment, Args &&...a_args );
+
+template < typename T, typename... Args >
+shm_handle make_shm_handle_mutable( std::shared_ptr<shared_segment> const &a_segment, Args &&...a_args );
+
+template < typename T >
+shm_handle_cast_result<T const> shm_handle_cast( shm_handle const &a_handle ) noexcept;
+
+template < typename T >
+shm_handle_cast_result<T> shm_handle_mutable_cast( shm_handle const &a_handle ) noexcept;
+
+void publish_shm_handle( shm_handle const &a_handle, std::string const &a_name );
+shm_handle find_shm_handle( std::shared_ptr<shared_segment> const &a_segment, std::string const &a_name ) noexcept;
+bool unpublish_shm_handle( shared_segment &a_segment, std::string const &a_name ) noexcept;
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+namespace detail {
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief One owning reference to a block of a shared segment (the common part of @c shm_handle and @c shm_ptr).
+class shm_reference
+{
+public:
+
+    constexpr shm_reference() noexcept = default;
+
+    /// @brief Adopt the given reference (already retained).
+    shm_reference( std::shared_ptr<shared_segment> a_segment, std::uint64_t a_offset ) noexcept
+        : m_segment{ std::move(a_segment) }
+        , m_offset{ a_offset }
+    {}
+
+    shm_reference( shm_reference const &a_other ) noexcept
+        : m_segment{ a_other.m_segment }
+        , m_offset{ a_other.m_offset }
+    {
+        if ( m_offset != 0 ) { m_segment->retain(m_offset); }
+    }
+
+    shm_reference( shm_reference &&a_other ) noexcept
+        : m_segment{ std::move(a_other.m_segment) }
+        , m_offset{ std::exchange(a_other.m_offset, 0) }
+    {}
+
+    shm_reference &operator=( shm_reference a_other ) noexcept
+    {
+        std::swap(m_segment, a_other.m_segment);
+        std::swap(m_offset, a_other.m_offset);
+        return *this;
+    }
+
+    ~shm_reference()
+    {
+        if ( m_offset != 0 ) { m_segment->release(m_offset); }
+    }
+
+    std::shared_ptr<shared_segment> const &segment() const noexcept { return m_segment; }
+    std::uint64_t offset() const noexcept { return m_offset; }
+
+    shared_object_header &object() const noexcept { return m_segment->object(m_offset); }
+
+private:
+
+    std::shared_ptr<shared_segment> m_segment{};
+    std::uint64_t m_offset{0};
+};
+
+}// EONS DETAIL
+
+//..............................................................................
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief A handle to an object of a shared segment, usable by all the processes mapping the segment.
+///
+/// The counterpart of @c any_handle for the objects shared between processes :
+/// the object lives in a @c shared_segment, its reference count is a cross-process atomic of the segment,
+/// and its type is identified by its fingerprint (see @c any_type_index::fingerprint) instead of @c std::type_info,
+/// which is not comparable between processes.
+///
+/// Copying a handle increments the shared reference count, destroying it decrements it :
+/// the block of the object is reused once no process references it.
+/// A handle keeps its segment mapped.
+///
+/// @note The shared objects are trivially destructible (no destructor runs) and hold no pointer
+/// (the segment is mapped at a different address in each process).
+class shm_handle
+{
+public:
+
+    /// @brief Build an empty handle.
+    constexpr shm_handle() noexcept = default;
+
+    /// @brief Return true if the handle is empty.
+    bool empty() const noexcept { return m_reference.offset() == 0; }
+
+    /// @brief Return true if the object can be cast to a mutable object (see @c shm_handle_mutable_cast).
+    bool is_mutable() const noexcept;
+
+    /// @brief Return the fingerprint of the type of the object (0 for an empty handle).
+    std::uint64_t type_fingerprint() const noexcept;
+
+    /// @brief Return the number of references to the object, in all the processes (0 for an empty handle).
+    std::uint64_t use_count() const noexcept;
+
+    /// @brief Return the segment of the object (null for an empty handle).
+    std::shared_ptr<shared_segment> const &segment() const noexcept { return m_reference.segment(); }
+
+    /// @brief Return the offset of the object block in its segment (0 for an empty handle).
+    std::uint64_t offset() const noexcept { return m_reference.offset(); }
+
+protected:
+
+    /// @brief Adopt the given reference (already retained).
+    explicit shm_handle( detail::shm_reference a_reference ) noexcept
+        : m_reference{ std::move(a_reference) }
+    {}
+
+    friend struct shm_handle_builder;
+
+private:
+
+    detail::shm_reference m_reference{};
+};
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The builder of the handles (the constructor of a handle is protected).
+struct shm_handle_builder
+{
+    static shm_handle build( std::shared_ptr<shared_segment> a_segment, std::uint64_t a_offset ) noexcept
+    {
+        return shm_handle{ detail::shm_reference{ std::move(a_segment), a_offset } };
+    }
+
+    static detail::shm_reference const &reference( shm_handle const &a_handle ) noexcept
+    {
+        return a_handle.m_reference;
+    }
+};
+
+//..............................................................................
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief An owning typed pointer to an object of a shared segment : the value of a successful @c shm_handle_cast.
+///
+/// It owns a reference, like the @c std::shared_ptr returned by @c any_handle_cast, without any allocation.
+template < typename T >
+class shm_ptr
+{
+public:
+
+    using element_type = T;
+
+    constexpr shm_ptr() noexcept = default;
+
+    explicit shm_ptr( detail::shm_reference a_reference ) noexcept
+        : m_reference{ std::move(a_reference) }
+        , m_ptr{ static_cast<T *>( m_reference.segment()->object_data(m_reference.offset()) ) }
+    {}
+
+    T *get() const noexcept { return m_ptr; }
+    T &operator*() const noexcept { return *m_ptr; }
+    T *operator->() const noexcept { return m_ptr; }
+    explicit operator bool() const noexcept { return m_ptr != nullptr; }
+
+    std::uint64_t use_count() const noexcept
+    {
+        return m_ptr == nullptr ? 0 : m_reference.object().use_count.load(std::memory_order_relaxed);
+    }
+
+private:
+
+    detail::shm_reference m_reference{};
+    T *m_ptr{nullptr};
+};
+
+//..............................................................................
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The result of @c shm_handle_cast and @c shm_handle_mutable_cast : a @c shm_ptr or an @c any_handle_cast_error.
+///
+/// Same interface as @c any_handle_cast_result.
+template < typename T >
+class shm_handle_cast_result
+{
+public:
+
+    using value_type = shm_ptr<T>;
+    using error_type = anys::errors::any_handle_cast_error;
+
+    shm_handle_cast_result( value_type &&a_value ) noexcept
+        : m_value{std::move(a_value)}
+        , m_valuable{true}
+    {}
+
+    shm_handle_cast_result( error_type &&a_error ) noexcept
+        : m_error{std::move(a_error)}
+        , m_valuable{false}
+    {}
+
+    shm_handle_cast_result() = delete;
+
+    bool has_value() const noexcept { return m_valuable; }
+
+    value_type const &assume_value() const & noexcept { return m_value; }
+
+    value_type assume_move_value() && noexcept { return std::move(m_value); }
+
+    bool has_error() const noexcept { return not m_valuable; }
+
+    error_type const &assume_error() const & noexcept { return m_error; }
+
+private:
+
+    value_type m_value{};
+    error_type m_error{};
+    bool m_valuable{false};
+};
+
+//..............................................................................
+//..............................................................................
+
+// INLINES :
+
+inline bool
+shm_handle::is_mutable() const noexcept
+{
+    return !empty() && ( m_reference.object().flags & shared_object_mutable ) != 0u;
+}
+
+inline std::uint64_t
+shm_handle::type_fingerprint() const noexcept
+{
+    return empty() ? 0 : m_reference.object().fingerprint;
+}
+
+inline std::uint64_t
+shm_handle::use_count() const noexcept
+{
+    return empty() ? 0 : m_reference.object().use_count.load(std::memory_order_relaxed);
+}
+
+//..............................................................................
+
+namespace detail {
+
+template < typename T >
+std::uint64_t
+shm_type_fingerprint() noexcept
+{
+    return make_any_type_index<T>().fingerprint();
+}
+
+template < typename T, typename... Args >
+shm_handle
+make_shm_handle_with_flags( std::shared_ptr<shared_segment> const &a_segment, std::uint32_t a_flags, Args &&...a_args )
+{
+    static_assert(std::is_trivially_destructible<T>::value, "shared objects are not destroyed : T must be trivially destructible");
+    static_assert(alignof(T) <= shared_segment_block_alignment, "T is over-aligned for a shared segment");
+
+    if ( !a_segment )
+    {
+        throw interprocess_error{ "no segment" };
+    }
+    auto const offset = a_segment->allocate(sizeof(T), alignof(T), shm_type_fingerprint<T>(), a_flags);
+    auto handle = shm_handle_builder::build(a_segment, offset);// releases the block if the constructor throws
+    ::new ( a_segment->object_data(offset) ) T( std::forward<Args>(a_args)... );
+    return handle;
+}
+
+template < typename T >
+anys::errors::any_handle_cast_error
+check_shm_handle_cast( shm_handle const &a_handle, bool a_mutable ) noexcept
+{
+    using errc = anys::errors::any_handle_cast_errc;
+    if ( a_handle.empty() )
+    {
+        return anys::errors::any_handle_cast_error{ errc::empty_source };
+    }
+    if ( a_handle.type_fingerprint() != shm_type_fingerprint<std::remove_const_t<T>>() )
+    {
+        return anys::errors::any_handle_cast_error{ errc::bad_source_type };
+    }
+    if ( a_mutable && !a_handle.is_mutable() )
+    {
+        return anys::errors::any_handle_cast_error{ errc::bad_source_mutability };
+    }
+    return anys::errors::any_handle_cast_error{};
+}
+
+}// EONS DETAIL
+
+//..............................................................................
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Build a non-mutable object of type @c T in the given segment, and return its handle.
+/// @throw @c interprocess_error if the segment is full, or what the constructor of @c T throws.
+template < typename T, typename... Args >
+shm_handle
+make_shm_handle( std::shared_ptr<shared_segment> const &a_segment, Args &&...a_args )
+{
+    return detail::make_shm_handle_with_flags<T>(a_segment, 0u, std::forward<Args>(a_args)...);
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Build a mutable object of type @c T in the given segment, and return its handle.
+/// @throw @c interprocess_error if the segment is full, or what the constructor of @c T throws.
+/// @note The library does not synchronize the accesses to a mutable shared object : use atomics or a lock of your own.
+template < typename T, typename... Args >
+shm_handle
+make_shm_handle_mutable( std::shared_ptr<shared_segment> const &a_segment, Args &&...a_args )
+{
+    return detail::make_shm_handle_with_flags<T>(a_segment, shared_object_mutable, std::forward<Args>(a_args)...);
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Cast the given handle to a constant object of type @c T (compared by fingerprint).
+/// @return A @c shm_ptr<T const>, or an @c any_handle_cast_error (empty source, bad source type).
+template < typename T >
+shm_handle_cast_result<T const>
+shm_handle_cast( shm_handle const &a_handle ) noexcept
+{
+    auto error = detail::check_shm_handle_cast<T>(a_handle, false);
+    if ( error.code() != anys::errors::any_handle_cast_errc::undefined )
+    {
+        return shm_handle_cast_result<T const>{ std::move(error) };
+    }
+    return shm_handle_cast_result<T const>{ shm_ptr<T const>{ shm_handle_builder::reference(a_handle) } };
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Cast the given handle to a mutable object of type @c T (compared by fingerprint).
+/// @return A @c shm_ptr<T>, or an @c any_handle_cast_error (empty source, bad source type, bad source mutability).
+template < typename T >
+shm_handle_cast_result<T>
+shm_handle_mutable_cast( shm_handle const &a_handle ) noexcept
+{
+    auto error = detail::check_shm_handle_cast<T>(a_handle, true);
+    if ( error.code() != anys::errors::any_handle_cast_errc::undefined )
+    {
+        return shm_handle_cast_result<T>{ std::move(error) };
+    }
+    return shm_handle_cast_result<T>{ shm_ptr<T>{ shm_handle_builder::reference(a_handle) } };
+}
+
+//..............................................................................
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Publish the given handle under the given name in the directory of its segment (which keeps it alive).
+/// @throw @c interprocess_error if the handle is empty, the name too long or already published, or the directory full.
+inline void
+publish_shm_handle( shm_handle const &a_handle, std::string const &a_name )
+{
+    if ( a_handle.empty() )
+    {
+        throw interprocess_error{ "cannot publish an empty handle as " + a_name };
+    }
+    a_handle.segment()->publish(a_handle.offset(), a_name);
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Return the handle published under the given name in the given segment, or an empty handle.
+inline shm_handle
+find_shm_handle( std::shared_ptr<shared_segment> const &a_segment, std::string const &a_name ) noexcept
+{
+    auto const offset = a_segment->find(a_name);
+    return offset == 0 ? shm_handle{} : shm_handle_builder::build(a_segment, offset);
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Withdraw the given name from the directory of the given segment (the existing handles remain valid).
+/// @return false if the name was not published.
+inline bool
+unpublish_shm_handle( shared_segment &a_segment, std::string const &a_name ) noexcept
+{
+    return a_segment.unpublish(a_name);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::INTERPROCESS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,21 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+/// @file
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Opt-in lazy handles, building their object on its first cast (not included by the library packages).
+///
+/// - @c solo::anys::lazy::make_any_handle_lazy<T>, @c make_any_handle_mutable_lazy<T> : the factories,
+/// from the constructor arguments (@c stdex::in_place) or from a callable returning the object.
+///
+/// The casts and accessors of @c any_handle build the object of a lazy handle, exactly once :
+/// an eager handle pays one flag test of its type information.
+
+#include <solo/anys/handles/lazy/make_any_handle_lazy.hpp>
@@ -0,0 +1,308 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/any_handle_core_package.hpp>
+#include <solo/anys/handles/any_type_tag.hpp>
+#include <solo/anys/handles/details/any_type_index_builder_t.hpp>
+#include <solo/anys/handles/details/lazy_object_header.hpp>
+#include <solo/anys/handles/details/select_any_type_info_instance_t.hpp>
+
+#include <stdex/in_place_t.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace lazy {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+template < typename T, typename... Args >
+any_handle make_any_handle_lazy( stdex::in_place_t, Args&&... a_type_constructor_arguments_list );
+
+template < typename T, typename Factory, typename >
+any_handle make_any_handle_lazy( Factory &&a_factory );
+
+template < typename T, typename... Args >
+any_handle make_any_handle_mutable_lazy( stdex::in_place_t, Args&&... a_type_constructor_arguments_list );
+
+template < typename T, typename Factory, typename >
+any_handle make_any_handle_mutable_lazy( Factory &&a_factory );
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+namespace detail {
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Return the two static lazy type informations of the type @c T (non-mutable at index 0, mutable at index 1).
+/// @note Equal to the ones of @c anys::detail::any_type_info_instances<T>() but for the lazy flag, which is not compared.
+template < typename T >
+inline anys::detail::any_type_info const *
+lazy_any_type_info_instances() noexcept
+{
+    static anys::detail::any_type_info const stis[2] = {
+        anys::detail::any_type_info{ typeid(T), mutability::false_, any_type_tag<T>::value, true },
+        anys::detail::any_type_info{ typeid(T), mutability::true_, any_type_tag<T>::value, true }
+    };
+    return stis;
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The factory constructing the object in place from the stored constructor arguments.
+///
+/// The arguments are given as lvalues when @c T is constructible from them : a failed construction leaves them intact
+/// for the next attempt. Otherwise (move-only arguments), they are moved : a failed construction may have consumed them,
+/// and the next attempts rethrow its exception instead of building another object.
+template < typename T, typename... Args >
+class lazy_arguments
+{
+public:
+
+    template < typename... Brgs >
+    explicit lazy_arguments( Brgs&&... a_args )
+        : m_args{ std::forward<Brgs>(a_args)... }
+    {}
+
+    void operator()( void *a_storage )
+    {
+        if ( m_failure )
+        {
+            std::rethrow_exception(m_failure);// the arguments may have been consumed
+        }
+        construct(a_storage, std::is_constructible<T, Args &...>{}, std::index_sequence_for<Args...>{});
+    }
+
+private:
+
+    template < std::size_t... Is >
+    void construct( void *a_storage, std::true_type, std::index_sequence<Is...> )
+    {
+        ::new (a_storage) T( std::get<Is>(m_args)... );// released once built
+    }
+
+    template < std::size_t... Is >
+    void construct( void *a_storage, std::false_type, std::index_sequence<Is...> )
+    {
+        try
+        {
+            ::new (a_storage) T( std::get<Is>(std::move(m_args))... );
+        }
+        catch ( ... )
+        {
+            m_failure = std::current_exception();
+            throw;
+        }
+    }
+
+    std::tuple<Args...> m_args;
+    std::exception_ptr m_failure;
+};
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The factory constructing the object in place from the result of a callable.
+template < typename T, typename F >
+class lazy_callable
+{
+public:
+
+    template < typename G >
+    explicit lazy_callable( G &&a_callable )
+        : m_callable{ std::forward<G>(a_callable) }
+    {}
+
+    void operator()( void *a_storage )
+    {
+        ::new (a_storage) T( m_callable() );
+    }
+
+private:
+
+    F m_callable;
+};
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The single allocation of a lazy object : its factory, then the lazy object header, then the storage of the object.
+///
+/// The header is placed right before the storage, where @c any_handle finds it (see @c anys::detail::lazy_object_header).
+/// The factory is destroyed once the object is built.
+template < typename T, typename Factory >
+class lazy_block
+{
+public:
+
+    explicit lazy_block( Factory &&a_factory )
+    {
+        ::new (static_cast<void *>(&m_factory)) Factory( std::move(a_factory) );
+        auto *const h = ::new (static_cast<void *>(header())) anys::detail::lazy_object_header{};
+        h->m_build = &lazy_block::build;
+        h->m_block = this;
+    }
+
+    lazy_block( lazy_block const & ) = delete;
+    lazy_block &operator=( lazy_block const & ) = delete;
+
+    ~lazy_block()
+    {
+        if ( header()->m_built.load(std::memory_order_relaxed) )// ordered by the release of the last owner
+        {
+            object()->~T();
+        }
+        else
+        {
+            m_factory.~Factory();
+        }
+        header()->~lazy_object_header();
+    }
+
+    /// @brief Return the address of the object (built or not).
+    T *object() noexcept
+    {
+        return reinterpret_cast<T *>( m_bytes + storage_offset );
+    }
+
+private:
+
+    static constexpr std::size_t header_size = sizeof(anys::detail::lazy_object_header);
+    static constexpr std::size_t block_alignment = alignof(T) > alignof(anys::detail::lazy_object_header)
+                                                 ? alignof(T) : alignof(anys::detail::lazy_object_header);
+    static constexpr std::size_t storage_offset = ( header_size + block_alignment - 1 ) / block_alignment * block_alignment;
+
+    anys::detail::lazy_object_header *header() noexcept
+    {
+        return reinterpret_cast<anys::detail::lazy_object_header *>( m_bytes + storage_offset - header_size );
+    }
+
+    /// @brief Build the object (first cast only) ; the concurrent first casts wait for it.
+    /// @throw Whatever the construction throws : the object is left unbuilt and its factory kept, the next cast retries.
+    static void build( void *a_block )
+    {
+        auto &self = *static_cast<lazy_block *>(a_block);
+        std::lock_guard<std::mutex> lock{ self.m_mutex };
+        if ( !self.header()->m_built.load(std::memory_order_relaxed) )// not built by a concurrent first cast
+        {
+            self.m_factory(self.object());
+            self.m_factory.~Factory();
+            self.header()->m_built.store(true, std::memory_order_release);
+        }
+    }
+
+    std::mutex m_mutex;
+    union { Factory m_factory; };
+    alignas(block_alignment) unsigned char m_bytes[storage_offset + sizeof(T)];
+};
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Allocate the block of a lazy object of type @c T, and return a handle to its storage.
+template < typename T, typename Factory >
+inline any_handle
+make_lazy_handle( mutability a_ismutable, Factory &&a_factory )
+{
+    static_assert(!std::is_reference<T>::value, "T should not be a reference type");
+    static_assert(!std::is_const<T>::value && !std::is_volatile<T>::value, "T should not be cv-qualified");
+
+    auto block = std::make_shared<lazy_block<T, Factory>>( std::move(a_factory) );
+    auto *const object = block->object();
+    return anys::detail::any_handle_builder<void>{
+        any_type_index{
+            anys::details::any_type_index_builder{
+                anys::detail::select_any_type_info_instance(lazy_any_type_info_instances<T>(), mutability_as_boolean(a_ismutable))
+            }
+        },
+        std::shared_ptr<void>{ block, object }// aliasing
+    };
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Enable the callable overloads for the non-@c in_place_t arguments only.
+template < typename Factory >
+using enable_if_lazy_callable_t = std::enable_if_t<!std::is_same<std::decay_t<Factory>, stdex::in_place_t>::value>;
+
+}// EONS DETAIL
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Build a handle to a non-mutable object of type @c T, constructed from the given arguments on its first cast.
+///
+/// The handle has the type of @c T right away (type queries, comparisons, failing casts do not build the object) ;
+/// the first successful cast (@c any_handle_cast, @c any_handle_mutable_cast, their @c _or_throw variants) constructs it,
+/// exactly once whatever the number of threads racing for it. Afterwards, a cast costs one more acquire load than
+/// the cast of an eager handle, which pays one flag test. The accessors of the handle (@c pointer, @c get) do not build
+/// the object : they return the address of its storage.
+///
+/// Example:
+///
+/// @code
+///     auto h = solo::anys::lazy::make_any_handle_lazy<Config>(stdex::in_place, "config.json");
+///     assert(h.type() == typeid(Config));// not parsed yet
+///     auto config = solo::any_handle_cast<Config>(h);// parsed here
+/// @endcode
+///
+/// @note The arguments are decay-copied into the single allocation of the object (use @c std::ref to pass a reference),
+/// and released once the object is built.
+/// @note A throwing construction leaves the object unbuilt : @c any_handle_cast_or_throw lets the exception propagate,
+/// @c any_handle_cast returns an @c any_handle_cast_errc::failed_source_construction error, and the next cast retries
+/// with the same arguments (given as lvalues). When @c T needs them as rvalues (move-only arguments), a failed construction
+/// may have consumed them : the handle fails for good, and the next casts fail the same way.
+template < typename T, typename... Args >
+inline any_handle
+make_any_handle_lazy( stdex::in_place_t, Args&&... a_type_constructor_arguments_list )
+{
+    using factory_type = detail::lazy_arguments<std::remove_cv_t<T>, std::decay_t<Args>...>;
+    return detail::make_lazy_handle<std::remove_cv_t<T>>(mutability::false_, factory_type{ std::forward<Args>(a_type_constructor_arguments_list)... });
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Build a handle to a non-mutable object of type @c T, constructed from the result of the given callable on its first cast.
+/// @pre <c>a_factory()</c> returns a @c T (moved into the handled object before C++17).
+/// @see The @c in_place_t overload.
+template < typename T, typename Factory, typename = detail::enable_if_lazy_callable_t<Factory> >
+inline any_handle
+make_any_handle_lazy( Factory &&a_factory )
+{
+    using factory_type = detail::lazy_callable<std::remove_cv_t<T>, std::decay_t<Factory>>;
+    return detail::make_lazy_handle<std::remove_cv_t<T>>(mutability::false_, factory_type{ std::forward<Factory>(a_factory) });
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Build a handle to a mutable object of type @c T, constructed from the given arguments on its first cast.
+/// @see @c make_any_handle_lazy.
+template < typename T, typename... Args >
+inline any_handle
+make_any_handle_mutable_lazy( stdex::in_place_t, Args&&... a_type_constructor_arguments_list )
+{
+    static_assert(!std::is_const<T>::value && !std::is_volatile<T>::value, "T should not be cv-qualified");
+    using factory_type = detail::lazy_arguments<T, std::decay_t<Args>...>;
+    return detail::make_lazy_handle<T>(mutability::true_, factory_type{ std::forward<Args>(a_type_constructor_arguments_list)... });
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Build a handle to a mutable object of type @c T, constructed from the result of the given callable on its first cast.
+/// @see @c make_any_handle_lazy.
+template < typename T, typename Factory, typename = detail::enable_if_lazy_callable_t<Factory> >
+inline any_handle
+make_any_handle_mutable_lazy( Factory &&a_factory )
+{
+    static_assert(!std::is_const<T>::value && !std::is_volatile<T>::value, "T should not be cv-qualified");
+    using factory_type = detail::lazy_callable<T, std::decay_t<Factory>>;
+    return detail::make_lazy_handle<T>(mutability::true_, factory_type{ std::forward<Factory>(a_factory) });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::LAZY
+////////////////////////////////////////////////////////////////////////////////
@@ -74,7 +74,7 @@ inline any_handle
 make_any_handle( std::shared_ptr<const T> const &a_shared_pointer_to_copy )
 {
     static_assert(!std::is_reference<T>::value,"");
-    return anys::detail::any_handle_builder<T>(a_shared_pointer_to_copy);
+    return anys::detail::any_handle_builder<T>::build(a_shared_pointer_to_copy);
 }
 
 /// @ingroup SoloAnyHandle
@@ -84,7 +84,7 @@ make_any_handle( std::shared_ptr<T> const &a_shared_pointer_to_copy )
 {
     static_assert(!std::is_reference<T>::value, "T should not be a reference type");
     static_assert(!std::is_const<T>::value && !std::is_volatile<T>::value, "T should not be cv-qualified");
-    return anys::detail::any_handle_builder<T>{a_shared_pointer_to_copy, mutability::false_};
+    return anys::detail::any_handle_builder<T>::build(a_shared_pointer_to_copy, mutability::false_);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -10,12 +10,15 @@
 #pragma once
 
 #include <solo/anys/handles/make_any_handle.hpp>
+#include <solo/anys/handles/details/make_owned_shared_t.hpp>
 
 #include <stdex/in_place_t.hpp>
 #include <stdex/in_place_type_t.hpp>
 #include <stdex/observer_ptr.hpp>
 #include <boost/hof/is_invocable.hpp>
 
+#include <memory>
+
 ////////////////////////////////////////////////////////////////////////////////
 namespace solo {
 ////////////////////////////////////////////////////////////////////////////////
@@ -28,6 +31,9 @@ any_handle make_any_handle( stdex::in_place_t, Args&&... a_type_constructor_argu
 template < typename T, typename U, typename... Args >
 any_handle make_any_handle( stdex::in_place_type_t<U>, Args&&... a_type_constructor_arguments_list );
 
+template < typename T, typename Alloc, typename... Args >
+any_handle make_any_handle( std::allocator_arg_t, Alloc const &a_allocator, Args&&... a_type_constructor_arguments_list );
+
 template < typename T >
 any_handle make_any_handle( stdex::observer_ptr<T> const &a_non_owned_pointer_to_copy );
 
@@ -66,7 +72,7 @@ make_any_handle( stdex::in_place_t, Args&&... a_type_constructor_arguments_list
     static_assert(!std::is_reference<T>::value, "T should not be a reference type");
 
     // call the first factory :
-    return make_any_handle( std::make_shared<T const>(std::forward<Args>(a_type_constructor_arguments_list)...) );
+    return make_any_handle( anys::detail::make_owned_shared<T const,T const>(mutability::false_, std::forward<Args>(a_type_constructor_arguments_list)...) );
 }
 /// @ingroup SoloAnyHandleAdvanced
 /// @brief Safely build a non-mutable @c any_handle object,
@@ -100,7 +106,36 @@ make_any_handle( stdex::in_place_type_t<U>, Args&&... a_type_constructor_argumen
     static_assert(std::is_convertible<U const*,T const*>::value, "U const * should be convertible to T const *");
 
     // call the first factory (std::shared_ptr<U const> will be implicitly converted to std::shared_ptr<T const>):
-    return make_any_handle<T const>( std::make_shared<U const>(std::forward<Args>(a_type_constructor_arguments_list)...) );
+    return make_any_handle<T const>( anys::detail::make_owned_shared<U const,U const>(mutability::false_, std::forward<Args>(a_type_constructor_arguments_list)...) );
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Safely build a non-mutable @c any_handle object,
+/// building @em in-place an object of type @c T with a given allocator.
+/// @pre @c T is not a reference type.
+/// @pre @c T is constructible from @c args .
+/// @param a_allocator The allocator used (through @c std::allocate_shared) to allocate both the control block and the object.
+/// @param a_type_constructor_arguments_list A list of arguments from which the object can be constructed.
+///
+/// Example:
+///
+/// @code
+///     // keep the control block and the object off the cache lines of their neighbours :
+///     auto y = make_any_handle<A>(std::allocator_arg, anys::allocators::cache_line_allocator<A>{}, args);
+///     assert(y.use_count() == 1);
+///     assert(y.type() == typeid(A));
+///     assert(y.is_mutable() == false);
+/// @endcode
+///
+/// @see @c anys::allocators::cache_line_allocator.
+template < typename T, typename Alloc, typename... Args >
+inline any_handle
+make_any_handle( std::allocator_arg_t, Alloc const &a_allocator, Args&&... a_type_constructor_arguments_list )
+{
+    static_assert(!std::is_reference<T>::value, "T should not be a reference type");
+
+    // call the first factory :
+    return make_any_handle( anys::detail::make_owned_allocated_shared<T const,T const>(a_allocator, mutability::false_, std::forward<Args>(a_type_constructor_arguments_list)...) );
 }
 
 /// @ingroup SoloAnyHandleAdvanced
@@ -175,7 +210,7 @@ make_any_handle( T *a_raw_pointer_to_copy, F &&a_callable_finalizer )
     static_assert(boost::hof::is_invocable<F,std::remove_cv_t<T>*>::value, "Bad finalizer signature");
 
     // call the first factory :
-    return make_any_handle( std::shared_ptr<T const>{ a_raw_pointer_to_copy, std::forward<F>(a_callable_finalizer) } );
+    return make_any_handle( std::shared_ptr<T const>{ anys::detail::make_owned_shared_with_finalizer(a_raw_pointer_to_copy, std::forward<F>(a_callable_finalizer), mutability::false_) } );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -60,7 +60,7 @@ make_any_handle_mutable( std::shared_ptr<T> const &a_shared_pointer_to_copy )
 {
     static_assert(!std::is_reference<T>::value, "T should not be a reference type");
     static_assert(!std::is_const<T>::value && !std::is_volatile<T>::value, "T should not be cv-qualified");
-    return anys::detail::any_handle_builder<T>( a_shared_pointer_to_copy, mutability::true_ );
+    return anys::detail::any_handle_builder<T>::build( a_shared_pointer_to_copy, mutability::true_ );
 }
 
 /// @ingroup SoloAnyHandle
@@ -10,12 +10,15 @@
 #pragma once
 
 #include <solo/anys/handles/make_any_handle_mutable.hpp>
+#include <solo/anys/handles/details/make_owned_shared_t.hpp>
 
 #include <stdex/in_place_t.hpp>
 #include <stdex/in_place_type_t.hpp>
 #include <stdex/observer_ptr.hpp>
 #include <boost/hof/is_invocable.hpp>
 
+#include <memory>
+
 ////////////////////////////////////////////////////////////////////////////////
 namespace solo {
 ////////////////////////////////////////////////////////////////////////////////
@@ -28,6 +31,9 @@ any_handle make_any_handle_mutable( stdex::in_place_t, Args&&... a_type_construc
 template < typename T, typename U, typename... Args >
 any_handle make_any_handle_mutable( stdex::in_place_type_t<U>, Args&&... a_type_constructor_arguments_list );
 
+template < typename T, typename Alloc, typename... Args >
+any_handle make_any_handle_mutable( std::allocator_arg_t, Alloc const &a_allocator, Args&&... a_type_constructor_arguments_list );
+
 template < typename T >
 any_handle make_any_handle_mutable( stdex::observer_ptr<T> const &a_non_owned_pointer_to_copy );
 
@@ -71,7 +77,7 @@ make_any_handle_mutable( stdex::in_place_t, Args&&... a_type_constructor_argumen
     static_assert(!std::is_const<T>::value && !std::is_volatile<T>::value, "T should not be cv-qualified");
 
     // call the first factory :
-    return make_any_handle_mutable( std::make_shared<T>(std::forward<Args>(a_type_constructor_arguments_list)...) );
+    return make_any_handle_mutable( anys::detail::make_owned_shared<T,T>(mutability::true_, std::forward<Args>(a_type_constructor_arguments_list)...) );
 }
 
 /// @ingroup SoloAnyHandleAdvanced
@@ -112,7 +118,39 @@ make_any_handle_mutable( stdex::in_place_type_t<U>, Args&&... a_type_constructor
     static_assert(!std::is_const<U>::value && !std::is_volatile<U>::value, "U should not be cv-qualified");
 
     // call the first factory :
-    return make_any_handle_mutable<T>( std::make_shared<U>(std::forward<Args>(a_type_constructor_arguments_list)...) );
+    return make_any_handle_mutable<T>( anys::detail::make_owned_shared<U,U>(mutability::true_, std::forward<Args>(a_type_constructor_arguments_list)...) );
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Safely build a mutable @c any_handle object, building @em in-place an
+/// object of type @c T with a given allocator.
+/// @pre @c T is a plain type (not a reference type, not cv-qualified).
+/// @pre @c T is constructible from @c args .
+/// @param a_allocator The allocator used (through @c std::allocate_shared) to
+/// allocate both the control block and the object.
+/// @param a_type_constructor_arguments_list A list of arguments from which the
+/// object can be constructed.
+///
+/// Example:
+///
+/// @code
+///     // hot resources created back to back, whose reference counts are updated from different cores :
+///     auto c1 = make_any_handle_mutable<Counter>(std::allocator_arg, anys::allocators::cache_line_allocator<Counter>{});
+///     auto c2 = make_any_handle_mutable<Counter>(std::allocator_arg, anys::allocators::cache_line_allocator<Counter>{});
+///     assert(c1.use_count() == 1);
+///     assert(c1.is_mutable() == true);
+/// @endcode
+///
+/// @see @c anys::allocators::cache_line_allocator.
+template < typename T, typename Alloc, typename... Args >
+inline any_handle
+make_any_handle_mutable( std::allocator_arg_t, Alloc const &a_allocator, Args&&... a_type_constructor_arguments_list )
+{
+    static_assert(!std::is_reference<T>::value, "T should not be a reference type");
+    static_assert(!std::is_const<T>::value && !std::is_volatile<T>::value, "T should not be cv-qualified");
+
+    // call the first factory :
+    return make_any_handle_mutable( anys::detail::make_owned_allocated_shared<T,T>(a_allocator, mutability::true_, std::forward<Args>(a_type_constructor_arguments_list)...) );
 }
 
 /// @ingroup SoloAnyHandleAdvanced
@@ -196,7 +234,7 @@ make_any_handle_mutable( T *a_raw_pointer_to_copy, F &&a_callable_finalizer )
     static_assert(boost::hof::is_invocable<F,std::remove_const_t<T>*>::value, "Bad finalizer signature");
 
     // call the first factory :
-    return make_any_handle_mutable( std::shared_ptr<T>{ a_raw_pointer_to_copy, std::forward<F>(a_callable_finalizer) } );
+    return make_any_handle_mutable( anys::detail::make_owned_shared_with_finalizer(a_raw_pointer_to_copy, std::forward<F>(a_callable_finalizer), mutability::true_) );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
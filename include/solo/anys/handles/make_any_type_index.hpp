@@ -34,7 +34,12 @@ template < typename T >
 inline any_type_index
 make_any_type_index( mutability a_ismutable ) noexcept
 {
-    return anys::details::any_type_index_builder<T>{a_ismutable};
+    return anys::details::any_type_index_builder
+    {
+        anys::detail::select_any_type_info_instance(
+            anys::detail::any_type_info_instances<std::remove_cv_t<T>>(),
+            ( a_ismutable == mutability::true_ ) && !( std::is_const<T>::value ) )
+    };
 }
 
 ////////////////////////////////////////////////////////////////////////////////
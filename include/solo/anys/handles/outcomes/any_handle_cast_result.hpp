@@ -27,9 +27,8 @@ public:
 
     using value_type = std::shared_ptr<T>;
 
-    static_assert(std::is_nothrow_default_constructible<value_type>::value, "");
-    static_assert(std::is_nothrow_move_constructible<value_type>::value, "");
-    static_assert(std::is_nothrow_move_assignable<value_type>::value, "");
+    // std::shared_ptr<T> is nothrow default constructible, move constructible and move assignable for any T :
+    // checked once (below the class), not once per instance.
 
     using error_type = anys::errors::any_handle_cast_error;
 
@@ -90,6 +89,10 @@ private:
     bool m_valuable{false};
 };
 
+static_assert(std::is_nothrow_default_constructible<std::shared_ptr<void>>::value, "");
+static_assert(std::is_nothrow_move_constructible<std::shared_ptr<void>>::value, "");
+static_assert(std::is_nothrow_move_assignable<std::shared_ptr<void>>::value, "");
+
 ////////////////////////////////////////////////////////////////////////////////
 }}}// EONS SOLO::ANYS::OUTCOME
 ////////////////////////////////////////////////////////////////////////////////
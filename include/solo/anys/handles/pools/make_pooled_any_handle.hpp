@@ -0,0 +1,90 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/any_handle_core_package.hpp>
+#include <solo/anys/handles/make_any_handle_ex.hpp>
+#include <solo/anys/handles/make_any_handle_mutable_ex.hpp>
+#include <solo/anys/handles/allocators/slab_allocator.hpp>
+
+#include <stdex/in_place_t.hpp>
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace pools {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+template < typename T, typename... Args >
+any_handle make_pooled_any_handle( stdex::in_place_t, Args&&... a_type_constructor_arguments_list );
+
+template < typename T, typename... Args >
+any_handle make_pooled_any_handle_mutable( stdex::in_place_t, Args&&... a_type_constructor_arguments_list );
+
+template < typename T >
+allocators::slab_statistics pooled_statistics();
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Build @em in-place a non-mutable object of type @c T, allocated with its control block from the slabs of @c T.
+///
+/// Same as <c>make_any_handle<T>(stdex::in_place, args)</c>, without any call to @c malloc once the slabs of @c T
+/// are warm : the block is taken from the magazine of the calling thread, and returned to the magazine of the
+/// thread releasing the last handle (see @c anys::allocators::slab_allocator).
+///
+/// Example:
+///
+/// @code
+///     auto m = solo::anys::pools::make_pooled_any_handle<Message>(stdex::in_place, args);
+///     assert(m.is_mutable() == false);
+///     assert(solo::anys::pools::pooled_statistics<Message>().blocks_in_use >= 1);
+/// @endcode
+template < typename T, typename... Args >
+inline any_handle
+make_pooled_any_handle( stdex::in_place_t, Args&&... a_type_constructor_arguments_list )
+{
+    static_assert(!std::is_reference<T>::value, "T should not be a reference type");
+    using value_type = std::remove_cv_t<T>;
+
+    return make_any_handle<value_type>( std::allocator_arg, allocators::slab_allocator<value_type>{}, std::forward<Args>(a_type_constructor_arguments_list)... );
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Build @em in-place a mutable object of type @c T, allocated with its control block from the slabs of @c T.
+/// @see @c make_pooled_any_handle.
+template < typename T, typename... Args >
+inline any_handle
+make_pooled_any_handle_mutable( stdex::in_place_t, Args&&... a_type_constructor_arguments_list )
+{
+    static_assert(!std::is_reference<T>::value, "T should not be a reference type");
+    static_assert(!std::is_const<T>::value && !std::is_volatile<T>::value, "T should not be cv-qualified");
+
+    return make_any_handle_mutable<T>( std::allocator_arg, allocators::slab_allocator<T>{}, std::forward<Args>(a_type_constructor_arguments_list)... );
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Return a snapshot of the slabs of @c T : blocks reserved and in use, fragmentation.
+template < typename T >
+inline allocators::slab_statistics
+pooled_statistics()
+{
+    return allocators::slab_allocator<std::remove_cv_t<T>>::statistics();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::POOLS
+////////////////////////////////////////////////////////////////////////////////
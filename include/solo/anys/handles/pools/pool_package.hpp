@@ -0,0 +1,22 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+/// @file
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Opt-in pooled handles (not included by the library packages).
+///
+/// - @c solo::anys::pools::make_pooled_any_handle<T>, @c make_pooled_any_handle_mutable<T> : the factories, allocating
+/// the control block and the object from the slabs of @c T through per-thread magazines,
+/// - @c solo::anys::pools::pooled_statistics<T> : the blocks reserved and in use (see @c anys::allocators::slab_allocator),
+/// - @c solo::anys::pools::recycling_pool<T>, @c make_recycled_any_handle, @c make_recycled_any_handle_mutable : the handles
+/// returning their object to a pool on their final release, instead of deleting it.
+
+#include <solo/anys/handles/pools/make_pooled_any_handle.hpp>
+#include <solo/anys/handles/pools/recycling_pool.hpp>
@@ -0,0 +1,352 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/any_handle_core_package.hpp>
+#include <solo/anys/handles/details/make_owned_shared_t.hpp>
+
+#include <stdex/in_place_t.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace pools {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+struct recycling_statistics;
+
+template < typename T >
+class recycling_pool;
+
+template < typename T, typename... Args >
+any_handle make_recycled_any_handle( recycling_pool<T> &a_pool, stdex::in_place_t, Args&&... a_type_constructor_arguments_list );
+
+template < typename T, typename... Args >
+any_handle make_recycled_any_handle_mutable( recycling_pool<T> &a_pool, stdex::in_place_t, Args&&... a_type_constructor_arguments_list );
+
+namespace detail {
+    template < typename T > class recycling_pool_state;
+    template < typename T > struct recycling_finalizer;
+}// EONS DETAIL
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief A snapshot of the counters of a recycling pool.
+struct recycling_statistics
+{
+    std::size_t hits = 0;// the objects taken from the pool
+    std::size_t misses = 0;// the objects built, the pool being empty
+    std::size_t recycled = 0;// the objects returned to the pool on their final release
+    std::size_t discarded = 0;// the objects deleted on their final release (pool full or closed, reset failed)
+    std::size_t pooled = 0;// the objects waiting in the pool
+
+    /// @brief The fraction of the objects taken from the pool (0 before the first one).
+    double hit_rate() const noexcept
+    {
+        return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(hits + misses);
+    }
+};
+
+namespace detail {
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The pooled objects and the counters of a recycling pool, shared with the finalizers of its handles.
+///
+/// The state outlives its pool while handles remain : once the pool is destroyed (closed), the objects released
+/// are deleted.
+template < typename T >
+class recycling_pool_state
+{
+public:
+
+    recycling_pool_state( std::size_t a_capacity, std::function<void(T &)> a_reset )
+        : m_capacity{ a_capacity }
+        , m_reset{ std::move(a_reset) }
+    {}
+
+    ~recycling_pool_state()
+    {
+        for ( auto *object : m_objects )
+        {
+            delete object;
+        }
+    }
+
+    recycling_pool_state( recycling_pool_state const & ) = delete;
+    recycling_pool_state &operator=( recycling_pool_state const & ) = delete;
+
+    /// @brief Take an object from the pool, or build one from the given arguments.
+    template < typename... Args >
+    std::unique_ptr<T> acquire( Args&&... a_type_constructor_arguments_list );
+
+    /// @brief Reset the given object and return it to the pool, or delete it.
+    void recycle( T *a_object ) noexcept;
+
+    /// @brief Delete the pooled objects, and the objects released from now on.
+    void close() noexcept;
+
+    /// @brief Delete the pooled objects beyond the given count.
+    void trim( std::size_t a_count ) noexcept;
+
+    recycling_statistics statistics() const;
+
+    std::size_t capacity() const noexcept { return m_capacity; }
+
+private:
+
+    std::size_t const m_capacity;
+    std::function<void(T &)> const m_reset;
+    mutable std::mutex m_mutex;
+    std::vector<T*> m_objects;
+    bool m_closed = false;
+    recycling_statistics m_statistics;
+};
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The finalizer of the handles of a recycling pool : return the object to the pool instead of deleting it.
+template < typename T >
+struct recycling_finalizer
+{
+    void operator()( T *a_object ) const noexcept
+    {
+        m_state->recycle(a_object);
+    }
+
+    std::shared_ptr<recycling_pool_state<T>> m_state;
+};
+
+}// EONS DETAIL
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief A pool of objects of type @c T, reused by its handles instead of being destroyed and built again.
+///
+/// On the final release of a handle made from the pool, its object is reset (by the optional reset hook) and
+/// returned to the pool, unless the pool holds @c capacity objects already : the next handles made from the pool
+/// take the pooled objects back, without building them. The handles are plain handles of type @c T (same type
+/// index, casts and comparisons than the other factories) : only their finalizer differs.
+///
+/// Example:
+///
+/// @code
+///     // parsers keeping their warm internal tables from one request to the next :
+///     solo::anys::pools::recycling_pool<Parser> parsers{ 16, []( Parser &p ) { p.clear(); } };
+///     auto h = solo::anys::pools::make_recycled_any_handle_mutable(parsers, stdex::in_place, grammar);
+///     ...
+///     h = solo::any_handle{};// p.clear(), then back to the pool
+///     assert(parsers.statistics().pooled == 1);
+/// @endcode
+///
+/// @pre @c T is a plain type (not a reference type, not cv-qualified).
+/// @note The pool is thread-safe : the objects are taken and returned under a lock, the reset hook runs out of it,
+/// on the thread releasing the last handle. A reset hook which throws makes the object deleted instead.
+/// @note The pool can be destroyed before its handles : their objects are deleted on release then.
+template < typename T >
+class recycling_pool
+{
+    static_assert(!std::is_reference<T>::value, "T should not be a reference type");
+    static_assert(!std::is_const<T>::value && !std::is_volatile<T>::value, "T should not be cv-qualified");
+
+public:
+
+    using value_type = T;
+
+    /// @brief Build a pool keeping up to @c a_capacity released objects, reset by @c a_reset if not empty.
+    explicit recycling_pool( std::size_t a_capacity, std::function<void(T &)> a_reset = {} )
+        : m_state{ std::make_shared<detail::recycling_pool_state<T>>(a_capacity, std::move(a_reset)) }
+    {}
+
+    ~recycling_pool()
+    {
+        m_state->close();
+    }
+
+    recycling_pool( recycling_pool const & ) = delete;
+    recycling_pool &operator=( recycling_pool const & ) = delete;
+
+    /// @brief Return an object taken from the pool, or built from the given arguments if the pool is empty.
+    /// @param a_ismutable The mutability of the handle which will own the object (tracking information only).
+    /// @note The arguments are ignored when an object is taken from the pool.
+    template < typename... Args >
+    std::shared_ptr<T> acquire( mutability a_ismutable, Args&&... a_type_constructor_arguments_list );
+
+    /// @brief Delete the pooled objects beyond the given count.
+    void trim( std::size_t a_count = 0 ) noexcept
+    {
+        m_state->trim(a_count);
+    }
+
+    /// @brief The maximum number of objects kept by the pool.
+    std::size_t capacity() const noexcept
+    {
+        return m_state->capacity();
+    }
+
+    /// @brief Return a snapshot of the counters.
+    recycling_statistics statistics() const
+    {
+        return m_state->statistics();
+    }
+
+private:
+
+    std::shared_ptr<detail::recycling_pool_state<T>> m_state;
+};
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Return a non-mutable handle on an object taken from the pool, or built from the given arguments.
+/// @note The arguments are ignored when an object is taken from the pool.
+/// @see @c recycling_pool.
+template < typename T, typename... Args >
+inline any_handle
+make_recycled_any_handle( recycling_pool<T> &a_pool, stdex::in_place_t, Args&&... a_type_constructor_arguments_list )
+{
+    return make_any_handle( std::shared_ptr<T const>{ a_pool.acquire(mutability::false_, std::forward<Args>(a_type_constructor_arguments_list)...) } );
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Return a mutable handle on an object taken from the pool, or built from the given arguments.
+/// @note The arguments are ignored when an object is taken from the pool.
+/// @see @c recycling_pool.
+template < typename T, typename... Args >
+inline any_handle
+make_recycled_any_handle_mutable( recycling_pool<T> &a_pool, stdex::in_place_t, Args&&... a_type_constructor_arguments_list )
+{
+    return make_any_handle_mutable( a_pool.acquire(mutability::true_, std::forward<Args>(a_type_constructor_arguments_list)...) );
+}
+
+//..............................................................................
+//..............................................................................
+
+// INLINES :
+
+namespace detail {
+
+template < typename T >
+template < typename... Args >
+inline std::unique_ptr<T>
+recycling_pool_state<T>::acquire( Args&&... a_type_constructor_arguments_list )
+{
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        if ( !m_objects.empty() )
+        {
+            ++m_statistics.hits;
+            auto object = std::unique_ptr<T>{ m_objects.back() };
+            m_objects.pop_back();
+            return object;
+        }
+        ++m_statistics.misses;
+    }
+    return std::unique_ptr<T>{ new T( std::forward<Args>(a_type_constructor_arguments_list)... ) };// out of the lock
+}
+
+template < typename T >
+inline void
+recycling_pool_state<T>::recycle( T *a_object ) noexcept
+{
+    auto keep = true;
+    if ( m_reset )
+    {
+        try
+        {
+            m_reset(*a_object);
+        }
+        catch ( ... )
+        {
+            keep = false;// in an unknown state
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        if ( keep && !m_closed && m_objects.size() < m_capacity )
+        {
+            try
+            {
+                m_objects.push_back(a_object);
+                ++m_statistics.recycled;
+                return;
+            }
+            catch ( ... )
+            {
+                // deleted below
+            }
+        }
+        ++m_statistics.discarded;
+    }
+    delete a_object;
+}
+
+template < typename T >
+inline void
+recycling_pool_state<T>::close() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        m_closed = true;
+    }
+    trim(0);
+}
+
+template < typename T >
+inline void
+recycling_pool_state<T>::trim( std::size_t a_count ) noexcept
+{
+    for ( ;; )
+    {
+        auto *object = static_cast<T*>(nullptr);
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            if ( m_objects.size() <= a_count )
+            {
+                return;
+            }
+            object = m_objects.back();
+            m_objects.pop_back();
+        }
+        delete object;// out of the lock
+    }
+}
+
+template < typename T >
+inline recycling_statistics
+recycling_pool_state<T>::statistics() const
+{
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    auto result = m_statistics;
+    result.pooled = m_objects.size();
+    return result;
+}
+
+}// EONS DETAIL
+
+template < typename T >
+template < typename... Args >
+inline std::shared_ptr<T>
+recycling_pool<T>::acquire( mutability a_ismutable, Args&&... a_type_constructor_arguments_list )
+{
+    auto object = m_state->acquire(std::forward<Args>(a_type_constructor_arguments_list)...);
+    // on failure, the shared pointer constructor recycles the object
+    return anys::detail::make_owned_shared_with_finalizer<T>(object.release(), detail::recycling_finalizer<T>{ m_state }, a_ismutable);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::POOLS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,38 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+// Code layout hints : keep the failure paths out of the hot code.
+//
+// - SOLO_LIKELY(x) / SOLO_UNLIKELY(x) : branch prediction hints on a condition,
+// - SOLO_NOINLINE : never inline the function (its code is shared by all the call sites),
+// - SOLO_COLD : the function is unlikely executed (moved to the .text.unlikely section with GCC and Clang,
+//   and the branches leading to its calls are predicted as not taken).
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SOLO_LIKELY(x)      __builtin_expect(!!(x), 1)
+#define SOLO_UNLIKELY(x)    __builtin_expect(!!(x), 0)
+#define SOLO_NOINLINE       __attribute__((noinline))
+#define SOLO_COLD           __attribute__((cold))
+
+#elif defined(_MSC_VER)
+#define SOLO_LIKELY(x)      (x)
+#define SOLO_UNLIKELY(x)    (x)
+#define SOLO_NOINLINE       __declspec(noinline)
+#define SOLO_COLD
+
+#else
+#define SOLO_LIKELY(x)      (x)
+#define SOLO_UNLIKELY(x)    (x)
+#define SOLO_NOINLINE
+#define SOLO_COLD
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
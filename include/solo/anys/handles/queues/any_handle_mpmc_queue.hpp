@@ -0,0 +1,275 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/any_handle.hpp>
+#include <solo/anys/handles/queues/ring_indexes.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace queues {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+class any_handle_mpmc_queue;
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief A bounded lock-free multi-producer multi-consumer queue of handles.
+///
+/// A ring of slots, each one holding a handle and a sequence number telling whether the slot is free
+/// or published for the current lap of the ring (D. Vyukov's bounded MPMC queue).
+/// The handles are moved in and out of the slots : a transfer never touches the reference counts.
+/// The producers' index and the consumers' index live on distinct cache lines.
+///
+/// @c try_push_n and @c try_pop_n claim a run of consecutive slots with a single atomic operation.
+///
+/// Example:
+///
+/// @code
+///     auto queue = any_handle_mpmc_queue{ 1024 };
+///
+///     // producer threads :
+///     auto job = make_any_handle<Job>(...);
+///     while ( !queue.try_push(std::move(job)) ) { std::this_thread::yield(); }
+///
+///     // consumer threads :
+///     auto next = any_handle{};
+///     if ( queue.try_pop(next) ) { run( any_handle_cast_or_throw<Job>(next) ); }
+/// @endcode
+///
+/// @note The operations never block : they fail when the queue is full (push) or empty (pop).
+/// A thread preempted between claiming a slot and publishing it delays the consumers of that slot.
+class any_handle_mpmc_queue
+{
+public:
+
+    /// @brief Build an empty queue of at least the given capacity (rounded up to a power of 2).
+    /// @throw @c std::bad_alloc, @c std::length_error.
+    explicit any_handle_mpmc_queue( std::size_t a_min_capacity );
+
+    any_handle_mpmc_queue( any_handle_mpmc_queue const & ) = delete;
+    any_handle_mpmc_queue &operator=( any_handle_mpmc_queue const & ) = delete;
+
+    /// @brief Return the number of slots.
+    std::size_t capacity() const noexcept { return m_mask + 1; }
+
+    /// @brief Return the number of handles in the queue (a snapshot, exact only when the queue is not used concurrently).
+    std::size_t size_approx() const noexcept;
+
+    /// @brief Move the given handle into the queue.
+    /// @return false if the queue is full (@c a_handle is left unchanged).
+    bool try_push( any_handle &&a_handle ) noexcept;
+
+    /// @brief Move the first of the @c a_count given handles into the queue, as many as there are free slots.
+    /// @return The number of handles moved (the first ones of the range).
+    std::size_t try_push_n( any_handle *a_handles, std::size_t a_count ) noexcept;
+
+    /// @brief Move the oldest handle of the queue into @c a_handle.
+    /// @return false if the queue is empty (@c a_handle is left unchanged).
+    bool try_pop( any_handle &a_handle ) noexcept;
+
+    /// @brief Move up to @c a_count of the oldest handles of the queue into the given range, in order.
+    /// @return The number of handles moved (0 if the queue is empty).
+    std::size_t try_pop_n( any_handle *a_handles, std::size_t a_count ) noexcept;
+
+private:
+
+    struct slot
+    {
+        std::atomic<std::size_t> sequence;
+        any_handle handle;
+    };
+
+    using difference_type = std::intptr_t;
+
+    slot &slot_at( std::size_t a_position ) const noexcept { return m_slots[a_position & m_mask]; }
+
+    // read-only :
+    std::size_t const m_mask;
+    std::unique_ptr<slot[]> const m_slots;
+
+    detail::cache_line_padding m_padding{};
+    detail::padded_ring_index m_tail{};// producers
+    detail::padded_ring_index m_head{};// consumers
+};
+
+//..............................................................................
+//..............................................................................
+
+// INLINES :
+
+inline
+any_handle_mpmc_queue::any_handle_mpmc_queue( std::size_t a_min_capacity )
+    : m_mask{ detail::ring_capacity(a_min_capacity) - 1 }
+    , m_slots{ new slot[m_mask + 1] }
+{
+    for ( auto i = std::size_t{0}; i <= m_mask; ++i )
+    {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+inline std::size_t
+any_handle_mpmc_queue::size_approx() const noexcept
+{
+    auto const head = m_head.value.load(std::memory_order_relaxed);
+    auto const tail = m_tail.value.load(std::memory_order_relaxed);
+    return tail > head ? tail - head : 0;
+}
+
+inline bool
+any_handle_mpmc_queue::try_push( any_handle &&a_handle ) noexcept
+{
+    auto position = m_tail.value.load(std::memory_order_relaxed);
+    for ( ;; )
+    {
+        auto &s = slot_at(position);
+        auto const lap = static_cast<difference_type>( s.sequence.load(std::memory_order_acquire) - position );
+        if ( lap == 0 )// free for this lap
+        {
+            if ( m_tail.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed) )
+            {
+                s.handle = std::move(a_handle);
+                s.sequence.store(position + 1, std::memory_order_release);// publish
+                return true;
+            }
+        }
+        else if ( lap < 0 )// not consumed yet : full
+        {
+            return false;
+        }
+        else// claimed by another producer
+        {
+            position = m_tail.value.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+inline std::size_t
+any_handle_mpmc_queue::try_push_n( any_handle *a_handles, std::size_t a_count ) noexcept
+{
+    if ( a_count == 0 )
+    {
+        return 0;
+    }
+    auto position = m_tail.value.load(std::memory_order_relaxed);
+    for ( ;; )
+    {
+        // the run of free slots from position (a free slot stays free until the tail moves past it) :
+        auto count = std::size_t{0};
+        while ( count < a_count && count <= m_mask
+             && slot_at(position + count).sequence.load(std::memory_order_acquire) == position + count )
+        {
+            ++count;
+        }
+        if ( count == 0 )
+        {
+            auto const lap = static_cast<difference_type>( slot_at(position).sequence.load(std::memory_order_acquire) - position );
+            if ( lap < 0 )
+            {
+                return 0;// full
+            }
+            position = m_tail.value.load(std::memory_order_relaxed);
+            continue;
+        }
+        if ( m_tail.value.compare_exchange_weak(position, position + count, std::memory_order_relaxed) )
+        {
+            for ( auto i = std::size_t{0}; i < count; ++i )
+            {
+                auto &s = slot_at(position + i);
+                s.handle = std::move(a_handles[i]);
+                s.sequence.store(position + i + 1, std::memory_order_release);
+            }
+            return count;
+        }
+    }
+}
+
+inline bool
+any_handle_mpmc_queue::try_pop( any_handle &a_handle ) noexcept
+{
+    auto position = m_head.value.load(std::memory_order_relaxed);
+    for ( ;; )
+    {
+        auto &s = slot_at(position);
+        auto const lap = static_cast<difference_type>( s.sequence.load(std::memory_order_acquire) - ( position + 1 ) );
+        if ( lap == 0 )// published for this lap
+        {
+            if ( m_head.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed) )
+            {
+                a_handle = std::move(s.handle);
+                s.sequence.store(position + m_mask + 1, std::memory_order_release);// free for the next lap
+                return true;
+            }
+        }
+        else if ( lap < 0 )// not published yet : empty
+        {
+            return false;
+        }
+        else// claimed by another consumer
+        {
+            position = m_head.value.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+inline std::size_t
+any_handle_mpmc_queue::try_pop_n( any_handle *a_handles, std::size_t a_count ) noexcept
+{
+    if ( a_count == 0 )
+    {
+        return 0;
+    }
+    auto position = m_head.value.load(std::memory_order_relaxed);
+    for ( ;; )
+    {
+        // the run of published slots from position :
+        auto count = std::size_t{0};
+        while ( count < a_count && count <= m_mask
+             && slot_at(position + count).sequence.load(std::memory_order_acquire) == position + count + 1 )
+        {
+            ++count;
+        }
+        if ( count == 0 )
+        {
+            auto const lap = static_cast<difference_type>( slot_at(position).sequence.load(std::memory_order_acquire) - ( position + 1 ) );
+            if ( lap < 0 )
+            {
+                return 0;// empty
+            }
+            position = m_head.value.load(std::memory_order_relaxed);
+            continue;
+        }
+        if ( m_head.value.compare_exchange_weak(position, position + count, std::memory_order_relaxed) )
+        {
+            for ( auto i = std::size_t{0}; i < count; ++i )
+            {
+                auto &s = slot_at(position + i);
+                a_handles[i] = std::move(s.handle);
+                s.sequence.store(position + i + m_mask + 1, std::memory_order_release);
+            }
+            return count;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::QUEUES
+////////////////////////////////////////////////////////////////////////////////
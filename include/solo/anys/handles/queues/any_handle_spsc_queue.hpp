@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/any_handle.hpp>
+#include <solo/anys/handles/queues/ring_indexes.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace queues {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+class any_handle_spsc_queue;
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief A bounded wait-free single-producer single-consumer queue of handles.
+///
+/// The single-threaded counterpart of @c any_handle_mpmc_queue : one thread pushes, one thread pops.
+/// The handles are moved in and out of a ring of handles, the indexes live on distinct cache lines,
+/// and each side keeps a cached copy of the other side's index, read again only when the ring looks full (or empty).
+///
+/// @note Pushing from two threads, or popping from two threads, is undefined behaviour.
+class any_handle_spsc_queue
+{
+public:
+
+    /// @brief Build an empty queue of at least the given capacity (rounded up to a power of 2).
+    /// @throw @c std::bad_alloc, @c std::length_error.
+    explicit any_handle_spsc_queue( std::size_t a_min_capacity );
+
+    any_handle_spsc_queue( any_handle_spsc_queue const & ) = delete;
+    any_handle_spsc_queue &operator=( any_handle_spsc_queue const & ) = delete;
+
+    /// @brief Return the number of slots.
+    std::size_t capacity() const noexcept { return m_mask + 1; }
+
+    /// @brief Return the number of handles in the queue (a snapshot, exact only when the queue is not used concurrently).
+    std::size_t size_approx() const noexcept;
+
+    /// @brief Move the given handle into the queue (producer thread).
+    /// @return false if the queue is full (@c a_handle is left unchanged).
+    bool try_push( any_handle &&a_handle ) noexcept;
+
+    /// @brief Move the first of the @c a_count given handles into the queue, as many as there are free slots (producer thread).
+    /// @return The number of handles moved (the first ones of the range).
+    std::size_t try_push_n( any_handle *a_handles, std::size_t a_count ) noexcept;
+
+    /// @brief Move the oldest handle of the queue into @c a_handle (consumer thread).
+    /// @return false if the queue is empty (@c a_handle is left unchanged).
+    bool try_pop( any_handle &a_handle ) noexcept;
+
+    /// @brief Move up to @c a_count of the oldest handles of the queue into the given range, in order (consumer thread).
+    /// @return The number of handles moved (0 if the queue is empty).
+    std::size_t try_pop_n( any_handle *a_handles, std::size_t a_count ) noexcept;
+
+private:
+
+    // read-only :
+    std::size_t const m_mask;
+    std::unique_ptr<any_handle[]> const m_slots;
+
+    detail::cache_line_padding m_padding{};
+    detail::padded_ring_index m_tail{};// producer (cached_opposite : the head)
+    detail::padded_ring_index m_head{};// consumer (cached_opposite : the tail)
+};
+
+//..............................................................................
+//..............................................................................
+
+// INLINES :
+
+inline
+any_handle_spsc_queue::any_handle_spsc_queue( std::size_t a_min_capacity )
+    : m_mask{ detail::ring_capacity(a_min_capacity) - 1 }
+    , m_slots{ new any_handle[m_mask + 1] }
+{}
+
+inline std::size_t
+any_handle_spsc_queue::size_approx() const noexcept
+{
+    auto const head = m_head.value.load(std::memory_order_relaxed);
+    auto const tail = m_tail.value.load(std::memory_order_relaxed);
+    return tail > head ? tail - head : 0;
+}
+
+inline bool
+any_handle_spsc_queue::try_push( any_handle &&a_handle ) noexcept
+{
+    return try_push_n(&a_handle, 1) == 1;
+}
+
+inline std::size_t
+any_handle_spsc_queue::try_push_n( any_handle *a_handles, std::size_t a_count ) noexcept
+{
+    auto const tail = m_tail.value.load(std::memory_order_relaxed);// owned
+    if ( tail - m_tail.cached_opposite + a_count > m_mask + 1 )
+    {
+        m_tail.cached_opposite = m_head.value.load(std::memory_order_acquire);
+    }
+    auto const count = std::min(a_count, m_mask + 1 - ( tail - m_tail.cached_opposite ));
+    for ( auto i = std::size_t{0}; i < count; ++i )
+    {
+        m_slots[(tail + i) & m_mask] = std::move(a_handles[i]);
+    }
+    if ( count != 0 )
+    {
+        m_tail.value.store(tail + count, std::memory_order_release);
+    }
+    return count;
+}
+
+inline bool
+any_handle_spsc_queue::try_pop( any_handle &a_handle ) noexcept
+{
+    return try_pop_n(&a_handle, 1) == 1;
+}
+
+inline std::size_t
+any_handle_spsc_queue::try_pop_n( any_handle *a_handles, std::size_t a_count ) noexcept
+{
+    auto const head = m_head.value.load(std::memory_order_relaxed);// owned
+    if ( m_head.cached_opposite - head < a_count )
+    {
+        m_head.cached_opposite = m_tail.value.load(std::memory_order_acquire);
+    }
+    auto const count = std::min(a_count, m_head.cached_opposite - head);
+    for ( auto i = std::size_t{0}; i < count; ++i )
+    {
+        a_handles[i] = std::move(m_slots[(head + i) & m_mask]);
+    }
+    if ( count != 0 )
+    {
+        m_head.value.store(head + count, std::memory_order_release);
+    }
+    return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::QUEUES
+////////////////////////////////////////////////////////////////////////////////
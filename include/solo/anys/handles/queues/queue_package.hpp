@@ -0,0 +1,20 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+/// @file
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Opt-in bounded lock-free queues moving handles between threads (not included by the library packages).
+///
+/// - @c solo::anys::queues::any_handle_mpmc_queue : multi-producer multi-consumer,
+/// - @c solo::anys::queues::any_handle_spsc_queue : single-producer single-consumer.
+
+#include <solo/anys/handles/queues/ring_indexes.hpp>
+#include <solo/anys/handles/queues/any_handle_mpmc_queue.hpp>
+#include <solo/anys/handles/queues/any_handle_spsc_queue.hpp>
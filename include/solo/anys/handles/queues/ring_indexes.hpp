@@ -0,0 +1,77 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/allocators/cache_line_allocator.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace queues { namespace detail {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+std::size_t ring_capacity( std::size_t a_min_capacity );
+
+struct cache_line_padding;
+struct padded_ring_index;
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The capacity of a ring : the given capacity rounded up to a power of 2 (at least 2).
+/// @throw @c std::length_error if the rounded capacity is not representable.
+inline std::size_t
+ring_capacity( std::size_t a_min_capacity )
+{
+    if ( a_min_capacity > ( std::numeric_limits<std::size_t>::max() / 2 + 1 ) )
+    {
+        throw std::length_error{ "solo::anys::queues: ring capacity too large" };
+    }
+    auto capacity = std::size_t{2};
+    while ( capacity < a_min_capacity )
+    {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief A whole cache line : keeps the next member off the cache line of the previous one.
+///
+/// The members are separated by padding rather than aligned : the queues are allocated with
+/// the default @c operator new, which does not honour extended alignments before C++17.
+struct cache_line_padding
+{
+    char bytes[allocators::cache_line_size];
+};
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief A ring index, with the owner's cached copy of the opposite index, padded up to a cache line.
+///
+/// Two consecutive @c padded_ring_index members are @c cache_line_size bytes apart : they never share a line.
+struct padded_ring_index
+{
+    std::atomic<std::size_t> value{0};
+    std::size_t cached_opposite{0};// SPSC rings only
+    char padding[allocators::cache_line_size - sizeof(std::atomic<std::size_t>) - sizeof(std::size_t)];
+};
+
+static_assert(sizeof(padded_ring_index) == allocators::cache_line_size, "");
+
+////////////////////////////////////////////////////////////////////////////////
+}}}}// EONS SOLO::ANYS::QUEUES::DETAIL
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/any_handle_core_package.hpp>
+#include <solo/anys/handles/details/make_owned_shared_t.hpp>
+#include <solo/anys/handles/reclaimers/reclaim_policy.hpp>
+#include <solo/anys/handles/reclaimers/reclaimer.hpp>
+
+#include <stdex/in_place_t.hpp>
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace reclaimers {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+template < typename T >
+std::shared_ptr<T> make_deferred_shared( reclaimer const &a_reclaimer, std::shared_ptr<T> a_owner );
+
+template < typename T, typename... Args >
+any_handle make_any_handle_deferred( reclaimer const &a_reclaimer, stdex::in_place_t, Args&&... a_type_constructor_arguments_list );
+
+template < typename T, typename... Args >
+any_handle make_any_handle_mutable_deferred( reclaimer const &a_reclaimer, stdex::in_place_t, Args&&... a_type_constructor_arguments_list );
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+namespace detail {
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The deleter of a deferred shared pointer : hands the owner of the object to the reclaimer.
+class deferred_deleter
+{
+public:
+
+    deferred_deleter( std::shared_ptr<reclaimer_queue> a_queue, std::shared_ptr<void const> a_owner ) noexcept
+        : m_queue{ std::move(a_queue) }
+        , m_owner{ std::move(a_owner) }
+    {}
+
+    void operator()( void const * ) noexcept
+    {
+        m_queue->defer( std::move(m_owner) );
+    }
+
+private:
+
+    std::shared_ptr<reclaimer_queue> m_queue;
+    std::shared_ptr<void const> m_owner;
+};
+
+}// EONS DETAIL
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Wrap the given owner : the object is released by the reclaimer when the last copy of the returned pointer is released.
+///
+/// The wrapper deleter of the deferred factories, usable with any factory taking a @c std::shared_ptr
+/// (e.g. <c>make_any_handle( make_deferred_shared(reclaimer, std::make_shared<T const>(...)) )</c>).
+/// @note The returned pointer has its own control block : one more allocation than the owner.
+/// @note If @c a_owner has other copies, the object is destroyed by the thread releasing the last one.
+template < typename T >
+inline std::shared_ptr<T>
+make_deferred_shared( reclaimer const &a_reclaimer, std::shared_ptr<T> a_owner )
+{
+    if ( !a_owner )
+    {
+        return a_owner;
+    }
+    auto *const p = a_owner.get();
+    return std::shared_ptr<T>{ p, detail::deferred_deleter{ a_reclaimer.queue(), std::move(a_owner) } };
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Build a non-mutable object of type @c T, released by the given reclaimer if @c reclaim_policy<T> is deferred.
+/// @see @c make_any_handle.
+template < typename T, typename... Args >
+inline any_handle
+make_any_handle_deferred( reclaimer const &a_reclaimer, stdex::in_place_t, Args&&... a_type_constructor_arguments_list )
+{
+    static_assert(!std::is_reference<T>::value, "T should not be a reference type");
+
+    auto owner = anys::detail::make_owned_shared<T const,T const>(mutability::false_, std::forward<Args>(a_type_constructor_arguments_list)...);
+    if ( reclaim_policy<std::remove_cv_t<T>>::mode == reclaim_mode::inline_ )
+    {
+        return make_any_handle( std::move(owner) );
+    }
+    return make_any_handle( make_deferred_shared(a_reclaimer, std::move(owner)) );
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Build a mutable object of type @c T, released by the given reclaimer if @c reclaim_policy<T> is deferred.
+/// @see @c make_any_handle_mutable.
+template < typename T, typename... Args >
+inline any_handle
+make_any_handle_mutable_deferred( reclaimer const &a_reclaimer, stdex::in_place_t, Args&&... a_type_constructor_arguments_list )
+{
+    static_assert(!std::is_reference<T>::value, "T should not be a reference type");
+    static_assert(!std::is_const<T>::value && !std::is_volatile<T>::value, "T should not be cv-qualified");
+
+    auto owner = anys::detail::make_owned_shared<T,T>(mutability::true_, std::forward<Args>(a_type_constructor_arguments_list)...);
+    if ( reclaim_policy<T>::mode == reclaim_mode::inline_ )
+    {
+        return make_any_handle_mutable( std::move(owner) );
+    }
+    return make_any_handle_mutable( make_deferred_shared(a_reclaimer, std::move(owner)) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::RECLAIMERS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,62 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace reclaimers {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+enum class reclaim_mode;
+
+template < typename T >
+struct reclaim_policy;
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Where the objects built by the deferred factories are destroyed (see @c make_any_handle_deferred).
+enum class reclaim_mode
+{
+    inline_, ///< by the thread releasing the last handle, as usual
+    deferred ///< by the background thread of a @c reclaimer
+};
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The reclaim mode of the type @c T : deferred by default.
+///
+/// Give the cheap types built with the deferred factories the inline mode with @c SOLO_ANY_HANDLE_RECLAIM_POLICY :
+/// a deferred release costs a queue insertion, and the payload is kept alive until the reclaimer runs.
+template < typename T >
+struct reclaim_policy
+{
+    static constexpr reclaim_mode mode = reclaim_mode::deferred;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::RECLAIMERS
+////////////////////////////////////////////////////////////////////////////////
+
+/// @def SOLO_ANY_HANDLE_RECLAIM_POLICY
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Set the reclaim mode (@c inline_ or @c deferred) of the given type (at global namespace scope).
+///
+/// Example:
+///
+/// @code
+///     SOLO_ANY_HANDLE_RECLAIM_POLICY(app::small_message, inline_)
+/// @endcode
+#define SOLO_ANY_HANDLE_RECLAIM_POLICY( a_type, a_mode ) \
+    namespace solo { namespace anys { namespace reclaimers { \
+        template <> struct reclaim_policy< a_type > { static constexpr reclaim_mode mode = reclaim_mode::a_mode; }; \
+    }}}
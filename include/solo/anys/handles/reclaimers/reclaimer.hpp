@@ -0,0 +1,238 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace reclaimers {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+struct reclaimer_options;
+class reclaimer;
+
+namespace detail {
+    class reclaimer_queue;
+}// EONS DETAIL
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The batching options of a @c reclaimer.
+struct reclaimer_options
+{
+    /// @brief The number of pending releases waking the background thread up.
+    std::size_t batch_size = 64;
+
+    /// @brief The maximal delay of a release when fewer than @c batch_size are pending (counted from the first pending release :
+    /// an idle reclaimer does not wake up).
+    std::chrono::milliseconds max_delay{ 10 };
+};
+
+namespace detail {
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The pending releases of a reclaimer, shared with the deferred deleters.
+///
+/// Outlives the reclaimer as long as a deferred handle references it : once the reclaimer is stopped,
+/// the releases are run inline.
+class reclaimer_queue
+{
+public:
+
+    explicit reclaimer_queue( reclaimer_options const &a_options )
+        : m_options{ a_options }
+    {
+        m_pending.reserve(a_options.batch_size);
+    }
+
+    /// @brief Hand the given last owner of an object to the background thread (or release it inline if stopped).
+    void defer( std::shared_ptr<void const> &&a_owner ) noexcept
+    {
+        {
+            std::unique_lock<std::mutex> lock{ m_mutex };
+            if ( !m_stopped )
+            {
+                try
+                {
+                    m_pending.push_back(std::move(a_owner));
+                }
+                catch ( ... )// out of memory : release inline
+                {
+                    lock.unlock();
+                    a_owner.reset();
+                    return;
+                }
+                ++m_deferred_count;
+                if ( m_pending.size() == 1 || m_pending.size() == m_options.batch_size )// start the delay, then once per batch
+                {
+                    m_work.notify_one();
+                }
+                return;
+            }
+        }
+        a_owner.reset();
+    }
+
+    /// @brief Wait until the releases deferred before the call are done.
+    void drain()
+    {
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        auto const target = m_deferred_count;
+        m_drain_requested = true;
+        m_work.notify_one();
+        m_done.wait(lock, [&] { return m_reclaimed_count >= target || m_stopped; });
+    }
+
+    std::uint64_t deferred_count() const
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        return m_deferred_count;
+    }
+
+    std::uint64_t reclaimed_count() const
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        return m_reclaimed_count;
+    }
+
+    /// @brief The loop of the background thread : release the pending owners by batches, until stopped.
+    void run()
+    {
+        auto batch = std::vector<std::shared_ptr<void const>>{};
+        batch.reserve(m_options.batch_size);
+        std::unique_lock<std::mutex> lock{ m_mutex };
+        for ( ;; )
+        {
+            // idle : no timer until the first release is queued
+            m_work.wait(lock, [&] { return !m_pending.empty() || m_drain_requested || m_stopping; });
+            m_work.wait_for(lock, m_options.max_delay,
+                            [&] { return m_pending.size() >= m_options.batch_size || m_drain_requested || m_stopping; });
+            m_drain_requested = false;
+            while ( !m_pending.empty() )// including the releases deferred by the released objects
+            {
+                batch.swap(m_pending);
+                lock.unlock();
+                auto const count = batch.size();
+                batch.clear();// the destructors run here
+                lock.lock();
+                m_reclaimed_count += count;
+            }
+            m_done.notify_all();
+            if ( m_stopping )
+            {
+                m_stopped = true;
+                m_done.notify_all();
+                return;
+            }
+        }
+    }
+
+    void stop()
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        m_stopping = true;
+        m_work.notify_one();
+    }
+
+private:
+
+    reclaimer_options const m_options;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_work;
+    std::condition_variable m_done;
+    std::vector<std::shared_ptr<void const>> m_pending;
+    std::uint64_t m_deferred_count{0};
+    std::uint64_t m_reclaimed_count{0};
+    bool m_drain_requested{false};
+    bool m_stopping{false};
+    bool m_stopped{false};
+};
+
+}// EONS DETAIL
+
+//..............................................................................
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief A background thread destroying the objects whose last handle was released by another thread.
+///
+/// The objects built by @c make_any_handle_deferred (and @c make_any_handle_mutable_deferred, @c make_deferred_shared)
+/// are not destroyed by the thread releasing their last handle : their owner is queued,
+/// and the background thread releases the queued owners by batches (see @c reclaimer_options).
+/// The releasing thread only pays a queue insertion, and a notification for the first release and the last one of a batch.
+///
+/// Example:
+///
+/// @code
+///     auto reclaimer = solo::anys::reclaimers::reclaimer{};
+///
+///     // request thread : the mesh is destroyed by the reclaimer thread
+///     auto h = make_any_handle_deferred<Mesh>(reclaimer, stdex::in_place, path);
+///     ...
+///     h = any_handle{};
+///
+///     // shutdown, tests :
+///     reclaimer.drain();
+/// @endcode
+///
+/// @note Destroying the reclaimer drains it. The handles released afterwards release their object inline.
+class reclaimer
+{
+public:
+
+    explicit reclaimer( reclaimer_options const &a_options = reclaimer_options{} )
+        : m_queue{ std::make_shared<detail::reclaimer_queue>(a_options) }
+        , m_thread{ [queue = m_queue] { queue->run(); } }
+    {}
+
+    reclaimer( reclaimer const & ) = delete;
+    reclaimer &operator=( reclaimer const & ) = delete;
+
+    /// @brief Release the pending objects, then stop the background thread.
+    ~reclaimer()
+    {
+        m_queue->stop();
+        m_thread.join();
+    }
+
+    /// @brief Wait until the objects released before the call are destroyed.
+    void drain() { m_queue->drain(); }
+
+    /// @brief The number of deferred releases since the creation of the reclaimer.
+    std::uint64_t deferred_count() const { return m_queue->deferred_count(); }
+
+    /// @brief The number of objects released by the background thread since the creation of the reclaimer.
+    std::uint64_t reclaimed_count() const { return m_queue->reclaimed_count(); }
+
+    /// @brief The queue shared with the deferred deleters.
+    std::shared_ptr<detail::reclaimer_queue> const &queue() const noexcept { return m_queue; }
+
+private:
+
+    std::shared_ptr<detail::reclaimer_queue> m_queue;
+    std::thread m_thread;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::RECLAIMERS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,22 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+/// @file
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Opt-in deferred destruction of the handled objects on a background thread (not included by the library packages).
+///
+/// - @c solo::anys::reclaimers::reclaimer : the background thread releasing the queued objects by batches, @c drain,
+/// - @c solo::anys::reclaimers::make_any_handle_deferred<T>, @c make_any_handle_mutable_deferred<T> : the factories,
+/// - @c solo::anys::reclaimers::make_deferred_shared : the wrapper deleter, for the other factories,
+/// - @c solo::anys::reclaimers::reclaim_policy<T> and @c SOLO_ANY_HANDLE_RECLAIM_POLICY : the per-type policy.
+
+#include <solo/anys/handles/reclaimers/reclaim_policy.hpp>
+#include <solo/anys/handles/reclaimers/reclaimer.hpp>
+#include <solo/anys/handles/reclaimers/make_any_handle_deferred.hpp>
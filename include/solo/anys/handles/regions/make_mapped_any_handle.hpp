@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/any_handle_core_package.hpp>
+#include <solo/anys/handles/regions/mapped_object.hpp>
+#include <solo/anys/handles/regions/mapped_region.hpp>
+#include <solo/anys/handles/regions/region_error.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace regions {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+namespace detail {
+
+char const *find_mapped_object( mapped_region const &a_region, std::size_t a_offset,
+                                std::type_index const &a_type, std::uint64_t a_type_key, std::size_t a_size, std::size_t a_alignment );
+
+}// EONS DETAIL
+
+template < typename T >
+any_handle make_mapped_any_handle( std::shared_ptr<mapped_region const> const &a_region, std::size_t a_offset );
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+namespace detail {
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Check the header at the given offset of the region against the given type, and return the object bytes.
+/// @throw @c region_error if the header is out of the region, or does not match the type (key, size, alignment),
+/// or if the object is out of the region or misaligned.
+/// @note Not a template : the checks are shared by all the @c make_mapped_any_handle<T> instances.
+inline char const *
+find_mapped_object( mapped_region const &a_region, std::size_t a_offset,
+                    std::type_index const &a_type, std::uint64_t a_type_key, std::size_t a_size, std::size_t a_alignment )
+{
+    auto const where = [&]{ return std::string{" at offset "} + std::to_string(a_offset); };
+
+    if ( a_offset % alignof(mapped_object_header) != 0 || !a_region.contains(a_offset, sizeof(mapped_object_header)) )
+    {
+        throw region_error{ "no object header" + where() + " (out of the region or misaligned)" };
+    }
+    auto header = mapped_object_header{};
+    std::memcpy(&header, a_region.data() + a_offset, sizeof(header));
+    if ( header.magic != mapped_object_magic )
+    {
+        throw region_error{ "no object header" + where() + " (bad magic number)" };
+    }
+    if ( header.type_key != a_type_key )
+    {
+        throw region_error{ std::string{"the object"} + where() + " is not a " + a_type.name() };
+    }
+    if ( header.size != a_size || header.alignment != a_alignment )
+    {
+        throw region_error{ std::string{"the object"} + where() + " has not the size or the alignment of " + a_type.name() };
+    }
+    if ( header.data_offset < sizeof(mapped_object_header) || header.data_offset > a_region.size() - a_offset
+      || !a_region.contains(a_offset + header.data_offset, a_size) )
+    {
+        throw region_error{ "the object" + where() + " is out of the region" };
+    }
+    auto const *const data = a_region.data() + a_offset + header.data_offset;
+    if ( reinterpret_cast<std::uintptr_t>(data) % a_alignment != 0 )
+    {
+        throw region_error{ "the object" + where() + " is misaligned" };
+    }
+    return data;
+}
+
+}// EONS DETAIL
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Make a non-mutable handle to the plain-data object of type @c T living in the given region (zero-copy).
+/// @param a_region The mapped region : shared by the returned handle, which keeps it mapped.
+/// @param a_offset The offset of the object header in the region (see @c append_mapped_object).
+/// @throw @c region_error if the object header does not match @c T (type, size, alignment) or is out of the region.
+///
+/// The returned handle is an ordinary non-mutable handle : @c any_handle_cast<T> returns a pointer into the region.
+///
+/// Example:
+///
+/// @code
+///     auto const region = make_mapped_region("reference_data.bin");
+///     auto const h = make_mapped_any_handle<Curve>(region, curve_offset);
+///     auto const curve = any_handle_cast<Curve>(h);// std::shared_ptr<Curve const> into the mapping
+/// @endcode
+template < typename T >
+inline any_handle
+make_mapped_any_handle( std::shared_ptr<mapped_region const> const &a_region, std::size_t a_offset )
+{
+    static_assert(std::is_trivially_copyable<T>::value, "make_mapped_any_handle<T> : T must be trivially copyable (plain data)");
+    static_assert(!std::is_const<T>::value && !std::is_volatile<T>::value, "make_mapped_any_handle<T> : T must not be cv-qualified");
+
+    auto const *const data = detail::find_mapped_object(*a_region, a_offset, typeid(T), anys::detail::make_any_type_persistent_key<T>(), sizeof(T), alignof(T));
+    return make_any_handle( std::shared_ptr<T const>{ a_region, reinterpret_cast<T const *>(data) } );// aliasing the region
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::REGIONS
+////////////////////////////////////////////////////////////////////////////////
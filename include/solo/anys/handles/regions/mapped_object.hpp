@@ -0,0 +1,91 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/details/any_type_info.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace regions {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+struct mapped_object_header;
+
+template < typename T >
+std::size_t append_mapped_object( std::string &a_bytes, T const &a_object );
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+// Layout of a mapped object (native endianness) :
+//
+//     mapped_object_header   at an offset aligned on alignof(mapped_object_header)
+//     padding
+//     object bytes           at header offset + data_offset, aligned on the object alignment
+//
+// The region may hold any other data around its objects : they are designated by the offsets of their headers.
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The magic number starting a @c mapped_object_header.
+constexpr std::uint32_t mapped_object_magic = 0x4a424f53u;// "SOBJ"
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The maximal alignment of a mapped object (the alignment of a region not memory-mapped).
+constexpr std::size_t mapped_object_max_alignment = 64;
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The header preceding an object in a region : checked against the requested type.
+struct mapped_object_header
+{
+    std::uint32_t magic;
+    std::uint32_t alignment;
+    std::uint64_t type_key;   // see anys::detail::make_any_type_persistent_key
+    std::uint64_t size;
+    std::uint64_t data_offset;// from the header
+};
+
+static_assert(std::is_trivially_copyable<mapped_object_header>::value && sizeof(mapped_object_header) == 32, "");
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Append a header and the bytes of the given plain-data object to the content of a region.
+/// @return The offset of the header in @c a_bytes : the offset to give to @c make_mapped_any_handle<T>.
+/// @note The region (e.g. a file) must be mapped at an address aligned on @c mapped_object_max_alignment.
+template < typename T >
+inline std::size_t
+append_mapped_object( std::string &a_bytes, T const &a_object )
+{
+    static_assert(std::is_trivially_copyable<T>::value, "append_mapped_object<T> : T must be trivially copyable");
+    static_assert(alignof(T) <= mapped_object_max_alignment, "append_mapped_object<T> : T is over-aligned");
+
+    auto const align = []( std::size_t a_offset, std::size_t a_alignment ) { return ( a_offset + a_alignment - 1 ) / a_alignment * a_alignment; };
+    auto const header_offset = align(a_bytes.size(), alignof(mapped_object_header));
+    auto const data_offset = align(header_offset + sizeof(mapped_object_header), alignof(T));
+
+    auto const header = mapped_object_header{ mapped_object_magic, static_cast<std::uint32_t>(alignof(T)),
+                                              anys::detail::make_any_type_persistent_key<T>(), sizeof(T), data_offset - header_offset };
+    a_bytes.resize(data_offset + sizeof(T), '\0');
+    std::memcpy(&a_bytes[header_offset], &header, sizeof(header));
+    std::memcpy(&a_bytes[data_offset], &a_object, sizeof(T));
+    return header_offset;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::REGIONS
+////////////////////////////////////////////////////////////////////////////////
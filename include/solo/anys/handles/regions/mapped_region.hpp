@@ -0,0 +1,168 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/regions/region_error.hpp>
+
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SOLO_ANY_HANDLE_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define SOLO_ANY_HANDLE_HAS_MMAP 0
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace regions {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+class mapped_region;
+
+std::shared_ptr<mapped_region const> make_mapped_region( std::string const &a_path );
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief A read-only view of a whole file.
+///
+/// The file is memory-mapped (@c mmap) on POSIX systems : its pages are loaded on first access.
+/// Elsewhere, the file is read into a buffer aligned on 64 bytes.
+///
+/// Share it with @c make_mapped_region : the handles to the objects of the region own it
+/// (see @c make_mapped_any_handle).
+///
+/// @note Neither copyable nor movable : the objects of the region are accessed in place.
+class mapped_region
+{
+public:
+
+    /// @brief Map the given file.
+    /// @throw @c region_error if the file cannot be opened, or is empty.
+    explicit mapped_region( std::string const &a_path );
+
+    mapped_region( mapped_region const & ) = delete;
+    mapped_region &operator=( mapped_region const & ) = delete;
+
+    ~mapped_region();
+
+    /// @brief The first byte of the region (aligned on a page when memory-mapped, on 64 bytes otherwise).
+    char const *data() const noexcept { return m_data; }
+
+    /// @brief The size of the region in bytes.
+    std::size_t size() const noexcept { return m_size; }
+
+    /// @brief Return true if the file is memory-mapped (false if it was read into a buffer).
+    bool is_memory_mapped() const noexcept { return m_buffer == nullptr; }
+
+    /// @brief Return true if the given address points into the region.
+    bool contains( void const *a_p ) const noexcept
+    {
+        auto const *p = static_cast<char const *>(a_p);
+        return p >= m_data && p < m_data + m_size;
+    }
+
+    /// @brief Return true if the given range of bytes is inside the region.
+    bool contains( std::size_t a_offset, std::size_t a_size ) const noexcept
+    {
+        return a_offset <= m_size && a_size <= m_size - a_offset;
+    }
+
+private:
+
+    char const *m_data{nullptr};
+    std::size_t m_size{0};
+    std::unique_ptr<char[]> m_buffer;// fallback (not memory-mapped)
+};
+
+//..............................................................................
+//..............................................................................
+
+// INLINES :
+
+inline
+mapped_region::mapped_region( std::string const &a_path )
+{
+#if SOLO_ANY_HANDLE_HAS_MMAP
+    auto const fd = ::open(a_path.c_str(), O_RDONLY);
+    if ( fd < 0 )
+    {
+        throw region_error{ "cannot open " + a_path };
+    }
+    struct stat st{};
+    if ( ::fstat(fd, &st) != 0 || st.st_size <= 0 )
+    {
+        ::close(fd);
+        throw region_error{ "cannot map empty or unreadable file " + a_path };
+    }
+    auto *const p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);// the mapping keeps the file
+    if ( p == MAP_FAILED )
+    {
+        throw region_error{ "cannot map " + a_path };
+    }
+    m_data = static_cast<char const *>(p);
+    m_size = static_cast<std::size_t>(st.st_size);
+#else
+    auto is = std::ifstream{ a_path, std::ios::binary | std::ios::ate };
+    if ( !is )
+    {
+        throw region_error{ "cannot open " + a_path };
+    }
+    auto const size = static_cast<std::size_t>(is.tellg());
+    if ( size == 0 )
+    {
+        throw region_error{ "cannot map empty file " + a_path };
+    }
+    constexpr std::size_t alignment = 64;
+    m_buffer.reset( new char[size + alignment] );
+    void *aligned = m_buffer.get();
+    auto space = size + alignment;
+    std::align(alignment, size, aligned, space);
+    is.seekg(0);
+    if ( !is.read(static_cast<char *>(aligned), static_cast<std::streamsize>(size)) )
+    {
+        throw region_error{ "cannot read " + a_path };
+    }
+    m_data = static_cast<char const *>(aligned);
+    m_size = size;
+#endif
+}
+
+inline
+mapped_region::~mapped_region()
+{
+#if SOLO_ANY_HANDLE_HAS_MMAP
+    ::munmap(const_cast<char *>(m_data), m_size);
+#endif
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Map the given file into a shared region.
+/// @throw @c region_error if the file cannot be opened, or is empty.
+inline std::shared_ptr<mapped_region const>
+make_mapped_region( std::string const &a_path )
+{
+    return std::make_shared<mapped_region const>(a_path);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::REGIONS
+////////////////////////////////////////////////////////////////////////////////
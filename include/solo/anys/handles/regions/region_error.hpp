@@ -0,0 +1,41 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace regions {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+class region_error;
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Exception thrown when a file cannot be mapped, or when a mapped object
+/// does not match the requested type (type, size, alignment or bounds).
+class region_error
+    : public std::runtime_error
+{
+public:
+    explicit region_error( std::string const &a_what )
+        : std::runtime_error{ "solo::anys::regions: " + a_what }
+    {}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::REGIONS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,22 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+/// @file
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Opt-in handles to plain-data objects living in mapped files (not included by the library packages).
+///
+/// - @c solo::anys::regions::mapped_region and @c solo::anys::regions::make_mapped_region : the shared mapping of a file,
+/// - @c solo::anys::regions::append_mapped_object : write an object and its header into the content of a region,
+/// - @c solo::anys::regions::make_mapped_any_handle<T> : a zero-copy, non-mutable handle to an object of a region.
+
+#include <solo/anys/handles/regions/region_error.hpp>
+#include <solo/anys/handles/regions/mapped_region.hpp>
+#include <solo/anys/handles/regions/mapped_object.hpp>
+#include <solo/anys/handles/regions/make_mapped_any_handle.hpp>
@@ -0,0 +1,384 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/any_handle.hpp>
+#include <solo/anys/handles/details/check_any_handle_cast.hpp>
+#include <solo/anys/handles/mutability.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Set to 1 if the compiler supports the C++20 coroutines (@c any_handle_registry::when_available).
+#if !defined(SOLO_ANY_HANDLE_HAS_COROUTINES)
+#  if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#    define SOLO_ANY_HANDLE_HAS_COROUTINES 1
+#  else
+#    define SOLO_ANY_HANDLE_HAS_COROUTINES 0
+#  endif
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace registries {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+class any_handle_registry;
+
+namespace detail {
+    class registry_waiter;
+}// EONS DETAIL
+
+#if SOLO_ANY_HANDLE_HAS_COROUTINES
+template < typename T, mutability IsMutable, typename Executor >
+class registry_awaitable;
+#endif
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+namespace detail {
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief A waiter for a handle of a given type and mutability, published under a given key.
+///
+/// Registered by @c any_handle_registry::wait and owned by the caller (no allocation per waiter but the
+/// slot of its key) : the coroutine awaitables derive from it, and live in the coroutine frames.
+class registry_waiter
+{
+public:
+
+    registry_waiter( anys::detail::any_cast_target_type const &a_target_type, mutability a_ismutable ) noexcept
+        : m_target_type{ &a_target_type }
+        , m_ismutable{ a_ismutable }
+    {}
+
+    registry_waiter( registry_waiter const & ) = delete;
+    registry_waiter &operator=( registry_waiter const & ) = delete;
+
+    /// @brief Return true if the given handle is the awaited one.
+    bool accepts( any_handle const &a_handle ) const noexcept
+    {
+        return anys::detail::is_any_handle_cast_valid(a_handle, *m_target_type, m_ismutable);// lazy objects built by the casts
+    }
+
+    /// @brief Called once, out of the lock of the registry, with the awaited handle (or an empty handle if the registry closed).
+    /// @note Not called once @c any_handle_registry::cancel has returned.
+    virtual void on_available( any_handle a_handle ) noexcept = 0;
+
+protected:
+
+    ~registry_waiter() = default;
+
+private:
+
+    anys::detail::any_cast_target_type const *m_target_type;
+    mutability m_ismutable;
+};
+
+}// EONS DETAIL
+
+//..............................................................................
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief A thread-safe registry of handles published under string keys, whose consumers can wait for a publication.
+///
+/// The components publish their resources at start-up, the other components find them,
+/// or wait for them without polling : with the C++20 coroutines,
+/// <c>co_await registry.when_available<T>(key, executor)</c> suspends the calling coroutine until
+/// a handle castable to @c T is published under @c key, then resumes it on the given executor
+/// with the result of @c any_handle_cast (no thread per waiter).
+///
+/// Example:
+///
+/// @code
+///     solo::anys::registries::any_handle_registry registry;
+///
+///     task<void> start_renderer( executor &ex )
+///     {
+///         auto device = co_await registry.when_available<Device>("device", ex);
+///         if ( device.has_value() ) { ... }
+///     }
+///
+///     // another component
+///     registry.publish("device", solo::make_any_handle<Device>(stdex::in_place, ...));
+/// @endcode
+///
+/// @note Closing (or destroying) the registry resumes the pending waiters with an empty source error.
+class any_handle_registry
+{
+public:
+
+    any_handle_registry() = default;
+    any_handle_registry( any_handle_registry const & ) = delete;
+    any_handle_registry &operator=( any_handle_registry const & ) = delete;
+
+    ~any_handle_registry() { close(); }
+
+    /// @brief Publish the given handle under the given key (replacing the previous one), and notify its waiters.
+    /// @note The waiters awaiting another type or mutability keep waiting.
+    void publish( std::string const &a_key, any_handle a_handle );
+
+    /// @brief Return the handle published under the given key, or an empty handle.
+    any_handle find( std::string const &a_key ) const;
+
+    /// @brief Withdraw the handle published under the given key.
+    /// @return false if no handle was published under the key.
+    bool unpublish( std::string const &a_key );
+
+    /// @brief Return the number of published handles.
+    std::size_t size() const;
+
+    /// @brief Return the number of pending waiters.
+    std::size_t waiter_count() const;
+
+    /// @brief Notify the pending waiters with an empty handle ; the later waits complete at once.
+    void close();
+
+    /// @brief Register the given waiter for the given key, unless the awaited handle is already published.
+    /// @return false if the wait completed at once : @c a_handle is then the awaited handle (empty if the registry is closed),
+    /// and @c on_available is not called.
+    bool wait( std::string const &a_key, detail::registry_waiter &a_waiter, any_handle &a_handle );
+
+    /// @brief Unregister the given waiter, if still pending (e.g. on the destruction of a suspended coroutine).
+    ///
+    /// A waiter selected by a publication (or a closing) but not notified yet is dropped ; if its @c on_available
+    /// is running on another thread, waits for its return. The waiter is not touched by the registry afterwards.
+    /// @pre Not called by the @c on_available of the given waiter.
+    void cancel( std::string const &a_key, detail::registry_waiter &a_waiter ) noexcept;
+
+#if SOLO_ANY_HANDLE_HAS_COROUTINES
+    /// @brief Return an awaitable resuming the awaiting coroutine on @c a_executor once a handle to a non-mutable
+    /// object of type @c T is published under @c a_key (see @c registry_awaitable).
+    template < typename T, typename Executor >
+    registry_awaitable<T, mutability::false_, Executor> when_available( std::string a_key, Executor a_executor );
+
+    /// @brief The same, for a handle to a mutable object of type @c T.
+    template < typename T, typename Executor >
+    registry_awaitable<T, mutability::true_, Executor> when_available_mutable( std::string a_key, Executor a_executor );
+#endif
+
+private:
+
+    /// @brief Notify the given waiters, out of the lock, but the ones cancelled meanwhile.
+    /// @pre The waiters are registered in @c m_selected.
+    void notify( std::vector<detail::registry_waiter *> const &a_waiters, any_handle const &a_handle ) noexcept;
+
+    /// @brief Reserve the room of the given number of selected waiters : their notification does not allocate (lock held).
+    void reserve_selected( std::size_t a_count );
+
+    /// @brief Remove one occurrence of the given waiter from the given list (lock held).
+    /// @return false if not found.
+    static bool remove_waiter( std::vector<detail::registry_waiter *> &a_waiters, detail::registry_waiter const *a_waiter ) noexcept;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, any_handle> m_handles;
+    std::unordered_map<std::string, std::vector<detail::registry_waiter *>> m_waiters;
+    std::vector<detail::registry_waiter *> m_selected;// by a publication, not notified yet (compared, never dereferenced)
+    std::vector<detail::registry_waiter *> m_notifying;// in their on_available (compared, never dereferenced)
+    std::condition_variable m_notified;// signaled at the return of each on_available
+    bool m_closed{false};
+};
+
+//..............................................................................
+//..............................................................................
+
+// INLINES :
+
+inline void
+any_handle_registry::publish( std::string const &a_key, any_handle a_handle )
+{
+    auto notified = std::vector<detail::registry_waiter *>{};
+    auto replaced = any_handle{};// released out of the lock
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        replaced = std::exchange(m_handles[a_key], a_handle);
+        auto const found = m_waiters.find(a_key);
+        if ( found != m_waiters.end() )
+        {
+            auto &waiters = found->second;
+            auto const accepted = std::stable_partition(waiters.begin(), waiters.end(),
+                                                        [&]( detail::registry_waiter const *w ) { return !w->accepts(a_handle); });
+            notified.assign(accepted, waiters.end());
+            reserve_selected(notified.size());
+            m_selected.insert(m_selected.end(), accepted, waiters.end());
+            waiters.erase(accepted, waiters.end());
+            if ( waiters.empty() )
+            {
+                m_waiters.erase(found);
+            }
+        }
+    }
+    notify(notified, a_handle);// out of the lock : the executors may resume the waiters inline
+}
+
+inline any_handle
+any_handle_registry::find( std::string const &a_key ) const
+{
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    auto const found = m_handles.find(a_key);
+    return found == m_handles.end() ? any_handle{} : found->second;
+}
+
+inline bool
+any_handle_registry::unpublish( std::string const &a_key )
+{
+    auto withdrawn = any_handle{};// released out of the lock
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    auto const found = m_handles.find(a_key);
+    if ( found == m_handles.end() )
+    {
+        return false;
+    }
+    withdrawn = std::move(found->second);
+    m_handles.erase(found);
+    return true;
+}
+
+inline std::size_t
+any_handle_registry::size() const
+{
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    return m_handles.size();
+}
+
+inline std::size_t
+any_handle_registry::waiter_count() const
+{
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    auto count = std::size_t{0};
+    for ( auto const &key_waiters : m_waiters )
+    {
+        count += key_waiters.second.size();
+    }
+    return count;
+}
+
+inline void
+any_handle_registry::close()
+{
+    auto waiters = std::unordered_map<std::string, std::vector<detail::registry_waiter *>>{};
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        m_closed = true;
+        auto count = std::size_t{0};
+        for ( auto const &key_waiters : m_waiters )
+        {
+            count += key_waiters.second.size();
+        }
+        reserve_selected(count);
+        waiters.swap(m_waiters);
+        for ( auto const &key_waiters : waiters )
+        {
+            m_selected.insert(m_selected.end(), key_waiters.second.begin(), key_waiters.second.end());
+        }
+    }
+    for ( auto const &key_waiters : waiters )
+    {
+        notify(key_waiters.second, any_handle{});
+    }
+}
+
+inline bool
+any_handle_registry::wait( std::string const &a_key, detail::registry_waiter &a_waiter, any_handle &a_handle )
+{
+    std::lock_guard<std::mutex> lock{ m_mutex };
+    if ( m_closed )
+    {
+        a_handle = any_handle{};
+        return false;
+    }
+    auto const found = m_handles.find(a_key);
+    if ( found != m_handles.end() && a_waiter.accepts(found->second) )
+    {
+        a_handle = found->second;
+        return false;
+    }
+    m_waiters[a_key].push_back(&a_waiter);
+    return true;
+}
+
+inline void
+any_handle_registry::cancel( std::string const &a_key, detail::registry_waiter &a_waiter ) noexcept
+{
+    std::unique_lock<std::mutex> lock{ m_mutex };
+    auto const found = m_waiters.find(a_key);
+    if ( found != m_waiters.end() && remove_waiter(found->second, &a_waiter) )// still pending
+    {
+        if ( found->second.empty() )
+        {
+            m_waiters.erase(found);
+        }
+        return;
+    }
+    if ( remove_waiter(m_selected, &a_waiter) )// selected by a publication : not notified
+    {
+        return;
+    }
+    m_notified.wait(lock, [&] { return std::find(m_notifying.begin(), m_notifying.end(), &a_waiter) == m_notifying.end(); });
+}
+
+inline void
+any_handle_registry::notify( std::vector<detail::registry_waiter *> const &a_waiters, any_handle const &a_handle ) noexcept
+{
+    for ( auto *const waiter : a_waiters )
+    {
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            if ( !remove_waiter(m_selected, waiter) )// cancelled meanwhile : maybe destroyed
+            {
+                continue;
+            }
+            m_notifying.push_back(waiter);// nothrow : reserved by reserve_selected
+        }
+        waiter->on_available(a_handle);
+        {
+            std::lock_guard<std::mutex> lock{ m_mutex };
+            remove_waiter(m_notifying, waiter);// by address only : the waiter may be destroyed by now
+        }
+        m_notified.notify_all();
+    }
+}
+
+inline void
+any_handle_registry::reserve_selected( std::size_t a_count )
+{
+    m_selected.reserve(m_selected.size() + a_count);
+    m_notifying.reserve(m_notifying.size() + m_selected.size() + a_count);// each notifying waiter was selected
+}
+
+inline bool
+any_handle_registry::remove_waiter( std::vector<detail::registry_waiter *> &a_waiters, detail::registry_waiter const *a_waiter ) noexcept
+{
+    auto const found = std::find(a_waiters.begin(), a_waiters.end(), a_waiter);
+    if ( found == a_waiters.end() )
+    {
+        return false;
+    }
+    a_waiters.erase(found);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::REGISTRIES
+////////////////////////////////////////////////////////////////////////////////
+
+#if SOLO_ANY_HANDLE_HAS_COROUTINES
+#include <solo/anys/handles/registries/registry_awaitable.hpp>
+#endif
@@ -0,0 +1,446 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/any_handle_core_package.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace registries {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+class persistent_handle_map;
+
+template < typename T >
+any_handle_cast_result_type<T> find_cast( persistent_handle_map const &a_map, std::string const &a_key );
+
+template < typename T >
+any_handle_mutable_cast_result_type<T> find_mutable_cast( persistent_handle_map const &a_map, std::string const &a_key );
+
+namespace detail {
+    struct hamt_leaf;
+    struct hamt_node;
+    struct hamt;
+}// EONS DETAIL
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+namespace detail {
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief A key, its hash and its handle, stored in the nodes of a hash array mapped trie.
+struct hamt_leaf
+{
+    std::size_t hash;
+    std::string key;
+    any_handle handle;
+};
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief An immutable node of a hash array mapped trie : 32 branches, each empty, a leaf or a child node.
+///
+/// The leaves and the children are stored apart, by rank of their branch in their bitmap (CHAMP layout).
+/// Once the hash bits are exhausted, a node is a collision node : its leaves only, in no particular order.
+struct hamt_node
+{
+    std::uint32_t leaf_map = 0;
+    std::uint32_t child_map = 0;
+    std::vector<hamt_leaf> leaves;
+    std::vector<std::shared_ptr<hamt_node const>> children;
+};
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The algorithms of the hash array mapped tries : the updates copy the path from the root to
+/// the updated leaf, and share all the other nodes with the original trie.
+struct hamt
+{
+    using node_ptr = std::shared_ptr<hamt_node const>;
+
+    static constexpr unsigned bits_per_level = 5;
+    static constexpr unsigned hash_bits = std::numeric_limits<std::size_t>::digits;
+
+    static std::uint32_t bit_of( std::size_t a_hash, unsigned a_shift ) noexcept
+    {
+        return std::uint32_t{1} << ( ( a_hash >> a_shift ) & 31u );
+    }
+
+    /// @brief The index of the given branch among the branches of the given bitmap.
+    static std::size_t rank( std::uint32_t a_map, std::uint32_t a_bit ) noexcept
+    {
+        auto x = a_map & ( a_bit - 1 );
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>( __builtin_popcount(x) );
+#else
+        x = x - ( ( x >> 1 ) & 0x55555555u );
+        x = ( x & 0x33333333u ) + ( ( x >> 2 ) & 0x33333333u );
+        return static_cast<std::size_t>( ( ( ( x + ( x >> 4 ) ) & 0x0F0F0F0Fu ) * 0x01010101u ) >> 24 );
+#endif
+    }
+
+    /// @brief Return the handle of the given key, or nullptr.
+    static any_handle const *find( hamt_node const *a_node, std::size_t a_hash, std::string const &a_key ) noexcept;
+
+    /// @brief Return a copy of the given node with the given leaf set (added or replaced, see @c a_added).
+    static node_ptr insert( hamt_node const &a_node, unsigned a_shift, hamt_leaf &&a_leaf, bool &a_added );
+
+    /// @brief Return a copy of the given node without the given key (nullptr if empty), if @c a_erased.
+    static node_ptr erase( hamt_node const &a_node, unsigned a_shift, std::size_t a_hash, std::string const &a_key, bool &a_erased );
+
+    /// @brief Return the node holding two leaves of different keys from the given level on.
+    static node_ptr merge( hamt_leaf &&a_first, hamt_leaf &&a_second, unsigned a_shift );
+
+    template < typename F >
+    static void for_each( hamt_node const &a_node, F &a_callable );
+};
+
+}// EONS DETAIL
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief An immutable map of handles by string keys : a hash array mapped trie, shared by its versions.
+///
+/// An update (@c with, @c without) returns a new map in O(log32 n) : it copies the nodes on the path of
+/// the key (about 4 nodes for a million keys) and shares all the others with the original map, which is
+/// left untouched. Copying a map is O(1) (one reference count), whatever its size : a map is a consistent
+/// snapshot, readable from any thread without lock.
+///
+/// Example:
+///
+/// @code
+///     auto const v1 = persistent_handle_map{}.with("device", device).with("window", window);
+///     auto const v2 = v1.without("window");
+///     assert(v1.size() == 2 && v2.size() == 1);
+///     auto d = find_cast<Device>(v2, "device");
+/// @endcode
+///
+/// @see @c persistent_registry, publishing the versions of a map to concurrent readers.
+class persistent_handle_map
+{
+public:
+
+    persistent_handle_map() = default;
+
+    /// @brief Return the handle published under the given key, or an empty handle.
+    any_handle find( std::string const &a_key ) const
+    {
+        auto const *const found = detail::hamt::find(m_root.get(), hash_of(a_key), a_key);
+        return found == nullptr ? any_handle{} : *found;
+    }
+
+    /// @brief Return true if a handle is published under the given key.
+    bool contains( std::string const &a_key ) const noexcept
+    {
+        return detail::hamt::find(m_root.get(), hash_of(a_key), a_key) != nullptr;
+    }
+
+    /// @brief Return a new map, with the given handle under the given key (replacing the previous one).
+    persistent_handle_map with( std::string a_key, any_handle a_handle ) const;
+
+    /// @brief Return a new map, without the given key (or this map if the key is absent).
+    persistent_handle_map without( std::string const &a_key ) const;
+
+    /// @brief Return the number of keys.
+    std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    /// @brief Call <c>a_callable(std::string const &key, any_handle const &handle)</c> for each key, in no particular order.
+    template < typename F >
+    void for_each( F &&a_callable ) const
+    {
+        if ( m_root )
+        {
+            detail::hamt::for_each(*m_root, a_callable);
+        }
+    }
+
+private:
+
+    persistent_handle_map( detail::hamt::node_ptr a_root, std::size_t a_size ) noexcept
+        : m_root{ std::move(a_root) }
+        , m_size{ a_size }
+    {}
+
+    static std::size_t hash_of( std::string const &a_key ) noexcept
+    {
+        return std::hash<std::string>{}(a_key);
+    }
+
+    detail::hamt::node_ptr m_root;
+    std::size_t m_size = 0;
+};
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Return the result of @c any_handle_cast<T> on the handle published under the given key.
+template < typename T >
+inline any_handle_cast_result_type<T>
+find_cast( persistent_handle_map const &a_map, std::string const &a_key )
+{
+    return any_handle_cast<T>(a_map.find(a_key));
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Return the result of @c any_handle_mutable_cast<T> on the handle published under the given key.
+template < typename T >
+inline any_handle_mutable_cast_result_type<T>
+find_mutable_cast( persistent_handle_map const &a_map, std::string const &a_key )
+{
+    return any_handle_mutable_cast<T>(a_map.find(a_key));
+}
+
+//..............................................................................
+//..............................................................................
+
+// INLINES :
+
+namespace detail {
+
+inline any_handle const *
+hamt::find( hamt_node const *a_node, std::size_t a_hash, std::string const &a_key ) noexcept
+{
+    for ( auto shift = 0u; a_node != nullptr; shift += bits_per_level )
+    {
+        if ( shift >= hash_bits )// collision node
+        {
+            for ( auto const &leaf : a_node->leaves )
+            {
+                if ( leaf.key == a_key )
+                {
+                    return &leaf.handle;
+                }
+            }
+            return nullptr;
+        }
+        auto const bit = bit_of(a_hash, shift);
+        if ( a_node->leaf_map & bit )
+        {
+            auto const &leaf = a_node->leaves[rank(a_node->leaf_map, bit)];
+            return leaf.hash == a_hash && leaf.key == a_key ? &leaf.handle : nullptr;
+        }
+        if ( ( a_node->child_map & bit ) == 0 )
+        {
+            return nullptr;
+        }
+        a_node = a_node->children[rank(a_node->child_map, bit)].get();
+    }
+    return nullptr;
+}
+
+inline hamt::node_ptr
+hamt::insert( hamt_node const &a_node, unsigned a_shift, hamt_leaf &&a_leaf, bool &a_added )
+{
+    auto copy = std::make_shared<hamt_node>(a_node);
+    if ( a_shift >= hash_bits )// collision node
+    {
+        for ( auto &leaf : copy->leaves )
+        {
+            if ( leaf.key == a_leaf.key )
+            {
+                leaf.handle = std::move(a_leaf.handle);
+                return copy;
+            }
+        }
+        copy->leaves.push_back(std::move(a_leaf));
+        a_added = true;
+        return copy;
+    }
+    auto const bit = bit_of(a_leaf.hash, a_shift);
+    if ( a_node.leaf_map & bit )
+    {
+        auto const existing = copy->leaves.begin() + static_cast<std::ptrdiff_t>(rank(a_node.leaf_map, bit));
+        if ( existing->hash == a_leaf.hash && existing->key == a_leaf.key )
+        {
+            existing->handle = std::move(a_leaf.handle);
+            return copy;
+        }
+        // another key on this branch : both go down to a new child
+        auto child = merge(std::move(*existing), std::move(a_leaf), a_shift + bits_per_level);
+        copy->leaves.erase(existing);
+        copy->leaf_map &= ~bit;
+        copy->children.insert(copy->children.begin() + static_cast<std::ptrdiff_t>(rank(copy->child_map, bit)), std::move(child));
+        copy->child_map |= bit;
+        a_added = true;
+        return copy;
+    }
+    if ( a_node.child_map & bit )
+    {
+        auto &child = copy->children[rank(a_node.child_map, bit)];
+        child = insert(*child, a_shift + bits_per_level, std::move(a_leaf), a_added);
+        return copy;
+    }
+    copy->leaves.insert(copy->leaves.begin() + static_cast<std::ptrdiff_t>(rank(a_node.leaf_map, bit)), std::move(a_leaf));
+    copy->leaf_map |= bit;
+    a_added = true;
+    return copy;
+}
+
+inline hamt::node_ptr
+hamt::erase( hamt_node const &a_node, unsigned a_shift, std::size_t a_hash, std::string const &a_key, bool &a_erased )
+{
+    if ( a_shift >= hash_bits )// collision node
+    {
+        for ( auto i = std::size_t{0}; i < a_node.leaves.size(); ++i )
+        {
+            if ( a_node.leaves[i].key == a_key )
+            {
+                a_erased = true;
+                if ( a_node.leaves.size() == 1 )
+                {
+                    return nullptr;
+                }
+                auto copy = std::make_shared<hamt_node>(a_node);
+                copy->leaves.erase(copy->leaves.begin() + static_cast<std::ptrdiff_t>(i));
+                return copy;
+            }
+        }
+        return nullptr;
+    }
+    auto const bit = bit_of(a_hash, a_shift);
+    if ( a_node.leaf_map & bit )
+    {
+        auto const index = rank(a_node.leaf_map, bit);
+        auto const &leaf = a_node.leaves[index];
+        if ( leaf.hash != a_hash || leaf.key != a_key )
+        {
+            return nullptr;
+        }
+        a_erased = true;
+        if ( a_node.leaf_map == bit && a_node.child_map == 0 )
+        {
+            return nullptr;
+        }
+        auto copy = std::make_shared<hamt_node>(a_node);
+        copy->leaves.erase(copy->leaves.begin() + static_cast<std::ptrdiff_t>(index));
+        copy->leaf_map &= ~bit;
+        return copy;
+    }
+    if ( ( a_node.child_map & bit ) == 0 )
+    {
+        return nullptr;
+    }
+    auto const index = rank(a_node.child_map, bit);
+    auto child = erase(*a_node.children[index], a_shift + bits_per_level, a_hash, a_key, a_erased);
+    if ( !a_erased )
+    {
+        return nullptr;
+    }
+    if ( child && ( child->child_map != 0 || child->leaves.size() != 1 ) )
+    {
+        auto copy = std::make_shared<hamt_node>(a_node);
+        copy->children[index] = std::move(child);
+        return copy;
+    }
+    if ( !child && a_node.child_map == bit && a_node.leaf_map == 0 )
+    {
+        return nullptr;
+    }
+    // the child is gone, or left with a single leaf : the leaf moves up to this branch (canonical form)
+    auto copy = std::make_shared<hamt_node>(a_node);
+    copy->children.erase(copy->children.begin() + static_cast<std::ptrdiff_t>(index));
+    copy->child_map &= ~bit;
+    if ( child )
+    {
+        copy->leaves.insert(copy->leaves.begin() + static_cast<std::ptrdiff_t>(rank(copy->leaf_map, bit)), child->leaves.front());
+        copy->leaf_map |= bit;
+    }
+    return copy;
+}
+
+inline hamt::node_ptr
+hamt::merge( hamt_leaf &&a_first, hamt_leaf &&a_second, unsigned a_shift )
+{
+    auto node = std::make_shared<hamt_node>();
+    if ( a_shift >= hash_bits )// same hashes : collision node
+    {
+        node->leaves.reserve(2);
+        node->leaves.push_back(std::move(a_first));
+        node->leaves.push_back(std::move(a_second));
+        return node;
+    }
+    auto const first_bit = bit_of(a_first.hash, a_shift);
+    auto const second_bit = bit_of(a_second.hash, a_shift);
+    if ( first_bit == second_bit )
+    {
+        node->children.push_back(merge(std::move(a_first), std::move(a_second), a_shift + bits_per_level));
+        node->child_map = first_bit;
+        return node;
+    }
+    node->leaves.reserve(2);
+    node->leaves.push_back(std::move(first_bit < second_bit ? a_first : a_second));
+    node->leaves.push_back(std::move(first_bit < second_bit ? a_second : a_first));
+    node->leaf_map = first_bit | second_bit;
+    return node;
+}
+
+template < typename F >
+inline void
+hamt::for_each( hamt_node const &a_node, F &a_callable )
+{
+    for ( auto const &leaf : a_node.leaves )
+    {
+        a_callable(static_cast<std::string const &>(leaf.key), static_cast<any_handle const &>(leaf.handle));
+    }
+    for ( auto const &child : a_node.children )
+    {
+        for_each(*child, a_callable);
+    }
+}
+
+}// EONS DETAIL
+
+inline persistent_handle_map
+persistent_handle_map::with( std::string a_key, any_handle a_handle ) const
+{
+    auto const hash = hash_of(a_key);
+    auto leaf = detail::hamt_leaf{ hash, std::move(a_key), std::move(a_handle) };
+    if ( !m_root )
+    {
+        auto root = std::make_shared<detail::hamt_node>();
+        root->leaf_map = detail::hamt::bit_of(hash, 0);
+        root->leaves.push_back(std::move(leaf));
+        return persistent_handle_map{ std::move(root), 1 };
+    }
+    auto added = false;
+    auto root = detail::hamt::insert(*m_root, 0, std::move(leaf), added);
+    return persistent_handle_map{ std::move(root), m_size + ( added ? 1 : 0 ) };
+}
+
+inline persistent_handle_map
+persistent_handle_map::without( std::string const &a_key ) const
+{
+    if ( !m_root )
+    {
+        return *this;
+    }
+    auto erased = false;
+    auto root = detail::hamt::erase(*m_root, 0, hash_of(a_key), a_key, erased);
+    return erased ? persistent_handle_map{ std::move(root), m_size - 1 } : *this;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::REGISTRIES
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,370 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/registries/persistent_handle_map.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace registries {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+class persistent_registry;
+
+namespace detail {
+    struct persistent_registry_access;
+}// EONS DETAIL
+
+template < typename T >
+any_handle_cast_result_type<T> find_cast( persistent_registry const &a_registry, std::string const &a_key );
+
+template < typename T >
+any_handle_mutable_cast_result_type<T> find_mutable_cast( persistent_registry const &a_registry, std::string const &a_key );
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief A registry of handles by string keys, whose readers take consistent snapshots in O(1), without waiting.
+///
+/// The registry publishes the successive versions of a @c persistent_handle_map. A reader (@c snapshot, @c find,
+/// @c size) is wait-free : it acquires the published version with one atomic increment, copies what it needs
+/// (for a snapshot, one reference count), and releases it with one atomic decrement, whatever the writers do.
+/// A long-running request reads its snapshot at leisure : the writers never change it, they publish new versions
+/// sharing all but O(log32 n) nodes with it.
+///
+/// The writers (@c publish, @c unpublish, @c update) are serialized by a mutex.
+///
+/// Example:
+///
+/// @code
+///     solo::anys::registries::persistent_registry registry;
+///     registry.publish("device", solo::make_any_handle<Device>(stdex::in_place, ...));
+///
+///     // a request : the same resources from its start to its end
+///     auto const resources = registry.snapshot();
+///     auto device = find_cast<Device>(resources, "device");
+/// @endcode
+///
+/// @note The versions are acquired through a split count : the published state packs the slot of the current version
+/// and the number of its acquisitions, the version counts its releases, and the last of the releases and of the
+/// replacement deletes it. All the readers increment the same state : they contend on its cache line.
+/// @note The acquisitions are counted on 48 bits, reset by each publication : in a registry read without being written,
+/// the reader crossing half of the range folds the acquisitions already released into the balance of the version
+/// (a few atomic operations, once per 2^47 reads), so the count never carries into the slot.
+class persistent_registry
+{
+public:
+
+    persistent_registry();
+    ~persistent_registry();
+
+    persistent_registry( persistent_registry const & ) = delete;
+    persistent_registry &operator=( persistent_registry const & ) = delete;
+
+    /// @brief Return the current version of the registry (wait-free, O(1)).
+    persistent_handle_map snapshot() const;
+
+    /// @brief Return the handle published under the given key, or an empty handle (wait-free).
+    any_handle find( std::string const &a_key ) const;
+
+    /// @brief Return the number of published handles (wait-free).
+    std::size_t size() const;
+
+    /// @brief Publish the given handle under the given key (replacing the previous one).
+    void publish( std::string a_key, any_handle a_handle );
+
+    /// @brief Withdraw the handle published under the given key.
+    /// @return false if no handle was published under the key.
+    bool unpublish( std::string const &a_key );
+
+    /// @brief Publish the version returned by <c>a_transform(persistent_handle_map const &current)</c> : the changes
+    /// of a batch are visible all at once.
+    template < typename F >
+    void update( F &&a_transform );
+
+private:
+
+    /// @brief A published version, deleted by the last of its readers and of its replacement.
+    struct version
+    {
+        explicit version( persistent_handle_map a_map ) noexcept
+            : map{ std::move(a_map) }
+        {}
+
+        persistent_handle_map const map;
+        std::atomic<std::int64_t> balance{ 0 };// the releases, until the replacement adds the acquisitions
+    };
+
+    static constexpr std::size_t slot_count = 64;
+    static constexpr unsigned slot_shift = 48;
+    static constexpr std::uint64_t acquisition_mask = ( std::uint64_t{1} << slot_shift ) - 1;
+    static constexpr std::uint64_t fold_threshold = std::uint64_t{1} << ( slot_shift - 1 );
+
+    /// @brief Acquire the current version.
+    version const *acquire( std::size_t &a_slot ) const noexcept;
+
+    /// @brief Move the acquisitions of the given version already released from the state to its balance.
+    /// @pre The caller holds an acquisition of the version (the cold path of @c acquire).
+    void fold( std::size_t a_slot, version const *a_version ) const noexcept;
+
+    /// @brief Release a version acquired by @c acquire.
+    void release( std::size_t a_slot, version const *a_version ) const noexcept;
+
+    /// @brief Publish the given version (writer lock held), and retire the previous one.
+    void replace( persistent_handle_map a_map );
+
+    /// @brief Delete the given version and free its slot.
+    void reclaim( std::size_t a_slot, version const *a_version ) const noexcept
+    {
+        delete a_version;
+        m_slots[a_slot].store(nullptr, std::memory_order_release);
+    }
+
+    mutable std::atomic<std::uint64_t> m_state{ 0 };// slot of the current version << 48 | acquisitions
+    mutable std::array<std::atomic<version *>, slot_count> m_slots;
+    std::mutex m_writer_mutex;
+    std::size_t m_current_slot = 0;// writer lock held
+
+    friend struct detail::persistent_registry_access;
+};
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Return the result of @c any_handle_cast<T> on the handle published under the given key (wait-free).
+template < typename T >
+inline any_handle_cast_result_type<T>
+find_cast( persistent_registry const &a_registry, std::string const &a_key )
+{
+    return any_handle_cast<T>(a_registry.find(a_key));
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Return the result of @c any_handle_mutable_cast<T> on the handle published under the given key (wait-free).
+template < typename T >
+inline any_handle_mutable_cast_result_type<T>
+find_mutable_cast( persistent_registry const &a_registry, std::string const &a_key )
+{
+    return any_handle_mutable_cast<T>(a_registry.find(a_key));
+}
+
+//..............................................................................
+//..............................................................................
+
+// INLINES :
+
+inline
+persistent_registry::persistent_registry()
+{
+    for ( auto &slot : m_slots )
+    {
+        slot.store(nullptr, std::memory_order_relaxed);
+    }
+    m_slots[0].store(new version{ persistent_handle_map{} }, std::memory_order_relaxed);
+}
+
+inline
+persistent_registry::~persistent_registry()
+{
+    for ( auto &slot : m_slots )// no reader left : the current version, and none pending
+    {
+        delete slot.load(std::memory_order_acquire);
+    }
+}
+
+inline persistent_registry::version const *
+persistent_registry::acquire( std::size_t &a_slot ) const noexcept
+{
+    auto const state = m_state.fetch_add(1, std::memory_order_acquire);
+    a_slot = static_cast<std::size_t>(state >> slot_shift);
+    auto const *const current = m_slots[a_slot].load(std::memory_order_acquire);// not reclaimed before the matching release
+    if ( SOLO_UNLIKELY(( state & acquisition_mask ) >= fold_threshold) )
+    {
+        fold(a_slot, current);// cold : once per 2^47 reads without a publication
+    }
+    return current;
+}
+
+inline void
+persistent_registry::fold( std::size_t a_slot, version const *a_version ) const noexcept
+{
+    auto &balance = const_cast<version *>(a_version)->balance;
+
+    // a negative balance : the version is still current, and as many acquisitions are released.
+    // Folding no more keeps it non-positive until the replacement, which alone lets it reach 0.
+    auto folded = std::int64_t{0};
+    auto current = balance.load(std::memory_order_relaxed);
+    do
+    {
+        if ( current >= 0 )
+        {
+            return;// replaced meanwhile (counted by the replacement), or nothing released
+        }
+        folded = -current;
+    }
+    while ( !balance.compare_exchange_weak(current, 0, std::memory_order_acq_rel, std::memory_order_relaxed) );
+
+    auto state = m_state.load(std::memory_order_relaxed);
+    for ( ;; )
+    {
+        if ( static_cast<std::size_t>(state >> slot_shift) != a_slot )
+        {
+            // replaced before the fold : the replacement has counted the folded acquisitions too
+            if ( balance.fetch_sub(folded, std::memory_order_acq_rel) == folded )
+            {
+                reclaim(a_slot, a_version);// not expected : the caller still holds an acquisition
+            }
+            return;
+        }
+        // at least the folded acquisitions are counted : each release follows its acquisition
+        if ( m_state.compare_exchange_weak(state, state - static_cast<std::uint64_t>(folded), std::memory_order_acq_rel, std::memory_order_relaxed) )
+        {
+            return;
+        }
+    }
+}
+
+inline void
+persistent_registry::release( std::size_t a_slot, version const *a_version ) const noexcept
+{
+    if ( const_cast<version *>(a_version)->balance.fetch_sub(1, std::memory_order_acq_rel) == 1 )
+    {
+        reclaim(a_slot, a_version);// the last reader of a replaced version
+    }
+}
+
+inline persistent_handle_map
+persistent_registry::snapshot() const
+{
+    auto slot = std::size_t{0};
+    auto const *const current = acquire(slot);
+    auto result = current->map;// one reference count
+    release(slot, current);
+    return result;
+}
+
+inline any_handle
+persistent_registry::find( std::string const &a_key ) const
+{
+    auto slot = std::size_t{0};
+    auto const *const current = acquire(slot);
+    auto result = current->map.find(a_key);
+    release(slot, current);
+    return result;
+}
+
+inline std::size_t
+persistent_registry::size() const
+{
+    auto slot = std::size_t{0};
+    auto const *const current = acquire(slot);
+    auto const result = current->map.size();
+    release(slot, current);
+    return result;
+}
+
+inline void
+persistent_registry::replace( persistent_handle_map a_map )
+{
+    // a free slot : the replaced versions are reclaimed as soon as their readers are done
+    auto slot = m_current_slot;
+    for ( auto i = std::size_t{1}; ; ++i )
+    {
+        slot = ( m_current_slot + i ) % slot_count;
+        if ( slot != m_current_slot && m_slots[slot].load(std::memory_order_acquire) == nullptr )
+        {
+            break;
+        }
+        if ( i % slot_count == 0 )
+        {
+            std::this_thread::yield();// 63 versions still read
+        }
+    }
+    auto *const next = new version{ std::move(a_map) };
+    m_slots[slot].store(next, std::memory_order_relaxed);
+    auto const state = m_state.exchange(std::uint64_t{ slot } << slot_shift, std::memory_order_acq_rel);
+    auto *const previous = m_slots[m_current_slot].load(std::memory_order_relaxed);
+    auto const acquisitions = static_cast<std::int64_t>(state & acquisition_mask);
+    m_current_slot = slot;
+    if ( previous->balance.fetch_add(acquisitions, std::memory_order_acq_rel) + acquisitions == 0 )
+    {
+        reclaim(static_cast<std::size_t>(state >> slot_shift), previous);// all its readers are done
+    }
+}
+
+inline void
+persistent_registry::publish( std::string a_key, any_handle a_handle )
+{
+    std::lock_guard<std::mutex> lock{ m_writer_mutex };
+    replace(m_slots[m_current_slot].load(std::memory_order_relaxed)->map.with(std::move(a_key), std::move(a_handle)));
+}
+
+inline bool
+persistent_registry::unpublish( std::string const &a_key )
+{
+    std::lock_guard<std::mutex> lock{ m_writer_mutex };
+    auto const &current = m_slots[m_current_slot].load(std::memory_order_relaxed)->map;
+    auto next = current.without(a_key);
+    if ( next.size() == current.size() )
+    {
+        return false;
+    }
+    replace(std::move(next));
+    return true;
+}
+
+template < typename F >
+inline void
+persistent_registry::update( F &&a_transform )
+{
+    std::lock_guard<std::mutex> lock{ m_writer_mutex };
+    replace(std::forward<F>(a_transform)(m_slots[m_current_slot].load(std::memory_order_relaxed)->map));
+}
+
+//..............................................................................
+
+namespace detail {
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief The access of the tests to the acquisition count of a @c persistent_registry.
+struct persistent_registry_access
+{
+    /// @brief Return the number of acquisitions counted by the state.
+    static std::uint64_t acquisitions( persistent_registry const &a_registry ) noexcept
+    {
+        return a_registry.m_state.load() & persistent_registry::acquisition_mask;
+    }
+
+    /// @brief Count the given number of acquisitions of the current version, already released (no reader running).
+    static void seed_acquisitions( persistent_registry &a_registry, std::uint64_t a_count ) noexcept
+    {
+        a_registry.m_state.fetch_add(a_count);
+        a_registry.m_slots[a_registry.m_current_slot].load()->balance.fetch_sub(static_cast<std::int64_t>(a_count));
+    }
+
+    /// @brief The number of acquisitions from which the readers fold the count.
+    static constexpr std::uint64_t fold_threshold = persistent_registry::fold_threshold;
+};
+
+}// EONS DETAIL
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::REGISTRIES
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,151 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/registries/any_handle_registry.hpp>
+
+#if !SOLO_ANY_HANDLE_HAS_COROUTINES
+#error "registry_awaitable.hpp requires the C++20 coroutines"
+#endif
+
+#include <solo/anys/handles/any_handle_cast.hpp>
+#include <solo/anys/handles/any_handle_mutable_cast.hpp>
+
+#include <coroutine>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace registries {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+struct inline_executor;
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The executor resuming the waiters on the publishing thread, inside @c any_handle_registry::publish.
+///
+/// An executor is any copyable callable taking the @c std::coroutine_handle<> to resume
+/// (e.g. a lambda posting it to a thread pool, or to the event loop of the caller).
+struct inline_executor
+{
+    void operator()( std::coroutine_handle<> a_continuation ) const { a_continuation.resume(); }
+};
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The awaitable of @c any_handle_registry::when_available and @c when_available_mutable.
+///
+/// Does not suspend if the awaited handle is already published. Otherwise registers itself (it lives in the frame of
+/// the awaiting coroutine : no allocation but the slot of its key, no thread), and the publication of the awaited handle
+/// hands the awaiting coroutine to the executor.
+/// The result of the @c co_await expression is the result of @c any_handle_cast<T> (or @c any_handle_mutable_cast<T>)
+/// applied to the published handle : an @c empty_source error if the registry was closed.
+///
+/// @note Destroying a suspended coroutine unregisters its awaitable : the registry must outlive it.
+/// A publication that has selected the awaitable but not notified it yet skips it ; one that is notifying it
+/// is waited for by the destruction (see @c any_handle_registry::cancel). The notification hands the coroutine
+/// to the executor : a coroutine destroyed while a publication resumes it is still an error.
+template < typename T, mutability IsMutable, typename Executor >
+class registry_awaitable final : private detail::registry_waiter
+{
+public:
+
+    using result_type = std::conditional_t<IsMutable == mutability::true_,
+                                           any_handle_mutable_cast_result_type<T>,
+                                           any_handle_cast_result_type<T>>;
+
+    registry_awaitable( any_handle_registry &a_registry, std::string a_key, Executor a_executor )
+        : registry_waiter{ anys::detail::any_cast_target<T>(), IsMutable }
+        , m_registry{ &a_registry }
+        , m_key{ std::move(a_key) }
+        , m_executor{ std::move(a_executor) }
+    {}
+
+    ~registry_awaitable()
+    {
+        if ( m_suspended )// the coroutine is destroyed while suspended
+        {
+            m_registry->cancel(m_key, *this);
+        }
+    }
+
+    bool await_ready() const noexcept { return false; }// the lookup is done under the lock of await_suspend
+
+    bool await_suspend( std::coroutine_handle<> a_continuation )
+    {
+        m_continuation = a_continuation;
+        m_suspended = true;
+        if ( !m_registry->wait(m_key, *this, m_handle) )
+        {
+            m_suspended = false;
+            return false;
+        }
+        return true;// registered : the coroutine may already run on the executor, *this is not touched anymore
+    }
+
+    result_type await_resume() noexcept
+    {
+        m_suspended = false;
+        if constexpr ( IsMutable == mutability::true_ )
+        {
+            return any_handle_mutable_cast<T>(m_handle);
+        }
+        else
+        {
+            return any_handle_cast<T>(m_handle);
+        }
+    }
+
+private:
+
+    void on_available( any_handle a_handle ) noexcept override
+    {
+        m_handle = std::move(a_handle);
+        auto executor = m_executor;// the resumed coroutine may destroy *this
+        executor(m_continuation);
+    }
+
+    any_handle_registry *m_registry;
+    std::string m_key;
+    Executor m_executor;
+    std::coroutine_handle<> m_continuation{};
+    any_handle m_handle{};
+    bool m_suspended{false};
+};
+
+//..............................................................................
+//..............................................................................
+
+// INLINES :
+
+template < typename T, typename Executor >
+inline registry_awaitable<T, mutability::false_, Executor>
+any_handle_registry::when_available( std::string a_key, Executor a_executor )
+{
+    return registry_awaitable<T, mutability::false_, Executor>{ *this, std::move(a_key), std::move(a_executor) };
+}
+
+template < typename T, typename Executor >
+inline registry_awaitable<T, mutability::true_, Executor>
+any_handle_registry::when_available_mutable( std::string a_key, Executor a_executor )
+{
+    static_assert(!std::is_const<T>::value, "a mutable object is not const");
+    return registry_awaitable<T, mutability::true_, Executor>{ *this, std::move(a_key), std::move(a_executor) };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::REGISTRIES
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,25 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+/// @file
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Opt-in registry of handles published under string keys (not included by the library packages).
+///
+/// - @c solo::anys::registries::any_handle_registry : @c publish, @c find, @c unpublish, @c close,
+/// - with the C++20 coroutines (@c SOLO_ANY_HANDLE_HAS_COROUTINES) : <c>co_await registry.when_available<T>(key, executor)</c>,
+///   @c when_available_mutable<T>, and @c solo::anys::registries::inline_executor,
+/// - @c solo::anys::registries::persistent_handle_map : an immutable hash array mapped trie of handles,
+///   updated in O(log32 n) by @c with and @c without, its versions sharing their nodes,
+/// - @c solo::anys::registries::persistent_registry : the versions of a persistent map published to wait-free readers,
+///   @c snapshot in O(1), and @c find_cast<T> / @c find_mutable_cast<T> on the maps and the registries.
+
+#include <solo/anys/handles/registries/any_handle_registry.hpp>
+#include <solo/anys/handles/registries/persistent_handle_map.hpp>
+#include <solo/anys/handles/registries/persistent_registry.hpp>
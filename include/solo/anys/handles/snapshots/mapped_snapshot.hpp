@@ -0,0 +1,283 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/regions/mapped_region.hpp>
+#include <solo/anys/handles/snapshots/snapshot_codec.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace snapshots {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+class mapped_snapshot;
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief A registry of handles restored from a snapshot file (see @c write_snapshot).
+///
+/// Opening a snapshot maps the file and checks its header and its tables : it does not read the objects.
+/// Each object is restored (materialized) by its codec on first access, then cached :
+/// the keys sharing an object in the saved registry share the same restored object.
+/// The non-mutable objects of trivially copyable types are zero-copy views into the mapped file.
+///
+/// Example:
+///
+/// @code
+///     // shutdown :
+///     write_snapshot("registry.snap", registry.begin(), registry.end(), codecs);
+///
+///     // restart :
+///     auto const snapshot = mapped_snapshot{ "registry.snap", codecs };
+///     auto const h = snapshot.find("textures/sky");// restored on first access
+/// @endcode
+///
+/// @note Thread-safe : concurrent accesses restore each object once.
+/// @note The restored handles keep the mapped file alive : they may outlive the snapshot.
+class mapped_snapshot
+{
+public:
+
+    /// @brief Open the given snapshot file.
+    ///
+    /// Check the header and the bounds of the entry records (linear in the number of keys, the objects are not read).
+    /// @throw @c snapshot_error if the file cannot be mapped, or if it is not a valid snapshot of this version.
+    mapped_snapshot( std::string const &a_path, snapshot_codec_registry a_codecs );
+
+    mapped_snapshot( mapped_snapshot const & ) = delete;
+    mapped_snapshot &operator=( mapped_snapshot const & ) = delete;
+
+    /// @brief The number of keys.
+    std::size_t size() const noexcept { return static_cast<std::size_t>(m_header.entry_count); }
+
+    /// @brief The number of distinct objects.
+    std::size_t object_count() const noexcept { return static_cast<std::size_t>(m_header.object_count); }
+
+    /// @brief The number of objects restored so far.
+    std::size_t materialized_count() const noexcept { return m_materialized_count.load(std::memory_order_relaxed); }
+
+    /// @brief The key at the given index (the keys are sorted).
+    /// @pre <c>a_index < size()</c>
+    std::string key( std::size_t a_index ) const;
+
+    /// @brief The handle at the given index, restored on first access.
+    /// @pre <c>a_index < size()</c>
+    /// @throw @c snapshot_error if no codec is registered for the handled type.
+    any_handle handle( std::size_t a_index ) const;
+
+    /// @brief Return the index of the given key, or @c size() if not found (binary search).
+    std::size_t index_of( std::string const &a_key ) const noexcept;
+
+    /// @brief The handle of the given key, restored on first access, or an empty handle if not found.
+    /// @throw @c snapshot_error if no codec is registered for the handled type.
+    any_handle find( std::string const &a_key ) const;
+
+    /// @brief Return true if the given address points into the mapped file (i.e. into a zero-copy view).
+    bool contains( void const *a_p ) const noexcept { return m_file->contains(a_p); }
+
+    /// @brief Return true if the file is memory-mapped.
+    bool is_memory_mapped() const noexcept { return m_file->is_memory_mapped(); }
+
+private:
+
+    static std::shared_ptr<regions::mapped_region const> open_snapshot_file( std::string const &a_path );
+
+    snapshot_object_record const &object_record( std::size_t a_index ) const noexcept;
+    snapshot_entry_record const &entry_record( std::size_t a_index ) const noexcept;
+    any_handle const &materialize( std::size_t a_object_index ) const;
+
+    std::shared_ptr<regions::mapped_region const> m_file;
+    snapshot_codec_registry m_codecs;
+    snapshot_file_header m_header;
+    std::unique_ptr<any_handle[]> m_objects;
+    std::unique_ptr<std::once_flag[]> m_object_flags;
+    mutable std::atomic<std::size_t> m_materialized_count{0};
+};
+
+//..............................................................................
+//..............................................................................
+
+// INLINES :
+
+inline
+mapped_snapshot::mapped_snapshot( std::string const &a_path, snapshot_codec_registry a_codecs )
+    : m_file{ open_snapshot_file(a_path) }
+    , m_codecs{ std::move(a_codecs) }
+    , m_header{}
+{
+    auto const file_size = static_cast<std::uint64_t>(m_file->size());
+    if ( file_size < sizeof(snapshot_file_header) )
+    {
+        throw snapshot_error{ a_path + " is not a snapshot file (too small)" };
+    }
+    std::memcpy(&m_header, m_file->data(), sizeof(m_header));
+    if ( std::memcmp(m_header.magic, snapshot_magic, sizeof(m_header.magic)) != 0 )
+    {
+        throw snapshot_error{ a_path + " is not a snapshot file (bad magic number)" };
+    }
+    if ( m_header.version != snapshot_format_version )
+    {
+        throw snapshot_error{ a_path + " has version " + std::to_string(m_header.version)
+                              + ", expected version " + std::to_string(snapshot_format_version) };
+    }
+    if ( m_header.endianness != snapshot_endianness_marker )
+    {
+        throw snapshot_error{ a_path + " was written with another endianness" };
+    }
+
+    // tables bounds (the records are read in place : their offsets must be aligned) :
+    auto const fits = [file_size]( std::uint64_t a_offset, std::uint64_t a_count, std::uint64_t a_size )
+    {
+        return a_offset <= file_size && a_count <= ( file_size - a_offset ) / a_size;
+    };
+    if ( m_header.file_size != file_size
+      || m_header.objects_offset % alignof(snapshot_object_record) != 0
+      || m_header.entries_offset % alignof(snapshot_entry_record) != 0
+      || m_header.data_offset % snapshot_data_alignment != 0
+      || !fits(m_header.objects_offset, m_header.object_count, sizeof(snapshot_object_record))
+      || !fits(m_header.entries_offset, m_header.entry_count, sizeof(snapshot_entry_record))
+      || !fits(m_header.keys_offset, m_header.keys_size, 1)
+      || !fits(m_header.data_offset, m_header.data_size, 1) )
+    {
+        throw snapshot_error{ a_path + " is truncated or corrupted" };
+    }
+
+    for ( auto i = std::size_t{0}; i < size(); ++i )
+    {
+        auto const &entry = entry_record(i);
+        if ( entry.key_offset > m_header.keys_size || entry.key_size > m_header.keys_size - entry.key_offset
+          || ( entry.object_index != snapshot_no_object && entry.object_index >= m_header.object_count ) )
+        {
+            throw snapshot_error{ a_path + " has a corrupted entry record" };
+        }
+    }
+
+    m_objects.reset( new any_handle[object_count()] );
+    m_object_flags.reset( new std::once_flag[object_count()] );
+}
+
+inline std::shared_ptr<regions::mapped_region const>
+mapped_snapshot::open_snapshot_file( std::string const &a_path )
+{
+    try
+    {
+        return regions::make_mapped_region(a_path);
+    }
+    catch ( regions::region_error const & )
+    {
+        throw snapshot_error{ "cannot map " + a_path };
+    }
+}
+
+inline snapshot_object_record const &
+mapped_snapshot::object_record( std::size_t a_index ) const noexcept
+{
+    return reinterpret_cast<snapshot_object_record const *>( m_file->data() + m_header.objects_offset )[a_index];
+}
+
+inline snapshot_entry_record const &
+mapped_snapshot::entry_record( std::size_t a_index ) const noexcept
+{
+    return reinterpret_cast<snapshot_entry_record const *>( m_file->data() + m_header.entries_offset )[a_index];
+}
+
+inline std::string
+mapped_snapshot::key( std::size_t a_index ) const
+{
+    auto const &entry = entry_record(a_index);
+    return std::string{ m_file->data() + m_header.keys_offset + entry.key_offset, static_cast<std::size_t>(entry.key_size) };
+}
+
+inline std::size_t
+mapped_snapshot::index_of( std::string const &a_key ) const noexcept
+{
+    auto const *const keys = m_file->data() + m_header.keys_offset;
+    auto const compare = [&]( std::size_t a_index ) noexcept// <0, 0, >0 as the key at a_index is before, equal, after a_key
+    {
+        auto const &entry = entry_record(a_index);
+        auto const n = std::min<std::size_t>( static_cast<std::size_t>(entry.key_size), a_key.size() );
+        auto const c = n == 0 ? 0 : std::memcmp(keys + entry.key_offset, a_key.data(), n);
+        return c != 0 ? c : ( entry.key_size < a_key.size() ? -1 : ( entry.key_size > a_key.size() ? 1 : 0 ) );
+    };
+    auto first = std::size_t{0};
+    auto count = size();
+    while ( count > 0 )
+    {
+        auto const half = count / 2;
+        if ( compare(first + half) < 0 )
+        {
+            first += half + 1;
+            count -= half + 1;
+        }
+        else
+        {
+            count = half;
+        }
+    }
+    return ( first < size() && compare(first) == 0 ) ? first : size();
+}
+
+inline any_handle const &
+mapped_snapshot::materialize( std::size_t a_object_index ) const
+{
+    std::call_once( m_object_flags[a_object_index], [this, a_object_index]
+    {
+        auto const &record = object_record(a_object_index);
+        auto const *codec = m_codecs.find(record.type_key);
+        if ( codec == nullptr )
+        {
+            throw snapshot_error{ "no codec registered for the type key " + std::to_string(record.type_key) };
+        }
+        auto const is_null = ( record.flags & snapshot_object_null ) != 0;
+        if ( !is_null && ( record.offset > m_header.data_size || record.size > m_header.data_size - record.offset
+                        || record.offset % codec->alignment() != 0 ) )
+        {
+            throw snapshot_error{ "corrupted object record" };
+        }
+        auto const *data = is_null ? nullptr : m_file->data() + m_header.data_offset + record.offset;
+        auto const ismutable = ( record.flags & snapshot_object_mutable ) != 0 ? mutability::true_ : mutability::false_;
+        m_objects[a_object_index] = codec->load(m_file, data, static_cast<std::size_t>(record.size), ismutable);
+        m_materialized_count.fetch_add(1, std::memory_order_relaxed);
+    });
+    return m_objects[a_object_index];
+}
+
+inline any_handle
+mapped_snapshot::handle( std::size_t a_index ) const
+{
+    auto const object_index = entry_record(a_index).object_index;
+    if ( object_index == snapshot_no_object )
+    {
+        return any_handle{};
+    }
+    return materialize( static_cast<std::size_t>(object_index) );
+}
+
+inline any_handle
+mapped_snapshot::find( std::string const &a_key ) const
+{
+    auto const index = index_of(a_key);
+    return index == size() ? any_handle{} : handle(index);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::SNAPSHOTS
+////////////////////////////////////////////////////////////////////////////////
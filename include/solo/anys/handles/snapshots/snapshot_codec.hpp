@@ -0,0 +1,239 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/any_handle_core_package.hpp>
+#include <solo/anys/handles/snapshots/snapshot_error.hpp>
+#include <solo/anys/handles/snapshots/snapshot_format.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace snapshots {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+class snapshot_codec;
+class snapshot_codec_registry;
+
+template < typename T >
+snapshot_codec make_snapshot_codec();
+
+template < typename T, typename Save, typename Load >
+snapshot_codec make_snapshot_codec( Save &&a_save, Load &&a_load );
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Save and restore the objects of one type.
+///
+/// Build codecs with @c make_snapshot_codec<T>, then register them into a @c snapshot_codec_registry.
+class snapshot_codec
+{
+public:
+
+    /// @brief Append the bytes of the object handled by the given (non-empty, non-null) handle.
+    using save_function = std::function<void( any_handle const &a_handle, std::string &a_bytes )>;
+
+    /// @brief Restore a handle from the object bytes, with the given mutability.
+    /// @param a_owner Owns the object bytes : the restored handle may point into them (zero-copy view).
+    /// @param a_data The object bytes (aligned on the codec alignment), or @c nullptr for a null typed handle.
+    using load_function = std::function<any_handle( std::shared_ptr<void const> const &a_owner,
+                                                    char const *a_data, std::size_t a_size, mutability a_ismutable )>;
+
+    /// @param a_type_key The key of the type in snapshot files (see @c anys::detail::make_any_type_persistent_key).
+    snapshot_codec( std::type_index const &a_type, std::uint64_t a_type_key, std::size_t a_alignment, save_function a_save, load_function a_load )
+        : m_type{ a_type }
+        , m_type_key{ a_type_key }
+        , m_alignment{ a_alignment }
+        , m_save{ std::move(a_save) }
+        , m_load{ std::move(a_load) }
+    {}
+
+    /// @brief The handled type.
+    std::type_index const &type() const noexcept { return m_type; }
+
+    /// @brief The key of the handled type in snapshot files.
+    std::uint64_t type_key() const noexcept { return m_type_key; }
+
+    /// @brief The alignment of the object bytes in snapshot files.
+    std::size_t alignment() const noexcept { return m_alignment; }
+
+    void save( any_handle const &a_handle, std::string &a_bytes ) const { m_save(a_handle, a_bytes); }
+
+    any_handle load( std::shared_ptr<void const> const &a_owner, char const *a_data, std::size_t a_size, mutability a_ismutable ) const
+    {
+        return m_load(a_owner, a_data, a_size, a_ismutable);
+    }
+
+private:
+
+    std::type_index m_type;
+    std::uint64_t m_type_key;
+    std::size_t m_alignment;
+    save_function m_save;
+    load_function m_load;
+};
+
+//..............................................................................
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The codecs of the types which can be saved in (and restored from) snapshots.
+///
+/// Example:
+///
+/// @code
+///     auto codecs = snapshot_codec_registry{};
+///     codecs.add( make_snapshot_codec<Point>() );// trivially copyable : raw bytes
+///     codecs.add( make_snapshot_codec<Text>(
+///         [](Text const &a_text, std::string &a_bytes) { a_bytes += a_text.value; },
+///         [](char const *a_data, std::size_t a_size) { return std::make_shared<Text>(std::string{a_data, a_size}); } ) );
+/// @endcode
+class snapshot_codec_registry
+{
+public:
+
+    /// @brief Register the given codec.
+    /// @throw @c snapshot_error if a codec of another type has the same type key (hash collision of the type names).
+    /// @note Replace the codec previously registered for the same type.
+    void add( snapshot_codec a_codec )
+    {
+        auto const found = m_codecs.find(a_codec.type_key());
+        if ( found != m_codecs.end() && found->second.type() != a_codec.type() )
+        {
+            throw snapshot_error{ "type key collision between two registered types" };
+        }
+        m_codecs.erase(a_codec.type_key());
+        m_codecs.emplace(a_codec.type_key(), std::move(a_codec));
+    }
+
+    /// @brief Return the codec of the given type key, or @c nullptr if no codec is registered.
+    snapshot_codec const *find( std::uint64_t a_type_key ) const noexcept
+    {
+        auto const found = m_codecs.find(a_type_key);
+        return found == m_codecs.end() ? nullptr : &found->second;
+    }
+
+    /// @brief Return the codec of the type of the given handle, or @c nullptr if no codec is registered.
+    snapshot_codec const *find( any_handle const &a_handle ) const noexcept
+    {
+        auto const *codec = find(anys::detail::make_any_type_persistent_key(a_handle.type_fingerprint()));
+        return codec != nullptr && codec->type() == a_handle.type() ? codec : nullptr;
+    }
+
+    std::size_t size() const noexcept { return m_codecs.size(); }
+
+private:
+
+    std::unordered_map<std::uint64_t, snapshot_codec> m_codecs;
+};
+
+//..............................................................................
+
+namespace detail {
+
+/// @ingroup SoloAnyHandleDetail
+/// @brief Build a handle from a restored typed shared pointer, with the given mutability.
+template < typename T >
+any_handle make_restored_any_handle( std::shared_ptr<T> &&a_sp, mutability a_ismutable )
+{
+    return mutability_as_boolean(a_ismutable)
+        ? make_any_handle_mutable(std::move(a_sp))
+        : make_any_handle(std::shared_ptr<T const>{ std::move(a_sp) });
+}
+
+}// EONS DETAIL
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Build the codec of a trivially copyable type @c T : the object bytes are saved as is.
+///
+/// Non-mutable objects are restored as zero-copy views : the restored handles point into the snapshot file
+/// (and keep it mapped). Mutable objects are restored as copies.
+template < typename T >
+inline snapshot_codec
+make_snapshot_codec()
+{
+    static_assert(std::is_trivially_copyable<T>::value, "make_snapshot_codec<T>() : T must be trivially copyable, give a save and a load function otherwise");
+    static_assert(!std::is_const<T>::value && !std::is_volatile<T>::value, "make_snapshot_codec<T>() : T must not be cv-qualified");
+    static_assert(alignof(T) <= snapshot_data_alignment, "make_snapshot_codec<T>() : T is over-aligned");
+
+    return snapshot_codec{
+        typeid(T),
+        anys::detail::make_any_type_persistent_key<T>(),
+        alignof(T),
+        []( any_handle const &a_handle, std::string &a_bytes )
+        {
+            auto const sp = any_handle_cast_or_throw<T>(a_handle);
+            a_bytes.append( reinterpret_cast<char const *>(sp.get()), sizeof(T) );
+        },
+        []( std::shared_ptr<void const> const &a_owner, char const *a_data, std::size_t a_size, mutability a_ismutable ) -> any_handle
+        {
+            if ( a_data == nullptr )
+            {
+                return detail::make_restored_any_handle(std::shared_ptr<T>{}, a_ismutable);
+            }
+            if ( a_size != sizeof(T) )
+            {
+                throw snapshot_error{ "bad object size" };
+            }
+            auto const *const p = reinterpret_cast<T const *>(a_data);
+            if ( mutability_as_boolean(a_ismutable) )
+            {
+                return make_any_handle_mutable( std::make_shared<T>(*p) );// copy
+            }
+            return make_any_handle( std::shared_ptr<T const>{ a_owner, p } );// zero-copy view (aliasing the file owner)
+        }
+    };
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Build the codec of type @c T from a save function and a load function.
+/// @param a_save Called as <c>a_save(T const &, std::string &a_bytes)</c> : append the bytes of the object.
+/// @param a_load Called as <c>a_load(char const *a_data, std::size_t a_size)</c> :
+/// return a @c std::shared_ptr<T> (or a pointer convertible to it) to the restored object.
+template < typename T, typename Save, typename Load >
+inline snapshot_codec
+make_snapshot_codec( Save &&a_save, Load &&a_load )
+{
+    static_assert(!std::is_const<T>::value && !std::is_volatile<T>::value, "make_snapshot_codec<T>(save, load) : T must not be cv-qualified");
+
+    return snapshot_codec{
+        typeid(T),
+        anys::detail::make_any_type_persistent_key<T>(),
+        alignof(std::max_align_t),
+        [save = std::forward<Save>(a_save)]( any_handle const &a_handle, std::string &a_bytes )
+        {
+            save( *any_handle_cast_or_throw<T>(a_handle), a_bytes );
+        },
+        [load = std::forward<Load>(a_load)]( std::shared_ptr<void const> const &, char const *a_data, std::size_t a_size, mutability a_ismutable ) -> any_handle
+        {
+            if ( a_data == nullptr )
+            {
+                return detail::make_restored_any_handle(std::shared_ptr<T>{}, a_ismutable);
+            }
+            return detail::make_restored_any_handle(std::shared_ptr<T>{ load(a_data, a_size) }, a_ismutable);
+        }
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::SNAPSHOTS
+////////////////////////////////////////////////////////////////////////////////
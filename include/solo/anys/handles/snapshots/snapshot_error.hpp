@@ -0,0 +1,41 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace snapshots {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+class snapshot_error;
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Exception thrown when a snapshot cannot be written or restored :
+/// I/O failure, invalid or incompatible file, type without registered codec.
+class snapshot_error
+    : public std::runtime_error
+{
+public:
+    explicit snapshot_error( std::string const &a_what )
+        : std::runtime_error{ "solo::anys::snapshots: " + a_what }
+    {}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::SNAPSHOTS
+////////////////////////////////////////////////////////////////////////////////
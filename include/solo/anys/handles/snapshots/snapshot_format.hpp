@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace snapshots {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+struct snapshot_file_header;
+struct snapshot_object_record;
+struct snapshot_entry_record;
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+// Snapshot file layout (native endianness, all offsets from the beginning of the file) :
+//
+//     snapshot_file_header
+//     snapshot_object_record[object_count]   one record per distinct handled object
+//     snapshot_entry_record[entry_count]     one record per registry key, sorted by key
+//     key bytes                              the keys, not null-terminated
+//     object bytes                           aligned on snapshot_data_alignment, each object on its codec alignment
+//
+// The version is increased for every incompatible change of the layout.
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The magic number starting a snapshot file.
+constexpr char const snapshot_magic[8] = { 'S', 'O', 'L', 'O', 'S', 'N', 'A', 'P' };
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The version of the snapshot file layout.
+constexpr std::uint32_t snapshot_format_version = 1;
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Written natively : reject the files written with another endianness.
+constexpr std::uint32_t snapshot_endianness_marker = 0x01020304u;
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The alignment of the object bytes (and the maximal alignment of a snapshot object).
+constexpr std::size_t snapshot_data_alignment = 64;
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The object index of the entries holding an empty handle.
+constexpr std::uint64_t snapshot_no_object = ~std::uint64_t{0};
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The flags of a @c snapshot_object_record.
+enum snapshot_object_flags : std::uint32_t
+{
+    snapshot_object_mutable = 1u,// handled as a mutable object
+    snapshot_object_null = 2u    // typed handle holding a null pointer (no object bytes)
+};
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The header of a snapshot file.
+struct snapshot_file_header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t endianness;
+    std::uint64_t file_size;
+    std::uint64_t object_count;
+    std::uint64_t objects_offset;
+    std::uint64_t entry_count;
+    std::uint64_t entries_offset;
+    std::uint64_t keys_offset;
+    std::uint64_t keys_size;
+    std::uint64_t data_offset;
+    std::uint64_t data_size;
+};
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief One distinct object of the snapshot.
+struct snapshot_object_record
+{
+    std::uint64_t type_key;// see snapshot_codec::type_key
+    std::uint64_t offset;  // from data_offset
+    std::uint64_t size;
+    std::uint32_t flags;   // snapshot_object_flags
+    std::uint32_t reserved;
+};
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief One key of the snapshot, and the object it designates.
+///
+/// Several entries designate the same object when several keys shared the same handled object.
+struct snapshot_entry_record
+{
+    std::uint64_t key_offset;// from keys_offset
+    std::uint64_t key_size;
+    std::uint64_t object_index;// or snapshot_no_object
+};
+
+static_assert(std::is_trivially_copyable<snapshot_file_header>::value && sizeof(snapshot_file_header) == 88, "");
+static_assert(std::is_trivially_copyable<snapshot_object_record>::value && sizeof(snapshot_object_record) == 32, "");
+static_assert(std::is_trivially_copyable<snapshot_entry_record>::value && sizeof(snapshot_entry_record) == 24, "");
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::SNAPSHOTS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,24 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+/// @file
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Opt-in binary snapshots of registries of handles (not included by the library packages).
+///
+/// - @c solo::anys::snapshots::make_snapshot_codec<T>() and @c solo::anys::snapshots::snapshot_codec_registry :
+///   the per-type serializers,
+/// - @c solo::anys::snapshots::write_snapshot : write a registry into a versioned binary file,
+/// - @c solo::anys::snapshots::mapped_snapshot : map a snapshot file and restore its handles lazily.
+
+#include <solo/anys/handles/snapshots/snapshot_error.hpp>
+#include <solo/anys/handles/snapshots/snapshot_format.hpp>
+#include <solo/anys/handles/snapshots/snapshot_codec.hpp>
+#include <solo/anys/handles/snapshots/write_snapshot.hpp>
+#include <solo/anys/handles/snapshots/mapped_snapshot.hpp>
@@ -0,0 +1,192 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/snapshots/snapshot_codec.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace snapshots {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+template < typename InputIt >
+void write_snapshot( std::string const &a_path, InputIt a_first, InputIt a_last, snapshot_codec_registry const &a_codecs );
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+namespace detail {
+
+inline std::uint64_t align_snapshot_offset( std::uint64_t a_offset, std::uint64_t a_alignment ) noexcept
+{
+    return ( a_offset + a_alignment - 1 ) / a_alignment * a_alignment;
+}
+
+/// @brief Hash of the identity of a handled object (pointer, type key and mutability).
+struct object_identity_hash
+{
+    std::size_t operator()( std::pair<void const *, std::uint64_t> const &a_identity ) const noexcept
+    {
+        return std::hash<void const *>{}(a_identity.first) ^ static_cast<std::size_t>(a_identity.second * 0x9e3779b97f4a7c15ull);
+    }
+};
+
+template < typename Record >
+void append_snapshot_records( std::string &a_bytes, std::vector<Record> const &a_records )
+{
+    if ( !a_records.empty() )
+    {
+        a_bytes.append( reinterpret_cast<char const *>(a_records.data()), a_records.size() * sizeof(Record) );
+    }
+}
+
+}// EONS DETAIL
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Write a registry of handles into a snapshot file.
+/// @param a_path The snapshot file. It is written next to its final path then renamed :
+/// a snapshot file is either the previous one or the complete new one.
+/// @param a_first, a_last The registry entries : @c first is the key (convertible to @c std::string),
+/// @c second the @c any_handle object (e.g. the iterators of a @c std::map<std::string,any_handle> ).
+/// @param a_codecs The codecs of the handled types.
+/// @throw @c snapshot_error if two entries have the same key, if a handled type has no codec, or on I/O failure.
+///
+/// The handled objects are written once : the entries sharing the same object (same pointer, type and mutability)
+/// share it again once restored.
+/// Empty handles are restored as empty handles, typed null handles as typed null handles.
+///
+/// @see @c mapped_snapshot
+template < typename InputIt >
+inline void
+write_snapshot( std::string const &a_path, InputIt a_first, InputIt a_last, snapshot_codec_registry const &a_codecs )
+{
+    using object_identity = std::pair<void const *, std::uint64_t>;// pointer, type key | mutability
+
+    auto keyed = std::vector<std::pair<std::string, std::uint64_t>>{};// key, object index
+    auto objects = std::vector<snapshot_object_record>{};
+    auto object_indexes = std::unordered_map<object_identity, std::uint64_t, detail::object_identity_hash>{};
+    auto data = std::string{};
+
+    for ( ; a_first != a_last; ++a_first )
+    {
+        auto const &key = a_first->first;
+        any_handle const &handle = a_first->second;
+        if ( handle.empty() )
+        {
+            keyed.emplace_back( key, snapshot_no_object );
+            continue;
+        }
+        auto const *codec = a_codecs.find(handle);
+        if ( codec == nullptr )
+        {
+            throw snapshot_error{ std::string{"no codec registered for type "} + handle.type().name() };
+        }
+
+        auto record = snapshot_object_record{};
+        record.type_key = codec->type_key();
+        record.flags = handle.is_mutable() ? snapshot_object_mutable : 0u;
+
+        auto const pointer = handle.pointer();
+        if ( !pointer )// typed null handle : no object bytes, not shared
+        {
+            record.flags |= snapshot_object_null;
+            objects.push_back(record);
+            keyed.emplace_back( key, objects.size() - 1 );
+            continue;
+        }
+
+        auto const identity = object_identity{ pointer.get(), record.type_key | record.flags };
+        auto found = object_indexes.find(identity);
+        if ( found == object_indexes.end() )
+        {
+            record.offset = detail::align_snapshot_offset(data.size(), codec->alignment());
+            data.resize(record.offset, '\0');
+            codec->save(handle, data);
+            record.size = data.size() - record.offset;
+            objects.push_back(record);
+            found = object_indexes.emplace( identity, objects.size() - 1 ).first;
+        }
+        keyed.emplace_back( key, found->second );
+    }
+
+    std::sort( keyed.begin(), keyed.end() );
+    auto const duplicate = std::adjacent_find( keyed.begin(), keyed.end(),
+        []( auto const &a_x, auto const &a_y ) { return a_x.first == a_y.first; } );
+    if ( duplicate != keyed.end() )
+    {
+        throw snapshot_error{ "duplicate key " + duplicate->first };
+    }
+
+    auto entries = std::vector<snapshot_entry_record>{};
+    entries.reserve(keyed.size());
+    auto keys = std::string{};
+    for ( auto const &k : keyed )
+    {
+        entries.push_back( snapshot_entry_record{ keys.size(), k.first.size(), k.second } );
+        keys += k.first;
+    }
+
+    auto header = snapshot_file_header{};
+    std::memcpy(header.magic, snapshot_magic, sizeof(header.magic));
+    header.version = snapshot_format_version;
+    header.endianness = snapshot_endianness_marker;
+    header.object_count = objects.size();
+    header.objects_offset = sizeof(snapshot_file_header);
+    header.entry_count = entries.size();
+    header.entries_offset = header.objects_offset + objects.size() * sizeof(snapshot_object_record);
+    header.keys_offset = header.entries_offset + entries.size() * sizeof(snapshot_entry_record);
+    header.keys_size = keys.size();
+    header.data_offset = detail::align_snapshot_offset(header.keys_offset + keys.size(), snapshot_data_alignment);
+    header.data_size = data.size();
+    header.file_size = header.data_offset + data.size();
+
+    auto bytes = std::string{};
+    bytes.reserve(header.file_size);
+    bytes.append( reinterpret_cast<char const *>(&header), sizeof(header) );
+    detail::append_snapshot_records(bytes, objects);
+    detail::append_snapshot_records(bytes, entries);
+    bytes += keys;
+    bytes.resize(header.data_offset, '\0');
+    bytes += data;
+
+    auto const temporary_path = a_path + ".tmp";
+    {
+        auto os = std::ofstream{ temporary_path, std::ios::binary | std::ios::trunc };
+        if ( !os.write(bytes.data(), static_cast<std::streamsize>(bytes.size())) || !os.flush() )
+        {
+            throw snapshot_error{ "cannot write " + temporary_path };
+        }
+    }
+    if ( std::rename(temporary_path.c_str(), a_path.c_str()) != 0 )// atomic replacement on POSIX systems
+    {
+        // std::rename does not replace an existing file everywhere : retry once the old file is removed
+        std::remove(a_path.c_str());
+        if ( std::rename(temporary_path.c_str(), a_path.c_str()) != 0 )
+        {
+            throw snapshot_error{ "cannot rename " + temporary_path + " to " + a_path };
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::SNAPSHOTS
+////////////////////////////////////////////////////////////////////////////////
@@ -83,6 +83,8 @@ inline std::ostream &operator<<(std::ostream &a_os, solo::anys::errors::any_hand
                 return "bad source type";
             case  errc_t::bad_source_mutability:
                 return "bad source mutability";
+            case  errc_t::failed_source_construction:
+                return "failed source construction";
             default:
                 return "undefined";
         };
@@ -0,0 +1,282 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/mutability.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace anys { namespace tracking {
+////////////////////////////////////////////////////////////////////////////////
+
+// -- package :
+
+class live_handle_record;
+struct live_handle_type_stats;
+class live_handle_table;
+
+live_handle_table &live_handle_table_instance() noexcept;
+std::vector<live_handle_type_stats> live_handle_snapshot();
+
+//..............................................................................
+//..............................................................................
+
+// -- definition :
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief The clock used to timestamp the creation of tracked objects.
+using live_handle_clock = std::chrono::steady_clock;
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Describe one live object owned by @c any_handle objects.
+///
+/// A record is an intrusive node of the @c live_handle_table :
+/// it is stored next to the tracked object (in the same allocation when possible)
+/// and is linked into one of the table's shards while the object is alive.
+///
+/// @note A record is neither copyable nor movable since the table keeps its address.
+class live_handle_record
+{
+public:
+
+    /// @brief Build an unlinked record describing an object of type @c a_type.
+    live_handle_record( std::type_index const &a_type, std::size_t a_size, mutability a_ismutable ) noexcept
+        : m_type{ a_type }
+        , m_size{ a_size }
+        , m_mutable_flag{ mutability_as_boolean(a_ismutable) }
+    {}
+
+    live_handle_record( live_handle_record const & ) = delete;
+    live_handle_record &operator=( live_handle_record const & ) = delete;
+
+    /// @brief The tracked object's type.
+    std::type_index const &type() const noexcept { return m_type; }
+
+    /// @brief The tracked object's size in bytes (i.e. @c sizeof(T)).
+    std::size_t size() const noexcept { return m_size; }
+
+    /// @brief Return true if the tracked object is handled as a mutable object.
+    bool is_mutable() const noexcept { return m_mutable_flag; }
+
+    /// @brief The tracked object's creation time.
+    live_handle_clock::time_point const &creation_time() const noexcept { return m_creation_time; }
+
+private:
+
+    friend class live_handle_table;
+
+    std::type_index m_type;
+    std::size_t m_size;
+    bool m_mutable_flag;
+    live_handle_clock::time_point m_creation_time{};
+
+    // intrusive links (guarded by the owning shard's mutex) :
+    live_handle_record *m_previous{ nullptr };
+    live_handle_record *m_next{ nullptr };
+    std::size_t m_shard_index{ 0 };
+};
+
+//..............................................................................
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Aggregated statistics on live objects of a given type and mutability.
+/// @see @c live_handle_snapshot.
+struct live_handle_type_stats
+{
+    std::type_index type;
+    bool is_mutable;
+    std::size_t count;
+    std::size_t bytes;
+    live_handle_clock::time_point oldest_creation_time;
+};
+
+//..............................................................................
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief A sharded table of the objects currently owned by @c any_handle objects.
+///
+/// Each thread inserts its records into its own shard (chosen once per thread),
+/// so that concurrent factories rarely contend on the same mutex.
+/// Records are intrusive: inserting and erasing a record never allocates.
+///
+/// The table is fed by the owning factories (@c make_any_handle and @c make_any_handle_mutable
+/// in-place and finalizer overloads) when @c SOLO_ANY_HANDLE_ENABLE_TRACKING is set to 1.
+///
+/// @see @c live_handle_snapshot.
+class live_handle_table
+{
+public:
+
+    /// @brief The number of shards.
+    static constexpr std::size_t shard_count = 16;
+
+    live_handle_table() noexcept = default;
+    live_handle_table( live_handle_table const & ) = delete;
+    live_handle_table &operator=( live_handle_table const & ) = delete;
+
+    /// @brief Timestamp and link the given record into the current thread's shard.
+    /// @pre @c a_record is not linked.
+    void insert( live_handle_record &a_record ) noexcept;
+
+    /// @brief Unlink the given record from the shard it was inserted into (possibly from another thread).
+    /// @pre @c a_record has been inserted into this table.
+    void erase( live_handle_record &a_record ) noexcept;
+
+    /// @brief Aggregate the live records by type and mutability.
+    /// @note Shards are locked one after the other, so the snapshot is not an atomic view
+    /// of the whole table while other threads are creating or releasing objects.
+    std::vector<live_handle_type_stats> snapshot() const;
+
+private:
+
+    struct alignas(64) shard
+    {
+        mutable std::mutex mutex{};
+        live_handle_record *first{ nullptr };
+    };
+
+    static std::size_t current_thread_shard_index() noexcept;
+
+    std::array<shard, shard_count> m_shards{};
+};
+
+//..............................................................................
+//..............................................................................
+
+// INLINES :
+
+inline std::size_t
+live_handle_table::current_thread_shard_index() noexcept
+{
+    static std::atomic<std::size_t> next_index{ 0 };
+    static thread_local std::size_t const index = next_index.fetch_add(1, std::memory_order_relaxed) % shard_count;
+    return index;
+}
+
+inline void
+live_handle_table::insert( live_handle_record &a_record ) noexcept
+{
+    a_record.m_creation_time = live_handle_clock::now();
+    a_record.m_shard_index = current_thread_shard_index();
+
+    auto &s = m_shards[a_record.m_shard_index];
+    std::lock_guard<std::mutex> lock{ s.mutex };
+    a_record.m_previous = nullptr;
+    a_record.m_next = s.first;
+    if ( s.first != nullptr )
+    {
+        s.first->m_previous = &a_record;
+    }
+    s.first = &a_record;
+}
+
+inline void
+live_handle_table::erase( live_handle_record &a_record ) noexcept
+{
+    auto &s = m_shards[a_record.m_shard_index];
+    std::lock_guard<std::mutex> lock{ s.mutex };
+    if ( a_record.m_previous != nullptr )
+    {
+        a_record.m_previous->m_next = a_record.m_next;
+    }
+    else
+    {
+        s.first = a_record.m_next;
+    }
+    if ( a_record.m_next != nullptr )
+    {
+        a_record.m_next->m_previous = a_record.m_previous;
+    }
+    a_record.m_previous = nullptr;
+    a_record.m_next = nullptr;
+}
+
+inline std::vector<live_handle_type_stats>
+live_handle_table::snapshot() const
+{
+    auto stats_by_type = std::map<std::pair<std::type_index,bool>, live_handle_type_stats>{};
+    for ( auto const &s : m_shards )
+    {
+        std::lock_guard<std::mutex> lock{ s.mutex };
+        for ( auto const *r = s.first; r != nullptr; r = r->m_next )
+        {
+            auto const key = std::make_pair(r->m_type, r->m_mutable_flag);
+            auto it = stats_by_type.find(key);
+            if ( it == stats_by_type.end() )
+            {
+                stats_by_type.emplace(key, live_handle_type_stats{ r->m_type, r->m_mutable_flag, 1, r->m_size, r->m_creation_time });
+                continue;
+            }
+            auto &stats = it->second;
+            stats.count += 1;
+            stats.bytes += r->m_size;
+            if ( r->m_creation_time < stats.oldest_creation_time )
+            {
+                stats.oldest_creation_time = r->m_creation_time;
+            }
+        }
+    }
+
+    auto output = std::vector<live_handle_type_stats>{};
+    output.reserve(stats_by_type.size());
+    for ( auto &kv : stats_by_type )
+    {
+        output.push_back(kv.second);
+    }
+    return output;
+}
+
+//..............................................................................
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Return the process-wide live handle table.
+inline live_handle_table &
+live_handle_table_instance() noexcept
+{
+    // never destroyed: handles held by static objects may be released after main() returns.
+    static std::aligned_storage_t<sizeof(live_handle_table), alignof(live_handle_table)> storage;
+    static auto *const table = ::new (static_cast<void*>(&storage)) live_handle_table{};
+    return *table;
+}
+
+/// @ingroup SoloAnyHandleAdvanced
+/// @brief Report the live objects owned by @c any_handle objects, aggregated by type and mutability.
+///
+/// Example:
+///
+/// @code
+///     for ( auto const &stats : solo::anys::tracking::live_handle_snapshot() )
+///     {
+///         std::cout << boost::core::demangle(stats.type.name())
+///                   << ( stats.is_mutable ? " (mutable)" : "" )
+///                   << " : " << stats.count << " objects, " << stats.bytes << " bytes" << std::endl;
+///     }
+/// @endcode
+///
+/// @note The snapshot is always empty if @c SOLO_ANY_HANDLE_ENABLE_TRACKING is not set to 1.
+inline std::vector<live_handle_type_stats>
+live_handle_snapshot()
+{
+    return live_handle_table_instance().snapshot();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::ANYS::TRACKING
+////////////////////////////////////////////////////////////////////////////////
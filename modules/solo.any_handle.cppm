@@ -0,0 +1,85 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+// C++20 named module exporting the complete library (any_handle_package.hpp) :
+//
+//     import solo.any_handle;
+//     #include <stdex/in_place_t.hpp>// tags used by the in-place factories
+//
+//     auto h = solo::make_any_handle_mutable<A>(stdex::in_place, args);
+//
+// The headers are parsed once, when the module interface is built,
+// instead of once per translation unit.
+// The testing outputters and the tracking table are not exported :
+// the units using them include their headers.
+
+module;
+
+#include <solo/anys/handles/any_handle_package.hpp>
+#include <solo/anys/handles/allocators/cache_line_allocator.hpp>
+
+export module solo.any_handle;
+
+////////////////////////////////////////////////////////////////////////////////
+export namespace solo {
+////////////////////////////////////////////////////////////////////////////////
+
+// types :
+using solo::mutability;
+using solo::mutability_as_boolean;
+using solo::any_type_index;
+using solo::any_type_index_less;
+using solo::any_type_tag;
+using solo::any_handle;
+
+// factories :
+using solo::make_any_type_index;
+using solo::make_any_handle;
+using solo::make_any_handle_mutable;
+
+// casts :
+using solo::any_handle_cast_result_type;
+using solo::any_handle_mutable_cast_result_type;
+using solo::any_handle_cast;
+using solo::any_handle_mutable_cast;
+using solo::any_handle_cast_or_throw;
+using solo::any_handle_mutable_cast_or_throw;
+
+// comparisons :
+using solo::operator==;
+using solo::operator!=;
+using solo::operator<;
+using solo::operator<=;
+using solo::operator>;
+using solo::operator>=;
+
+namespace anys { namespace errors {
+    using solo::anys::errors::any_handle_cast_errc;
+    using solo::anys::errors::any_handle_cast_error;
+    using solo::anys::errors::is_empty_source_error;
+    using solo::anys::errors::is_bad_source_type_error;
+    using solo::anys::errors::is_bad_source_mutability_error;
+}}// EONS ANYS::ERRORS
+
+namespace anys { namespace exceptions {
+    using solo::anys::exceptions::bad_any_handle_cast;
+}}// EONS ANYS::EXCEPTIONS
+
+namespace anys { namespace outcomes {
+    using solo::anys::outcomes::any_handle_cast_result;
+}}// EONS ANYS::OUTCOMES
+
+namespace anys { namespace allocators {
+    using solo::anys::allocators::cache_line_size;
+    using solo::anys::allocators::cache_line_allocator;
+}}// EONS ANYS::ALLOCATORS
+
+////////////////////////////////////////////////////////////////////////////////
+}// EONS SOLO
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,40 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <cstddef>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+/// @brief The number of calls to the global allocation functions made by the current thread.
+/// @note Defined with the replacement of the global @c operator @c new and @c operator @c delete.
+struct allocation_counts
+{
+    std::size_t allocations;
+    std::size_t deallocations;
+};
+
+/// @brief Return the current thread's counts since the thread started.
+allocation_counts current_thread_allocation_counts() noexcept;
+
+/// @brief Count the allocations and deallocations made by the current thread while calling @c a_callable.
+template < typename F >
+inline allocation_counts count_allocations( F &&a_callable )
+{
+    auto const before = current_thread_allocation_counts();
+    a_callable();
+    auto const after = current_thread_allocation_counts();
+    return { after.allocations - before.allocations, after.deallocations - before.deallocations };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::TESTS
+////////////////////////////////////////////////////////////////////////////////
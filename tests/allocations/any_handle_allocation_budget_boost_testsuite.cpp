@@ -0,0 +1,253 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "allocation_counter.hpp"
+#include "any_handle_testsuite_types.hpp"
+
+#include <solo/anys/handles/any_handle_package.hpp>
+#include <solo/anys/handles/allocators/cache_line_allocator.hpp>
+#include <solo/anys/handles/pools/pool_package.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+// Each test pins the exact number of global allocations made by one operation :
+// a change adding an allocation to one of these paths makes the suite fail.
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+//..............................................................................
+
+/// @brief The allocation made by @c std::runtime_error to store its message (reference-counted string).
+constexpr std::size_t runtime_error_message_allocations = 1;
+
+//..............................................................................
+
+BOOST_AUTO_TEST_SUITE( FactoryBudgetTests )
+
+BOOST_AUTO_TEST_CASE( SharedPointerFactoriesDontAllocateTest )
+{
+    auto const x_sh = std::make_shared<TestObject>(1);
+    auto const x_csh = std::make_shared<TestObject const>(1);
+    auto ah = solo::any_handle{};
+
+    auto counts = count_allocations([&]() { ah = solo::make_any_handle(x_sh); });
+    BOOST_TEST( counts.allocations == 0u );
+    counts = count_allocations([&]() { ah = solo::make_any_handle(x_csh); });
+    BOOST_TEST( counts.allocations == 0u );
+    counts = count_allocations([&]() { ah = solo::make_any_handle<TestObjectBase>(x_sh); });
+    BOOST_TEST( counts.allocations == 0u );
+    counts = count_allocations([&]() { ah = solo::make_any_handle_mutable(x_sh); });
+    BOOST_TEST( counts.allocations == 0u );
+    counts = count_allocations([&]() { ah = solo::make_any_handle_mutable(std::shared_ptr<void>{x_sh}); });
+    BOOST_TEST( counts.allocations == 0u );
+}
+
+BOOST_AUTO_TEST_CASE( InPlaceFactoriesAllocateOnceTest )
+{
+    // one allocation for both the control block and the object :
+    auto ah = solo::any_handle{};
+
+    auto counts = count_allocations([&]() { ah = solo::make_any_handle<TestObject>(stdex::in_place, 1); });
+    BOOST_TEST( counts.allocations == 1u );
+    counts = count_allocations([&]() { ah = solo::make_any_handle<TestObjectBase>(stdex::in_place_type<TestObject>, 1); });
+    BOOST_TEST( counts.allocations == 1u );
+    counts = count_allocations([&]() { ah = solo::make_any_handle_mutable<TestObject>(stdex::in_place, 1); });
+    BOOST_TEST( counts.allocations == 1u );
+    counts = count_allocations([&]() { ah = solo::make_any_handle_mutable<TestObjectBase>(stdex::in_place_type<TestObject>, 1); });
+    BOOST_TEST( counts.allocations == 1u );
+}
+
+BOOST_AUTO_TEST_CASE( AllocatorFactoriesAllocateOnceTest )
+{
+    // one (cache line aligned) allocation for both the control block and the object :
+    using solo::anys::allocators::cache_line_allocator;
+    auto ah = solo::any_handle{};
+
+    auto counts = count_allocations([&]() { ah = solo::make_any_handle<TestObject>(std::allocator_arg, cache_line_allocator<TestObject>{}, 1); });
+    BOOST_TEST( counts.allocations == 1u );
+    counts = count_allocations([&]() { ah = solo::make_any_handle_mutable<TestObject>(std::allocator_arg, cache_line_allocator<TestObject>{}, 1); });
+    BOOST_TEST( counts.allocations == 1u );
+}
+
+BOOST_AUTO_TEST_CASE( ObserverFactoriesAllocateOnceTest )
+{
+    // one allocation for the control block :
+    auto x = TestObject{1};
+    auto ah = solo::any_handle{};
+
+    auto counts = count_allocations([&]() { ah = solo::make_any_handle(stdex::make_observer(&x)); });
+    BOOST_TEST( counts.allocations == 1u );
+    counts = count_allocations([&]() { ah = solo::make_any_handle_mutable(stdex::make_observer(&x)); });
+    BOOST_TEST( counts.allocations == 1u );
+}
+
+BOOST_AUTO_TEST_CASE( FinalizerFactoriesAllocateOnceTest )
+{
+    // one allocation for the control block (which stores the finalizer) :
+    auto x = TestObject{1};
+    auto finalizer = [](TestObject *) {};
+    auto ah = solo::any_handle{};
+
+    auto counts = count_allocations([&]() { ah = solo::make_any_handle(&x, finalizer); });
+    BOOST_TEST( counts.allocations == 1u );
+    counts = count_allocations([&]() { ah = solo::make_any_handle_mutable(&x, finalizer); });
+    BOOST_TEST( counts.allocations == 1u );
+}
+
+BOOST_AUTO_TEST_CASE( PooledFactoriesDontAllocateWhenWarmTest )
+{
+    // the control block and the object in a block of the slabs of TestObject, once the magazine of the thread is filled :
+    using solo::anys::pools::make_pooled_any_handle;
+    using solo::anys::pools::make_pooled_any_handle_mutable;
+    auto ah = make_pooled_any_handle<TestObject>(stdex::in_place, 1);
+
+    auto counts = count_allocations([&]() {
+        ah = make_pooled_any_handle<TestObject>(stdex::in_place, 1);
+        ah = make_pooled_any_handle_mutable<TestObject>(stdex::in_place, 1);
+        ah = solo::any_handle{};
+    });
+    BOOST_TEST( counts.allocations == 0u );
+    BOOST_TEST( counts.deallocations == 0u );
+}
+
+BOOST_AUTO_TEST_CASE( ReleaseDeallocatesOnceTest )
+{
+    auto ah = solo::make_any_handle<TestObject>(stdex::in_place, 1);
+    auto const counts = count_allocations([&]() { ah = solo::any_handle{}; });
+    BOOST_TEST( counts.allocations == 0u );
+    BOOST_TEST( counts.deallocations == 1u );
+}
+
+BOOST_AUTO_TEST_CASE( TypeIndexFactoryDoesntAllocateTest )
+{
+    auto ti = solo::any_type_index{};
+    auto const counts = count_allocations([&]() {
+        ti = solo::make_any_type_index<TestObject>(solo::mutability::true_);
+        ti = solo::make_any_type_index<TestObject const>();
+    });
+    BOOST_TEST( counts.allocations == 0u );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // FactoryBudgetTests
+
+//..............................................................................
+
+BOOST_AUTO_TEST_SUITE( HandleBudgetTests )
+
+BOOST_AUTO_TEST_CASE( CopyMoveSwapDontAllocateTest )
+{
+    auto const ah = solo::make_any_handle_mutable<TestObject>(stdex::in_place, 1);
+    auto counts = count_allocations([&]() {
+        auto ah_copy = ah;
+        auto ah_moved = std::move(ah_copy);
+        auto ah_other = solo::any_handle{};
+        ah_other.swap(ah_moved);
+        ah_other = ah;
+    });
+    BOOST_TEST( counts.allocations == 0u );
+    BOOST_TEST( counts.deallocations == 0u );
+}
+
+BOOST_AUTO_TEST_CASE( ComparisonsDontAllocateTest )
+{
+    auto const ah1 = solo::make_any_handle_mutable<TestObject>(stdex::in_place, 1);
+    auto const ah2 = solo::make_any_handle<TestObject>(stdex::in_place, 2);
+    auto const x_sh = std::make_shared<TestObject>(3);
+    auto result = false;
+    auto counts = count_allocations([&]() {
+        result ^= ( ah1 == ah2 ) ^ ( ah1 != ah2 ) ^ ( ah1 < ah2 ) ^ ( ah1 <= ah2 ) ^ ( ah1 > ah2 ) ^ ( ah1 >= ah2 );
+        result ^= ( ah1 == x_sh ) ^ ( x_sh < ah2 ) ^ ( ah1 == nullptr ) ^ ( ah1 == x_sh.get() );
+        result ^= ah1.equals(ah2);
+        result ^= ( ah1.type() == ah2.type() );
+    });
+    BOOST_TEST( counts.allocations == 0u );
+    boost::ignore_unused(result);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // HandleBudgetTests
+
+//..............................................................................
+
+BOOST_AUTO_TEST_SUITE( CastBudgetTests )
+
+BOOST_AUTO_TEST_CASE( NonThrowingCastsDontAllocateTest )
+{
+    auto const ah = solo::make_any_handle_mutable<TestObject>(stdex::in_place, 1);
+    auto const ah_c = solo::make_any_handle<TestObject>(stdex::in_place, 1);
+    auto const ah_empty = solo::any_handle{};
+    auto failures = 0;
+    auto counts = count_allocations([&]() {
+        failures += solo::any_handle_cast<TestObject>(ah).has_error();// hit
+        failures += solo::any_handle_cast<TestObjectBase>(ah).has_error();// miss
+        failures += solo::any_handle_cast<TestObject>(ah_empty).has_error();// miss
+        failures += solo::any_handle_mutable_cast<TestObject>(ah).has_error();// hit
+        failures += solo::any_handle_mutable_cast<TestObject>(ah_c).has_error();// miss
+    });
+    BOOST_TEST( counts.allocations == 0u );
+    BOOST_TEST( failures == 3 );
+}
+
+BOOST_AUTO_TEST_CASE( ThrowingCastsSuccessDontAllocateTest )
+{
+    auto const ah = solo::make_any_handle_mutable<TestObject>(stdex::in_place, 1);
+    auto counts = count_allocations([&]() {
+        auto const p = solo::any_handle_cast_or_throw<TestObject>(ah);
+        auto const p_m = solo::any_handle_mutable_cast_or_throw<TestObject>(ah);
+    });
+    BOOST_TEST( counts.allocations == 0u );
+}
+
+BOOST_AUTO_TEST_CASE( ThrowingCastsFailureTest )
+{
+    // the exception object itself is allocated by the runtime (not by operator new) :
+    // only its message is counted.
+    auto const ah = solo::make_any_handle<TestObject>(stdex::in_place, 1);
+    auto caught = 0;
+    auto counts = count_allocations([&]() {
+        try
+        {
+            solo::any_handle_cast_or_throw<TestObjectBase>(ah);
+        }
+        catch ( solo::anys::exceptions::bad_any_handle_cast const & )
+        {
+            ++caught;
+        }
+    });
+    BOOST_TEST( caught == 1 );
+    BOOST_TEST( counts.allocations == runtime_error_message_allocations );
+    BOOST_TEST( counts.deallocations == runtime_error_message_allocations );
+
+    counts = count_allocations([&]() {
+        try
+        {
+            solo::any_handle_mutable_cast_or_throw<TestObject>(ah);
+        }
+        catch ( solo::anys::exceptions::bad_any_handle_cast const & )
+        {
+            ++caught;
+        }
+    });
+    BOOST_TEST( caught == 2 );
+    BOOST_TEST( counts.allocations == runtime_error_message_allocations );
+    BOOST_TEST( counts.deallocations == runtime_error_message_allocations );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // CastBudgetTests
+
+//..............................................................................
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
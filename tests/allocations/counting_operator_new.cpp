@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+// Replace the global allocation functions with counting hooks.
+// This unit must only be linked into the allocation testsuite.
+
+#include "allocation_counter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+thread_local allocation_counts current_thread_counts{ 0, 0 };
+
+void *counted_allocate( std::size_t a_size ) noexcept
+{
+    ++current_thread_counts.allocations;
+    return std::malloc(a_size == 0 ? 1 : a_size);
+}
+
+void counted_deallocate( void *a_ptr ) noexcept
+{
+    if ( a_ptr != nullptr )
+    {
+        ++current_thread_counts.deallocations;
+        std::free(a_ptr);
+    }
+}
+
+}// EONS ANONYMOUS
+
+allocation_counts current_thread_allocation_counts() noexcept
+{
+    return current_thread_counts;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLO::TESTS
+////////////////////////////////////////////////////////////////////////////////
+
+void *operator new( std::size_t a_size )
+{
+    if ( auto *p = solo::tests::counted_allocate(a_size) )
+    {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void *operator new[]( std::size_t a_size )
+{
+    return ::operator new(a_size);
+}
+
+void *operator new( std::size_t a_size, std::nothrow_t const & ) noexcept
+{
+    return solo::tests::counted_allocate(a_size);
+}
+
+void *operator new[]( std::size_t a_size, std::nothrow_t const & ) noexcept
+{
+    return solo::tests::counted_allocate(a_size);
+}
+
+void operator delete( void *a_ptr ) noexcept
+{
+    solo::tests::counted_deallocate(a_ptr);
+}
+
+void operator delete[]( void *a_ptr ) noexcept
+{
+    solo::tests::counted_deallocate(a_ptr);
+}
+
+void operator delete( void *a_ptr, std::size_t ) noexcept
+{
+    solo::tests::counted_deallocate(a_ptr);
+}
+
+void operator delete[]( void *a_ptr, std::size_t ) noexcept
+{
+    solo::tests::counted_deallocate(a_ptr);
+}
+
+#if defined(__cpp_aligned_new)
+
+void *operator new( std::size_t a_size, std::align_val_t a_alignment )
+{
+    auto const alignment = static_cast<std::size_t>(a_alignment);
+    auto const size = ( a_size + alignment - 1 ) / alignment * alignment;// aligned_alloc requires a multiple of the alignment
+    ++solo::tests::current_thread_counts.allocations;
+    if ( auto *p = std::aligned_alloc(alignment, size == 0 ? alignment : size) )
+    {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void *operator new[]( std::size_t a_size, std::align_val_t a_alignment )
+{
+    return ::operator new(a_size, a_alignment);
+}
+
+void operator delete( void *a_ptr, std::align_val_t ) noexcept
+{
+    solo::tests::counted_deallocate(a_ptr);
+}
+
+void operator delete[]( void *a_ptr, std::align_val_t ) noexcept
+{
+    solo::tests::counted_deallocate(a_ptr);
+}
+
+void operator delete( void *a_ptr, std::size_t, std::align_val_t ) noexcept
+{
+    solo::tests::counted_deallocate(a_ptr);
+}
+
+void operator delete[]( void *a_ptr, std::size_t, std::align_val_t ) noexcept
+{
+    solo::tests::counted_deallocate(a_ptr);
+}
+
+#endif// __cpp_aligned_new
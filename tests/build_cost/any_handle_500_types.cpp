@@ -0,0 +1,55 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+// Build cost probe : builds, casts and throwing-casts handles of 500 distinct resource types,
+// as a service registry of a large application would do.
+// Compiled (not run) by the build cost test, which counts the symbols instantiated per type.
+
+#include <solo/anys/handles/any_handle_package.hpp>
+
+#include <cstddef>
+#include <utility>
+
+namespace solo { namespace tests { namespace build_cost {
+
+constexpr std::size_t synthetic_type_count = 500;
+
+template < std::size_t I >
+struct synthetic_resource
+{
+    int data{static_cast<int>(I)};
+};
+
+template < std::size_t I >
+int use_synthetic_resource()
+{
+    auto const ah = solo::make_any_handle_mutable<synthetic_resource<I>>(stdex::in_place);
+    auto const ah_c = solo::make_any_handle(std::make_shared<synthetic_resource<I> const>());
+    auto const r = solo::any_handle_cast<synthetic_resource<I>>(ah_c);
+    auto const r_m = solo::any_handle_mutable_cast<synthetic_resource<I>>(ah);
+    auto const p = solo::any_handle_cast_or_throw<synthetic_resource<I>>(ah);
+    return r.assume_value()->data + r_m.assume_value()->data + p->data;
+}
+
+template < std::size_t... Is >
+int use_synthetic_resources( std::index_sequence<Is...> )
+{
+    auto const results = { use_synthetic_resource<Is>()... };
+    auto sum = 0;
+    for ( auto r : results ) { sum += r; }
+    return sum;
+}
+
+}}}// EONS SOLO::TESTS::BUILD_COST
+
+int solo_any_handle_build_cost_probe()
+{
+    using namespace solo::tests::build_cost;
+    return use_synthetic_resources( std::make_index_sequence<synthetic_type_count>{} );
+}
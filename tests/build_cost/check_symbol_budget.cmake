@@ -0,0 +1,30 @@
+# solo-any-handle/tests/build_cost/check_symbol_budget.cmake
+#
+# Counts the symbols instantiated per synthetic type by any_handle_500_types.cpp,
+# fails when the count exceeds the budget.
+#
+# cmake -DNM=<nm> -DOBJECTS=<object files> -DTYPE_COUNT=<n> -DBUDGET=<symbols per type> -P check_symbol_budget.cmake
+
+foreach(var NM OBJECTS TYPE_COUNT BUDGET)
+  if(NOT DEFINED ${var})
+    message(FATAL_ERROR "check_symbol_budget: ${var} is not defined")
+  endif()
+endforeach()
+
+execute_process(
+    COMMAND ${NM} -C ${OBJECTS}
+    OUTPUT_VARIABLE symbols
+    RESULT_VARIABLE nm_result
+)
+if(NOT nm_result EQUAL 0)
+  message(FATAL_ERROR "check_symbol_budget: ${NM} failed (${nm_result})")
+endif()
+
+string(REGEX MATCHALL "[^\n]*synthetic_resource<[^\n]*" matches "${symbols}")
+list(LENGTH matches symbol_count)
+math(EXPR symbols_per_type "${symbol_count} / ${TYPE_COUNT}")
+
+message(STATUS "${symbol_count} symbols for ${TYPE_COUNT} types : ${symbols_per_type} symbols per type (budget ${BUDGET})")
+if(symbols_per_type GREATER BUDGET)
+  message(FATAL_ERROR "check_symbol_budget: ${symbols_per_type} symbols per type exceeds the budget of ${BUDGET}")
+endif()
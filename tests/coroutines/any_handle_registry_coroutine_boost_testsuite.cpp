@@ -0,0 +1,194 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include <solo/anys/handles/any_handle_package.hpp>
+#include <solo/anys/handles/registries/registry_package.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// @brief A coroutine started at once, and destroyed at its end (or by its owner if still suspended).
+struct Detached
+{
+    struct promise_type
+    {
+        Detached get_return_object() { return Detached{ std::coroutine_handle<promise_type>::from_promise(*this) }; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+
+    explicit Detached( std::coroutine_handle<promise_type> a_coroutine ) : coroutine{ a_coroutine } {}
+    Detached( Detached &&a_other ) noexcept : coroutine{ std::exchange(a_other.coroutine, {}) } {}
+    ~Detached() { if ( coroutine ) { coroutine.destroy(); } }
+
+    bool done() const { return coroutine.done(); }
+
+    std::coroutine_handle<promise_type> coroutine;
+};
+
+/// @brief An executor queuing the coroutines to resume, run by the test.
+struct QueueExecutor
+{
+    void operator()( std::coroutine_handle<> a_continuation ) const
+    {
+        std::lock_guard<std::mutex> lock{ queue->mutex };
+        queue->pending.push_back(a_continuation);
+    }
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<std::coroutine_handle<>> pending;
+
+        std::size_t run()
+        {
+            auto count = std::size_t{0};
+            for ( ;; )
+            {
+                auto next = std::coroutine_handle<>{};
+                {
+                    std::lock_guard<std::mutex> lock{ mutex };
+                    if ( pending.empty() )
+                    {
+                        return count;
+                    }
+                    next = pending.front();
+                    pending.pop_front();
+                }
+                next.resume();
+                ++count;
+            }
+        }
+    };
+
+    Queue *queue;
+};
+
+}// EONS ANONYMOUS
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( RegistryCoroutineTests )
+
+BOOST_AUTO_TEST_CASE( ResumeOnTheExecutorTest )
+{
+    using namespace solo::anys::registries;
+
+    any_handle_registry registry;
+    QueueExecutor::Queue queue;
+    auto value = 0;
+    auto consumer = [&]() -> Detached
+    {
+        auto result = co_await registry.when_available<int>("answer", QueueExecutor{ &queue });
+        value = *result.assume_value();
+    };
+
+    auto task = consumer();
+    BOOST_TEST( !task.done() );
+    BOOST_TEST( registry.waiter_count() == 1u );
+    registry.publish("answer", solo::make_any_handle<long>(stdex::in_place, 1));// not the awaited type
+    BOOST_TEST( queue.run() == 0u );
+    registry.publish("answer", solo::make_any_handle<int>(stdex::in_place, 42));
+    BOOST_TEST( !task.done() );// queued on the executor
+    BOOST_TEST( queue.run() == 1u );
+    BOOST_TEST( task.done() );
+    BOOST_TEST( value == 42 );
+}
+
+BOOST_AUTO_TEST_CASE( AlreadyPublishedAndMutableTest )
+{
+    using namespace solo::anys::registries;
+
+    any_handle_registry registry;
+    registry.publish("counter", solo::make_any_handle_mutable<int>(stdex::in_place, 1));
+    auto increment = [&]() -> Detached// named : the coroutine refers to the captures of the closure
+    {
+        auto result = co_await registry.when_available_mutable<int>("counter", inline_executor{});
+        ++*result.assume_value();
+    };
+    auto task = increment();
+    BOOST_TEST( task.done() );// not suspended
+    BOOST_TEST( *solo::any_handle_cast<int>(registry.find("counter")).assume_value() == 2 );
+}
+
+BOOST_AUTO_TEST_CASE( CloseAndCancelTest )
+{
+    using namespace solo::anys::registries;
+    using solo::anys::errors::any_handle_cast_errc;
+
+    auto code = any_handle_cast_errc::undefined;
+    {
+        any_handle_registry registry;
+        auto wait_error = [&]() -> Detached
+        {
+            auto result = co_await registry.when_available<int>("never", inline_executor{});
+            code = result.assume_error().code();
+        };
+        auto wait_forever = [&]() -> Detached
+        {
+            co_await registry.when_available<int>("never", inline_executor{});
+        };
+        auto waiting = wait_error();
+        {
+            auto cancelled = wait_forever();
+            BOOST_TEST( registry.waiter_count() == 2u );
+        }// destroyed while suspended
+        BOOST_TEST( registry.waiter_count() == 1u );
+        registry.close();
+        BOOST_TEST( waiting.done() );
+    }
+    BOOST_TEST( ( code == any_handle_cast_errc::empty_source ) );
+}
+
+BOOST_AUTO_TEST_CASE( PublishedByAnotherThreadTest )
+{
+    using namespace solo::anys::registries;
+
+    any_handle_registry registry;
+    QueueExecutor::Queue queue;
+    auto sum = 0;
+    auto consumer = [&]( std::string a_key ) -> Detached
+    {
+        auto result = co_await registry.when_available<int>(a_key, QueueExecutor{ &queue });
+        sum += *result.assume_value();
+    };
+
+    auto first = consumer("first");
+    auto second = consumer("second");
+    std::thread{ [&]
+    {
+        registry.publish("second", solo::make_any_handle<int>(stdex::in_place, 2));
+        registry.publish("first", solo::make_any_handle<int>(stdex::in_place, 1));
+    } }.join();
+    BOOST_TEST( queue.run() == 2u );// resumed on the thread running the executor
+    BOOST_TEST( first.done() );
+    BOOST_TEST( second.done() );
+    BOOST_TEST( sum == 3 );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // RegistryCoroutineTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,197 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include <solo/anys/handles/any_handle_package.hpp>
+#include <solo/anys/handles/interprocess/interprocess_package.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// @brief A plain-data lookup table, built once and read by all the processes.
+struct SharedTable
+{
+    std::int64_t values[1024];
+};
+
+/// @brief A counter updated by all the processes.
+struct SharedCounter
+{
+    std::atomic<std::uint64_t> value;
+};
+
+/// @brief A segment of a name unique to the test process, removed at the end of the test.
+struct SegmentName
+{
+    explicit SegmentName( char const *a_suffix )
+        : name{ "/solo_any_handle_testsuite_" + std::to_string(::getpid()) + "_" + a_suffix }
+    {}
+    ~SegmentName() { anys::interprocess::remove_shared_segment(name); }
+
+    std::string name;
+};
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( InterprocessTests )
+
+BOOST_AUTO_TEST_CASE( ShmHandleTest )
+{
+    using namespace solo::anys::interprocess;
+
+    auto const name = SegmentName{ "handle" };
+    auto const segment = make_shared_segment(name.name, 1u << 20);
+    BOOST_TEST( segment->used_size() == 0u );
+
+    auto const empty = shm_handle{};
+    BOOST_TEST( empty.empty() );
+    BOOST_TEST( empty.use_count() == 0u );
+    BOOST_TEST( is_empty_source_error( shm_handle_cast<SharedTable>(empty).assume_error() ) );
+
+    auto h = make_shm_handle<SharedTable>(segment);
+    BOOST_TEST( !h.empty() );
+    BOOST_TEST( !h.is_mutable() );
+    BOOST_TEST( h.type_fingerprint() == make_any_type_index<SharedTable>().fingerprint() );
+    BOOST_TEST( h.use_count() == 1u );
+    BOOST_TEST( segment->used_size() >= sizeof(SharedTable) );
+
+    {
+        auto const copy = h;
+        BOOST_TEST( h.use_count() == 2u );
+        auto const result = shm_handle_cast<SharedTable>(copy);
+        BOOST_TEST( result.has_value() );
+        BOOST_TEST( result.assume_value().use_count() == 3u );
+        BOOST_TEST( reinterpret_cast<std::uintptr_t>(result.assume_value().get()) % alignof(SharedTable) == 0u );
+    }
+    BOOST_TEST( h.use_count() == 1u );
+
+    BOOST_TEST( is_bad_source_type_error( shm_handle_cast<SharedCounter>(h).assume_error() ) );
+    BOOST_TEST( is_bad_source_mutability_error( shm_handle_mutable_cast<SharedTable>(h).assume_error() ) );
+
+    auto const m = make_shm_handle_mutable<SharedCounter>(segment);
+    BOOST_TEST( m.is_mutable() );
+    shm_handle_mutable_cast<SharedCounter>(m).assume_value()->value = 3u;
+    BOOST_TEST( shm_handle_cast<SharedCounter>(m).assume_value()->value == 3u );
+
+    // the released blocks are reused :
+    auto const offset = h.offset();
+    h = shm_handle{};
+    auto const h2 = make_shm_handle<SharedTable>(segment);
+    BOOST_TEST( h2.offset() == offset );
+}
+
+BOOST_AUTO_TEST_CASE( ShmSegmentErrorsTest )
+{
+    using namespace solo::anys::interprocess;
+
+    auto const name = SegmentName{ "errors" };
+    auto const segment = make_shared_segment(name.name, 8u << 10);
+    BOOST_CHECK_THROW( make_shared_segment(name.name, 8u << 10), interprocess_error );// already exists
+    BOOST_CHECK_THROW( open_shared_segment(name.name + "_missing"), interprocess_error );
+    BOOST_CHECK_THROW( make_shm_handle<SharedTable>(segment), interprocess_error );// too large for the segment
+    BOOST_CHECK_THROW( publish_shm_handle(shm_handle{}, "empty"), interprocess_error );
+
+    auto const h = make_shm_handle<SharedCounter>(segment);
+    publish_shm_handle(h, "counter");
+    BOOST_CHECK_THROW( publish_shm_handle(h, "counter"), interprocess_error );// already published
+    BOOST_CHECK_THROW( publish_shm_handle(h, std::string(100, 'x')), interprocess_error );// name too long
+    BOOST_TEST( h.use_count() == 2u );// the directory owns one reference
+    BOOST_TEST( find_shm_handle(segment, "missing").empty() );
+    BOOST_TEST( unpublish_shm_handle(*segment, "counter") );
+    BOOST_TEST( !unpublish_shm_handle(*segment, "counter") );
+    BOOST_TEST( h.use_count() == 1u );
+}
+
+BOOST_AUTO_TEST_CASE( ShmHandleMultiProcessTest )
+{
+    using namespace solo::anys::interprocess;
+
+    constexpr int worker_count = 4;
+    constexpr int increment_count = 1000;
+
+    auto const name = SegmentName{ "workers" };
+    {
+        auto const segment = make_shared_segment(name.name, 1u << 20);
+        auto const table = make_shm_handle<SharedTable>(segment);
+        auto *const values = const_cast<SharedTable *>( shm_handle_cast<SharedTable>(table).assume_value().get() );
+        for ( auto i = 0; i < 1024; ++i )
+        {
+            values->values[i] = i * i;
+        }
+        publish_shm_handle(table, "table");
+        publish_shm_handle(make_shm_handle_mutable<SharedCounter>(segment), "counter");
+    }// the segment persists, its objects are owned by the directory
+
+    for ( auto w = 0; w < worker_count; ++w )
+    {
+        auto const pid = ::fork();
+        BOOST_REQUIRE( pid >= 0 );
+        if ( pid == 0 )
+        {
+            // worker process : no Boost.Test assertion here, the exit status reports the failures
+            auto status = 1;
+            try
+            {
+                auto const segment = open_shared_segment(name.name);
+                auto const table = shm_handle_cast<SharedTable>( find_shm_handle(segment, "table") );
+                auto const counter = shm_handle_mutable_cast<SharedCounter>( find_shm_handle(segment, "counter") );
+                if ( table.has_value() && counter.has_value() && table.assume_value()->values[1023] == 1023 * 1023 )
+                {
+                    for ( auto i = 0; i < increment_count; ++i )
+                    {
+                        counter.assume_value()->value.fetch_add(1u, std::memory_order_relaxed);
+                    }
+                    status = 0;
+                }
+            }
+            catch ( ... )
+            {
+            }
+            ::_exit(status);
+        }
+    }
+    for ( auto w = 0; w < worker_count; ++w )
+    {
+        auto status = 0;
+        BOOST_REQUIRE( ::wait(&status) > 0 );
+        BOOST_TEST( WIFEXITED(status) );
+        BOOST_TEST( WEXITSTATUS(status) == 0 );
+    }
+
+    auto const segment = open_shared_segment(name.name);
+    auto const counter = find_shm_handle(segment, "counter");
+    BOOST_TEST( shm_handle_cast<SharedCounter>(counter).assume_value()->value == std::uint64_t{ worker_count * increment_count } );
+    BOOST_TEST( counter.use_count() == 2u );// the workers released their references
+    BOOST_TEST( unpublish_shm_handle(*segment, "table") );
+    BOOST_TEST( unpublish_shm_handle(*segment, "counter") );
+    BOOST_TEST( segment->used_size() == 64u );// the counter block, still held by the local handle
+}
+
+BOOST_AUTO_TEST_SUITE_END() // InterprocessTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,2 @@
+#define BOOST_TEST_MODULE SoloAnyHandleInterprocessTestSuite
+#include <boost/test/included/unit_test.hpp>
@@ -0,0 +1,109 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "any_handle_testsuite_types.hpp"
+
+#include <solo/anys/handles/any_handle_package.hpp>
+#include <solo/anys/handles/testing/printing/any_handle_boost_test_outputters.hpp>
+#include <solo/anys/handles/allocators/cache_line_allocator.hpp>
+#include <stdex/testing/printing/typeindex/std_type_index_boost_test_outputters.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// @brief The address of the object held by a handle, as an integer.
+std::uintptr_t address_of( solo::any_handle const &a_handle )
+{
+    return reinterpret_cast<std::uintptr_t>( a_handle.pointer().get() );
+}
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( CacheLineAllocatorTests )
+
+//..............................................................................
+
+BOOST_AUTO_TEST_CASE( AllocateOnWholeCacheLinesTest )
+{
+    using solo::anys::allocators::cache_line_allocator;
+    using solo::anys::allocators::cache_line_size;
+
+    BOOST_TEST( cache_line_allocator<char>::padded_size(1) == cache_line_size );
+    BOOST_TEST( cache_line_allocator<char>::padded_size(cache_line_size) == cache_line_size );
+    BOOST_TEST( cache_line_allocator<char>::padded_size(cache_line_size + 1) == 2 * cache_line_size );
+
+    auto alloc = cache_line_allocator<TestObject>{};
+    auto *p1 = alloc.allocate(1);
+    auto *p2 = alloc.allocate(3);
+    BOOST_TEST( reinterpret_cast<std::uintptr_t>(p1) % cache_line_size == 0u );
+    BOOST_TEST( reinterpret_cast<std::uintptr_t>(p2) % cache_line_size == 0u );
+    alloc.deallocate(p2, 3);
+    alloc.deallocate(p1, 1);
+
+    // stateless : rebound copies compare equal.
+    BOOST_TEST( ( alloc == cache_line_allocator<char>{alloc} ) );
+}
+
+BOOST_AUTO_TEST_CASE( MakeAnyHandleWithAllocatorTest )
+{
+    using solo::anys::allocators::cache_line_allocator;
+
+    auto const ah = solo::make_any_handle<TestObject>(std::allocator_arg, cache_line_allocator<TestObject>{}, 7);
+    BOOST_TEST( ah.use_count() == 1 );
+    BOOST_TEST( ah.type() == typeid(TestObject) );
+    BOOST_TEST( ah.is_mutable() == false );
+    BOOST_TEST( solo::any_handle_cast_or_throw<TestObject>(ah)->data() == 7 );
+
+    auto const ah_m = solo::make_any_handle_mutable<TestObject>(std::allocator_arg, cache_line_allocator<TestObject>{}, 8);
+    BOOST_TEST( ah_m.use_count() == 1 );
+    BOOST_TEST( ah_m.type() == typeid(TestObject) );
+    BOOST_TEST( ah_m.is_mutable() == true );
+    BOOST_TEST( solo::any_handle_mutable_cast_or_throw<TestObject>(ah_m)->data() == 8 );
+
+    // any allocator can be used :
+    auto const ah_std = solo::make_any_handle_mutable<TestObject>(std::allocator_arg, std::allocator<TestObject>{}, 9);
+    BOOST_TEST( solo::any_handle_mutable_cast_or_throw<TestObject>(ah_std)->data() == 9 );
+}
+
+BOOST_AUTO_TEST_CASE( NeighbourHandlesDontShareCacheLinesTest )
+{
+    using solo::anys::allocators::cache_line_allocator;
+    using solo::anys::allocators::cache_line_size;
+
+    // the objects sit at the same offset in their (line aligned, line padded) blocks :
+    // the distance between two neighbours is a non-null multiple of the line size.
+    auto const ah1 = solo::make_any_handle_mutable<TestObject>(std::allocator_arg, cache_line_allocator<TestObject>{}, 1);
+    auto const ah2 = solo::make_any_handle_mutable<TestObject>(std::allocator_arg, cache_line_allocator<TestObject>{}, 2);
+    auto const a1 = address_of(ah1);
+    auto const a2 = address_of(ah2);
+    auto const distance = a1 < a2 ? a2 - a1 : a1 - a2;
+    BOOST_TEST( distance >= cache_line_size );
+    BOOST_TEST( distance % cache_line_size == 0u );
+}
+
+//..............................................................................
+
+BOOST_AUTO_TEST_SUITE_END() // CacheLineAllocatorTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
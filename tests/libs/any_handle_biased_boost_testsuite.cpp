@@ -0,0 +1,222 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include <solo/anys/handles/any_handle_package.hpp>
+#include <solo/anys/handles/biased/biased_package.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// @brief An object counting its destructions.
+struct Counted
+{
+    explicit Counted( std::atomic<int> *a_destroyed ) : destroyed{ a_destroyed } {}
+    ~Counted() { destroyed->fetch_add(1); }
+
+    std::atomic<int> *destroyed;
+};
+
+/// @brief An object holding a biased handle, released with it.
+struct Holder
+{
+    solo::anys::biased::biased_handle inner;
+};
+
+}// EONS ANONYMOUS
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( BiasedHandleTests )
+
+BOOST_AUTO_TEST_CASE( FactoriesAndCastsTest )
+{
+    using namespace solo::anys::biased;
+    using solo::anys::errors::any_handle_cast_errc;
+
+    auto const empty = biased_handle{};
+    BOOST_TEST( empty.empty() );
+    BOOST_TEST( empty.use_count() == 0 );
+    BOOST_TEST( ( biased_handle_cast<int>(empty).assume_error().code() == any_handle_cast_errc::empty_source ) );
+
+    auto const h = make_biased_handle<int>(stdex::in_place, 42);
+    BOOST_TEST( !h.empty() );
+    BOOST_TEST( !h.is_mutable() );
+    BOOST_TEST( h.is_biased() );
+    BOOST_TEST( ( h.type() == typeid(int) ) );
+    BOOST_TEST( h.type_index().equals( solo::make_any_type_index<int>() ) );
+    BOOST_TEST( h.type_fingerprint() == solo::make_any_type_index<int>().fingerprint() );
+
+    auto const rh = biased_handle_cast<int>(h);
+    BOOST_TEST( rh.has_value() );
+    BOOST_TEST( *rh.assume_value() == 42 );
+    BOOST_TEST( rh.assume_value().get() == h.get() );
+    BOOST_TEST( h.use_count() == 2 );
+    BOOST_TEST( ( biased_handle_cast<long>(h).assume_error().code() == any_handle_cast_errc::bad_source_type ) );
+    BOOST_TEST( ( biased_handle_mutable_cast<int>(h).assume_error().code() == any_handle_cast_errc::bad_source_mutability ) );
+
+    auto const m = make_biased_handle_mutable<int>(stdex::in_place, 1);
+    BOOST_TEST( m.is_mutable() );
+    auto const rm = biased_handle_mutable_cast<int>(m);
+    BOOST_TEST( rm.has_value() );
+    *rm.assume_value() = 2;
+    BOOST_TEST( *biased_handle_cast<int>(m).assume_value() == 2 );
+}
+
+BOOST_AUTO_TEST_CASE( OwnerThreadTest )
+{
+    using namespace solo::anys::biased;
+
+    std::atomic<int> destroyed{ 0 };
+    {
+        auto h = make_biased_handle<Counted>(stdex::in_place, &destroyed);
+        auto copies = std::vector<biased_handle>(10, h);
+        BOOST_TEST( h.use_count() == 11 );
+        copies.clear();
+        BOOST_TEST( h.use_count() == 1 );
+        auto moved = std::move(h);
+        BOOST_TEST( h.empty() );
+        BOOST_TEST( moved.use_count() == 1 );
+        BOOST_TEST( destroyed.load() == 0 );
+    }
+    BOOST_TEST( destroyed.load() == 1 );
+}
+
+BOOST_AUTO_TEST_CASE( CrossThreadReleaseTest )
+{
+    using namespace solo::anys::biased;
+
+    // the other thread releases the last reference, after the owner released its biased references
+    std::atomic<int> destroyed{ 0 };
+    auto h = make_biased_handle<Counted>(stdex::in_place, &destroyed);
+    auto remote = biased_handle{};
+    std::thread{ [&]
+    {
+        BOOST_TEST( !h.is_biased() );
+        remote = h;// counted by the atomic count
+    } }.join();
+    BOOST_TEST( h.use_count() == 2 );
+    h = biased_handle{};// merged
+    BOOST_TEST( destroyed.load() == 0 );
+    std::thread{ [&] { remote = biased_handle{}; } }.join();
+    BOOST_TEST( destroyed.load() == 1 );
+
+    // the other thread releases a reference counted by the owner : queued, merged by the owner
+    auto g = make_biased_handle<Counted>(stdex::in_place, &destroyed);
+    std::thread{ [moved = std::move(g)]() mutable { moved = biased_handle{}; } }.join();
+    BOOST_TEST( destroyed.load() == 1 );
+    solo::anys::biased::collect_biased_releases();
+    BOOST_TEST( destroyed.load() == 2 );
+}
+
+BOOST_AUTO_TEST_CASE( OwnerExitTest )
+{
+    using namespace solo::anys::biased;
+
+    std::atomic<int> destroyed{ 0 };
+    auto h = biased_handle{};
+    auto queued = biased_handle{};
+    std::thread{ [&]
+    {
+        h = make_biased_handle<Counted>(stdex::in_place, &destroyed);
+        queued = make_biased_handle<Counted>(stdex::in_place, &destroyed);
+    } }.join();// the owner thread exits : its record is closed
+    BOOST_TEST( !h.is_biased() );
+    auto copy = h;
+    h = biased_handle{};
+    BOOST_TEST( destroyed.load() == 0 );
+    queued = biased_handle{};// merged by this thread : the record is closed
+    BOOST_TEST( destroyed.load() == 1 );
+    copy = biased_handle{};
+    BOOST_TEST( destroyed.load() == 2 );
+
+    // nested : the merge of the outer object by the exit of its owner releases the inner object of the same owner
+    auto outer = biased_handle{};
+    std::atomic<bool> created{ false };
+    std::atomic<bool> released{ false };
+    auto owner = std::thread{ [&]
+    {
+        auto inner = make_biased_handle<Counted>(stdex::in_place, &destroyed);
+        outer = make_biased_handle<Holder>(stdex::in_place, Holder{ inner });
+        inner = biased_handle{};
+        created = true;
+        while ( !released.load() )
+        {
+            std::this_thread::yield();
+        }
+    } };
+    while ( !created.load() )
+    {
+        std::this_thread::yield();
+    }
+    outer = biased_handle{};// queued to the owner thread, which exits without collecting
+    released = true;
+    owner.join();
+    BOOST_TEST( destroyed.load() == 3 );
+
+    // the same, released after the exit of the owner
+    std::thread{ [&]
+    {
+        auto inner = make_biased_handle<Counted>(stdex::in_place, &destroyed);
+        outer = make_biased_handle<Holder>(stdex::in_place, Holder{ inner });
+    } }.join();
+    outer = biased_handle{};
+    BOOST_TEST( destroyed.load() == 4 );
+}
+
+BOOST_AUTO_TEST_CASE( ConcurrentCopiesTest )
+{
+    using namespace solo::anys::biased;
+
+    constexpr auto thread_count = 4;
+    constexpr auto copy_count = 2000;
+
+    std::atomic<int> destroyed{ 0 };
+    auto h = make_biased_handle<Counted>(stdex::in_place, &destroyed);
+    auto threads = std::vector<std::thread>{};
+    for ( auto t = 0; t < thread_count; ++t )
+    {
+        threads.emplace_back( [copy = h]
+        {
+            auto copies = std::vector<biased_handle>{};
+            for ( auto i = 0; i < copy_count; ++i )
+            {
+                copies.push_back(copy);
+            }
+        } );
+    }
+    for ( auto i = 0; i < copy_count; ++i )// concurrent owner copies
+    {
+        auto const copy = h;
+    }
+    for ( auto &thread : threads )
+    {
+        thread.join();
+    }
+    solo::anys::biased::collect_biased_releases();// the copies captured by the threads
+    BOOST_TEST( h.use_count() == 1 );
+    h = biased_handle{};
+    BOOST_TEST( destroyed.load() == 1 );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // BiasedHandleTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
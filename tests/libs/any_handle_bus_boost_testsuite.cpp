@@ -0,0 +1,167 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include <solo/anys/handles/any_handle_package.hpp>
+#include <solo/anys/handles/buses/any_handle_bus.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests { namespace buses {
+////////////////////////////////////////////////////////////////////////////////
+
+/// @brief A message type.
+struct Quote
+{
+    std::string symbol;
+    double price;
+};
+
+/// @brief Another message type.
+struct Trade
+{
+    int quantity;
+};
+
+/// @brief Two message types sharing the same tag, hence the same fingerprint.
+struct CollidingA { int value; };
+struct CollidingB { int value; };
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::TESTS::BUSES
+////////////////////////////////////////////////////////////////////////////////
+
+SOLO_ANY_TYPE_TAG(solo::tests::buses::CollidingA, "solo.tests.colliding")
+SOLO_ANY_TYPE_TAG(solo::tests::buses::CollidingB, "solo.tests.colliding")
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( AnyHandleBusTests )
+
+BOOST_AUTO_TEST_CASE( PublishDeliversBorrowedObjectsTest )
+{
+    using namespace solo::tests::buses;
+
+    auto bus = solo::any_handle_bus{};
+    auto quotes = std::vector<Quote const *>{};
+    auto trades = 0;
+    bus.subscribe<Quote>( [&]( Quote const &a_quote ) { quotes.push_back(&a_quote); } );
+    bus.subscribe<Quote>( [&]( Quote const &a_quote ) { quotes.push_back(&a_quote); } );
+    bus.subscribe<Trade>( [&]( Trade const &a_trade ) { trades += a_trade.quantity; } );
+    BOOST_TEST( bus.subscriber_count(solo::make_any_type_index<Quote>()) == 2u );
+    BOOST_TEST( bus.subscriber_count(solo::make_any_type_index<Quote>(solo::mutability::true_)) == 2u );
+    BOOST_TEST( bus.subscriber_count(solo::make_any_type_index<int>()) == 0u );
+
+    auto const quote = solo::make_any_handle<Quote>(stdex::in_place, Quote{ "EURUSD", 1.08 });
+    BOOST_TEST( bus.publish(quote) == 2u );
+    BOOST_TEST( quotes.size() == 2u );
+    BOOST_TEST( quotes[0] == quote.get() );// borrowed, not copied
+    BOOST_TEST( quotes[1] == quote.get() );
+    BOOST_TEST( quote.use_count() == 1 );
+
+    // mutable handles are delivered to the same subscribers :
+    BOOST_TEST( bus.publish(solo::make_any_handle_mutable<Trade>(stdex::in_place, Trade{ 3 })) == 1u );
+    BOOST_TEST( trades == 3 );
+
+    // no delivery :
+    BOOST_TEST( bus.publish(solo::any_handle{}) == 0u );
+    BOOST_TEST( bus.publish(solo::make_any_handle(std::shared_ptr<Trade const>{})) == 0u );// null pointer
+    BOOST_TEST( bus.publish(solo::make_any_handle<int>(stdex::in_place, 1)) == 0u );
+}
+
+BOOST_AUTO_TEST_CASE( UnsubscribeTest )
+{
+    using namespace solo::tests::buses;
+
+    auto bus = solo::any_handle_bus{};
+    auto received = std::string{};
+    auto const first = bus.subscribe<Trade>( [&]( Trade const & ) { received += "1"; } );
+    auto const second = bus.subscribe<Trade>( [&]( Trade const & ) { received += "2"; } );
+    bus.subscribe<Trade>( [&]( Trade const & ) { received += "3"; } );
+    BOOST_TEST( first != 0u );
+    BOOST_TEST( first != second );
+
+    auto const trade = solo::make_any_handle<Trade>(stdex::in_place, Trade{ 1 });
+    bus.publish(trade);
+    BOOST_TEST( received == "123" );
+
+    BOOST_TEST( bus.unsubscribe(second) );
+    BOOST_TEST( !bus.unsubscribe(second) );
+    bus.publish(trade);
+    BOOST_TEST( received == "12313" );// subscription order kept
+    BOOST_TEST( bus.subscriber_count(solo::make_any_type_index<Trade>()) == 2u );
+}
+
+BOOST_AUTO_TEST_CASE( PublishRangeTest )
+{
+    using namespace solo::tests::buses;
+
+    auto bus = solo::any_handle_bus{};
+    auto first_received = std::vector<int>{};
+    auto second_received = std::vector<int>{};
+    bus.subscribe<Trade>( [&]( Trade const &a_trade ) { first_received.push_back(a_trade.quantity); } );
+    bus.subscribe<Trade>( [&]( Trade const &a_trade ) { second_received.push_back(a_trade.quantity); } );
+    bus.subscribe<Quote>( [&]( Quote const &a_quote ) { first_received.push_back(-static_cast<int>(a_quote.price)); } );
+
+    auto const messages = std::vector<solo::any_handle>{
+        solo::make_any_handle<Trade>(stdex::in_place, Trade{ 1 }),
+        solo::make_any_handle_mutable<Trade>(stdex::in_place, Trade{ 2 }),
+        solo::make_any_handle<int>(stdex::in_place, 0),
+        solo::any_handle{},
+        solo::make_any_handle<Quote>(stdex::in_place, Quote{ "X", 7. }),
+        solo::make_any_handle<Trade>(stdex::in_place, Trade{ 3 }),
+        solo::make_any_handle(std::shared_ptr<Trade const>{}),
+        solo::make_any_handle<Trade>(stdex::in_place, Trade{ 4 }) };
+
+    BOOST_TEST( bus.publish(messages.begin(), messages.end()) == 9u );
+    BOOST_TEST( first_received == ( std::vector<int>{ 1, 2, -7, 3, 4 } ) );// each subscriber receives the messages in order
+    BOOST_TEST( second_received == ( std::vector<int>{ 1, 2, 3, 4 } ) );
+    BOOST_TEST( bus.publish(messages.begin(), messages.begin()) == 0u );
+}
+
+BOOST_AUTO_TEST_CASE( FingerprintCollisionTest )
+{
+    using namespace solo::tests::buses;
+
+    auto bus = solo::any_handle_bus{};
+    auto received = 0;
+    bus.subscribe<CollidingA>( [&]( CollidingA const &a_object ) { received += a_object.value; } );
+#if SOLO_ANY_HANDLE_ENABLE_TYPE_FINGERPRINTS
+    // the types of the same fingerprint are the same type
+    BOOST_TEST( bus.publish(solo::make_any_handle<CollidingB>(stdex::in_place, CollidingB{ 1 })) == 1u );
+#else
+    BOOST_CHECK_THROW( bus.subscribe<CollidingB>( []( CollidingB const & ) {} ), std::invalid_argument );
+    BOOST_TEST( bus.subscriber_count(solo::make_any_type_index<CollidingB>()) == 0u );
+
+    auto const messages = std::vector<solo::any_handle>{
+        solo::make_any_handle<CollidingB>(stdex::in_place, CollidingB{ 1 }),
+        solo::make_any_handle<CollidingA>(stdex::in_place, CollidingA{ 2 }),
+        solo::make_any_handle<CollidingB>(stdex::in_place, CollidingB{ 4 }),
+        solo::make_any_handle<CollidingA>(stdex::in_place, CollidingA{ 8 }) };
+    BOOST_TEST( bus.publish(messages[0]) == 0u );
+    BOOST_TEST( bus.publish(messages.begin(), messages.end()) == 2u );
+    BOOST_TEST( received == 10 );
+#endif
+}
+
+BOOST_AUTO_TEST_SUITE_END() // AnyHandleBusTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
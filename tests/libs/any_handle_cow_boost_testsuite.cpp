@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include <solo/anys/handles/any_handle_package.hpp>
+#include <solo/anys/handles/cow/cow_package.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// @brief A copyable object counting its copies.
+struct CopyCounted
+{
+    explicit CopyCounted( int *a_copies ) : copies{ a_copies } {}
+    CopyCounted( CopyCounted const &a_other ) : copies{ a_other.copies }, values{ a_other.values } { ++*copies; }
+    CopyCounted &operator=( CopyCounted const & ) = default;
+
+    int *copies;
+    std::vector<int> values;
+};
+
+}// EONS ANONYMOUS
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( CopyOnWriteTests )
+
+BOOST_AUTO_TEST_CASE( UnsharedMutatesInPlaceTest )
+{
+    auto copies = 0;
+    auto h = solo::anys::cow::make_any_handle_cow<CopyCounted>(stdex::in_place, &copies);
+    BOOST_TEST( !h.is_mutable() );
+    BOOST_TEST( ( h.type() == typeid(CopyCounted) ) );
+    BOOST_TEST( ( h.type_fingerprint() == solo::make_any_type_index<CopyCounted>().fingerprint() ) );
+    BOOST_TEST( !solo::any_handle_mutable_cast<CopyCounted>(h).has_value() );// not through the plain mutable cast
+
+    auto const before = h.get();
+    solo::anys::cow::any_handle_cow_mutable_cast<CopyCounted>(h).assume_value()->values.push_back(1);
+    BOOST_TEST( copies == 0 );
+    BOOST_TEST( h.get() == before );
+    BOOST_TEST( solo::any_handle_cast<CopyCounted>(h).assume_value()->values.size() == 1u );
+}
+
+BOOST_AUTO_TEST_CASE( SharedIsCopiedTest )
+{
+    auto copies = 0;
+    auto const shared = solo::anys::cow::make_any_handle_cow<CopyCounted>(stdex::in_place, &copies);
+    auto mine = shared;
+    BOOST_TEST( ( mine == shared ) );
+
+    solo::anys::cow::any_handle_cow_mutable_cast<CopyCounted>(mine).assume_value()->values.push_back(2);
+    BOOST_TEST( copies == 1 );
+    BOOST_TEST( mine.get() != shared.get() );
+    BOOST_TEST( mine.use_count() == 1 );
+    BOOST_TEST( solo::any_handle_cast<CopyCounted>(shared).assume_value()->values.empty() );
+    BOOST_TEST( solo::any_handle_cast<CopyCounted>(mine).assume_value()->values.size() == 1u );
+
+    // the copy is copy-on-write too, and now owned by mine only
+    solo::anys::cow::any_handle_cow_mutable_cast<CopyCounted>(mine).assume_value()->values.push_back(3);
+    BOOST_TEST( copies == 1 );
+    auto const again = mine;
+    solo::anys::cow::any_handle_cow_mutable_cast<CopyCounted>(mine).assume_value()->values.push_back(4);
+    BOOST_TEST( copies == 2 );
+    BOOST_TEST( solo::any_handle_cast<CopyCounted>(again).assume_value()->values.size() == 2u );
+
+    // a typed pointer still held is an owner too
+    auto const held = solo::any_handle_cast<CopyCounted>(mine).assume_value();
+    solo::anys::cow::any_handle_cow_mutable_cast<CopyCounted>(mine).assume_value()->values.clear();
+    BOOST_TEST( copies == 3 );
+    BOOST_TEST( held->values.size() == 3u );
+}
+
+BOOST_AUTO_TEST_CASE( OtherHandlesTest )
+{
+    using solo::anys::errors::any_handle_cast_errc;
+
+    auto copies = 0;
+    auto h = solo::anys::cow::make_any_handle_cow<CopyCounted>(stdex::in_place, &copies);
+    BOOST_TEST( ( solo::anys::cow::any_handle_cow_mutable_cast<std::string>(h).assume_error().code() == any_handle_cast_errc::bad_source_type ) );
+
+    auto empty = solo::any_handle{};
+    BOOST_TEST( ( solo::anys::cow::any_handle_cow_mutable_cast<int>(empty).assume_error().code() == any_handle_cast_errc::empty_source ) );
+    BOOST_TEST( !empty.unshare() );
+
+    auto constant = solo::make_any_handle<int>(stdex::in_place, 1);
+    BOOST_TEST( ( solo::anys::cow::any_handle_cow_mutable_cast<int>(constant).assume_error().code() == any_handle_cast_errc::bad_source_mutability ) );
+    BOOST_TEST( !constant.unshare() );
+
+    // a mutable handle is cast in place, shared or not
+    auto m = solo::make_any_handle_mutable<int>(stdex::in_place, 1);
+    auto const m_copy = m;
+    *solo::anys::cow::any_handle_cow_mutable_cast<int>(m).assume_value() = 2;
+    BOOST_TEST( *solo::any_handle_cast<int>(m_copy).assume_value() == 2 );
+
+    // from an existing pointer, shared with the caller
+    auto const p = std::make_shared<CopyCounted>(&copies);
+    auto from_pointer = solo::anys::cow::make_any_handle_cow(p);
+    BOOST_TEST( from_pointer.unshare() );
+    BOOST_TEST( copies == 1 );
+    BOOST_TEST( from_pointer.get() != p.get() );
+    BOOST_TEST( solo::anys::cow::make_any_handle_cow(std::shared_ptr<CopyCounted>{}).empty() );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // CopyOnWriteTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
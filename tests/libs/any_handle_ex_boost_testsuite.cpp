@@ -10,6 +10,7 @@
 #include "any_handle_testsuite_types.hpp"
 
 #include <solo/anys/handles/any_handle_package.hpp>
+#include <solo/anys/handles/testing/printing/any_handle_boost_test_outputters.hpp>
 #include <stdex/testing/printing/typeindex/std_type_index_boost_test_outputters.hpp>
 
 #include <boost/test/unit_test.hpp>
@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+// the forward header must be self-sufficient : it is included first.
+#include <solo/anys/handles/any_handle_fwd.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// @brief A component declared with the forward declarations only.
+class ForwardDeclaredRegistry
+{
+public:
+    void add( solo::any_handle const &a_handle );
+    solo::any_handle const &get() const;
+    bool is_mutable( solo::mutability a_mutability ) const;
+private:
+    solo::any_handle const *m_handle{nullptr};
+};
+
+}// EONS ANONYMOUS
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
+
+#include "any_handle_testsuite_types.hpp"
+
+#include <solo/anys/handles/any_handle_package.hpp>
+#include <solo/anys/handles/testing/printing/any_handle_boost_test_outputters.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+void ForwardDeclaredRegistry::add( solo::any_handle const &a_handle )
+{
+    m_handle = &a_handle;
+}
+
+solo::any_handle const &ForwardDeclaredRegistry::get() const
+{
+    return *m_handle;
+}
+
+bool ForwardDeclaredRegistry::is_mutable( solo::mutability a_mutability ) const
+{
+    return m_handle->is_mutable() == solo::mutability_as_boolean(a_mutability);
+}
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( ForwardHeaderTests )
+
+BOOST_AUTO_TEST_CASE( ForwardDeclaredTypesAreTheLibraryTypesTest )
+{
+    auto const ah = solo::make_any_handle_mutable<TestObject>(stdex::in_place, 1);
+    auto registry = ForwardDeclaredRegistry{};
+    registry.add(ah);
+    BOOST_TEST( registry.get() == ah );
+    BOOST_TEST( registry.is_mutable(solo::mutability::true_) );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // ForwardHeaderTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
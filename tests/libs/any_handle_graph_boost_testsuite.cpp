@@ -0,0 +1,153 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include <solo/anys/handles/any_handle_package.hpp>
+#include <solo/anys/handles/graphs/graph_package.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using solo::anys::graphs::depends_on;
+using solo::anys::graphs::graph_error;
+using solo::anys::graphs::resource_graph;
+using solo::anys::registries::any_handle_registry;
+
+/// @brief Declare the diamond a -> (b, c) -> d, with d = (a + 1) * (a + 2).
+void add_diamond( resource_graph &a_graph, std::atomic<int> &a_calls )
+{
+    a_graph.add<int>("a", [&a_calls] { ++a_calls; return std::make_shared<int const>(3); });
+    a_graph.add<long>("b", depends_on<int>("a"), [&a_calls]( std::shared_ptr<int const> a ) {
+        ++a_calls;
+        return std::make_shared<long const>(*a + 1);
+    });
+    a_graph.add<std::string>("c", depends_on<int>("a"), [&a_calls]( std::shared_ptr<int const> a ) {
+        ++a_calls;
+        return std::make_shared<std::string const>(std::to_string(*a + 2));
+    });
+    a_graph.add<long>("d", depends_on<long, std::string>("b", "c"), [&a_calls]( std::shared_ptr<long const> b, std::shared_ptr<std::string const> c ) {
+        ++a_calls;
+        return std::make_shared<long const>(*b * std::stol(*c));
+    });
+}
+
+}// EONS ANONYMOUS
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( ResourceGraphTests )
+
+BOOST_AUTO_TEST_CASE( BuildTest )
+{
+    for ( auto const threads : { 1u, 2u, 8u } )
+    {
+        std::atomic<int> calls{0};
+        resource_graph graph{};
+        add_diamond(graph, calls);
+        BOOST_TEST( graph.size() == 4u );
+
+        any_handle_registry registry{};
+        auto const report = graph.build(registry, threads);
+        BOOST_TEST( calls == 4 );
+        BOOST_TEST( report.thread_count == threads );
+        BOOST_TEST( registry.size() == 4u );
+        BOOST_TEST( *solo::any_handle_cast<long>(registry.find("d")).assume_value() == 20 );
+        BOOST_TEST( !registry.find("d").is_mutable() );
+
+        BOOST_TEST( report.resources.size() == 4u );
+        BOOST_TEST( report.resources[3].key == "d" );
+        BOOST_TEST( ( report.resources[3].start >= report.resources[0].start + report.resources[0].duration ) );
+        BOOST_TEST( report.critical_path.size() == 3u );
+        BOOST_TEST( report.critical_path.front() == "a" );
+        BOOST_TEST( report.critical_path.back() == "d" );
+        BOOST_TEST( report.critical_path_duration.count() <= report.total_duration.count() );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( WideGraphTest )
+{
+    // 64 leaves depending on a root, and another root
+    resource_graph graph{};
+    graph.add<int>("root", [] { return std::make_shared<int const>(1); });
+    for ( auto i = 0; i < 64; ++i )
+    {
+        graph.add<int>("leaf" + std::to_string(i), depends_on<int>("root"), [i]( std::shared_ptr<int const> r ) {
+            return std::make_shared<int const>(*r + i);
+        });
+    }
+    graph.add<int>("other", [] { return std::make_shared<int const>(0); });
+
+    any_handle_registry registry{};
+    graph.build(registry, 4);
+    BOOST_TEST( registry.size() == 66u );
+    BOOST_TEST( *solo::any_handle_cast<int>(registry.find("leaf63")).assume_value() == 64 );
+}
+
+BOOST_AUTO_TEST_CASE( InvalidGraphTest )
+{
+    std::atomic<int> calls{0};
+    any_handle_registry registry{};
+
+    resource_graph duplicate{};
+    add_diamond(duplicate, calls);
+    BOOST_CHECK_THROW( duplicate.add<int>("a", [] { return std::make_shared<int const>(0); }), graph_error );
+
+    resource_graph missing{};
+    missing.add<int>("a", depends_on<int>("nowhere"), []( std::shared_ptr<int const> x ) { return x; });
+    BOOST_CHECK_THROW( missing.build(registry, 2), graph_error );
+
+    resource_graph mistyped{};
+    add_diamond(mistyped, calls);
+    mistyped.add<int>("e", depends_on<int>("c"), []( std::shared_ptr<int const> x ) { return x; });
+    BOOST_CHECK_THROW( mistyped.build(registry, 2), graph_error );
+
+    resource_graph cyclic{};
+    cyclic.add<int>("a", depends_on<int>("b"), []( std::shared_ptr<int const> x ) { return x; });
+    cyclic.add<int>("b", depends_on<int>("a"), []( std::shared_ptr<int const> x ) { return x; });
+    BOOST_CHECK_THROW( cyclic.build(registry, 2), graph_error );
+
+    BOOST_TEST( calls == 0 );
+    BOOST_TEST( registry.size() == 0u );
+}
+
+BOOST_AUTO_TEST_CASE( ThrowingFactoryTest )
+{
+    std::atomic<int> calls{0};
+    resource_graph graph{};
+    add_diamond(graph, calls);
+    graph.add<int>("broken", depends_on<int>("a"), []( std::shared_ptr<int const> ) -> std::shared_ptr<int const> {
+        throw std::runtime_error{ "broken" };
+    });
+    graph.add<int>("after_broken", depends_on<int>("broken"), [&calls]( std::shared_ptr<int const> x ) { ++calls; return x; });
+    graph.add<int>("null", [] { return std::shared_ptr<int const>{}; });
+
+    any_handle_registry registry{};
+    BOOST_CHECK_THROW( graph.build(registry, 4), std::exception );
+    BOOST_TEST( calls == 4 );// the diamond is built, not the dependent of the broken resource
+    BOOST_TEST( registry.size() == 4u );
+    BOOST_TEST( registry.find("after_broken").empty() );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // ResourceGraphTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include <solo/anys/handles/any_handle_package.hpp>
+#include <solo/anys/handles/interning/interning_package.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+    solo::anys::interning::intern_table *reinterning_table = nullptr;
+    solo::any_handle compared_owner{};
+    int reinternings = 0;
+
+    /// Colliding values : their comparison releases @c compared_owner, and the destructor of a reinterning value
+    /// interns another value of the same shard.
+    struct Reinterning
+    {
+        Reinterning( int a_value, bool a_reinterns ) : value{ a_value }, reinterns{ a_reinterns } {}
+
+        ~Reinterning()
+        {
+            if ( reinterns )
+            {
+                solo::anys::interning::make_interned_any_handle<Reinterning>(*reinterning_table, stdex::in_place, value + 1, false);
+                ++reinternings;
+            }
+        }
+
+        int value;
+        bool reinterns;
+    };
+
+    bool operator==( Reinterning const &a_lhs, Reinterning const &a_rhs )
+    {
+        compared_owner = solo::any_handle{};// the compared object may be left to the interning only
+        return a_lhs.value == a_rhs.value;
+    }
+
+}// EONS ANONYMOUS
+
+}}// EONS SOLOTESTS
+
+namespace std {
+    template <> struct hash<solo::tests::Reinterning>
+    {
+        std::size_t operator()( solo::tests::Reinterning const & ) const noexcept { return 0; }
+    };
+}// EONS STD
+
+namespace solo { namespace tests {
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( InterningTests )
+
+BOOST_AUTO_TEST_CASE( SameValueSameObjectTest )
+{
+    using solo::anys::interning::make_interned_any_handle;
+
+    solo::anys::interning::intern_table table{};
+    auto const a = make_interned_any_handle<std::string>(table, stdex::in_place, "key");
+    auto const b = make_interned_any_handle<std::string>(table, stdex::in_place, std::string{"ke"} + "y");
+    auto const c = make_interned_any_handle<std::string>(table, stdex::in_place, "other");
+    BOOST_TEST( ( a == b ) );// the same object
+    BOOST_TEST( a.get() == b.get() );
+    BOOST_TEST( ( a != c ) );
+    BOOST_TEST( !a.is_mutable() );
+    BOOST_TEST( *solo::any_handle_cast<std::string>(b).assume_value() == "key" );
+    BOOST_TEST( table.size() == 2u );
+
+    // equal hashes and values, other types : other objects
+    auto const i = make_interned_any_handle<int>(table, stdex::in_place, 7);
+    auto const l = make_interned_any_handle<long>(table, stdex::in_place, 7);
+    BOOST_TEST( i.get() != l.get() );
+    BOOST_TEST( make_interned_any_handle<long const>(table, stdex::in_place, 7).get() == l.get() );
+
+    // the process-wide table
+    BOOST_TEST( make_interned_any_handle<std::string>(stdex::in_place, "key").get()
+                == make_interned_any_handle<std::string>(stdex::in_place, "key").get() );
+}
+
+BOOST_AUTO_TEST_CASE( WeakEntriesTest )
+{
+    using solo::anys::interning::make_interned_any_handle;
+
+    solo::anys::interning::intern_table table{};
+    auto kept = make_interned_any_handle<std::string>(table, stdex::in_place, "kept");
+    {
+        auto const dropped = make_interned_any_handle<std::string>(table, stdex::in_place, "dropped");
+        BOOST_TEST( dropped.use_count() == 1 );// not owned by the table
+        BOOST_TEST( table.size() == 2u );
+    }
+    BOOST_TEST( table.size() == 1u );
+
+    // many short-lived values : the entries of the destroyed ones are purged
+    for ( auto n = 0; n < 10000; ++n )
+    {
+        make_interned_any_handle<int>(table, stdex::in_place, n);
+    }
+    BOOST_TEST( table.size() == 1u );
+    BOOST_TEST( make_interned_any_handle<std::string>(table, stdex::in_place, "kept").get() == kept.get() );
+}
+
+BOOST_AUTO_TEST_CASE( ConcurrentInterningTest )
+{
+    using solo::anys::interning::make_interned_any_handle;
+
+    solo::anys::interning::intern_table table{};
+    auto results = std::vector<std::vector<solo::any_handle>>(4);
+    auto threads = std::vector<std::thread>{};
+    for ( auto t = 0u; t < results.size(); ++t )
+    {
+        threads.emplace_back([&table, &results, t] {
+            for ( auto n = 0; n < 256; ++n )
+            {
+                results[t].push_back(make_interned_any_handle<std::string>(table, stdex::in_place, std::to_string(n % 16)));
+            }
+        });
+    }
+    for ( auto &t : threads )
+    {
+        t.join();
+    }
+    BOOST_TEST( table.size() == 16u );
+    for ( auto const &r : results )
+    {
+        for ( auto n = 0u; n < r.size(); ++n )
+        {
+            BOOST_TEST( r[n].get() == results[0][n].get() );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( DestructorInterningTest )
+{
+    using solo::anys::interning::make_interned_any_handle;
+
+    solo::anys::interning::intern_table table{};
+    reinterning_table = &table;
+    compared_owner = make_interned_any_handle<Reinterning>(table, stdex::in_place, 1, true);
+    // 3 is compared with 1, which loses its last owner : destroyed out of the shard lock, it interns 2
+    auto const kept = make_interned_any_handle<Reinterning>(table, stdex::in_place, 3, false);
+    BOOST_TEST( reinternings == 1 );
+    BOOST_TEST( table.size() == 1u );
+    BOOST_TEST( solo::any_handle_cast<Reinterning>(kept).assume_value()->value == 3 );
+    reinterning_table = nullptr;
+}
+
+BOOST_AUTO_TEST_SUITE_END() // InterningTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
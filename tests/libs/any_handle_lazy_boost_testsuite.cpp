@@ -0,0 +1,227 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include <solo/anys/handles/any_handle_package.hpp>
+#include <solo/anys/handles/lazy/lazy_package.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// @brief An object counting its constructions and destructions.
+struct Counted
+{
+    Counted( std::atomic<int> *a_constructions, std::atomic<int> *a_destructions, std::string a_name )
+        : destructions{ a_destructions }
+        , name{ std::move(a_name) }
+    {
+        ++*a_constructions;
+    }
+
+    Counted( Counted const & ) = delete;
+    Counted &operator=( Counted const & ) = delete;
+
+    ~Counted() { ++*destructions; }
+
+    std::atomic<int> *destructions;
+    std::string name;
+};
+
+/// @brief An object taking its argument by value, whose first construction fails after having taken it.
+struct FailingOnce
+{
+    FailingOnce( std::string a_path, int *a_attempts )
+        : path{ std::move(a_path) }
+    {
+        if ( ++*a_attempts == 1 )
+        {
+            throw std::runtime_error{ "first attempt" };
+        }
+    }
+
+    std::string path;
+};
+
+/// @brief The same, with a move-only argument.
+struct FailingOnceMoveOnly
+{
+    FailingOnceMoveOnly( std::unique_ptr<int> a_value, int *a_attempts )
+        : value{ std::move(a_value) }
+    {
+        if ( ++*a_attempts == 1 )
+        {
+            throw std::runtime_error{ "first attempt" };
+        }
+    }
+
+    std::unique_ptr<int> value;
+};
+
+}// EONS ANONYMOUS
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( LazyHandleTests )
+
+BOOST_AUTO_TEST_CASE( BuildOnFirstCastTest )
+{
+    std::atomic<int> constructions{0};
+    std::atomic<int> destructions{0};
+    {
+        auto const h = solo::anys::lazy::make_any_handle_lazy<Counted>(stdex::in_place, &constructions, &destructions, "a");
+
+        // the type is known up front, and the type queries do not build the object
+        BOOST_TEST( ( h.type() == typeid(Counted) ) );
+        BOOST_TEST( h.type_fingerprint() == solo::make_any_type_index<Counted>().fingerprint() );
+        BOOST_TEST( !h.is_mutable() );
+        BOOST_TEST( h.has_value() );
+        BOOST_TEST( !solo::any_handle_cast<int>(h).has_value() );
+        BOOST_TEST( !solo::any_handle_mutable_cast<Counted>(h).has_value() );
+        BOOST_TEST( constructions == 0 );
+
+        auto const p = solo::any_handle_cast<Counted>(h).assume_value();
+        BOOST_TEST( constructions == 1 );
+        BOOST_TEST( p->name == "a" );
+        BOOST_TEST( solo::any_handle_cast<Counted>(h).assume_value() == p );
+        BOOST_TEST( constructions == 1 );
+    }
+    BOOST_TEST( destructions == 1 );
+}
+
+BOOST_AUTO_TEST_CASE( NeverBuiltTest )
+{
+    std::atomic<int> constructions{0};
+    std::atomic<int> destructions{0};
+    auto h = solo::anys::lazy::make_any_handle_lazy<Counted>(stdex::in_place, &constructions, &destructions, "a");
+    BOOST_TEST( h.is_lazy() );
+    BOOST_TEST( h.get() != nullptr );// the address of the storage : the accessors do not build the object
+    BOOST_TEST( ( h.pointer() == h ) );
+    auto const moved = std::move(h);
+    BOOST_TEST( h.get() == nullptr );// moved from : nothing to build
+    BOOST_TEST( constructions == 0 );
+    BOOST_TEST( destructions == 0 );
+}
+
+BOOST_AUTO_TEST_CASE( CallableAndMutableTest )
+{
+    auto calls = 0;
+    auto h = solo::anys::lazy::make_any_handle_mutable_lazy<std::vector<int>>([&calls] {
+        ++calls;
+        return std::vector<int>{ 1, 2, 3 };
+    });
+    BOOST_TEST( h.is_mutable() );
+    BOOST_TEST( ( h.type() == typeid(std::vector<int>) ) );
+    BOOST_TEST( calls == 0 );
+
+    solo::any_handle_mutable_cast<std::vector<int>>(h).assume_value()->push_back(4);
+    BOOST_TEST( calls == 1 );
+    BOOST_TEST( solo::any_handle_cast<std::vector<int>>(h).assume_value()->size() == 4u );
+    BOOST_TEST( calls == 1 );
+
+    // equal to an eager handle to the same object
+    auto const eager = solo::make_any_handle_mutable(solo::any_handle_mutable_cast<std::vector<int>>(h).assume_value());
+    BOOST_TEST( ( eager == h ) );
+}
+
+BOOST_AUTO_TEST_CASE( ThrowingConstructionTest )
+{
+    auto attempts = 0;
+    auto const h = solo::anys::lazy::make_any_handle_mutable_lazy<std::string>([&attempts] {
+        if ( ++attempts < 3 )
+        {
+            throw std::runtime_error{ "not yet" };
+        }
+        return std::string{ "built" };
+    });
+    BOOST_TEST( !solo::make_any_handle<int>(stdex::in_place, 0).is_lazy() );
+
+    // reported as an error by the casts returning a result, propagated by the throwing casts : left unbuilt
+    auto const failed = solo::any_handle_cast<std::string>(h);
+    BOOST_REQUIRE( failed.has_error() );
+    BOOST_TEST( solo::anys::errors::is_failed_source_construction_error(failed.assume_error()) );
+    BOOST_CHECK_THROW( solo::any_handle_mutable_cast_or_throw<std::string>(h), std::runtime_error );
+    BOOST_TEST( attempts == 2 );
+
+    // the next cast retries
+    BOOST_TEST( *solo::any_handle_mutable_cast<std::string>(h).assume_value() == "built" );
+    BOOST_TEST( *solo::any_handle_cast_or_throw<std::string>(h) == "built" );
+    BOOST_TEST( attempts == 3 );
+
+    // a bad cast is still reported as such, without building
+    auto const other = solo::anys::lazy::make_any_handle_lazy<std::string>([]() -> std::string { throw std::runtime_error{ "never" }; });
+    BOOST_TEST( solo::anys::errors::is_bad_source_type_error(solo::any_handle_cast<int>(other).assume_error()) );
+    BOOST_TEST( solo::anys::errors::is_bad_source_mutability_error(solo::any_handle_mutable_cast<std::string>(other).assume_error()) );
+    BOOST_CHECK_THROW( solo::any_handle_cast_or_throw<int>(other), solo::anys::exceptions::bad_any_handle_cast );
+    BOOST_CHECK_THROW( solo::any_handle_cast_or_throw<std::string>(other), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_CASE( RetryWithTheSameArgumentsTest )
+{
+    // the arguments are given as lvalues : the retry builds the object from the same ones
+    auto attempts = 0;
+    auto const h = solo::anys::lazy::make_any_handle_lazy<FailingOnce>(stdex::in_place, std::string{ "config.json" }, &attempts);
+    BOOST_TEST( solo::anys::errors::is_failed_source_construction_error(solo::any_handle_cast<FailingOnce>(h).assume_error()) );
+    BOOST_TEST( solo::any_handle_cast<FailingOnce>(h).assume_value()->path == "config.json" );
+    BOOST_TEST( attempts == 2 );
+
+    // moved, maybe consumed by the failed construction : the handle fails for good
+    auto move_only_attempts = 0;
+    auto const m = solo::anys::lazy::make_any_handle_lazy<FailingOnceMoveOnly>(stdex::in_place, std::make_unique<int>(7), &move_only_attempts);
+    BOOST_TEST( solo::anys::errors::is_failed_source_construction_error(solo::any_handle_cast<FailingOnceMoveOnly>(m).assume_error()) );
+    BOOST_TEST( solo::anys::errors::is_failed_source_construction_error(solo::any_handle_cast<FailingOnceMoveOnly>(m).assume_error()) );
+    BOOST_CHECK_THROW( solo::any_handle_cast_or_throw<FailingOnceMoveOnly>(m), std::runtime_error );
+    BOOST_TEST( move_only_attempts == 1 );
+}
+
+BOOST_AUTO_TEST_CASE( ConcurrentFirstCastsTest )
+{
+    std::atomic<int> constructions{0};
+    std::atomic<int> destructions{0};
+    {
+        auto const h = solo::anys::lazy::make_any_handle_lazy<Counted>(stdex::in_place, &constructions, &destructions, "shared");
+        auto seen = std::vector<Counted const *>(8, nullptr);
+        auto threads = std::vector<std::thread>{};
+        for ( auto i = 0u; i < seen.size(); ++i )
+        {
+            threads.emplace_back([&h, &seen, i] {
+                auto const p = solo::any_handle_cast<Counted>(h).assume_value();
+                seen[i] = p->name == "shared" ? p.get() : nullptr;
+            });
+        }
+        for ( auto &t : threads )
+        {
+            t.join();
+        }
+        BOOST_TEST( constructions == 1 );
+        for ( auto const *p : seen )
+        {
+            BOOST_TEST( p == h.get() );
+        }
+    }
+    BOOST_TEST( destructions == 1 );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // LazyHandleTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,129 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include <solo/anys/handles/any_handle_package.hpp>
+#include <solo/anys/handles/regions/region_package.hpp>
+
+#include <solo/anys/handles/testing/printing/any_handle_boost_test_outputters.hpp>
+#include <stdex/testing/printing/typeindex/std_type_index_boost_test_outputters.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// @brief A plain-data resource of the reference data file.
+struct MappedCurve
+{
+    double points[4];
+    std::int32_t id;
+};
+
+/// @brief A plain-data resource with a stronger alignment.
+struct alignas(32) MappedBlock
+{
+    std::uint8_t bytes[32];
+};
+
+/// @brief A region file removed at the end of the test.
+struct RegionFile
+{
+    RegionFile( std::string a_path, std::string const &a_bytes )
+        : path{ std::move(a_path) }
+    {
+        auto os = std::ofstream{ path, std::ios::binary | std::ios::trunc };
+        os.write(a_bytes.data(), static_cast<std::streamsize>(a_bytes.size()));
+    }
+    ~RegionFile() { std::remove(path.c_str()); }
+
+    std::string path;
+};
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( MappedRegionTests )
+
+BOOST_AUTO_TEST_CASE( MakeMappedAnyHandleTest )
+{
+    using namespace solo::anys::regions;
+
+    auto bytes = std::string{"some other data"};
+    auto const curve_offset = append_mapped_object( bytes, MappedCurve{ {1., 2., 3., 4.}, 42 } );
+    auto const block_offset = append_mapped_object( bytes, MappedBlock{ {7} } );
+    auto const file = RegionFile{ "solo_any_handle_mapped_region_testsuite.bin", bytes };
+
+    auto region = make_mapped_region(file.path);
+    BOOST_TEST( region->size() == bytes.size() );
+
+    auto const hc = make_mapped_any_handle<MappedCurve>(region, curve_offset);
+    BOOST_TEST( !hc.empty() );
+    BOOST_TEST( !hc.is_mutable() );
+    BOOST_TEST( ( hc.type() == typeid(MappedCurve) ) );
+    auto const result = solo::any_handle_cast<MappedCurve>(hc);
+    BOOST_TEST( result.has_value() );
+    auto const curve = result.assume_value();
+    BOOST_TEST( curve->points[3] == 4. );
+    BOOST_TEST( curve->id == 42 );
+    BOOST_TEST( region->contains(curve.get()) == region->is_memory_mapped() );// zero-copy
+
+    auto const hb = make_mapped_any_handle<MappedBlock>(region, block_offset);
+    auto const block = solo::any_handle_cast_or_throw<MappedBlock>(hb);
+    BOOST_TEST( reinterpret_cast<std::uintptr_t>(block.get()) % alignof(MappedBlock) == 0u );
+    BOOST_TEST( block->bytes[0] == 7 );
+
+    // the handles keep the region alive :
+    auto const weak_region = std::weak_ptr<mapped_region const>{ region };
+    region.reset();
+    BOOST_TEST( !weak_region.expired() );
+    BOOST_TEST( solo::any_handle_cast_or_throw<MappedCurve>(hc)->id == 42 );
+}
+
+BOOST_AUTO_TEST_CASE( MakeMappedAnyHandleErrorsTest )
+{
+    using namespace solo::anys::regions;
+
+    auto bytes = std::string{};
+    auto const curve_offset = append_mapped_object( bytes, MappedCurve{ {1., 2., 3., 4.}, 42 } );
+    bytes.resize(bytes.size() + 64, 'x');
+    auto const file = RegionFile{ "solo_any_handle_mapped_region_testsuite.bin", bytes };
+    auto const region = make_mapped_region(file.path);
+
+    BOOST_CHECK_THROW( make_mapped_any_handle<MappedBlock>(region, curve_offset), region_error );// bad type
+    BOOST_CHECK_THROW( make_mapped_any_handle<MappedCurve>(region, curve_offset + 8), region_error );// no header
+    BOOST_CHECK_THROW( make_mapped_any_handle<MappedCurve>(region, curve_offset + 1), region_error );// misaligned
+    BOOST_CHECK_THROW( make_mapped_any_handle<MappedCurve>(region, bytes.size()), region_error );// out of the region
+    BOOST_CHECK_THROW( make_mapped_region("solo_any_handle_mapped_region_testsuite.missing"), region_error );
+
+    // truncated object :
+    auto const truncated = RegionFile{ "solo_any_handle_mapped_region_testsuite_truncated.bin", bytes.substr(0, curve_offset + sizeof(mapped_object_header) + 8) };
+    auto const truncated_region = make_mapped_region(truncated.path);
+    BOOST_CHECK_THROW( make_mapped_any_handle<MappedCurve>(truncated_region, curve_offset), region_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // MappedRegionTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,293 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include <solo/anys/handles/any_handle_package.hpp>
+#include <solo/anys/handles/registries/registry_package.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using solo::anys::registries::find_cast;
+using solo::anys::registries::find_mutable_cast;
+using solo::anys::registries::persistent_handle_map;
+using solo::anys::registries::persistent_registry;
+
+inline solo::any_handle make_int( int a_value )
+{
+    return solo::make_any_handle<int>(stdex::in_place, a_value);
+}
+
+inline int value_of( solo::any_handle const &a_handle )
+{
+    return *solo::any_handle_cast<int>(a_handle).assume_value();
+}
+
+}// EONS ANONYMOUS
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( PersistentRegistryTests )
+
+BOOST_AUTO_TEST_CASE( PersistentMapTest )
+{
+    auto const empty = persistent_handle_map{};
+    BOOST_TEST( empty.empty() );
+    BOOST_TEST( empty.find("a").empty() );
+
+    auto const v1 = empty.with("a", make_int(1)).with("b", make_int(2));
+    auto const v2 = v1.with("a", make_int(10));
+    auto const v3 = v2.without("b");
+
+    // the previous versions are left untouched
+    BOOST_TEST( empty.size() == 0u );
+    BOOST_TEST( v1.size() == 2u );
+    BOOST_TEST( value_of(v1.find("a")) == 1 );
+    BOOST_TEST( v2.size() == 2u );
+    BOOST_TEST( value_of(v2.find("a")) == 10 );
+    BOOST_TEST( v3.size() == 1u );
+    BOOST_TEST( v3.contains("a") );
+    BOOST_TEST( !v3.contains("b") );
+    BOOST_TEST( v2.contains("b") );
+
+    BOOST_TEST( v3.without("missing").size() == 1u );
+    BOOST_TEST( v3.without("a").empty() );
+
+    auto visited = std::map<std::string, int>{};
+    v2.for_each([&visited]( std::string const &a_key, solo::any_handle const &a_handle ) { visited[a_key] = value_of(a_handle); });
+    BOOST_TEST( ( visited == std::map<std::string, int>{ { "a", 10 }, { "b", 2 } } ) );
+
+    BOOST_TEST( *find_cast<int>(v2, "b").assume_value() == 2 );
+    BOOST_TEST( !find_cast<int>(v2, "c").has_value() );
+    BOOST_TEST( !find_cast<double>(v2, "b").has_value() );
+    BOOST_TEST( !find_mutable_cast<int>(v2, "b").has_value() );
+
+    auto const m = v3.with("m", solo::make_any_handle_mutable<int>(stdex::in_place, 7));
+    BOOST_TEST( ( *find_mutable_cast<int>(m, "m").assume_value() = 8 ) == 8 );
+    BOOST_TEST( *find_cast<int>(m, "m").assume_value() == 8 );
+}
+
+BOOST_AUTO_TEST_CASE( LargePersistentMapTest )
+{
+    auto map = persistent_handle_map{};
+    for ( auto n = 0; n < 10000; ++n )
+    {
+        map = map.with(std::to_string(n), make_int(n));
+    }
+    auto const full = map;
+    for ( auto n = 0; n < 10000; n += 2 )
+    {
+        map = map.without(std::to_string(n));
+    }
+    BOOST_TEST( full.size() == 10000u );
+    BOOST_TEST( map.size() == 5000u );
+
+    auto failures = 0;
+    for ( auto n = 0; n < 10000; ++n )
+    {
+        auto const key = std::to_string(n);
+        failures += ( !full.contains(key) || value_of(full.find(key)) != n ) ? 1 : 0;
+        failures += map.contains(key) != ( n % 2 == 1 ) ? 1 : 0;
+    }
+    BOOST_TEST( failures == 0 );
+
+    auto count = std::size_t{0};
+    map.for_each([&count]( std::string const &, solo::any_handle const & ) { ++count; });
+    BOOST_TEST( count == 5000u );
+
+    for ( auto n = 1; n < 10000; n += 2 )
+    {
+        map = map.without(std::to_string(n));
+    }
+    BOOST_TEST( map.empty() );
+    BOOST_TEST( full.size() == 10000u );
+}
+
+BOOST_AUTO_TEST_CASE( HashCollisionTest )
+{
+    namespace detail = solo::anys::registries::detail;
+    auto const hash = std::size_t{ 0x2Au };
+    auto root = detail::hamt::node_ptr{ std::make_shared<detail::hamt_node>() };
+    auto added = false;
+    for ( auto n = 0; n < 3; ++n )
+    {
+        added = false;
+        root = detail::hamt::insert(*root, 0, detail::hamt_leaf{ hash, "key" + std::to_string(n), make_int(n) }, added);
+        BOOST_TEST( added );
+    }
+    added = false;
+    root = detail::hamt::insert(*root, 0, detail::hamt_leaf{ hash, "key1", make_int(10) }, added);
+    BOOST_TEST( !added );
+    for ( auto n = 0; n < 3; ++n )
+    {
+        auto const *const found = detail::hamt::find(root.get(), hash, "key" + std::to_string(n));
+        BOOST_REQUIRE( found != nullptr );
+        BOOST_TEST( value_of(*found) == ( n == 1 ? 10 : n ) );
+    }
+    BOOST_TEST( detail::hamt::find(root.get(), hash, "key3") == nullptr );
+
+    auto erased = false;
+    root = detail::hamt::erase(*root, 0, hash, "key0", erased);
+    BOOST_TEST( erased );
+    erased = false;
+    root = detail::hamt::erase(*root, 0, hash, "key2", erased);
+    BOOST_TEST( erased );
+    // the last leaf is pulled up to the root
+    BOOST_REQUIRE( root );
+    BOOST_TEST( root->child_map == 0u );
+    BOOST_TEST( root->leaves.size() == 1u );
+    BOOST_TEST( value_of(*detail::hamt::find(root.get(), hash, "key1")) == 10 );
+}
+
+BOOST_AUTO_TEST_CASE( PersistentRegistryTest )
+{
+    persistent_registry registry;
+    BOOST_TEST( registry.size() == 0u );
+    BOOST_TEST( registry.find("a").empty() );
+
+    registry.publish("a", make_int(1));
+    auto const before = registry.snapshot();
+    registry.publish("b", make_int(2));
+    registry.publish("a", make_int(3));
+
+    BOOST_TEST( registry.size() == 2u );
+    BOOST_TEST( *find_cast<int>(registry, "a").assume_value() == 3 );
+    BOOST_TEST( !find_mutable_cast<int>(registry, "a").has_value() );
+    BOOST_TEST( before.size() == 1u );
+    BOOST_TEST( value_of(before.find("a")) == 1 );
+
+    BOOST_TEST( registry.unpublish("a") );
+    BOOST_TEST( !registry.unpublish("a") );
+    BOOST_TEST( registry.size() == 1u );
+
+    // a batch, visible all at once
+    registry.update([]( persistent_handle_map const &a_current ) {
+        return a_current.without("b").with("c", make_int(4)).with("d", make_int(5));
+    });
+    auto const after = registry.snapshot();
+    BOOST_TEST( after.size() == 2u );
+    BOOST_TEST( !after.contains("b") );
+    BOOST_TEST( value_of(after.find("d")) == 5 );
+
+    // more versions than slots, some kept by snapshots
+    auto snapshots = std::vector<persistent_handle_map>{};
+    for ( auto n = 0; n < 200; ++n )
+    {
+        registry.publish("n", make_int(n));
+        if ( n % 10 == 0 )
+        {
+            snapshots.push_back(registry.snapshot());
+        }
+    }
+    BOOST_TEST( value_of(registry.find("n")) == 199 );
+    BOOST_TEST( value_of(snapshots[3].find("n")) == 30 );
+}
+
+BOOST_AUTO_TEST_CASE( ConcurrentPersistentRegistryTest )
+{
+    persistent_registry registry;
+    std::atomic<bool> done{false};
+    std::atomic<bool> torn{false};
+    auto readers = std::vector<std::thread>{};
+    for ( auto t = 0; t < 3; ++t )
+    {
+        readers.emplace_back([&] {
+            while ( !done )
+            {
+                // a writer publishes "x" and "y" together : a snapshot holds both or none, with the same value
+                auto const snapshot = registry.snapshot();
+                auto const x = snapshot.find("x");
+                auto const y = snapshot.find("y");
+                if ( x.has_value() != y.has_value() || ( x.has_value() && value_of(x) != value_of(y) ) )
+                {
+                    torn = true;
+                }
+                registry.find("x");
+            }
+        });
+    }
+    for ( auto n = 0; n <= 2000; ++n )
+    {
+        registry.update([n]( persistent_handle_map const &a_current ) {
+            return n % 5 == 4 ? a_current.without("x").without("y") : a_current.with("x", make_int(n)).with("y", make_int(n));
+        });
+    }
+    done = true;
+    for ( auto &t : readers )
+    {
+        t.join();
+    }
+    BOOST_TEST( !torn );
+    BOOST_TEST( value_of(registry.find("x")) == 2000 );
+}
+
+BOOST_AUTO_TEST_CASE( AcquisitionCountFoldTest )
+{
+    using access = solo::anys::registries::detail::persistent_registry_access;
+    auto const threshold = std::uint64_t{ access::fold_threshold };
+
+    persistent_registry registry;
+    registry.publish("a", make_int(1));
+    auto const held = registry.snapshot();
+
+    // a registry read for months without a publication : the count is folded, never carried into the slot
+    access::seed_acquisitions(registry, threshold - 2);
+    for ( auto n = 0; n < 10; ++n )
+    {
+        BOOST_TEST( value_of(registry.find("a")) == 1 );
+    }
+    BOOST_TEST( access::acquisitions(registry) < 16u );
+    BOOST_TEST( registry.size() == 1u );
+
+    // folded while other readers run
+    access::seed_acquisitions(registry, threshold - 1000);
+    std::atomic<bool> wrong{false};
+    auto readers = std::vector<std::thread>{};
+    for ( auto t = 0; t < 4; ++t )
+    {
+        readers.emplace_back([&] {
+            for ( auto n = 0; n < 2000; ++n )
+            {
+                auto const snapshot = registry.snapshot();
+                wrong = wrong || value_of(snapshot.find("a")) != 1;
+            }
+        });
+    }
+    for ( auto &t : readers )
+    {
+        t.join();
+    }
+    BOOST_TEST( !wrong );
+    BOOST_TEST( access::acquisitions(registry) < threshold );
+
+    // the versions are still reclaimed by their last reader
+    registry.publish("a", make_int(2));
+    BOOST_TEST( value_of(held.find("a")) == 1 );
+    BOOST_TEST( value_of(registry.find("a")) == 2 );
+    BOOST_TEST( access::acquisitions(registry) == 1u );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // PersistentRegistryTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
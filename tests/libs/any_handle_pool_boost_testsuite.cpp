@@ -0,0 +1,181 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include <solo/anys/handles/any_handle_package.hpp>
+#include <solo/anys/handles/pools/pool_package.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// one type per test : each type has its own slabs
+
+struct Pooled1 { int value; std::string name; };
+struct Pooled2 { int value; };
+struct Pooled3 { int value; };
+struct Pooled4 { long values[4]; };
+
+}// EONS ANONYMOUS
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( PooledHandleTests )
+
+BOOST_AUTO_TEST_CASE( FactoriesTest )
+{
+    using solo::anys::pools::make_pooled_any_handle;
+    using solo::anys::pools::make_pooled_any_handle_mutable;
+    using solo::anys::pools::pooled_statistics;
+
+    BOOST_TEST( pooled_statistics<Pooled1>().block_size == 0u );
+    {
+        auto const c = make_pooled_any_handle<Pooled1>(stdex::in_place, Pooled1{ 1, "one" });
+        auto const m = make_pooled_any_handle_mutable<Pooled1>(stdex::in_place, Pooled1{ 2, "two" });
+        BOOST_TEST( !c.is_mutable() );
+        BOOST_TEST( m.is_mutable() );
+        BOOST_TEST( ( c.type() == typeid(Pooled1) ) );
+        BOOST_TEST( ( c.type_fingerprint() == solo::make_any_type_index<Pooled1>().fingerprint() ) );
+        BOOST_TEST( solo::any_handle_cast<Pooled1>(c).assume_value()->name == "one" );
+        solo::any_handle_mutable_cast<Pooled1>(m).assume_value()->value = 3;
+        BOOST_TEST( solo::any_handle_cast<Pooled1>(m).assume_value()->value == 3 );
+
+        auto const stats = pooled_statistics<Pooled1 const>();
+        BOOST_TEST( stats.block_size >= sizeof(Pooled1) );
+        BOOST_TEST( stats.slab_count == 1u );
+        BOOST_TEST( stats.blocks_in_use == 2u );
+        BOOST_TEST( stats.reserved_blocks * stats.block_size >= 64u * 1024u - stats.block_size );
+        BOOST_TEST( stats.fragmentation() > 0.9 );
+    }
+    BOOST_TEST( pooled_statistics<Pooled1>().blocks_in_use == 0u );
+    BOOST_TEST( pooled_statistics<Pooled1>().fragmentation() == 1.0 );
+
+    // a block released is reused first by its thread
+    auto const *const first = make_pooled_any_handle<Pooled1>(stdex::in_place).get();
+    BOOST_TEST( make_pooled_any_handle<Pooled1>(stdex::in_place).get() == first );
+}
+
+BOOST_AUTO_TEST_CASE( ManyBlocksTest )
+{
+    using solo::anys::pools::make_pooled_any_handle_mutable;
+    using solo::anys::pools::pooled_statistics;
+
+    // more blocks than a slab : the blocks are distinct, aligned, and all come back
+    auto handles = std::vector<solo::any_handle>{};
+    auto addresses = std::set<void const*>{};
+    for ( auto n = 0; n < 10000; ++n )
+    {
+        handles.push_back(make_pooled_any_handle_mutable<Pooled4>(stdex::in_place, Pooled4{ { n, n, n, n } }));
+        addresses.insert(handles.back().get());
+        BOOST_TEST( reinterpret_cast<std::uintptr_t>(handles.back().get()) % alignof(Pooled4) == 0u );
+    }
+    BOOST_TEST( addresses.size() == handles.size() );
+    BOOST_TEST( solo::any_handle_cast<Pooled4>(handles[1234]).assume_value()->values[3] == 1234 );
+    auto const stats = pooled_statistics<Pooled4>();
+    BOOST_TEST( stats.slab_count > 1u );
+    BOOST_TEST( stats.blocks_in_use == 10000u );
+
+    handles.clear();
+    BOOST_TEST( pooled_statistics<Pooled4>().blocks_in_use == 0u );
+    for ( auto n = 0; n < 10000; ++n )
+    {
+        handles.push_back(make_pooled_any_handle_mutable<Pooled4>(stdex::in_place));
+    }
+    BOOST_TEST( pooled_statistics<Pooled4>().slab_count == stats.slab_count );// no new slab
+}
+
+BOOST_AUTO_TEST_CASE( CrossThreadReleaseTest )
+{
+    using solo::anys::pools::make_pooled_any_handle;
+    using solo::anys::pools::pooled_statistics;
+
+    // allocated by threads which exit, released by this one
+    auto handles = std::vector<std::vector<solo::any_handle>>(4);
+    auto threads = std::vector<std::thread>{};
+    for ( auto t = 0u; t < handles.size(); ++t )
+    {
+        threads.emplace_back([&handles, t] {
+            for ( auto n = 0; n < 1000; ++n )
+            {
+                handles[t].push_back(make_pooled_any_handle<Pooled2>(stdex::in_place, Pooled2{ n }));
+                if ( n % 3 == 0 )
+                {
+                    handles[t].pop_back();// churn
+                }
+            }
+        });
+    }
+    for ( auto &t : threads )
+    {
+        t.join();
+    }
+    BOOST_TEST( pooled_statistics<Pooled2>().blocks_in_use == 4u * 666u );
+    handles.clear();
+    BOOST_TEST( pooled_statistics<Pooled2>().blocks_in_use == 0u );
+
+    // released concurrently by other threads than their allocator
+    auto shared = std::vector<solo::any_handle>{};
+    for ( auto n = 0; n < 4000; ++n )
+    {
+        shared.push_back(make_pooled_any_handle<Pooled3>(stdex::in_place, Pooled3{ n }));
+    }
+    threads.clear();
+    for ( auto t = 0; t < 4; ++t )
+    {
+        threads.emplace_back([&shared, t] {
+            for ( auto n = t; n < 4000; n += 4 )
+            {
+                shared[static_cast<std::size_t>(n)] = make_pooled_any_handle<Pooled3>(stdex::in_place, Pooled3{ -n });
+                shared[static_cast<std::size_t>(n)] = solo::any_handle{};
+            }
+        });
+    }
+    // the snapshots racing with the releases stay in range (a release may be counted before its allocation)
+    auto out_of_range = 0;
+    for ( auto n = 0; n < 1000; ++n )
+    {
+        auto const stats = pooled_statistics<Pooled3>();
+        out_of_range += ( stats.blocks_in_use > stats.reserved_blocks || stats.fragmentation() < 0.0 || stats.fragmentation() > 1.0 ) ? 1 : 0;
+    }
+    BOOST_TEST( out_of_range == 0 );
+    for ( auto &t : threads )
+    {
+        t.join();
+    }
+    BOOST_TEST( pooled_statistics<Pooled3>().blocks_in_use == 0u );
+}
+
+BOOST_AUTO_TEST_CASE( FallbackTest )
+{
+    using solo::anys::allocators::slab_allocator;
+
+    // arrays are not pooled
+    auto const before = slab_allocator<Pooled3>::statistics().fallback_allocations;
+    auto v = std::vector<Pooled3, slab_allocator<Pooled3>>{};
+    v.resize(100);
+    BOOST_TEST( slab_allocator<Pooled3>::statistics().fallback_allocations > before );
+    BOOST_TEST( ( slab_allocator<Pooled3>{} == slab_allocator<int, Pooled3>{} ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // PooledHandleTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,196 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include <solo/anys/handles/any_handle_package.hpp>
+#include <solo/anys/handles/queues/queue_package.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// @brief Return the value of the given handle of an int.
+int queued_value( solo::any_handle const &a_handle )
+{
+    return *solo::any_handle_cast_or_throw<int>(a_handle);
+}
+
+/// @brief Check the single-threaded behaviour of a queue of the given capacity.
+template < typename Queue >
+void check_queue_sequence()
+{
+    Queue queue{ 3 };
+    BOOST_TEST( queue.capacity() == 4u );
+    BOOST_TEST( queue.size_approx() == 0u );
+
+    auto popped = solo::any_handle{};
+    BOOST_TEST( !queue.try_pop(popped) );
+
+    auto const first = solo::make_any_handle<int>(stdex::in_place, 1);
+    auto h = first;
+    BOOST_TEST( first.use_count() == 2 );
+    BOOST_TEST( queue.try_push(std::move(h)) );
+    BOOST_TEST( h.get() == nullptr );// moved in
+    BOOST_TEST( first.use_count() == 2 );// no reference count traffic
+
+    auto batch = std::vector<solo::any_handle>{};
+    for ( auto i = 2; i <= 5; ++i )
+    {
+        batch.push_back( solo::make_any_handle<int>(stdex::in_place, i) );
+    }
+    BOOST_TEST( queue.try_push_n(batch.data(), batch.size()) == 3u );// as many as free slots
+    BOOST_TEST( queue.size_approx() == 4u );
+    BOOST_TEST( batch[3].get() != nullptr );// not pushed
+    BOOST_TEST( !queue.try_push(std::move(batch[3])) );// full
+    BOOST_TEST( batch[3].get() != nullptr );// left unchanged
+
+    BOOST_TEST( queue.try_pop(popped) );
+    BOOST_TEST( popped.get() == first.get() );
+    BOOST_TEST( first.use_count() == 2 );
+
+    auto out = std::vector<solo::any_handle>(8);
+    BOOST_TEST( queue.try_pop_n(out.data(), 2) == 2u );
+    BOOST_TEST( queued_value(out[0]) == 2 );
+    BOOST_TEST( queued_value(out[1]) == 3 );
+    BOOST_TEST( queue.try_push(std::move(batch[3])) );
+    BOOST_TEST( queue.try_pop_n(out.data(), out.size()) == 2u );// wraps around the ring
+    BOOST_TEST( queued_value(out[0]) == 4 );
+    BOOST_TEST( queued_value(out[1]) == 5 );
+    BOOST_TEST( queue.try_pop_n(out.data(), out.size()) == 0u );
+    BOOST_TEST( queue.try_push_n(out.data(), 0) == 0u );
+}
+
+/// @brief Transfer the given number of handles from each producer to the consumers, and check that each one is received once.
+template < typename Queue >
+void check_queue_transfer( int a_producer_count, int a_consumer_count, std::size_t a_batch_size )
+{
+    constexpr auto handle_count = 20000;
+
+    Queue queue{ 64 };
+    std::atomic<std::int64_t> received_sum{ 0 };
+    std::atomic<int> received_count{ 0 };
+    auto const total_count = a_producer_count * handle_count;
+    auto const shared = solo::make_any_handle<int>(stdex::in_place, 0);
+
+    auto threads = std::vector<std::thread>{};
+    for ( auto p = 0; p < a_producer_count; ++p )
+    {
+        threads.emplace_back( [&, p]
+        {
+            auto batch = std::vector<solo::any_handle>{};
+            for ( auto i = 0; i < handle_count; ++i )
+            {
+                batch.push_back( i % 100 == 0 ? shared : solo::make_any_handle<int>(stdex::in_place, p * handle_count + i) );
+                if ( batch.size() == a_batch_size || i + 1 == handle_count )
+                {
+                    auto pushed = std::size_t{0};
+                    while ( pushed != batch.size() )
+                    {
+                        auto const n = a_batch_size == 1
+                            ? std::size_t{ queue.try_push(std::move(batch[pushed])) }
+                            : queue.try_push_n(batch.data() + pushed, batch.size() - pushed);
+                        pushed += n;
+                        if ( n == 0 ) { std::this_thread::yield(); }
+                    }
+                    batch.clear();
+                }
+            }
+        } );
+    }
+    for ( auto c = 0; c < a_consumer_count; ++c )
+    {
+        threads.emplace_back( [&]
+        {
+            auto out = std::vector<solo::any_handle>(a_batch_size);
+            while ( received_count.load() < total_count )
+            {
+                auto const n = queue.try_pop_n(out.data(), out.size());
+                for ( auto i = std::size_t{0}; i < n; ++i )
+                {
+                    received_sum += queued_value(out[i]);
+                    out[i] = solo::any_handle{};
+                }
+                received_count += static_cast<int>(n);
+                if ( n == 0 ) { std::this_thread::yield(); }
+            }
+        } );
+    }
+    for ( auto &t : threads )
+    {
+        t.join();
+    }
+
+    auto expected_sum = std::int64_t{0};
+    for ( auto v = 0; v < total_count; ++v )
+    {
+        expected_sum += v % 100 == 0 ? 0 : v;// handle_count is a multiple of 100
+    }
+    BOOST_TEST( received_count.load() == total_count );
+    BOOST_TEST( received_sum.load() == expected_sum );
+    BOOST_TEST( queue.size_approx() == 0u );
+    BOOST_TEST( shared.use_count() == 1 );// all the transferred copies are released
+}
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( AnyHandleQueueTests )
+
+BOOST_AUTO_TEST_CASE( MpmcQueueSequenceTest )
+{
+    check_queue_sequence<solo::anys::queues::any_handle_mpmc_queue>();
+}
+
+BOOST_AUTO_TEST_CASE( SpscQueueSequenceTest )
+{
+    check_queue_sequence<solo::anys::queues::any_handle_spsc_queue>();
+}
+
+BOOST_AUTO_TEST_CASE( MpmcQueueTransferTest )
+{
+    check_queue_transfer<solo::anys::queues::any_handle_mpmc_queue>(4, 4, 1);
+    check_queue_transfer<solo::anys::queues::any_handle_mpmc_queue>(4, 3, 16);
+}
+
+BOOST_AUTO_TEST_CASE( SpscQueueTransferTest )
+{
+    check_queue_transfer<solo::anys::queues::any_handle_spsc_queue>(1, 1, 1);
+    check_queue_transfer<solo::anys::queues::any_handle_spsc_queue>(1, 1, 16);
+}
+
+BOOST_AUTO_TEST_CASE( QueueDestructionReleasesTheHandlesTest )
+{
+    auto const h = solo::make_any_handle<int>(stdex::in_place, 7);
+    {
+        solo::anys::queues::any_handle_mpmc_queue queue{ 8 };
+        auto copy = h;
+        BOOST_TEST( queue.try_push(std::move(copy)) );
+        BOOST_TEST( h.use_count() == 2 );
+    }
+    BOOST_TEST( h.use_count() == 1 );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // AnyHandleQueueTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
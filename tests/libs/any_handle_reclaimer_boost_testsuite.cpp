@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include <solo/anys/handles/any_handle_package.hpp>
+#include <solo/anys/handles/reclaimers/reclaimer_package.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests { namespace reclaimers {
+////////////////////////////////////////////////////////////////////////////////
+
+/// @brief An object recording the thread destroying it.
+struct Recorded
+{
+    explicit Recorded( std::thread::id *a_destroyer ) : destroyer{ a_destroyer } {}
+    ~Recorded() { *destroyer = std::this_thread::get_id(); }
+
+    std::thread::id *destroyer;
+};
+
+/// @brief The same, destroyed inline (see the policy below).
+struct InlineRecorded : Recorded
+{
+    using Recorded::Recorded;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::TESTS::RECLAIMERS
+////////////////////////////////////////////////////////////////////////////////
+
+SOLO_ANY_HANDLE_RECLAIM_POLICY(solo::tests::reclaimers::InlineRecorded, inline_)
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( ReclaimerTests )
+
+BOOST_AUTO_TEST_CASE( DeferredReleaseTest )
+{
+    using namespace solo::anys::reclaimers;
+    using solo::tests::reclaimers::Recorded;
+
+    auto const options = reclaimer_options{ 64, std::chrono::milliseconds{ 1000 } };
+    reclaimer r{ options };
+    auto destroyer = std::thread::id{};
+
+    auto h = make_any_handle_deferred<Recorded>(r, stdex::in_place, &destroyer);
+    BOOST_TEST( solo::any_handle_cast<Recorded>(h).has_value() );
+    BOOST_TEST( !h.is_mutable() );
+    auto const copy = h;
+    h = solo::any_handle{};
+    BOOST_TEST( r.deferred_count() == 0u );// not the last handle
+
+    auto m = make_any_handle_mutable_deferred<Recorded>(r, stdex::in_place, &destroyer);
+    BOOST_TEST( solo::any_handle_mutable_cast<Recorded>(m).has_value() );
+    m = solo::any_handle{};
+    BOOST_TEST( r.deferred_count() == 1u );
+    BOOST_TEST( ( destroyer == std::thread::id{} ) );// pending (the batch is not full, the delay is long)
+
+    r.drain();
+    BOOST_TEST( r.reclaimed_count() == 1u );
+    BOOST_TEST( ( destroyer != std::thread::id{} ) );
+    BOOST_TEST( ( destroyer != std::this_thread::get_id() ) );
+}
+
+BOOST_AUTO_TEST_CASE( InlinePolicyTest )
+{
+    using namespace solo::anys::reclaimers;
+    using solo::tests::reclaimers::InlineRecorded;
+
+    reclaimer r{};
+    auto destroyer = std::thread::id{};
+    auto h = make_any_handle_deferred<InlineRecorded>(r, stdex::in_place, &destroyer);
+    h = solo::any_handle{};
+    BOOST_TEST( ( destroyer == std::this_thread::get_id() ) );
+    BOOST_TEST( r.deferred_count() == 0u );
+}
+
+BOOST_AUTO_TEST_CASE( BatchWakesTheReclaimerUpTest )
+{
+    using namespace solo::anys::reclaimers;
+
+    auto const options = reclaimer_options{ 8, std::chrono::milliseconds{ 60000 } };
+    reclaimer r{ options };
+    for ( auto i = 0; i < 8; ++i )
+    {
+        make_any_handle_deferred<int>(r, stdex::in_place, i);// released at once
+    }
+    BOOST_TEST( r.deferred_count() == 8u );
+    for ( auto i = 0; i < 1000 && r.reclaimed_count() != 8u; ++i )// without drain : woken up by the full batch
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 5 });
+    }
+    BOOST_TEST( r.reclaimed_count() == 8u );
+}
+
+BOOST_AUTO_TEST_CASE( FirstReleaseStartsTheDelayTest )
+{
+    using namespace solo::anys::reclaimers;
+
+    auto const options = reclaimer_options{ 64, std::chrono::milliseconds{ 20 } };
+    reclaimer r{ options };
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 50 });// idle : the background thread sleeps without a timer
+    make_any_handle_deferred<int>(r, stdex::in_place, 1);// released at once
+    for ( auto i = 0; i < 1000 && r.reclaimed_count() != 1u; ++i )// without drain : woken up by the first release, then the delay
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 5 });
+    }
+    BOOST_TEST( r.reclaimed_count() == 1u );
+}
+
+BOOST_AUTO_TEST_CASE( WrapperDeleterAndShutdownTest )
+{
+    using namespace solo::anys::reclaimers;
+    using solo::tests::reclaimers::Recorded;
+
+    auto destroyer = std::thread::id{};
+    auto late_destroyer = std::thread::id{};
+    auto late = solo::any_handle{};
+    {
+        reclaimer r{};
+        auto h = solo::make_any_handle( make_deferred_shared(r, std::make_shared<Recorded const>(&destroyer)) );
+        late = solo::make_any_handle( make_deferred_shared(r, std::make_shared<Recorded const>(&late_destroyer)) );
+        h = solo::any_handle{};
+    }// the reclaimer is drained
+    BOOST_TEST( ( destroyer != std::thread::id{} ) );
+    BOOST_TEST( ( destroyer != std::this_thread::get_id() ) );
+
+    late = solo::any_handle{};// released after the reclaimer : inline
+    BOOST_TEST( ( late_destroyer == std::this_thread::get_id() ) );
+
+    reclaimer r{};
+    BOOST_TEST( !make_deferred_shared(r, std::shared_ptr<int>{}) );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // ReclaimerTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,182 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include <solo/anys/handles/any_handle_package.hpp>
+#include <solo/anys/handles/pools/pool_package.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using solo::anys::pools::make_recycled_any_handle;
+using solo::anys::pools::make_recycled_any_handle_mutable;
+using solo::anys::pools::recycling_pool;
+
+/// @brief A buffer counting its constructions and destructions.
+struct Buffer
+{
+    explicit Buffer( std::atomic<int> &a_built, std::atomic<int> &a_destroyed, std::size_t a_size = 16 )
+        : destroyed{ &a_destroyed }
+        , bytes( a_size )
+    {
+        ++a_built;
+    }
+
+    ~Buffer()
+    {
+        ++*destroyed;
+    }
+
+    std::atomic<int> *destroyed;
+    std::vector<char> bytes;
+    int uses = 0;
+};
+
+}// EONS ANONYMOUS
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( RecyclingPoolTests )
+
+BOOST_AUTO_TEST_CASE( RecycleTest )
+{
+    std::atomic<int> built{0};
+    std::atomic<int> destroyed{0};
+    auto resets = 0;
+    recycling_pool<Buffer> pool{ 4, [&resets]( Buffer &b ) { ++resets; b.uses = 0; } };
+
+    auto m = make_recycled_any_handle_mutable(pool, stdex::in_place, built, destroyed, 1024);
+    BOOST_TEST( m.is_mutable() );
+    BOOST_TEST( ( m.type() == typeid(Buffer) ) );
+    BOOST_TEST( ( m.type_fingerprint() == solo::make_any_type_index<Buffer>(solo::mutability::true_).fingerprint() ) );
+    auto const object = m.get();
+    solo::any_handle_mutable_cast<Buffer>(m).assume_value()->uses = 5;
+    auto copy = m;
+    m = solo::any_handle{};
+    BOOST_TEST( resets == 0 );// still owned by the copy
+
+    // the object is reset and pooled, not destroyed
+    copy = solo::any_handle{};
+    BOOST_TEST( resets == 1 );
+    BOOST_TEST( destroyed == 0 );
+    BOOST_TEST( pool.statistics().pooled == 1u );
+
+    // then taken back, by a non-mutable handle : the constructor arguments are ignored
+    auto const c = make_recycled_any_handle(pool, stdex::in_place, built, destroyed, 1);
+    BOOST_TEST( !c.is_mutable() );
+    BOOST_TEST( c.get() == object );
+    BOOST_TEST( built == 1 );
+    BOOST_TEST( solo::any_handle_cast<Buffer>(c).assume_value()->bytes.size() == 1024u );
+    BOOST_TEST( solo::any_handle_cast<Buffer>(c).assume_value()->uses == 0 );
+    BOOST_TEST( !solo::any_handle_mutable_cast<Buffer>(c).has_value() );
+
+    auto const stats = pool.statistics();
+    BOOST_TEST( stats.hits == 1u );
+    BOOST_TEST( stats.misses == 1u );
+    BOOST_TEST( stats.recycled == 1u );
+    BOOST_TEST( stats.pooled == 0u );
+    BOOST_TEST( stats.hit_rate() == 0.5 );
+}
+
+BOOST_AUTO_TEST_CASE( CapacityTest )
+{
+    std::atomic<int> built{0};
+    std::atomic<int> destroyed{0};
+    {
+        recycling_pool<Buffer> pool{ 2 };
+        BOOST_TEST( pool.capacity() == 2u );
+        {
+            auto handles = std::vector<solo::any_handle>{};
+            for ( auto n = 0; n < 3; ++n )
+            {
+                handles.push_back(make_recycled_any_handle_mutable(pool, stdex::in_place, built, destroyed));
+            }
+        }
+        BOOST_TEST( destroyed == 1 );
+        BOOST_TEST( pool.statistics().pooled == 2u );
+        BOOST_TEST( pool.statistics().discarded == 1u );
+
+        pool.trim(1);
+        BOOST_TEST( destroyed == 2 );
+        BOOST_TEST( pool.statistics().pooled == 1u );
+    }
+    BOOST_TEST( destroyed == 3 );
+    BOOST_TEST( built == 3 );
+}
+
+BOOST_AUTO_TEST_CASE( FailedResetAndClosedPoolTest )
+{
+    std::atomic<int> built{0};
+    std::atomic<int> destroyed{0};
+    auto held = solo::any_handle{};
+    {
+        recycling_pool<Buffer> pool{ 8, []( Buffer &b ) { if ( b.uses != 0 ) { throw std::runtime_error{ "dirty" }; } } };
+        auto h = make_recycled_any_handle_mutable(pool, stdex::in_place, built, destroyed);
+        solo::any_handle_mutable_cast<Buffer>(h).assume_value()->uses = 1;
+        h = solo::any_handle{};
+        BOOST_TEST( destroyed == 1 );
+        BOOST_TEST( pool.statistics().discarded == 1u );
+
+        held = make_recycled_any_handle(pool, stdex::in_place, built, destroyed);
+    }
+    // the pool is destroyed : the object is deleted on release
+    BOOST_TEST( destroyed == 1 );
+    held = solo::any_handle{};
+    BOOST_TEST( destroyed == 2 );
+}
+
+BOOST_AUTO_TEST_CASE( ConcurrentRecycleTest )
+{
+    std::atomic<int> built{0};
+    std::atomic<int> destroyed{0};
+    std::atomic<bool> shared{false};
+    recycling_pool<Buffer> pool{ 8, []( Buffer &b ) { b.uses = 0; } };
+    auto threads = std::vector<std::thread>{};
+    for ( auto t = 0; t < 4; ++t )
+    {
+        threads.emplace_back([&] {
+            for ( auto n = 0; n < 1000; ++n )
+            {
+                auto h = make_recycled_any_handle_mutable(pool, stdex::in_place, built, destroyed);
+                auto const b = solo::any_handle_mutable_cast<Buffer>(h).assume_value();
+                if ( ++b->uses != 1 )
+                {
+                    shared = true;// by two handles
+                }
+            }
+        });
+    }
+    for ( auto &t : threads )
+    {
+        t.join();
+    }
+    BOOST_TEST( !shared );
+    auto const stats = pool.statistics();
+    BOOST_TEST( stats.hits + stats.misses == 4000u );
+    BOOST_TEST( stats.misses == static_cast<std::size_t>(built.load()) );
+    BOOST_TEST( built <= 4 );// never more objects than handles alive
+    BOOST_TEST( stats.pooled == static_cast<std::size_t>(built - destroyed) );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // RecyclingPoolTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,175 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include <solo/anys/handles/any_handle_package.hpp>
+#include <solo/anys/handles/registries/registry_package.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// @brief A waiter recording its notifications.
+struct RecordingWaiter final : solo::anys::registries::detail::registry_waiter
+{
+    using registry_waiter::registry_waiter;
+
+    void on_available( solo::any_handle a_handle ) noexcept override
+    {
+        handle = a_handle;
+        ++notifications;
+    }
+
+    solo::any_handle handle{};
+    int notifications{0};
+};
+
+/// @brief A waiter running a callback on its notification.
+struct CallbackWaiter final : solo::anys::registries::detail::registry_waiter
+{
+    CallbackWaiter( std::function<void()> a_callback )
+        : registry_waiter{ solo::anys::detail::any_cast_target<int>(), solo::mutability::false_ }
+        , callback{ std::move(a_callback) }
+    {}
+
+    void on_available( solo::any_handle ) noexcept override
+    {
+        ++notifications;
+        callback();
+    }
+
+    std::function<void()> callback;
+    std::atomic<int> notifications{0};
+};
+
+}// EONS ANONYMOUS
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( RegistryTests )
+
+BOOST_AUTO_TEST_CASE( PublishFindUnpublishTest )
+{
+    solo::anys::registries::any_handle_registry registry{};
+    BOOST_TEST( registry.find("a").empty() );
+
+    registry.publish("a", solo::make_any_handle<int>(stdex::in_place, 1));
+    registry.publish("b", solo::make_any_handle<std::string>(stdex::in_place, "b"));
+    BOOST_TEST( registry.size() == 2u );
+    BOOST_TEST( *solo::any_handle_cast<int>(registry.find("a")).assume_value() == 1 );
+
+    registry.publish("a", solo::make_any_handle<int>(stdex::in_place, 2));// replaced
+    BOOST_TEST( *solo::any_handle_cast<int>(registry.find("a")).assume_value() == 2 );
+
+    BOOST_TEST( registry.unpublish("a") );
+    BOOST_TEST( !registry.unpublish("a") );
+    BOOST_TEST( registry.find("a").empty() );
+    BOOST_TEST( registry.size() == 1u );
+}
+
+BOOST_AUTO_TEST_CASE( WaitTest )
+{
+    solo::anys::registries::any_handle_registry registry{};
+    auto handle = solo::any_handle{};
+
+    // already published : completes at once
+    registry.publish("ready", solo::make_any_handle<int>(stdex::in_place, 1));
+    RecordingWaiter ready{ solo::anys::detail::any_cast_target<int>(), solo::mutability::false_ };
+    BOOST_TEST( !registry.wait("ready", ready, handle) );
+    BOOST_TEST( *solo::any_handle_cast<int>(handle).assume_value() == 1 );
+    BOOST_TEST( ready.notifications == 0 );
+
+    // the wrong type, then the wrong mutability, then the awaited handle
+    RecordingWaiter waiter{ solo::anys::detail::any_cast_target<int>(), solo::mutability::true_ };
+    BOOST_TEST( registry.wait("late", waiter, handle) );
+    BOOST_TEST( registry.waiter_count() == 1u );
+    registry.publish("late", solo::make_any_handle<long>(stdex::in_place, 2));
+    registry.publish("late", solo::make_any_handle<int>(stdex::in_place, 3));
+    BOOST_TEST( waiter.notifications == 0 );
+    registry.publish("late", solo::make_any_handle_mutable<int>(stdex::in_place, 4));
+    BOOST_TEST( waiter.notifications == 1 );
+    BOOST_TEST( *solo::any_handle_mutable_cast<int>(waiter.handle).assume_value() == 4 );
+    BOOST_TEST( registry.waiter_count() == 0u );
+
+    // cancelled
+    RecordingWaiter cancelled{ solo::anys::detail::any_cast_target<int>(), solo::mutability::false_ };
+    BOOST_TEST( registry.wait("never", cancelled, handle) );
+    registry.cancel("never", cancelled);
+    registry.publish("never", solo::make_any_handle<int>(stdex::in_place, 5));
+    BOOST_TEST( cancelled.notifications == 0 );
+}
+
+BOOST_AUTO_TEST_CASE( CloseTest )
+{
+    auto handle = solo::any_handle{};
+    RecordingWaiter waiter{ solo::anys::detail::any_cast_target<int>(), solo::mutability::false_ };
+    {
+        solo::anys::registries::any_handle_registry registry{};
+        BOOST_TEST( registry.wait("a", waiter, handle) );
+    }// closed by its destructor
+    BOOST_TEST( waiter.notifications == 1 );
+    BOOST_TEST( waiter.handle.empty() );
+
+    solo::anys::registries::any_handle_registry registry{};
+    registry.close();
+    handle = solo::make_any_handle<int>(stdex::in_place, 1);
+    BOOST_TEST( !registry.wait("a", waiter, handle) );
+    BOOST_TEST( handle.empty() );
+}
+
+BOOST_AUTO_TEST_CASE( CancelDuringPublicationTest )
+{
+    solo::anys::registries::any_handle_registry registry{};
+    auto handle = solo::any_handle{};
+
+    // selected by the publication, cancelled before its notification : skipped
+    CallbackWaiter second{ [] {} };
+    CallbackWaiter first{ [&] { registry.cancel("a", second); } };
+    BOOST_TEST( registry.wait("a", first, handle) );
+    BOOST_TEST( registry.wait("a", second, handle) );
+    registry.publish("a", solo::make_any_handle<int>(stdex::in_place, 1));
+    BOOST_TEST( first.notifications == 1 );
+    BOOST_TEST( second.notifications == 0 );
+
+    // cancelled while notified by another thread : the cancellation waits for the notification
+    std::atomic<bool> entered{false};
+    std::atomic<bool> left{false};
+    CallbackWaiter slow{ [&] {
+        entered = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        left = true;
+    } };
+    BOOST_TEST( registry.wait("b", slow, handle) );
+    auto publisher = std::thread{ [&] { registry.publish("b", solo::make_any_handle<int>(stdex::in_place, 2)); } };
+    while ( !entered )
+    {
+        std::this_thread::yield();
+    }
+    registry.cancel("b", slow);
+    BOOST_TEST( left );
+    publisher.join();
+    BOOST_TEST( slow.notifications == 1 );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // RegistryTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,244 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include <solo/anys/handles/any_handle_package.hpp>
+#include <solo/anys/handles/snapshots/snapshot_package.hpp>
+
+#include <solo/anys/handles/testing/printing/any_handle_boost_test_outputters.hpp>
+#include <stdex/testing/printing/typeindex/std_type_index_boost_test_outputters.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// @brief A trivially copyable resource : restored as a zero-copy view when non-mutable.
+struct SnapshotPoint
+{
+    double x;
+    double y;
+    int id;
+};
+
+/// @brief A resource owning memory : saved and restored by user functions.
+struct SnapshotText
+{
+    std::string value;
+};
+
+solo::anys::snapshots::snapshot_codec_registry make_test_codecs()
+{
+    using namespace solo::anys::snapshots;
+    auto codecs = snapshot_codec_registry{};
+    codecs.add( make_snapshot_codec<SnapshotPoint>() );
+    codecs.add( make_snapshot_codec<SnapshotText>(
+        []( SnapshotText const &a_text, std::string &a_bytes ) { a_bytes += a_text.value; },
+        []( char const *a_data, std::size_t a_size ) { return std::make_shared<SnapshotText>( SnapshotText{ std::string{a_data, a_size} } ); } ) );
+    return codecs;
+}
+
+/// @brief A snapshot file removed at the end of the test.
+struct SnapshotFile
+{
+    std::string path{ "solo_any_handle_snapshot_testsuite.snap" };
+    ~SnapshotFile() { std::remove(path.c_str()); }
+};
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( SnapshotTests )
+
+BOOST_AUTO_TEST_CASE( WriteAndRestoreRegistryTest )
+{
+    using namespace solo::anys::snapshots;
+    auto const file = SnapshotFile{};
+    auto const codecs = make_test_codecs();
+
+    auto const shared_point = solo::make_any_handle<SnapshotPoint>(stdex::in_place, SnapshotPoint{1.5, 2.5, 7});
+    auto registry = std::map<std::string, solo::any_handle>{};
+    registry["points/origin"] = shared_point;
+    registry["points/alias"] = shared_point;// same object
+    registry["points/mutable"] = solo::make_any_handle_mutable<SnapshotPoint>(stdex::in_place, SnapshotPoint{3, 4, 8});
+    registry["texts/hello"] = solo::make_any_handle<SnapshotText>(stdex::in_place, SnapshotText{"hello"});
+    registry["texts/null"] = solo::make_any_handle(std::shared_ptr<SnapshotText const>{});
+    registry["empty"] = solo::any_handle{};
+
+    write_snapshot(file.path, registry.begin(), registry.end(), codecs);
+
+    mapped_snapshot const snapshot{ file.path, codecs };
+    BOOST_TEST( snapshot.size() == registry.size() );
+    BOOST_TEST( snapshot.object_count() == 4u );// origin (and alias), mutable, hello, null
+    BOOST_TEST( snapshot.materialized_count() == 0u );// lazy
+
+    // the keys are sorted :
+    auto i = std::size_t{0};
+    for ( auto const &entry : registry )
+    {
+        BOOST_TEST( snapshot.key(i) == entry.first );
+        ++i;
+    }
+
+    // zero-copy view of a non-mutable trivially copyable object :
+    auto const origin = snapshot.find("points/origin");
+    BOOST_TEST( snapshot.materialized_count() == 1u );
+    BOOST_TEST( !origin.is_mutable() );
+    auto const p = solo::any_handle_cast_or_throw<SnapshotPoint>(origin);
+    BOOST_TEST( p->x == 1.5 );
+    BOOST_TEST( p->y == 2.5 );
+    BOOST_TEST( p->id == 7 );
+    BOOST_TEST( snapshot.contains(p.get()) == snapshot.is_memory_mapped() );
+
+    // shared identity :
+    auto const alias = snapshot.find("points/alias");
+    BOOST_TEST( ( alias == origin ) );
+    BOOST_TEST( snapshot.materialized_count() == 1u );
+
+    // mutable objects are restored as mutable copies :
+    auto const m = snapshot.find("points/mutable");
+    BOOST_TEST( m.is_mutable() );
+    BOOST_TEST( !snapshot.contains(m.pointer().get()) );
+    BOOST_TEST( solo::any_handle_mutable_cast_or_throw<SnapshotPoint>(m)->id == 8 );
+
+    // user codec :
+    BOOST_TEST( solo::any_handle_cast_or_throw<SnapshotText>(snapshot.find("texts/hello"))->value == "hello" );
+
+    // typed null and empty handles :
+    auto const null_text = snapshot.find("texts/null");
+    BOOST_TEST( !null_text.empty() );
+    BOOST_TEST( !null_text.has_value() );
+    BOOST_TEST( ( null_text.type() == typeid(SnapshotText) ) );
+    BOOST_TEST( snapshot.find("empty").empty() );
+
+    // missing key :
+    BOOST_TEST( snapshot.find("missing").empty() );
+    BOOST_TEST( snapshot.index_of("missing") == snapshot.size() );
+}
+
+BOOST_AUTO_TEST_CASE( RestoredViewsOutliveTheSnapshotTest )
+{
+    using namespace solo::anys::snapshots;
+    auto const file = SnapshotFile{};
+    auto const codecs = make_test_codecs();
+
+    auto registry = std::map<std::string, solo::any_handle>{};
+    registry["p"] = solo::make_any_handle<SnapshotPoint>(stdex::in_place, SnapshotPoint{1, 2, 3});
+    write_snapshot(file.path, registry.begin(), registry.end(), codecs);
+
+    auto h = solo::any_handle{};
+    {
+        mapped_snapshot const snapshot{ file.path, codecs };
+        h = snapshot.find("p");
+    }
+    BOOST_TEST( solo::any_handle_cast_or_throw<SnapshotPoint>(h)->id == 3 );
+}
+
+BOOST_AUTO_TEST_CASE( ConcurrentAccessesRestoreOnceTest )
+{
+    using namespace solo::anys::snapshots;
+    auto const file = SnapshotFile{};
+    auto const codecs = make_test_codecs();
+
+    auto registry = std::map<std::string, solo::any_handle>{};
+    for ( auto i = 0; i < 64; ++i )
+    {
+        registry["text" + std::to_string(i)] = solo::make_any_handle<SnapshotText>(stdex::in_place, SnapshotText{std::to_string(i)});
+    }
+    write_snapshot(file.path, registry.begin(), registry.end(), codecs);
+
+    mapped_snapshot const snapshot{ file.path, codecs };
+    auto results = std::vector<std::vector<solo::any_handle>>(4);
+    auto threads = std::vector<std::thread>{};
+    for ( auto &result : results )
+    {
+        threads.emplace_back( [&snapshot, &result]
+        {
+            for ( auto i = std::size_t{0}; i < snapshot.size(); ++i )
+            {
+                result.push_back(snapshot.handle(i));
+            }
+        });
+    }
+    for ( auto &t : threads )
+    {
+        t.join();
+    }
+    BOOST_TEST( snapshot.materialized_count() == 64u );
+    for ( auto const &result : results )
+    {
+        BOOST_TEST( ( result == results.front() ) );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( WriteErrorsTest )
+{
+    using namespace solo::anys::snapshots;
+    auto const file = SnapshotFile{};
+
+    auto registry = std::map<std::string, solo::any_handle>{};
+    registry["i"] = solo::make_any_handle<int>(stdex::in_place, 1);
+    BOOST_CHECK_THROW( write_snapshot(file.path, registry.begin(), registry.end(), make_test_codecs()), snapshot_error );
+
+    auto const duplicates = std::vector<std::pair<std::string, solo::any_handle>>{ {"a", solo::any_handle{}}, {"a", solo::any_handle{}} };
+    BOOST_CHECK_THROW( write_snapshot(file.path, duplicates.begin(), duplicates.end(), make_test_codecs()), snapshot_error );
+}
+
+BOOST_AUTO_TEST_CASE( RestoreErrorsTest )
+{
+    using namespace solo::anys::snapshots;
+    auto const file = SnapshotFile{};
+    auto const codecs = make_test_codecs();
+
+    BOOST_CHECK_THROW( mapped_snapshot(file.path, codecs), snapshot_error );// missing file
+
+    {
+        auto os = std::ofstream{ file.path, std::ios::binary };
+        os << "this is not a snapshot file, this is not a snapshot file, this is not a snapshot file, this is not";
+    }
+    BOOST_CHECK_THROW( mapped_snapshot(file.path, codecs), snapshot_error );// bad magic number
+
+    auto registry = std::map<std::string, solo::any_handle>{};
+    registry["p"] = solo::make_any_handle<SnapshotPoint>(stdex::in_place, SnapshotPoint{1, 2, 3});
+    write_snapshot(file.path, registry.begin(), registry.end(), codecs);
+    {
+        mapped_snapshot const snapshot{ file.path, snapshot_codec_registry{} };// no codec
+        BOOST_CHECK_THROW( snapshot.find("p"), snapshot_error );
+        BOOST_TEST( snapshot.materialized_count() == 0u );
+    }
+    {
+        // another version :
+        auto fs = std::fstream{ file.path, std::ios::binary | std::ios::in | std::ios::out };
+        auto const version = std::uint32_t{ snapshot_format_version + 1 };
+        fs.seekp(offsetof(snapshot_file_header, version));
+        fs.write(reinterpret_cast<char const *>(&version), sizeof(version));
+    }
+    BOOST_CHECK_THROW( mapped_snapshot(file.path, codecs), snapshot_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // SnapshotTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,192 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+// this test unit always enables the tracking mode :
+// the factories are only instantiated with types local to this unit.
+#if !defined(SOLO_ANY_HANDLE_ENABLE_TRACKING)
+#define SOLO_ANY_HANDLE_ENABLE_TRACKING 1
+#endif
+
+#include <solo/anys/handles/any_handle_core_package.hpp>
+#include <solo/anys/handles/make_any_handle_ex.hpp>
+#include <solo/anys/handles/make_any_handle_mutable_ex.hpp>
+#include <solo/anys/handles/tracking/live_handle_table.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+struct TrackedBase
+{
+    virtual ~TrackedBase() = default;
+    int data{0};
+};
+
+struct TrackedObject : TrackedBase
+{
+    explicit TrackedObject(int a_ = 0) noexcept { data = a_; }
+    char padding[100]{};
+};
+
+struct TrackedValue
+{
+    double x{0};
+    double y{0};
+};
+
+struct TrackedSharedFromThis : std::enable_shared_from_this<TrackedSharedFromThis>
+{
+    int data{0};
+};
+
+/// @brief Find the live stats of the given type and mutability (null count if not found).
+solo::anys::tracking::live_handle_type_stats find_live_stats( std::type_index const &a_type, bool a_ismutable )
+{
+    auto const snapshot = solo::anys::tracking::live_handle_snapshot();
+    auto it = std::find_if(snapshot.begin(), snapshot.end(), [&](auto const &stats) {
+        return stats.type == a_type && stats.is_mutable == a_ismutable;
+    });
+    if ( it == snapshot.end() )
+    {
+        return { a_type, a_ismutable, 0, 0, {} };
+    }
+    return *it;
+}
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( LiveHandleTrackingTests )
+
+//..............................................................................
+
+BOOST_AUTO_TEST_CASE( TrackInPlaceObjectTest )
+{
+    auto const before = solo::anys::tracking::live_handle_clock::now();
+    {
+        auto ah = solo::make_any_handle<TrackedValue>( stdex::in_place );
+        BOOST_TEST( ah.use_count() == 1 );
+        BOOST_TEST( solo::any_handle_cast<TrackedValue>(ah).has_value() );
+
+        auto const stats = find_live_stats(typeid(TrackedValue), false);
+        BOOST_TEST( stats.count == 1u );
+        BOOST_TEST( stats.bytes == sizeof(TrackedValue) );
+        BOOST_TEST(( stats.oldest_creation_time >= before ));
+
+        // copies share the same tracked object :
+        auto ah_copy = ah;
+        BOOST_TEST( find_live_stats(typeid(TrackedValue), false).count == 1u );
+    }
+    BOOST_TEST( find_live_stats(typeid(TrackedValue), false).count == 0u );
+}
+
+BOOST_AUTO_TEST_CASE( TrackMutableInPlaceTypeObjectTest )
+{
+    {
+        auto ah1 = solo::make_any_handle_mutable<TrackedBase>( stdex::in_place_type<TrackedObject>, 1 );
+        auto ah2 = solo::make_any_handle_mutable<TrackedBase>( stdex::in_place_type<TrackedObject>, 2 );
+        BOOST_TEST( solo::any_handle_mutable_cast<TrackedBase>(ah2).assume_value()->data == 2 );
+
+        // the tracked type is the built type, not the handle type :
+        auto const stats = find_live_stats(typeid(TrackedObject), true);
+        BOOST_TEST( stats.count == 2u );
+        BOOST_TEST( stats.bytes == 2 * sizeof(TrackedObject) );
+        BOOST_TEST( find_live_stats(typeid(TrackedObject), false).count == 0u );
+        BOOST_TEST( find_live_stats(typeid(TrackedBase), true).count == 0u );
+    }
+    BOOST_TEST( find_live_stats(typeid(TrackedObject), true).count == 0u );
+}
+
+BOOST_AUTO_TEST_CASE( TrackSharedFromThisObjectTest )
+{
+    {
+        // the shared pointer owns the object itself : enable_shared_from_this is honoured as without tracking
+        auto ah = solo::make_any_handle_mutable<TrackedSharedFromThis>( stdex::in_place );
+        auto const object = solo::any_handle_mutable_cast<TrackedSharedFromThis>(ah).assume_value();
+        auto const self = object->shared_from_this();
+        BOOST_TEST( self.get() == object.get() );
+        BOOST_TEST( ah.use_count() == 3 );
+
+        auto allocated = solo::make_any_handle<TrackedSharedFromThis>( std::allocator_arg, std::allocator<TrackedSharedFromThis>{} );
+        auto const allocated_object = solo::any_handle_cast<TrackedSharedFromThis>(allocated).assume_value();
+        BOOST_TEST( allocated_object->shared_from_this().get() == allocated_object.get() );
+
+        BOOST_TEST( find_live_stats(typeid(TrackedSharedFromThis), true).count == 1u );
+        BOOST_TEST( find_live_stats(typeid(TrackedSharedFromThis), false).count == 1u );
+        BOOST_TEST( find_live_stats(typeid(TrackedSharedFromThis), false).bytes == sizeof(TrackedSharedFromThis) );
+    }
+    BOOST_TEST( find_live_stats(typeid(TrackedSharedFromThis), true).count == 0u );
+    BOOST_TEST( find_live_stats(typeid(TrackedSharedFromThis), false).count == 0u );
+}
+
+BOOST_AUTO_TEST_CASE( TrackFinalizedObjectTest )
+{
+    auto x = TrackedValue{};
+    auto finalized_count = 0;
+    {
+        auto ah = solo::make_any_handle( &x, [&](TrackedValue *) { ++finalized_count; } );
+        BOOST_TEST( ah.pointer().get() == &x );
+        BOOST_TEST( find_live_stats(typeid(TrackedValue), false).count == 1u );
+
+        auto ah_m = solo::make_any_handle_mutable( &x, [&](TrackedValue *) { ++finalized_count; } );
+        BOOST_TEST( find_live_stats(typeid(TrackedValue), true).count == 1u );
+    }
+    BOOST_TEST( finalized_count == 2 );
+    BOOST_TEST( find_live_stats(typeid(TrackedValue), false).count == 0u );
+    BOOST_TEST( find_live_stats(typeid(TrackedValue), true).count == 0u );
+}
+
+BOOST_AUTO_TEST_CASE( ObserverIsNotTrackedTest )
+{
+    // observed objects are not owned by handles :
+    auto x = TrackedValue{};
+    auto ah = solo::make_any_handle( stdex::make_observer(&x) );
+    BOOST_TEST( find_live_stats(typeid(TrackedValue), false).count == 0u );
+}
+
+BOOST_AUTO_TEST_CASE( ReleaseFromAnotherThreadTest )
+{
+    constexpr auto const object_count = 1000u;
+
+    auto handles = std::vector<solo::any_handle>{};
+    std::thread producer{ [&]() {
+        for ( auto i = 0u; i < object_count; ++i )
+        {
+            handles.push_back( solo::make_any_handle_mutable<TrackedObject>( stdex::in_place, static_cast<int>(i) ) );
+        }
+    } };
+    producer.join();
+    BOOST_TEST( find_live_stats(typeid(TrackedObject), true).count == object_count );
+
+    std::thread consumer{ [&]() { handles.clear(); } };
+    consumer.join();
+    BOOST_TEST( find_live_stats(typeid(TrackedObject), true).count == 0u );
+}
+
+//..............................................................................
+
+BOOST_AUTO_TEST_SUITE_END() // LiveHandleTrackingTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
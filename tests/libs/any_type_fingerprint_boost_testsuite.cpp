@@ -0,0 +1,140 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "any_handle_testsuite_types.hpp"
+
+#include <solo/anys/handles/any_handle_package.hpp>
+#include <solo/anys/handles/regions/region_package.hpp>
+#include <solo/anys/handles/snapshots/snapshot_package.hpp>
+
+#include <solo/anys/handles/testing/printing/any_handle_boost_test_outputters.hpp>
+#include <stdex/testing/printing/typeindex/std_type_index_boost_test_outputters.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests { namespace fingerprints {
+////////////////////////////////////////////////////////////////////////////////
+
+/// @brief A type identified by a user tag.
+struct TaggedObject
+{
+    int value;
+};
+
+namespace {
+
+/// @brief A type with internal linkage : its name may be given to another type in another binary.
+struct HiddenObject
+{
+    int value;
+};
+
+}// EONS ANONYMOUS
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::TESTS::FINGERPRINTS
+////////////////////////////////////////////////////////////////////////////////
+
+SOLO_ANY_TYPE_TAG(solo::tests::fingerprints::TaggedObject, "solo.tests.tagged_object/1")
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( AnyTypeFingerprintTests )
+
+BOOST_AUTO_TEST_CASE( FingerprintIsAHashOfTheTypeNameOrTagTest )
+{
+    using solo::tests::fingerprints::TaggedObject;
+
+    auto const ti = solo::make_any_type_index<TestObject>();
+    BOOST_TEST( ti.fingerprint() == solo::anys::detail::make_any_type_fingerprint(typeid(TestObject).name()) );
+    BOOST_TEST( solo::make_any_type_index<TestObject>(solo::mutability::true_).fingerprint() == ti.fingerprint() );
+    BOOST_TEST( solo::make_any_type_index<TestObject const>().fingerprint() == ti.fingerprint() );
+    BOOST_TEST( solo::make_any_type_index<TestObjectBase>().fingerprint() != ti.fingerprint() );
+
+    auto const tagged = solo::make_any_type_index<TaggedObject>();
+    BOOST_TEST( tagged.fingerprint() == solo::anys::detail::make_any_type_fingerprint("solo.tests.tagged_object/1") );
+    BOOST_TEST( tagged.fingerprint() != solo::anys::detail::make_any_type_fingerprint(typeid(TaggedObject).name()) );
+}
+
+BOOST_AUTO_TEST_CASE( TypesWithInternalLinkageAreDetectedTest )
+{
+    using solo::anys::detail::is_any_type_name_local;
+    struct LocalObject {};
+
+    BOOST_TEST( !is_any_type_name_local(typeid(TestObject).name()) );
+    BOOST_TEST( !is_any_type_name_local(typeid(int).name()) );
+    BOOST_TEST( is_any_type_name_local(typeid(solo::tests::fingerprints::HiddenObject).name()) );
+    BOOST_TEST( is_any_type_name_local(typeid(LocalObject).name()) );
+
+    // the same type still compares equal to itself
+    auto const ti = solo::make_any_type_index<solo::tests::fingerprints::HiddenObject>();
+    BOOST_TEST( ti.equals(solo::make_any_type_index<solo::tests::fingerprints::HiddenObject>()) );
+    BOOST_TEST( !ti.before(solo::make_any_type_index<solo::tests::fingerprints::HiddenObject>()) );
+}
+
+BOOST_AUTO_TEST_CASE( OrderingKeyIsBuiltFromTheFingerprintTest )
+{
+    auto const ti = solo::make_any_type_index<TestObject>(solo::mutability::true_);
+    BOOST_TEST( ( ti.ordering_key() >> 2 ) == ( ti.fingerprint() & ( ~std::uint64_t{0} >> 2 ) ) );
+    BOOST_TEST( ( ti.ordering_key() & 3u ) == 3u );// non-empty, mutable
+}
+
+BOOST_AUTO_TEST_CASE( HandlesOfTaggedTypesAreCastTest )
+{
+    using solo::tests::fingerprints::TaggedObject;
+
+    auto const h = solo::make_any_handle<TaggedObject>(stdex::in_place, TaggedObject{ 5 });
+    BOOST_TEST( h.type_fingerprint() == solo::make_any_type_index<TaggedObject>().fingerprint() );
+    BOOST_TEST( solo::any_handle_cast_or_throw<TaggedObject>(h)->value == 5 );
+    BOOST_TEST( solo::any_handle_cast<TestObject>(h).has_error() );
+    BOOST_CHECK_THROW( solo::any_handle_mutable_cast_or_throw<TaggedObject>(h), solo::anys::exceptions::bad_any_handle_cast );
+    BOOST_TEST( solo::any_handle{}.type_fingerprint() == solo::any_type_index{}.fingerprint() );
+}
+
+BOOST_AUTO_TEST_CASE( FilesIdentifyTheTypesByTheirTagOrNameTest )
+{
+    using solo::tests::fingerprints::TaggedObject;
+
+    // the same key in the snapshot files and the mapped regions, computed from the tag if any :
+    auto const tagged_key = solo::anys::detail::make_any_type_persistent_key<TaggedObject>();
+    BOOST_TEST( tagged_key == solo::make_any_type_index<TaggedObject>().ordering_key() );
+    BOOST_TEST( tagged_key == solo::anys::detail::make_any_type_persistent_key(solo::anys::detail::make_any_type_fingerprint("solo.tests.tagged_object/1")) );
+    BOOST_TEST( solo::anys::detail::make_any_type_persistent_key<TaggedObject const>() == tagged_key );
+    BOOST_TEST( solo::anys::detail::make_any_type_persistent_key<TestObject>() == solo::make_any_type_index<TestObject>().ordering_key() );
+
+    auto const codec = solo::anys::snapshots::make_snapshot_codec<TaggedObject>();
+    BOOST_TEST( codec.type_key() == tagged_key );
+    auto codecs = solo::anys::snapshots::snapshot_codec_registry{};
+    codecs.add(codec);
+    BOOST_TEST( codecs.find(solo::make_any_handle<TaggedObject>(stdex::in_place, TaggedObject{ 1 })) != nullptr );
+    BOOST_TEST( codecs.find(solo::make_any_handle<TestObject>(stdex::in_place)) == nullptr );
+
+    auto bytes = std::string{};
+    auto const offset = solo::anys::regions::append_mapped_object( bytes, TaggedObject{ 2 } );
+    auto header = solo::anys::regions::mapped_object_header{};
+    std::memcpy(&header, bytes.data() + offset, sizeof(header));
+    BOOST_TEST( header.type_key == tagged_key );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // AnyTypeFingerprintTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
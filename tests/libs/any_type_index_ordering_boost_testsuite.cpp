@@ -0,0 +1,123 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "any_handle_testsuite_types.hpp"
+
+#include <solo/anys/handles/any_handle_core_package.hpp>
+
+#include <solo/anys/handles/testing/printing/any_handle_boost_test_outputters.hpp>
+#include <stdex/testing/printing/typeindex/std_type_index_boost_test_outputters.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( AnyTypeIndexOrderingTests )
+
+namespace {
+
+/// @brief All the flavours of type information of a few types (empty one included).
+std::vector<solo::any_type_index> make_ordering_test_type_indexes()
+{
+    return {
+        solo::any_type_index{},
+        solo::make_any_type_index<void>(solo::mutability::false_),
+        solo::make_any_type_index<void>(solo::mutability::true_),
+        solo::make_any_type_index<int>(solo::mutability::false_),
+        solo::make_any_type_index<int>(solo::mutability::true_),
+        solo::make_any_type_index<TestObject>(solo::mutability::false_),
+        solo::make_any_type_index<TestObject>(solo::mutability::true_),
+        solo::make_any_type_index<TestObjectBase>(solo::mutability::false_),
+        solo::make_any_type_index<TestObjectBase>(solo::mutability::true_),
+    };
+}
+
+}// EONS ANONYMOUS
+
+BOOST_AUTO_TEST_CASE( OrderingKeyCoversTypeEmptinessAndMutabilityTest )
+{
+    auto const tis = make_ordering_test_type_indexes();
+    for ( auto const &x : tis )
+    {
+        for ( auto const &y : tis )
+        {
+            BOOST_TEST( ( x.equals(y) == ( x.ordering_key() == y.ordering_key() ) ) );
+        }
+    }
+    // the empty type information is not the (non-empty) void one :
+    BOOST_TEST( solo::any_type_index{}.ordering_key() != solo::make_any_type_index<void>(solo::mutability::false_).ordering_key() );
+    // cv-qualifiers are ignored, as for the builtin c++ type information :
+    BOOST_TEST( solo::make_any_type_index<TestObject const>(solo::mutability::false_).ordering_key()
+             == solo::make_any_type_index<TestObject>(solo::mutability::false_).ordering_key() );
+}
+
+BOOST_AUTO_TEST_CASE( BeforeIsAStrictTotalOrderConsistentWithEqualsTest )
+{
+    auto const tis = make_ordering_test_type_indexes();
+    for ( auto const &x : tis )
+    {
+        BOOST_TEST( !x.before(x) );
+        for ( auto const &y : tis )
+        {
+            // exactly one of : x < y, y < x, x equals y
+            auto const count = int{x.before(y)} + int{y.before(x)} + int{x.equals(y)};
+            BOOST_TEST( count == 1 );
+            for ( auto const &z : tis )
+            {
+                if ( x.before(y) && y.before(z) )
+                {
+                    BOOST_TEST( x.before(z) );
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( OrderingKeyIsStableTest )
+{
+    // the key depends on the type name only : it is the same for every call (and every run)
+    auto const x = solo::make_any_type_index<TestObject>(solo::mutability::true_);
+    auto const key = solo::anys::detail::make_any_type_ordering_key(typeid(TestObject), true, true);
+    BOOST_TEST( x.ordering_key() == key );
+    BOOST_TEST( ( key & 3u ) == 3u );
+}
+
+BOOST_AUTO_TEST_CASE( SortedContainerKeyedByTypeTest )
+{
+    auto m = std::map<solo::any_type_index, int, solo::any_type_index_less>{};
+    m[solo::make_any_type_index<TestObject>(solo::mutability::false_)] = 1;
+    m[solo::make_any_type_index<TestObject>(solo::mutability::true_)] = 2;
+    m[solo::make_any_type_index<TestObject const>(solo::mutability::false_)] = 3;// same key as the first one
+    m[solo::any_type_index{}] = 4;
+    BOOST_TEST( m.size() == 3u );
+    BOOST_TEST( m[solo::make_any_type_index<TestObject>(solo::mutability::false_)] == 3 );
+
+    auto tis = make_ordering_test_type_indexes();
+    std::reverse(tis.begin(), tis.end());
+    std::sort(tis.begin(), tis.end(), solo::any_type_index_less{});
+    BOOST_TEST( std::is_sorted(tis.begin(), tis.end(), solo::any_type_index_less{}) );
+    BOOST_TEST( ( std::adjacent_find(tis.begin(), tis.end(),
+        [](solo::any_type_index const &a_x, solo::any_type_index const &a_y) { return a_x.equals(a_y); }) == tis.end() ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // AnyTypeIndexOrderingTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
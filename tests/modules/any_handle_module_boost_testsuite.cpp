@@ -0,0 +1,80 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#define BOOST_TEST_MODULE SoloAnyHandleModuleTestSuite
+#include <boost/test/included/unit_test.hpp>
+
+#include <stdex/in_place_t.hpp>
+#include <stdex/in_place_type_t.hpp>
+
+#include <memory>
+#include <typeinfo>
+
+import solo.any_handle;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+struct ModuleTestBase
+{
+    virtual ~ModuleTestBase() = default;
+};
+
+struct ModuleTestObject : ModuleTestBase
+{
+    explicit ModuleTestObject(int a_ = 0) noexcept : data{a_} {}
+    int data;
+};
+
+}// EONS ANONYMOUS
+
+//..............................................................................
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( ModuleTests )
+
+BOOST_AUTO_TEST_CASE( ImportedFactoriesAndCastsTest )
+{
+    auto const ah = solo::make_any_handle_mutable<ModuleTestObject>(stdex::in_place, 3);
+    BOOST_TEST( ah.use_count() == 1 );
+    BOOST_TEST( ah.is_mutable() );
+    BOOST_TEST( ( ah.type() == typeid(ModuleTestObject) ) );
+
+    auto const p = solo::any_handle_mutable_cast<ModuleTestObject>(ah);
+    BOOST_TEST( p.has_value() );
+    BOOST_TEST( p.assume_value()->data == 3 );
+    BOOST_TEST( solo::any_handle_cast<ModuleTestBase>(ah).has_error() );
+    BOOST_CHECK_THROW( solo::any_handle_cast_or_throw<ModuleTestBase>(ah), solo::anys::exceptions::bad_any_handle_cast );
+
+    auto const ah_base = solo::make_any_handle<ModuleTestBase>(stdex::in_place_type<ModuleTestObject>, 4);
+    BOOST_TEST( ( ah_base.type() == typeid(ModuleTestBase) ) );
+    BOOST_TEST( ( ah != ah_base ) );
+    BOOST_TEST( ( ah == ah ) );
+}
+
+BOOST_AUTO_TEST_CASE( ImportedSharedPointerFactoriesTest )
+{
+    auto const x_sh = std::make_shared<ModuleTestObject>(5);
+    auto const ah = solo::make_any_handle(x_sh);
+    BOOST_TEST( ah.use_count() == 2 );
+    BOOST_TEST( !ah.is_mutable() );
+    BOOST_TEST( ( solo::any_handle_cast_or_throw<ModuleTestObject>(ah) == x_sh ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // ModuleTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,182 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "plugin_types.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <dlfcn.h>
+
+#include <stdexcept>
+#include <string>
+
+// The plugins paths are given by the build :
+// SOLO_TESTS_PRODUCER_PLUGIN and SOLO_TESTS_CONSUMER_PLUGIN.
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests {
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// @brief A shared library loaded with RTLD_LOCAL (its symbols are not shared with the other binaries).
+class LocalPlugin
+{
+public:
+
+    explicit LocalPlugin( char const *a_path )
+        : m_library{ ::dlopen(a_path, RTLD_NOW | RTLD_LOCAL) }
+    {
+        if ( m_library == nullptr )
+        {
+            throw std::runtime_error{ std::string{"cannot load "} + a_path + " : " + ::dlerror() };
+        }
+    }
+
+    LocalPlugin( LocalPlugin const & ) = delete;
+    LocalPlugin &operator=( LocalPlugin const & ) = delete;
+
+    ~LocalPlugin() { ::dlclose(m_library); }
+
+    template < typename F >
+    F function( char const *a_name ) const
+    {
+        auto *const f = ::dlsym(m_library, a_name);
+        if ( f == nullptr )
+        {
+            throw std::runtime_error{ std::string{"cannot find "} + a_name };
+        }
+        return reinterpret_cast<F>(f);
+    }
+
+private:
+
+    void *m_library;
+};
+
+/// @brief The two plugins, loaded once for the whole testsuite (the handles they built must not outlive them).
+struct Plugins
+{
+    LocalPlugin producer{ SOLO_TESTS_PRODUCER_PLUGIN };
+    LocalPlugin consumer{ SOLO_TESTS_CONSUMER_PLUGIN };
+
+    solo_tests_make_handle_function make_mesh = producer.function<solo_tests_make_handle_function>("solo_tests_producer_make_mesh");
+    solo_tests_make_handle_function make_texture = producer.function<solo_tests_make_handle_function>("solo_tests_producer_make_texture");
+    solo_tests_make_handle_function make_local = producer.function<solo_tests_make_handle_function>("solo_tests_producer_make_local");
+    solo_tests_type_index_function producer_local_type_index = producer.function<solo_tests_type_index_function>("solo_tests_producer_local_type_index");
+    solo_tests_fingerprint_function producer_mesh_fingerprint = producer.function<solo_tests_fingerprint_function>("solo_tests_producer_mesh_fingerprint");
+
+    solo_tests_read_handle_function read_mesh = consumer.function<solo_tests_read_handle_function>("solo_tests_consumer_read_mesh");
+    solo_tests_read_handle_function grow_mesh = consumer.function<solo_tests_read_handle_function>("solo_tests_consumer_grow_mesh");
+    solo_tests_read_handle_function read_texture = consumer.function<solo_tests_read_handle_function>("solo_tests_consumer_read_texture");
+    solo_tests_fingerprint_function consumer_mesh_fingerprint = consumer.function<solo_tests_fingerprint_function>("solo_tests_consumer_mesh_fingerprint");
+};
+
+Plugins const &loaded_plugins()
+{
+    static Plugins const p;
+    return p;
+}
+
+}// EONS ANONYMOUS
+
+namespace plugins { namespace {
+
+/// @brief A type with internal linkage, of the same name than the one of the producer plugin (same fingerprint).
+struct PluginLocal
+{
+    double value;
+};
+
+}}// EONS PLUGINS::ANONYMOUS
+
+//..............................................................................
+
+BOOST_AUTO_TEST_SUITE( SoloAnyHandleTestSuite )
+
+BOOST_AUTO_TEST_SUITE( PluginsTests )
+
+BOOST_AUTO_TEST_CASE( FingerprintsAreTheSameInEveryBinaryTest )
+{
+    using solo::tests::plugins::PluginMesh;
+    auto const &p = loaded_plugins();
+    auto const fingerprint = solo::make_any_type_index<PluginMesh>().fingerprint();
+    BOOST_TEST( p.producer_mesh_fingerprint() == fingerprint );
+    BOOST_TEST( p.consumer_mesh_fingerprint() == fingerprint );
+    BOOST_TEST( solo::make_any_type_index<PluginMesh>(solo::mutability::true_).fingerprint() == fingerprint );
+    BOOST_TEST( solo::make_any_type_index<solo::tests::plugins::PluginTexture>().fingerprint() != fingerprint );
+}
+
+BOOST_AUTO_TEST_CASE( HandlesMadeInAPluginAreCastInAnotherPluginTest )
+{
+    using solo::tests::plugins::PluginMesh;
+    auto const &p = loaded_plugins();
+
+    auto mesh = solo::any_handle{};
+    p.make_mesh(&mesh, 3);
+    BOOST_TEST( mesh.is_mutable() );
+    BOOST_TEST( p.read_mesh(&mesh) == 3 );
+    BOOST_TEST( p.grow_mesh(&mesh) == 4 );
+    BOOST_TEST( solo::any_handle_cast_or_throw<PluginMesh>(mesh)->vertex_count == 4 );// cast in the executable
+
+    auto texture = solo::any_handle{};
+    p.make_texture(&texture, 256);
+    BOOST_TEST( !texture.is_mutable() );
+    BOOST_TEST( p.read_texture(&texture) == 256 );// tagged type
+    BOOST_TEST( p.read_mesh(&texture) == -1 );// bad type
+    BOOST_TEST( p.grow_mesh(&texture) == -1 );
+    BOOST_TEST( p.read_texture(&mesh) == -1 );
+
+    auto const empty = solo::any_handle{};
+    BOOST_TEST( p.read_mesh(&empty) == -1 );
+}
+
+BOOST_AUTO_TEST_CASE( HandlesMadeInTheExecutableAreCastInAPluginTest )
+{
+    using solo::tests::plugins::PluginMesh;
+    auto const &p = loaded_plugins();
+
+    auto const mesh = solo::make_any_handle<PluginMesh>(stdex::in_place, PluginMesh{ 8 });
+    BOOST_TEST( p.read_mesh(&mesh) == 8 );
+    BOOST_TEST( p.grow_mesh(&mesh) == -1 );// non-mutable
+
+    auto mesh_from_plugin = solo::any_handle{};
+    p.make_mesh(&mesh_from_plugin, 8);
+    BOOST_TEST( mesh_from_plugin.type_fingerprint() == mesh.type_fingerprint() );
+}
+
+BOOST_AUTO_TEST_CASE( TypesWithInternalLinkageAreNotConfusedTest )
+{
+    using solo::tests::plugins::PluginLocal;
+    auto const &p = loaded_plugins();
+
+    auto local = solo::any_handle{};
+    p.make_local(&local, 5);
+    auto const own = solo::make_any_handle<PluginLocal>(stdex::in_place, PluginLocal{ 5. });
+
+    // distinct types of the same name : the same fingerprint, told apart by their builtin type information
+    BOOST_TEST( local.type_fingerprint() == own.type_fingerprint() );
+    BOOST_TEST( !solo::any_handle_cast<PluginLocal>(local).has_value() );
+    BOOST_TEST( solo::any_handle_cast<PluginLocal>(own).has_value() );
+
+    auto const local_type = p.producer_local_type_index();
+    auto const own_type = solo::make_any_type_index<PluginLocal>();
+    BOOST_TEST( local_type.fingerprint() == own_type.fingerprint() );
+    BOOST_TEST( !local_type.equals(own_type) );
+    BOOST_TEST( own_type.equals(solo::make_any_type_index<PluginLocal>()) );
+    BOOST_TEST( local_type.before(own_type) != own_type.before(local_type) );
+}
+
+BOOST_AUTO_TEST_SUITE_END() // PluginsTests
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
+}}// EONS SOLOTESTS
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,41 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "plugin_types.hpp"
+
+// A plugin casting the handles made by the producer plugin and by the testsuite.
+
+using solo::tests::plugins::PluginMesh;
+using solo::tests::plugins::PluginTexture;
+
+/// @return The vertex count of the handled mesh, or -1 if the cast fails.
+SOLO_TESTS_PLUGIN_EXPORT int solo_tests_consumer_read_mesh( solo::any_handle const *a_handle )
+{
+    auto const result = solo::any_handle_cast<PluginMesh>(*a_handle);
+    return result.has_value() ? result.assume_value()->vertex_count : -1;
+}
+
+/// @return The incremented vertex count of the handled mutable mesh, or -1 if the cast fails.
+SOLO_TESTS_PLUGIN_EXPORT int solo_tests_consumer_grow_mesh( solo::any_handle const *a_handle )
+{
+    auto const result = solo::any_handle_mutable_cast<PluginMesh>(*a_handle);
+    return result.has_value() ? ++result.assume_value()->vertex_count : -1;
+}
+
+/// @return The width of the handled texture, or -1 if the cast fails.
+SOLO_TESTS_PLUGIN_EXPORT int solo_tests_consumer_read_texture( solo::any_handle const *a_handle )
+{
+    auto const result = solo::any_handle_cast<PluginTexture>(*a_handle);
+    return result.has_value() ? result.assume_value()->width : -1;
+}
+
+SOLO_TESTS_PLUGIN_EXPORT std::uint64_t solo_tests_consumer_mesh_fingerprint()
+{
+    return solo::make_any_type_index<PluginMesh>().fingerprint();
+}
@@ -0,0 +1,49 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <solo/anys/handles/any_handle_package.hpp>
+
+#include <cstdint>
+
+// The types and the C interface shared by the test plugins and the plugins testsuite.
+// The plugins are loaded with RTLD_LOCAL and built with hidden visibility :
+// each binary has its own type information objects.
+
+////////////////////////////////////////////////////////////////////////////////
+namespace solo { namespace tests { namespace plugins {
+////////////////////////////////////////////////////////////////////////////////
+
+/// @brief A type identified by its name.
+struct PluginMesh
+{
+    int vertex_count;
+};
+
+/// @brief A type identified by a user tag.
+struct PluginTexture
+{
+    int width;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}}}// EONS SOLO::TESTS::PLUGINS
+////////////////////////////////////////////////////////////////////////////////
+
+SOLO_ANY_TYPE_TAG(solo::tests::plugins::PluginTexture, "solo.tests.plugins.texture/1")
+
+#define SOLO_TESTS_PLUGIN_EXPORT extern "C" __attribute__((visibility("default")))
+
+// producer plugin :
+using solo_tests_make_handle_function = void (*)( solo::any_handle *a_handle, int a_value );
+using solo_tests_fingerprint_function = std::uint64_t (*)();
+using solo_tests_type_index_function = solo::any_type_index (*)();
+
+// consumer plugin :
+using solo_tests_read_handle_function = int (*)( solo::any_handle const *a_handle );
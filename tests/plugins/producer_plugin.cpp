@@ -0,0 +1,50 @@
+//------------------------------------------------------------------------------
+//
+// Copyright (c) 2020 Nicolas Pichon
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See http://www.boost.org/LICENSE_1_0.txt)
+//
+//------------------------------------------------------------------------------
+
+#include "plugin_types.hpp"
+
+// A plugin making the handles read by the consumer plugin and by the testsuite.
+
+using solo::tests::plugins::PluginMesh;
+using solo::tests::plugins::PluginTexture;
+
+namespace solo { namespace tests { namespace plugins { namespace {
+
+/// @brief A type with internal linkage : the testsuite has another type of the same name.
+struct PluginLocal
+{
+    int value;
+};
+
+}}}}// EONS SOLO::TESTS::PLUGINS::ANONYMOUS
+
+SOLO_TESTS_PLUGIN_EXPORT void solo_tests_producer_make_mesh( solo::any_handle *a_handle, int a_vertex_count )
+{
+    *a_handle = solo::make_any_handle_mutable<PluginMesh>( stdex::in_place, PluginMesh{ a_vertex_count } );
+}
+
+SOLO_TESTS_PLUGIN_EXPORT void solo_tests_producer_make_texture( solo::any_handle *a_handle, int a_width )
+{
+    *a_handle = solo::make_any_handle<PluginTexture>( stdex::in_place, PluginTexture{ a_width } );
+}
+
+SOLO_TESTS_PLUGIN_EXPORT void solo_tests_producer_make_local( solo::any_handle *a_handle, int a_value )
+{
+    *a_handle = solo::make_any_handle<solo::tests::plugins::PluginLocal>( stdex::in_place, solo::tests::plugins::PluginLocal{ a_value } );
+}
+
+SOLO_TESTS_PLUGIN_EXPORT solo::any_type_index solo_tests_producer_local_type_index()
+{
+    return solo::make_any_type_index<solo::tests::plugins::PluginLocal>();
+}
+
+SOLO_TESTS_PLUGIN_EXPORT std::uint64_t solo_tests_producer_mesh_fingerprint()
+{
+    return solo::make_any_type_index<PluginMesh>().fingerprint();
+}